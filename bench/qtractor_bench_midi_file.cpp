@@ -0,0 +1,257 @@
+// qtractor_bench_midi_file.cpp
+//
+/****************************************************************************
+   Copyright (C) 2005-2025, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#include "qtractorMidiFile.h"
+#include "qtractorMidiFileTempo.h"
+#include "qtractorTimeScale.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFileInfo>
+#include <QStringList>
+
+#include <chrono>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+
+//----------------------------------------------------------------------
+// qtractorMidiFile (SMF) import corpus benchmark.
+//
+// usage: qtractor_bench_midi_file [files or directories...]
+//
+// Imports each given SMF (or every *.mid file found in each given
+// directory) as the session would: once with all tracks in one go
+// (readTracks, parallel for large format 1 files), once one track at
+// a time (readTrack, serial), and also asks for all track durations
+// (readTrackDuration, as on clip open). When no arguments are given,
+// a synthetic corpus of CC-heavy, multi-track format 1 files is
+// written to a temporary directory first, and removed afterwards.
+//
+
+typedef std::chrono::steady_clock bench_clock;
+
+static double bench_ms ( const bench_clock::time_point& t0 )
+{
+	return std::chrono::duration<double, std::milli>(
+		bench_clock::now() - t0).count();
+}
+
+
+// Write a synthetic SMF format 1 file, SMF-like.
+static bool bench_write ( const QString& sFilename,
+	unsigned short iTracks, unsigned int iEvents, unsigned int iSeed )
+{
+	const unsigned short iTicksPerBeat = 960;
+
+	qtractorMidiFile file;
+	if (!file.open(sFilename, qtractorMidiFile::Write))
+		return false;
+
+	if (!file.writeHeader(1, iTracks + 1, iTicksPerBeat)) {
+		file.close();
+		return false;
+	}
+
+	qtractorTimeScale ts;
+	ts.setTicksPerBeat(iTicksPerBeat);
+	if (file.tempoMap())
+		file.tempoMap()->fromTimeScale(&ts, 0);
+
+	// The tempo/time-signature track...
+	file.writeTrack(nullptr);
+
+	for (unsigned short iTrack = 0; iTrack < iTracks; ++iTrack) {
+		qtractorMidiSequence seq(QString(), iTrack & 0x0f, iTicksPerBeat);
+		qtractorMidiEventArena *pArena = seq.arena();
+		unsigned long iTime = 0;
+		unsigned int n = 0;
+		while (n < iEvents) {
+			iSeed = iSeed * 1664525 + 1013904223;
+			const unsigned char note = 36 + ((iSeed >> 16) % 48);
+			qtractorMidiEvent *pEvent = new (pArena) qtractorMidiEvent(
+				iTime, qtractorMidiEvent::NOTEON, note, 100);
+			pEvent->setDuration(iTicksPerBeat >> 1);
+			seq.addEvent(pEvent);
+			++n;
+			for (int i = 0; i < 8 && n < iEvents; ++i, ++n) {
+				pEvent = new (pArena) qtractorMidiEvent(iTime + 10 * i,
+					(i & 1) ? qtractorMidiEvent::CONTROLLER
+						: qtractorMidiEvent::PITCHBEND,
+					(i & 1) ? 1 + (i >> 1) : 0, (iSeed >> (i + 8)) & 0x7f);
+				seq.addEvent(pEvent);
+			}
+			iTime += (iTicksPerBeat >> 2);
+		}
+		seq.close();
+		if (!file.writeTrack(&seq)) {
+			file.close();
+			return false;
+		}
+	}
+
+	file.close();
+	return true;
+}
+
+
+// Corpus totals.
+struct BenchStats
+{
+	unsigned int  files;
+	unsigned int  tracks;
+	unsigned long events;
+	unsigned long bytes;
+	double        t_tracks;
+	double        t_track;
+	double        t_duration;
+};
+
+
+// Import one file, all three ways.
+static bool bench_read ( const QString& sFilename, BenchStats& stats )
+{
+	qtractorMidiFile file;
+
+	// All tracks in one go...
+	bench_clock::time_point t0 = bench_clock::now();
+	if (!file.open(sFilename))
+		return false;
+	const unsigned short iFormat = file.format();
+	const unsigned short iSeqs = (iFormat == 1 ? file.tracks() : 16);
+	qtractorMidiSequence **ppSeqs = new qtractorMidiSequence * [iSeqs];
+	for (unsigned short iSeq = 0; iSeq < iSeqs; ++iSeq) {
+		ppSeqs[iSeq] = new qtractorMidiSequence(
+			QString(), iSeq, file.ticksPerBeat());
+	}
+	const bool bResult = file.readTracks(ppSeqs, iSeqs);
+	file.close();
+	stats.t_tracks += bench_ms(t0);
+
+	unsigned long iEvents = 0;
+	for (unsigned short iSeq = 0; iSeq < iSeqs; ++iSeq) {
+		iEvents += ppSeqs[iSeq]->events().count();
+		delete ppSeqs[iSeq];
+	}
+	delete [] ppSeqs;
+
+	if (!bResult)
+		return false;
+
+	// One track at a time...
+	t0 = bench_clock::now();
+	if (!file.open(sFilename))
+		return false;
+	for (unsigned short iSeq = 0; iSeq < iSeqs; ++iSeq) {
+		qtractorMidiSequence seq(QString(), iSeq, file.ticksPerBeat());
+		file.readTrack(&seq, iSeq);
+	}
+	file.close();
+	stats.t_track += bench_ms(t0);
+
+	// All track durations...
+	unsigned long iDuration = 0;
+	t0 = bench_clock::now();
+	if (!file.open(sFilename))
+		return false;
+	for (unsigned short iSeq = 0; iSeq < iSeqs; ++iSeq)
+		iDuration += file.readTrackDuration(iSeq);
+	file.close();
+	stats.t_duration += bench_ms(t0);
+
+	++stats.files;
+	stats.tracks += iSeqs;
+	stats.events += iEvents;
+	stats.bytes  += QFileInfo(sFilename).size();
+
+	return (iDuration > 0 || iEvents == 0);
+}
+
+
+// Main.
+int main ( int argc, char **argv )
+{
+	QStringList files;
+	QDir tmpdir;
+	bool bTemp = false;
+
+	for (int i = 1; i < argc; ++i) {
+		const QFileInfo info(QString::fromLocal8Bit(argv[i]));
+		if (info.isDir()) {
+			const QDir dir(info.absoluteFilePath());
+			const QStringList filters = QStringList()
+				<< "*.mid" << "*.midi" << "*.smf" << "*.MID";
+			for (const QString& sName : dir.entryList(filters, QDir::Files))
+				files.append(dir.absoluteFilePath(sName));
+		}
+		else
+		if (info.isFile())
+			files.append(info.absoluteFilePath());
+	}
+
+	// No corpus given, make up one...
+	if (argc < 2) {
+		tmpdir.setPath(QDir::temp().absoluteFilePath(
+			QString("qtractor_bench_midi_file.%1")
+				.arg(QCoreApplication::applicationPid())));
+		bTemp = tmpdir.mkpath(tmpdir.path());
+		static const struct { unsigned short tracks; unsigned int events; } corpus[] = {
+			{  2,   2000 },
+			{  8,  20000 },
+			{ 16,  40000 },
+			{ 32,  20000 },
+			{ 64,   5000 }
+		};
+		unsigned int iSeed = 1;
+		for (const auto& item : corpus) {
+			const QString& sFilename = tmpdir.absoluteFilePath(
+				QString("bench_%1x%2.mid").arg(item.tracks).arg(item.events));
+			if (bench_write(sFilename, item.tracks, item.events, iSeed++))
+				files.append(sFilename);
+		}
+	}
+
+	::printf("qtractor_bench_midi_file: %d files\n\n", int(files.count()));
+
+	BenchStats stats = { 0, 0, 0, 0, 0.0, 0.0, 0.0 };
+
+	for (const QString& sFilename : files) {
+		if (!bench_read(sFilename, stats))
+			::printf("failed   %s\n", sFilename.toLocal8Bit().constData());
+	}
+
+	if (bTemp)
+		tmpdir.removeRecursively();
+
+	::printf("files    %10u  (%u tracks, %lu events, %lu KB)\n",
+		stats.files, stats.tracks, stats.events, stats.bytes / 1024);
+	::printf("tracks   %10.3f ms  (%.0f events/s)\n", stats.t_tracks,
+		stats.t_tracks > 0.0 ? 1000.0 * stats.events / stats.t_tracks : 0.0);
+	::printf("track    %10.3f ms  (%.0f events/s)\n", stats.t_track,
+		stats.t_track > 0.0 ? 1000.0 * stats.events / stats.t_track : 0.0);
+	::printf("duration %10.3f ms\n", stats.t_duration);
+
+	return 0;
+}
+
+
+// end of qtractor_bench_midi_file.cpp
@@ -0,0 +1,210 @@
+// qtractor_bench_midi_sequence.cpp
+//
+/****************************************************************************
+   Copyright (C) 2005-2025, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#include "qtractorMidiSequence.h"
+
+#include <chrono>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+
+//----------------------------------------------------------------------
+// qtractorMidiSequence (arena-backed) event storage benchmark.
+//
+// usage: qtractor_bench_midi_sequence [events [passes]]
+//
+// Loads a large, CC-heavy sequence, as from a SMF (notes and their
+// note-offs, controllers, pitch-bend and some sysex), then copies it
+// and walks it as in playback, reporting times and resident memory;
+// finally, deletes most of the events out of order, to show how many
+// chunks are still pinned by the survivors.
+//
+
+typedef std::chrono::steady_clock bench_clock;
+
+static double bench_ms ( const bench_clock::time_point& t0 )
+{
+	return std::chrono::duration<double, std::milli>(
+		bench_clock::now() - t0).count();
+}
+
+
+// Current resident set size (in KB; Linux only).
+static unsigned long bench_rss (void)
+{
+	unsigned long iSize = 0, iResident = 0;
+	FILE *fp = ::fopen("/proc/self/statm", "r");
+	if (fp) {
+		if (::fscanf(fp, "%lu %lu", &iSize, &iResident) != 2)
+			iResident = 0;
+		::fclose(fp);
+	}
+	return iResident * (::sysconf(_SC_PAGESIZE) / 1024);
+}
+
+
+// Load a synthetic sequence, SMF-like.
+static void bench_load ( qtractorMidiSequence *pSeq, unsigned int iEvents )
+{
+	static const unsigned char sysex[]
+		= { 0xf0, 0x7e, 0x7f, 0x09, 0x01, 0xf7 };
+
+	qtractorMidiEventArena *pArena = pSeq->arena();
+
+	unsigned long iTime = 0;
+	unsigned int iSeed = 1;
+	unsigned int n = 0;
+
+	while (n < iEvents) {
+		iSeed = iSeed * 1664525 + 1013904223;
+		const unsigned char note = 36 + ((iSeed >> 16) % 48);
+		qtractorMidiEvent *pEvent;
+		// A note-on...
+		pEvent = new (pArena) qtractorMidiEvent(
+			iTime, qtractorMidiEvent::NOTEON, note, 100);
+		pSeq->addEvent(pEvent);
+		++n;
+		// A burst of controllers and pitch-bend...
+		for (int i = 0; i < 8 && n < iEvents; ++i, ++n) {
+			pEvent = new (pArena) qtractorMidiEvent(iTime + 10 * i,
+				(i & 1) ? qtractorMidiEvent::CONTROLLER
+					: qtractorMidiEvent::PITCHBEND,
+				(i & 1) ? 1 + (i >> 1) : 0, (iSeed >> (i + 8)) & 0x7f);
+			pSeq->addEvent(pEvent);
+		}
+		// Some sysex, every now and then...
+		if ((n & 0x3ff) == 0 && n < iEvents) {
+			pEvent = new (pArena) qtractorMidiEvent(
+				iTime, qtractorMidiEvent::SYSEX);
+			pEvent->setSysex(sysex, sizeof(sysex), pArena);
+			pSeq->addEvent(pEvent);
+			++n;
+		}
+		// And the note-off (transient)...
+		pSeq->addNoteOff(iTime + 90, note);
+		iTime += 120;
+	}
+
+	pSeq->close();
+}
+
+
+// Walk the sequence, as in playback.
+static unsigned long bench_play ( qtractorMidiSequence *pSeq )
+{
+	unsigned long iSum = 0;
+	const qtractorList<qtractorMidiEvent>& events = pSeq->events();
+	for (qtractorMidiEvent *pEvent = events.first();
+			pEvent; pEvent = pEvent->next()) {
+		iSum += pEvent->time() + pEvent->type() + pEvent->value();
+		if (pEvent->type() == qtractorMidiEvent::NOTEON)
+			iSum += pEvent->duration();
+	}
+	return iSum;
+}
+
+
+// Main.
+int main ( int argc, char **argv )
+{
+	unsigned int iEvents = 200000;
+	int iPasses = 50;
+
+	if (argc > 1)
+		iEvents = ::strtoul(argv[1], nullptr, 0);
+	if (argc > 2)
+		iPasses = ::atoi(argv[2]);
+	if (iEvents < 1000)
+		iEvents = 1000;
+	if (iPasses < 1)
+		iPasses = 1;
+
+	::printf("qtractor_bench_midi_sequence: %u events, %d playback passes\n\n",
+		iEvents, iPasses);
+
+	const unsigned long iRss0 = bench_rss();
+
+	// Load...
+	qtractorMidiSequence *pSeq = new qtractorMidiSequence();
+	bench_clock::time_point t0 = bench_clock::now();
+	bench_load(pSeq, iEvents);
+	const double t_load = bench_ms(t0);
+	const unsigned int iLoadChunks = qtractorMidiEventArena::chunks();
+	const unsigned long iRss1 = bench_rss();
+
+	// Copy...
+	qtractorMidiSequence *pCopy = new qtractorMidiSequence();
+	t0 = bench_clock::now();
+	pCopy->copyEvents(pSeq);
+	const double t_copy = bench_ms(t0);
+
+	// Playback walk...
+	unsigned long iSum = 0;
+	t0 = bench_clock::now();
+	for (int i = 0; i < iPasses; ++i)
+		iSum += bench_play(pCopy);
+	const double t_play = bench_ms(t0);
+
+	// Clear...
+	t0 = bench_clock::now();
+	pCopy->clear();
+	const double t_clear = bench_ms(t0);
+	delete pCopy;
+
+	// Out of order deletion, keeping one in every 64 events...
+	t0 = bench_clock::now();
+	unsigned int iLive = 0;
+	unsigned int k = 0;
+	qtractorMidiEvent *pEvent = pSeq->events().first();
+	while (pEvent) {
+		qtractorMidiEvent *pNextEvent = pEvent->next();
+		if ((++k & 63) == 0)
+			++iLive;
+		else
+			pSeq->removeEvent(pEvent);
+		pEvent = pNextEvent;
+	}
+	const double t_remove = bench_ms(t0);
+	const unsigned int iPinnedChunks = qtractorMidiEventArena::chunks();
+
+	::printf("load     %10.3f ms  (%u chunks, %lu KB resident)\n",
+		t_load, iLoadChunks, iRss1 - iRss0);
+	::printf("copy     %10.3f ms\n", t_copy);
+	::printf("play     %10.3f ms  (%.3f ms per pass, checksum %lu)\n",
+		t_play, t_play / iPasses, iSum);
+	::printf("clear    %10.3f ms\n", t_clear);
+	::printf("remove   %10.3f ms  (%u live events pin %u chunks)\n",
+		t_remove, iLive, iPinnedChunks);
+
+	::printf("\nheap allocs=%u slot reuses=%u spares=%u\n",
+		qtractorMidiEventArena::heapAllocs(),
+		qtractorMidiEventArena::slotReuses(),
+		qtractorMidiEventArena::spares());
+
+	delete pSeq;
+
+	return 0;
+}
+
+
+// end of qtractor_bench_midi_sequence.cpp
@@ -0,0 +1,203 @@
+// qtractor_bench_mix.cpp
+//
+/****************************************************************************
+   Copyright (C) 2005-2025, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#include "qtractorAudioBufferMix.h"
+
+#include <chrono>
+#include <cmath>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+
+//----------------------------------------------------------------------
+// qtractorAudioBuffer gain/panning mix-down (add) kernels micro-benchmark.
+//
+// usage: qtractor_bench_mix [frames [iterations]]
+//
+// Every kernel output is first checked to be bit-identical to the
+// standard kernels, for all (mis)alignments of both buffers; exits
+// with failure status otherwise (also run as a test).
+//
+
+typedef void (*MixGainFunc)(float *, const float *, unsigned int, float);
+typedef void (*MixRampFunc)(float *, const float *, unsigned int, float, float);
+
+struct MixKernel
+{
+	const char *name;
+	MixGainFunc gain;
+	MixRampFunc ramp;
+};
+
+
+// Fill buffer with some (deterministic) noise.
+static void bench_fill ( float *pBuffer, unsigned int iFrames, unsigned int iSeed )
+{
+	for (unsigned int n = 0; n < iFrames; ++n) {
+		iSeed = iSeed * 1664525 + 1013904223;
+		pBuffer[n] = float(int(iSeed >> 9) - 0x400000) / float(0x400000);
+	}
+}
+
+
+// Largest absolute difference between two buffers.
+static float bench_diff ( const float *pA, const float *pB, unsigned int iFrames )
+{
+	float fDiff = 0.0f;
+	for (unsigned int n = 0; n < iFrames; ++n) {
+		const float d = std::fabs(pA[n] - pB[n]);
+		if (fDiff < d)
+			fDiff = d;
+	}
+	return fDiff;
+}
+
+
+// Time one kernel, over all (mis)alignments of the output buffer.
+static double bench_gain ( MixGainFunc pfnGain,
+	float *pFrames, const float *pBuffer, unsigned int iFrames, int iIters )
+{
+	const auto t0 = std::chrono::steady_clock::now();
+	for (int i = 0; i < iIters; ++i) {
+		const unsigned int k = (i & 7);
+		(*pfnGain)(pFrames + k, pBuffer, iFrames - k, 0.5f);
+	}
+	const auto t1 = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::nano>(t1 - t0).count()
+		/ (double(iIters) * double(iFrames));
+}
+
+static double bench_ramp ( MixRampFunc pfnRamp,
+	float *pFrames, const float *pBuffer, unsigned int iFrames, int iIters )
+{
+	const float fGainStep = 1.0f / float(iFrames);
+	const auto t0 = std::chrono::steady_clock::now();
+	for (int i = 0; i < iIters; ++i) {
+		const unsigned int k = (i & 7);
+		(*pfnRamp)(pFrames + k, pBuffer, iFrames - k, 0.0f, fGainStep);
+	}
+	const auto t1 = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::nano>(t1 - t0).count()
+		/ (double(iIters) * double(iFrames));
+}
+
+
+// Main.
+int main ( int argc, char **argv )
+{
+	unsigned int iFrames = 1024;
+	int iIters = 200000;
+
+	if (argc > 1)
+		iFrames = ::strtoul(argv[1], nullptr, 0);
+	if (argc > 2)
+		iIters = ::atoi(argv[2]);
+	if (iFrames < 16)
+		iFrames = 16;
+	if (iIters < 1)
+		iIters = 1;
+
+	MixKernel kernels[4];
+	int iKernels = 0;
+
+	kernels[iKernels++] = { "std", std_mix_gain, std_mix_ramp };
+#if defined(__SSE__)
+	if (sse_enabled())
+		kernels[iKernels++] = { "sse", sse_mix_gain, sse_mix_ramp };
+#if defined(QTRACTOR_AVX_MIX)
+	if (avx_enabled())
+		kernels[iKernels++] = { "avx", avx_mix_gain, avx_mix_ramp };
+#endif
+#endif
+#if defined(__ARM_NEON__)
+	kernels[iKernels++] = { "neon", neon_mix_gain, neon_mix_ramp };
+#endif
+
+	const unsigned int iSize = iFrames + 16;
+	float *pBuffer = new float [iSize];
+	float *pFrames = new float [iSize];
+	float *pCheck0 = new float [iSize];
+	float *pCheck1 = new float [iSize];
+
+	bench_fill(pBuffer, iSize, 1);
+
+	::printf("qtractor_bench_mix: %u frames x %d iterations\n\n",
+		iFrames, iIters);
+	::printf("%-6s %12s %8s %12s %8s %12s\n",
+		"kernel", "gain ns/fr", "speedup", "ramp ns/fr", "speedup", "max diff");
+
+	double t0_gain = 0.0;
+	double t0_ramp = 0.0;
+
+	int iResult = 0;
+
+	for (int i = 0; i < iKernels; ++i) {
+		const MixKernel& kernel = kernels[i];
+		// Check results against the standard kernels, for
+		// every output and input buffer (mis)alignment...
+		float fDiff = 0.0f;
+		for (unsigned int k = 0; k < 8; ++k) {
+			for (unsigned int j = 0; j < 8; ++j) {
+				const unsigned int n = iFrames - 8;
+				bench_fill(pCheck0, iSize, 2);
+				bench_fill(pCheck1, iSize, 2);
+				std_mix_gain(pCheck0 + k, pBuffer + j, n, 0.75f);
+				(*kernel.gain)(pCheck1 + k, pBuffer + j, n, 0.75f);
+				std_mix_ramp(pCheck0 + k, pBuffer + j, n, 0.25f, 0.5f / float(n));
+				(*kernel.ramp)(pCheck1 + k, pBuffer + j, n, 0.25f, 0.5f / float(n));
+				const float d = bench_diff(pCheck0, pCheck1, iSize);
+				if (fDiff < d)
+					fDiff = d;
+			}
+		}
+		if (fDiff > 0.0f)
+			iResult = 1;
+		// Timings...
+		bench_fill(pFrames, iSize, 3);
+		const double t_gain
+			= bench_gain(kernel.gain, pFrames, pBuffer, iFrames, iIters);
+		bench_fill(pFrames, iSize, 3);
+		const double t_ramp
+			= bench_ramp(kernel.ramp, pFrames, pBuffer, iFrames, iIters);
+		if (i == 0) {
+			t0_gain = t_gain;
+			t0_ramp = t_ramp;
+		}
+		::printf("%-6s %12.4f %7.2fx %12.4f %7.2fx %12g\n",
+			kernel.name,
+			t_gain, t0_gain / t_gain,
+			t_ramp, t0_ramp / t_ramp, fDiff);
+	}
+
+	delete [] pCheck1;
+	delete [] pCheck0;
+	delete [] pFrames;
+	delete [] pBuffer;
+
+	if (iResult)
+		::printf("\nFAILED: kernels output differs from the standard ones.\n");
+
+	return iResult;
+}
+
+
+// end of qtractor_bench_mix.cpp
@@ -0,0 +1,202 @@
+// qtractor_bench_wsola.cpp
+//
+/****************************************************************************
+   Copyright (C) 2005-2025, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#include "qtractorWsolaTimeStretcher.h"
+
+#include <chrono>
+#include <cmath>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+
+//----------------------------------------------------------------------
+// qtractorWsolaTimeStretcher seek modes and kernels benchmark.
+//
+// usage: qtractor_bench_wsola [seconds [tempo]]
+//
+// Speed is given as the realtime factor (stretched audio seconds per
+// processing second); quality as the excess high-frequency energy of
+// the output over the input's, in dB (splice clicks and discontinuities
+// show up there; the lower the better, 0 dB is ideal), and the output
+// length error against the nominal stretched length.
+//
+
+static const unsigned int c_iSampleRate = 44100;
+static const unsigned short c_iChannels = 2;
+static const unsigned int c_iBlockSize  = 1024;
+
+
+// High-frequency (second difference) to total energy ratio.
+static double bench_hf_ratio ( const float *pFrames, unsigned int iFrames )
+{
+	double e0 = 0.0, e2 = 0.0;
+	for (unsigned int n = 2; n < iFrames; ++n) {
+		const double d2 = pFrames[n] - 2.0 * pFrames[n - 1] + pFrames[n - 2];
+		e0 += double(pFrames[n]) * double(pFrames[n]);
+		e2 += d2 * d2;
+	}
+	return (e0 > 0.0 ? e2 / e0 : 0.0);
+}
+
+
+// Stretch the whole input, returning the elapsed time in seconds.
+static double bench_stretch (
+	qtractorWsolaTimeStretcher& ts, float **ppInput, unsigned int iFrames,
+	float **ppOutput, unsigned int iMaxFrames, unsigned int& iOutFrames )
+{
+	float *ppIn[c_iChannels];
+	float *ppOut[c_iChannels];
+
+	iOutFrames = 0;
+
+	const auto t0 = std::chrono::steady_clock::now();
+
+	for (unsigned int i = 0; i < iFrames; i += c_iBlockSize) {
+		unsigned int n = iFrames - i;
+		if (n > c_iBlockSize)
+			n = c_iBlockSize;
+		for (unsigned short k = 0; k < c_iChannels; ++k)
+			ppIn[k] = ppInput[k] + i;
+		ts.putFrames(ppIn, n);
+		while (iOutFrames < iMaxFrames) {
+			for (unsigned short k = 0; k < c_iChannels; ++k)
+				ppOut[k] = ppOutput[k] + iOutFrames;
+			const unsigned int m = ts.receiveFrames(ppOut, iMaxFrames - iOutFrames);
+			if (m < 1)
+				break;
+			iOutFrames += m;
+		}
+	}
+
+	ts.flushInput();
+	while (iOutFrames < iMaxFrames) {
+		for (unsigned short k = 0; k < c_iChannels; ++k)
+			ppOut[k] = ppOutput[k] + iOutFrames;
+		const unsigned int m = ts.receiveFrames(ppOut, iMaxFrames - iOutFrames);
+		if (m < 1)
+			break;
+		iOutFrames += m;
+	}
+
+	const auto t1 = std::chrono::steady_clock::now();
+
+	return std::chrono::duration<double>(t1 - t0).count();
+}
+
+
+// Main.
+int main ( int argc, char **argv )
+{
+	float fSeconds = 10.0f;
+	float fTempo = 1.3f;
+
+	if (argc > 1)
+		fSeconds = ::atof(argv[1]);
+	if (argc > 2)
+		fTempo = ::atof(argv[2]);
+	if (fSeconds < 1.0f)
+		fSeconds = 1.0f;
+	if (fTempo < 0.25f || fTempo > 4.0f)
+		fTempo = 1.3f;
+
+	// Test signal: two-tone chord with some vibrato, plus a
+	// percussive (decaying noise burst) hit every half second...
+	const unsigned int iFrames = (unsigned int) (fSeconds * c_iSampleRate);
+	float *ppInput[c_iChannels];
+	unsigned int iSeed = 1;
+	for (unsigned short k = 0; k < c_iChannels; ++k) {
+		ppInput[k] = new float [iFrames];
+		for (unsigned int n = 0; n < iFrames; ++n) {
+			const double t = double(n) / double(c_iSampleRate);
+			const double v = 1.0 + 0.003 * ::sin(2.0 * M_PI * 5.0 * t);
+			const double h = ::fmod(t, 0.5);
+			iSeed = iSeed * 1664525 + 1013904223;
+			const double r = double(int(iSeed >> 9) - 0x400000) / double(0x400000);
+			ppInput[k][n] = float(
+				0.3 * ::sin(2.0 * M_PI * 220.0 * v * t + k)
+				+ 0.2 * ::sin(2.0 * M_PI * 277.2 * v * t)
+				+ 0.2 * r * ::exp(-h * 40.0));
+		}
+	}
+
+	double fHFRatioIn = 0.0;
+	for (unsigned short k = 0; k < c_iChannels; ++k)
+		fHFRatioIn += bench_hf_ratio(ppInput[k], iFrames);
+
+	const unsigned int iNominal = (unsigned int) (float(iFrames) / fTempo);
+	const unsigned int iMaxFrames = iNominal + (c_iSampleRate << 1);
+	float *ppOutput[c_iChannels];
+	for (unsigned short k = 0; k < c_iChannels; ++k)
+		ppOutput[k] = new float [iMaxFrames];
+
+	::printf("qtractor_bench_wsola: %g seconds, %u channels, %u Hz, tempo %g\n\n",
+		fSeconds, c_iChannels, c_iSampleRate, fTempo);
+	::printf("%-8s %-6s %10s %10s %12s %10s\n",
+		"seek", "kernel", "time (s)", "realtime", "HF excess dB", "length %");
+
+	static const struct { const char *name; bool quick; bool coarse; } modes[] = {
+		{ "linear", false, false },
+		{ "quick",  true,  false },
+		{ "coarse", false, true  }
+	};
+
+	static const struct { const char *name; qtractorWsolaTimeStretcher::Kernel kernel; } kernels[] = {
+		{ "std",  qtractorWsolaTimeStretcher::KernelStd  },
+		{ "sse",  qtractorWsolaTimeStretcher::KernelSse  },
+		{ "avx2", qtractorWsolaTimeStretcher::KernelAvx2 }
+	};
+
+	for (const auto& mode : modes) {
+		for (const auto& kernel : kernels) {
+			qtractorWsolaTimeStretcher ts(c_iChannels, c_iSampleRate);
+			if (!ts.setKernel(kernel.kernel))
+				continue;
+			ts.setQuickSeek(mode.quick);
+			ts.setCoarseSeek(mode.coarse);
+			ts.setTempo(fTempo);
+			unsigned int iOutFrames = 0;
+			const double fTime = bench_stretch(ts,
+				ppInput, iFrames, ppOutput, iMaxFrames, iOutFrames);
+			double fHFRatioOut = 0.0;
+			for (unsigned short k = 0; k < c_iChannels; ++k)
+				fHFRatioOut += bench_hf_ratio(ppOutput[k], iOutFrames);
+			const double fHFExcess = (fHFRatioIn > 0.0 && fHFRatioOut > 0.0
+				? 10.0 * ::log10(fHFRatioOut / fHFRatioIn) : 0.0);
+			const double fLength = 100.0
+				* (double(iOutFrames) - double(iNominal)) / double(iNominal);
+			const double fRealtime = (fTime > 0.0
+				? double(iOutFrames) / double(c_iSampleRate) / fTime : 0.0);
+			::printf("%-8s %-6s %10.4f %9.1fx %12.3f %+9.3f%%\n",
+				mode.name, kernel.name, fTime, fRealtime, fHFExcess, fLength);
+		}
+	}
+
+	for (unsigned short k = 0; k < c_iChannels; ++k) {
+		delete [] ppOutput[k];
+		delete [] ppInput[k];
+	}
+
+	return 0;
+}
+
+
+// end of qtractor_bench_wsola.cpp
@@ -21,7 +21,10 @@
 
 #include "qtractorAbout.h"
 #include "qtractorAudioBuffer.h"
+#include "qtractorAudioBufferMix.h"
 #include "qtractorAudioPeak.h"
+#include "qtractorAudioRender.h"
+#include "qtractorAudioPageCache.h"
 
 #include "qtractorTimeStretcher.h"
 
@@ -47,9 +50,12 @@ qtractorAudioBufferThread::qtractorAudioBufferThread (
 	while (m_iSyncSize < iSyncSize)
 		m_iSyncSize <<= 1;
 	m_iSyncMask = (m_iSyncSize - 1);
-	m_ppSyncItems = new qtractorAudioBuffer * [m_iSyncSize];
-	m_iSyncRead   = 0;
-	m_iSyncWrite  = 0;
+	m_ppSyncItems = new std::atomic<qtractorAudioBuffer *> [m_iSyncSize];
+	for (unsigned int i = 0; i < m_iSyncSize; ++i)
+		m_ppSyncItems[i].store(nullptr);
+
+	m_iSyncRead.store(0);
+	ATOMIC_SET(&m_iSyncWrite, 0);
 
 	m_bRunState = false;
 }
@@ -84,30 +90,32 @@ bool qtractorAudioBufferThread::runState (void) const
 void qtractorAudioBufferThread::sync ( qtractorAudioBuffer *pAudioBuffer )
 {
 	if (pAudioBuffer == nullptr) {
-		unsigned int r = m_iSyncRead;
-		unsigned int w = m_iSyncWrite;
+		unsigned int r = m_iSyncRead.load(std::memory_order_relaxed);
+		unsigned int w = ATOMIC_GET(&m_iSyncWrite);
 		while (r != w) {
-			m_ppSyncItems[r]->setSyncFlag(qtractorAudioBuffer::WaitSync, false);
+			qtractorAudioBuffer *pSyncItem = m_ppSyncItems[r].exchange(
+				nullptr, std::memory_order_acquire);
+			if (pSyncItem == nullptr)
+				break; // Reserved, not published yet...
+			pSyncItem->setSyncFlag(qtractorAudioBuffer::WaitSync, false);
 			++r &= m_iSyncMask;
-			w = m_iSyncWrite;
+			w = ATOMIC_GET(&m_iSyncWrite);
 		}
-		m_iSyncRead = r;
+		m_iSyncRead.store(r, std::memory_order_release);
 	} else {
 		// !pAudioBuffer->isSyncFlag(qtractorAudioBuffer::WaitSync)
-		unsigned int n;
-		unsigned int r = m_iSyncRead;
-		unsigned int w = m_iSyncWrite;
-		if (w > r) {
-			n = ((r - w + m_iSyncSize) & m_iSyncMask) - 1;
-		} else if (r > w) {
-			n = (r - w) - 1;
-		} else {
-			n = m_iSyncSize - 1;
-		}
-		if (n > 0) {
-			pAudioBuffer->setSyncFlag(qtractorAudioBuffer::WaitSync);
-			m_ppSyncItems[w] = pAudioBuffer;
-			m_iSyncWrite = (w + 1) & m_iSyncMask;
+		// May be called from parallel graph workers (lock-free)...
+		for (;;) {
+			const unsigned int r = m_iSyncRead.load(std::memory_order_acquire);
+			const unsigned int w = ATOMIC_GET(&m_iSyncWrite);
+			const unsigned int w1 = (w + 1) & m_iSyncMask;
+			if (w1 == r)
+				break; // Full...
+			if (ATOMIC_CAS(&m_iSyncWrite, w, w1)) {
+				pAudioBuffer->setSyncFlag(qtractorAudioBuffer::WaitSync);
+				m_ppSyncItems[w].store(pAudioBuffer, std::memory_order_release);
+				break;
+			}
 		}
 	}
 
@@ -159,16 +167,20 @@ void qtractorAudioBufferThread::run (void)
 // Thread run executive.
 void qtractorAudioBufferThread::process (void)
 {
-	unsigned int r = m_iSyncRead;
-	unsigned int w = m_iSyncWrite;
+	unsigned int r = m_iSyncRead.load(std::memory_order_relaxed);
+	unsigned int w = ATOMIC_GET(&m_iSyncWrite);
 
 	while (r != w) {
-		m_ppSyncItems[r]->sync();
+		qtractorAudioBuffer *pSyncItem = m_ppSyncItems[r].exchange(
+			nullptr, std::memory_order_acquire);
+		if (pSyncItem == nullptr)
+			break; // Reserved, not published yet...
+		pSyncItem->sync();
 		++r &= m_iSyncMask;
-		w = m_iSyncWrite;
+		w = ATOMIC_GET(&m_iSyncWrite);
 	}
 
-	m_iSyncRead = r;
+	m_iSyncRead.store(r, std::memory_order_release);
 }
 
 
@@ -180,11 +192,14 @@ void qtractorAudioBufferThread::checkSyncSize ( unsigned int iSyncSize )
 		unsigned int iNewSyncSize = (m_iSyncSize << 1);
 		while (iNewSyncSize < iSyncSize)
 			iNewSyncSize <<= 1;
-		qtractorAudioBuffer **ppNewSyncItems
-			= new qtractorAudioBuffer * [iNewSyncSize];
-		qtractorAudioBuffer **ppOldSyncItems = m_ppSyncItems;
-		::memcpy(ppNewSyncItems, ppOldSyncItems,
-			m_iSyncSize * sizeof(qtractorAudioBuffer *));
+		std::atomic<qtractorAudioBuffer *> *ppNewSyncItems
+			= new std::atomic<qtractorAudioBuffer *> [iNewSyncSize];
+		std::atomic<qtractorAudioBuffer *> *ppOldSyncItems = m_ppSyncItems;
+		unsigned int i = 0;
+		for ( ; i < m_iSyncSize; ++i)
+			ppNewSyncItems[i].store(ppOldSyncItems[i].load());
+		for ( ; i < iNewSyncSize; ++i)
+			ppNewSyncItems[i].store(nullptr);
 		m_iSyncSize = iNewSyncSize;
 		m_iSyncMask = (iNewSyncSize - 1);
 		m_ppSyncItems = ppNewSyncItems;
@@ -240,6 +255,10 @@ qtractorAudioBuffer::qtractorAudioBuffer (
 
 	m_pTimeStretcher = nullptr;
 
+	m_pRenderFile    = nullptr;
+	m_pLiveFile      = nullptr;
+	m_bRendered      = false;
+
 	m_fGain          = 1.0f;
 	m_fPanning       = 0.0f;
 
@@ -248,6 +267,28 @@ qtractorAudioBuffer::qtractorAudioBuffer (
 	m_fNextGain      = 0.0f;
 	m_iRampGain      = 0;
 
+#if defined(__ARM_NEON__)
+	m_pfnMixGain = neon_mix_gain;
+	m_pfnMixRamp = neon_mix_ramp;
+#else
+#if defined(QTRACTOR_AVX_MIX)
+	if (avx_enabled()) {
+		m_pfnMixGain = avx_mix_gain;
+		m_pfnMixRamp = avx_mix_ramp;
+	} else
+#endif
+#if defined(__SSE__)
+	if (sse_enabled()) {
+		m_pfnMixGain = sse_mix_gain;
+		m_pfnMixRamp = sse_mix_ramp;
+	} else
+#endif
+	{
+		m_pfnMixGain = std_mix_gain;
+		m_pfnMixRamp = std_mix_ramp;
+	}
+#endif
+
 #ifdef CONFIG_LIBSAMPLERATE
 	m_bResample      = false;
 	m_fResampleRatio = 1.0f;
@@ -259,6 +300,8 @@ qtractorAudioBuffer::qtractorAudioBuffer (
 
 	m_pPeakFile      = nullptr;
 
+	m_iPreloadSize   = 0;
+
 	// Buffer engine modes flags.
 	m_iStretcherFlags = g_iDefaultStretcherFlags;
 }
@@ -321,17 +364,45 @@ bool qtractorAudioBuffer::open ( const QString& sFilename, int iMode )
 
 	const unsigned int iSampleRate = pSession->sampleRate();
 
-	// Get proper file type class...
-	m_pFile = qtractorAudioFileFactory::createAudioFile(
-		sFilename, m_iChannels, iSampleRate);
-	if (m_pFile == nullptr)
-		return false;
+	// Whether there's a pre-rendered time-stretch/pitch-shift
+	// cache entry, otherwise schedule it for (re)rendering...
+	if (iMode == qtractorAudioFile::Read
+		&& (m_bTimeStretch || m_bPitchShift)) {
+		qtractorAudioRenderFactory *pRenderFactory
+			= pSession->audioRenderFactory();
+		if (pRenderFactory) {
+			m_pRenderFile = pRenderFactory->createRenderFile(sFilename,
+				m_fTimeStretch, m_fPitchShift, m_iStretcherFlags);
+		}
+		if (m_pRenderFile && m_pRenderFile->isReady()) {
+			const QString& sRenderFilename = m_pRenderFile->renderFilename();
+			m_pFile = qtractorAudioFileFactory::createAudioFile(
+				sRenderFilename, m_iChannels, iSampleRate);
+			if (m_pFile && m_pFile->open(sRenderFilename, iMode)) {
+				m_bRendered = true;
+			} else if (m_pFile) {
+				delete m_pFile;
+				m_pFile = nullptr;
+			}
+		}
+	}
 
-	// Go open it...
-	if (!m_pFile->open(sFilename, iMode)) {
-		delete m_pFile;
-		m_pFile = nullptr;
-		return false;
+	// Get proper file type class...
+	if (m_pFile == nullptr) {
+		m_pFile = qtractorAudioFileFactory::createAudioFile(
+			sFilename, m_iChannels, iSampleRate);
+		if (m_pFile == nullptr)
+			return false;
+		// Share decoded frames with everybody else...
+		qtractorAudioPageCache *pPageCache = pSession->audioPageCache();
+		if (pPageCache && iMode == qtractorAudioFile::Read)
+			m_pFile = pPageCache->createPageFile(m_pFile);
+		// Go open it...
+		if (!m_pFile->open(sFilename, iMode)) {
+			delete m_pFile;
+			m_pFile = nullptr;
+			return false;
+		}
 	}
 
 	// Check samplerate and how many channels there really are.
@@ -375,10 +446,31 @@ bool qtractorAudioBuffer::open ( const QString& sFilename, int iMode )
 	if (iBufferSize > (iSampleRate << 2))
 		iBufferSize = (iSampleRate << 2);
 
+	// Whether it may fit integrally in memory, as budget allows;
+	// mind the budget is in output frames, as actually read in
+	// (ie. resampled and/or time-stretched, up to end-of-file)...
+	if (iMode == qtractorAudioFile::Read) {
+		unsigned long iFramesOut = frames();
+		if (iFramesOut > m_iOffset)
+			iFramesOut -= m_iOffset;
+		else
+			iFramesOut = 0;
+		if (iFramesOut > m_iLength)
+			iFramesOut = m_iLength;
+		if (iFramesOut + 2 > iBufferSize)
+			iBufferSize = preloadReserve(iBuffers, iFramesOut + 2, iBufferSize);
+	}
+
 	m_pRingBuffer = new qtractorRingBuffer<float> (iBuffers, iBufferSize);
 	m_iThreshold  = (m_pRingBuffer->bufferSize() >> 2);
 	m_iBufferSize = (m_iThreshold >> 2);
 
+	// Keep I/O chunks as sane as ever, even if preloaded...
+	if (m_iPreloadSize > 0) {
+		while (m_iBufferSize > (iSampleRate >> 1))
+			m_iBufferSize >>= 1;
+	}
+
 #ifdef CONFIG_LIBSAMPLERATE
 	if (m_bResample && m_fResampleRatio < 1.0f) {
 		iBufferSize = (unsigned int) framesOut(m_iBufferSize);
@@ -395,7 +487,7 @@ bool qtractorAudioBuffer::open ( const QString& sFilename, int iMode )
 		m_ppFrames[i] = new float [m_iBufferSize];
 
 	// Allocate time-stretch engine whether needed...
-	if (m_bTimeStretch || m_bPitchShift) {
+	if ((m_bTimeStretch || m_bPitchShift) && !m_bRendered) {
 		m_pTimeStretcher = new qtractorTimeStretcher(iBuffers, iSampleRate,
 			m_fTimeStretch, m_fPitchShift, m_iStretcherFlags, m_iBufferSize);
 	}
@@ -507,12 +599,30 @@ void qtractorAudioBuffer::close (void)
 		m_pRingBuffer = nullptr;
 	}
 
+	// Give back any in-memory preload reservation.
+	preloadRelease();
+
 	// Finally delete what we still own.
 	if (m_pFile) {
 		delete m_pFile;
 		m_pFile = nullptr;
 	}
 
+	if (m_pLiveFile) {
+		delete m_pLiveFile;
+		m_pLiveFile = nullptr;
+	}
+
+	if (m_pRenderFile) {
+		qtractorAudioRenderFactory *pRenderFactory
+			= qtractorAudioRenderFactory::getInstance();
+		if (pRenderFactory)
+			pRenderFactory->releaseRenderFile(m_pRenderFile);
+		m_pRenderFile = nullptr;
+	}
+
+	m_bRendered = false;
+
 	// Reset all relevant state variables.
 	m_iThreshold   = 0;
 	m_iBufferSize  = 0;
@@ -786,9 +896,8 @@ int qtractorAudioBuffer::readMux ( float **ppFrames, unsigned int iFrames,
 
 	const unsigned short iBuffers = m_pRingBuffer->channels();
 
-	unsigned short i, j; int n;
+	unsigned short i, j;
 	float *pFrames, *pBuffer;
-	float fGainIter;
 
 	const float fPrevGain = m_fGain * fGain;
 
@@ -799,9 +908,7 @@ int qtractorAudioBuffer::readMux ( float **ppFrames, unsigned int iFrames,
 		for (i = 0; i < iBuffers; ++i) {
 			pFrames = ppFrames[i] + iOffset;
 			pBuffer = m_ppBuffer[i];
-			fGainIter = fPrevGain * m_pfGains[i];
-			for (n = 0; n < nread; ++n)
-				*pFrames++ += fGainIter * *pBuffer++;
+			(*m_pfnMixGain)(pFrames, pBuffer, nread, fPrevGain * m_pfGains[i]);
 		}
 	}
 	else if (iChannels > iBuffers) {
@@ -809,9 +916,7 @@ int qtractorAudioBuffer::readMux ( float **ppFrames, unsigned int iFrames,
 		for (i = 0; i < iChannels; ++i) {
 			pFrames = ppFrames[i] + iOffset;
 			pBuffer = m_ppBuffer[j];
-			fGainIter = fPrevGain * m_pfGains[j];
-			for (n = 0; n < nread; ++n)
-				*pFrames++ += fGainIter * *pBuffer++;
+			(*m_pfnMixGain)(pFrames, pBuffer, nread, fPrevGain * m_pfGains[j]);
 			if (++j >= iBuffers)
 				j = 0;
 		}
@@ -821,9 +926,7 @@ int qtractorAudioBuffer::readMux ( float **ppFrames, unsigned int iFrames,
 		for (j = 0; j < iBuffers; ++j) {
 			pFrames = ppFrames[i] + iOffset;
 			pBuffer = m_ppBuffer[j];
-			fGainIter = fPrevGain * m_pfGains[j];
-			for (n = 0; n < nread; ++n)
-				*pFrames++ += fGainIter * *pBuffer++;
+			(*m_pfnMixGain)(pFrames, pBuffer, nread, fPrevGain * m_pfGains[j]);
 			if (++i >= iChannels)
 				i = 0;
 		}
@@ -1064,6 +1167,10 @@ void qtractorAudioBuffer::readSync (void)
 
 	// Check whether we have some hard-seek pending...
 	if (ATOMIC_TAZ(&m_seekPending)) {
+		// Switch over to the pre-rendered file, as soon as ready,
+		// but only here, as the whole ring-buffer gets refilled...
+		if (m_pTimeStretcher && m_pRenderFile && m_pRenderFile->isReady())
+			openRenderFile();
 		// Do it...
 		if (!seekSync(m_iSeekOffset))
 			return;
@@ -1196,6 +1303,49 @@ bool qtractorAudioBuffer::seekSync ( unsigned long iFrame )
 }
 
 
+// Pre-rendered (time-stretched/pitch-shifted) file switch-over.
+// (sync thread only; the live source file is kept until close)
+bool qtractorAudioBuffer::openRenderFile (void)
+{
+	if (m_pLiveFile || m_pRenderFile == nullptr)
+		return false;
+
+	const QString& sRenderFilename = m_pRenderFile->renderFilename();
+	qtractorAudioFile *pRenderFile = qtractorAudioFileFactory::createAudioFile(
+		sRenderFilename, m_iChannels, m_pFile->sampleRate());
+	if (pRenderFile == nullptr)
+		return false;
+
+	// Must be a perfect match...
+	if (!pRenderFile->open(sRenderFilename)
+		|| pRenderFile->channels() != m_pFile->channels()
+		|| pRenderFile->sampleRate() != m_pFile->sampleRate()) {
+		delete pRenderFile;
+		qtractorAudioRenderFactory *pRenderFactory
+			= qtractorAudioRenderFactory::getInstance();
+		if (pRenderFactory)
+			pRenderFactory->releaseRenderFile(m_pRenderFile);
+		m_pRenderFile = nullptr;
+		return false;
+	}
+
+#ifdef CONFIG_DEBUG
+	qDebug("qtractorAudioBuffer[%p]::openRenderFile(\"%s\")",
+		this, sRenderFilename.toUtf8().constData());
+#endif
+
+	m_pLiveFile = m_pFile;
+	m_pFile = pRenderFile;
+	m_bRendered = true;
+
+	// No more live time-stretching...
+	delete m_pTimeStretcher;
+	m_pTimeStretcher = nullptr;
+
+	return true;
+}
+
+
 // Last-mile frame buffer-helper processor.
 int qtractorAudioBuffer::writeFrames (
 	float **ppFrames, unsigned int iFrames )
@@ -1354,6 +1504,17 @@ int qtractorAudioBuffer::writeBuffer ( unsigned int iFrames )
 }
 
 
+// Gain/panning mix-down (add) kernel dispatcher.
+inline void qtractorAudioBuffer::mixFrames ( float *pFrames,
+	const float *pBuffer, unsigned int iFrames, float fGain, float fGainStep ) const
+{
+	if (fGainStep == 0.0f)
+		(*m_pfnMixGain)(pFrames, pBuffer, iFrames, fGain);
+	else
+		(*m_pfnMixRamp)(pFrames, pBuffer, iFrames, fGain, fGainStep);
+}
+
+
 // Special kind of super-read/channel-mix buffer helper.
 int qtractorAudioBuffer::readMixFrames (
 	float **ppFrames, unsigned int iFrames, unsigned short iChannels,
@@ -1369,7 +1530,7 @@ int qtractorAudioBuffer::readMixFrames (
 	const unsigned short iBuffers = m_pRingBuffer->channels();
 
 	unsigned short i, j; int n;
-	float fGainIter, fGainStep1, fGainStep2;
+	float fGainIter, fGainStep1;
 	float *pFrames, *pBuffer;
 
 	// HACK: Case of clip ramp in/out-set in this run...
@@ -1400,10 +1561,8 @@ int qtractorAudioBuffer::readMixFrames (
 		for (i = 0; i < iBuffers; ++i) {
 			pFrames = ppFrames[i] + iOffset;
 			pBuffer = m_ppBuffer[i];
-			fGainIter = fPrevGain * m_pfGains[i];
-			fGainStep2 = fGainStep1 * m_pfGains[i];
-			for (n = 0; n < nread; ++n, fGainIter += fGainStep2)
-				*pFrames++ += fGainIter * *pBuffer++;
+			mixFrames(pFrames, pBuffer, nread,
+				fPrevGain * m_pfGains[i], fGainStep1 * m_pfGains[i]);
 		}
 	}
 	else if (iChannels > iBuffers) {
@@ -1411,10 +1570,8 @@ int qtractorAudioBuffer::readMixFrames (
 		for (i = 0; i < iChannels; ++i) {
 			pFrames = ppFrames[i] + iOffset;
 			pBuffer = m_ppBuffer[j];
-			fGainIter = fPrevGain * m_pfGains[j];
-			fGainStep2 = fGainStep1 * m_pfGains[j];
-			for (n = 0; n < nread; ++n, fGainIter += fGainStep2)
-				*pFrames++ += fGainIter * *pBuffer++;
+			mixFrames(pFrames, pBuffer, nread,
+				fPrevGain * m_pfGains[j], fGainStep1 * m_pfGains[j]);
 			if (++j >= iBuffers)
 				j = 0;
 		}
@@ -1424,10 +1581,8 @@ int qtractorAudioBuffer::readMixFrames (
 		for (j = 0; j < iBuffers; ++j) {
 			pFrames = ppFrames[i] + iOffset;
 			pBuffer = m_ppBuffer[j];
-			fGainIter = fPrevGain * m_pfGains[j];
-			fGainStep2 = fGainStep1 * m_pfGains[j];
-			for (n = 0; n < nread; ++n, fGainIter += fGainStep2)
-				*pFrames++ += fGainIter * *pBuffer++;
+			mixFrames(pFrames, pBuffer, nread,
+				fPrevGain * m_pfGains[j], fGainStep1 * m_pfGains[j]);
 			if (++i >= iChannels)
 				i = 0;
 		}
@@ -1512,7 +1667,7 @@ unsigned long qtractorAudioBuffer::framesIn ( unsigned long iFrames ) const
 		iFrames = (unsigned long) (float(iFrames) * m_fResampleRatio);
 #endif
 
-	if (m_bTimeStretch)
+	if (m_bTimeStretch && !m_bRendered)
 		iFrames = (unsigned long) (float(iFrames) * m_fTimeStretch);
 
 	return iFrames;
@@ -1525,7 +1680,7 @@ unsigned long qtractorAudioBuffer::framesOut ( unsigned long iFrames ) const
 		iFrames = (unsigned long) (float(iFrames) / m_fResampleRatio);
 #endif
 
-	if (m_bTimeStretch)
+	if (m_bTimeStretch && !m_bRendered)
 		iFrames = (unsigned long) (float(iFrames) / m_fTimeStretch);
 
 	return iFrames;
@@ -1730,4 +1885,73 @@ int qtractorAudioBuffer::defaultResampleType (void)
 }
 
 
+// In-memory (integral) preload budget (global option).
+unsigned long qtractorAudioBuffer::g_iPreloadMaxSize = 0;
+unsigned long qtractorAudioBuffer::g_iPreloadSize = 0;
+
+QMutex qtractorAudioBuffer::g_preloadMutex;
+
+void qtractorAudioBuffer::setPreloadMaxSize ( unsigned long iPreloadMaxSize )
+{
+	QMutexLocker locker(&g_preloadMutex);
+
+	g_iPreloadMaxSize = iPreloadMaxSize;
+}
+
+unsigned long qtractorAudioBuffer::preloadMaxSize (void)
+{
+	return g_iPreloadMaxSize;
+}
+
+unsigned long qtractorAudioBuffer::preloadSize (void)
+{
+	return g_iPreloadSize;
+}
+
+
+// In-memory (integral) preload budget reservation: returns the
+// ring-buffer size that fits the whole clip, if budget allows;
+// otherwise falls back to the given (streaming) buffer size.
+unsigned int qtractorAudioBuffer::preloadReserve (
+	unsigned short iChannels, unsigned long iFrames, unsigned int iBufferSize )
+{
+	if (g_iPreloadMaxSize == 0 || iFrames > 0x40000000UL)
+		return iBufferSize;
+
+	// Ring-buffers are always a power-of-two in size...
+	unsigned long iRingSize = 4096;
+	while (iRingSize < iFrames)
+		iRingSize <<= 1;
+
+	const unsigned long iPreloadSize
+		= iRingSize * iChannels * sizeof(float);
+
+	QMutexLocker locker(&g_preloadMutex);
+
+	if (g_iPreloadSize + iPreloadSize > g_iPreloadMaxSize)
+		return iBufferSize;
+
+	g_iPreloadSize += iPreloadSize;
+	m_iPreloadSize  = iPreloadSize;
+
+	return (unsigned int) iFrames;
+}
+
+
+void qtractorAudioBuffer::preloadRelease (void)
+{
+	if (m_iPreloadSize == 0)
+		return;
+
+	QMutexLocker locker(&g_preloadMutex);
+
+	if (g_iPreloadSize > m_iPreloadSize)
+		g_iPreloadSize -= m_iPreloadSize;
+	else
+		g_iPreloadSize = 0;
+
+	m_iPreloadSize = 0;
+}
+
+
 // end of qtractorAudioBuffer.cpp
@@ -35,9 +35,12 @@
 #include <QMutex>
 #include <QWaitCondition>
 
+#include <atomic>
+
 
 // Forward declarations.
 class qtractorAudioPeakFile;
+class qtractorAudioRenderFile;
 class qtractorAudioBuffer;
 class qtractorTimeStretcher;
 
@@ -80,10 +83,14 @@ private:
 	// Instance variables.
 	unsigned int          m_iSyncSize;
 	unsigned int          m_iSyncMask;
-	qtractorAudioBuffer **m_ppSyncItems;
 
-	volatile unsigned int m_iSyncRead;
-	volatile unsigned int m_iSyncWrite;
+	// Multiple producers (parallel graph workers), single consumer
+	// ring: a slot is reserved by advancing the write index, then
+	// published by storing its item; null slots are not ready yet.
+	std::atomic<qtractorAudioBuffer *> *m_ppSyncItems;
+
+	std::atomic<unsigned int> m_iSyncRead;
+	qtractorAtomic            m_iSyncWrite;
 
 	// Whether the thread is logically running.
 	volatile bool m_bRunState;
@@ -214,6 +221,11 @@ public:
 	static void setDefaultResampleType(int iResampleType);
 	static int defaultResampleType();
 
+	// In-memory (integral) preload budget accessors (global option).
+	static void setPreloadMaxSize(unsigned long iPreloadMaxSize);
+	static unsigned long preloadMaxSize();
+	static unsigned long preloadSize();
+
 protected:
 
 	// Read-sync mode methods (playback).
@@ -233,6 +245,10 @@ protected:
 	int readBuffer  (unsigned int iFrames);
 	int writeBuffer (unsigned int iFrames);
 
+	// Gain/panning mix-down (add) kernel dispatcher.
+	void mixFrames(float *pFrames, const float *pBuffer,
+		unsigned int iFrames, float fGain, float fGainStep) const;
+
 	// Special kind of super-read/channel-mix buffer helper.
 	int readMixFrames(float **ppFrames, unsigned int iFrames,
 		unsigned short iChannels, unsigned int iOffset, float fGain);
@@ -240,6 +256,14 @@ protected:
 	// I/O buffer release.
 	void deleteIOBuffers();
 
+	// Pre-rendered (time-stretched/pitch-shifted) file switch-over.
+	bool openRenderFile();
+
+	// In-memory (integral) preload budget reservation.
+	unsigned int preloadReserve(unsigned short iChannels,
+		unsigned long iFrames, unsigned int iBufferSize);
+	void preloadRelease();
+
 	// Frame position converters.
 	unsigned long framesIn(unsigned long iFrames) const;
 	unsigned long framesOut(unsigned long iFrames) const;
@@ -286,6 +310,11 @@ private:
 
 	qtractorTimeStretcher *m_pTimeStretcher;
 
+	// Pre-rendered time-stretch/pitch-shift cache entry.
+	qtractorAudioRenderFile *m_pRenderFile;
+	qtractorAudioFile *m_pLiveFile;
+	volatile bool  m_bRendered;
+
 	float          m_fGain;
 	float          m_fPanning;
 
@@ -294,6 +323,10 @@ private:
 	float          m_fNextGain;
 	int            m_iRampGain;
 
+	// Gain/panning mix-down (add) processor kernels.
+	void (*m_pfnMixGain)(float *, const float *, unsigned int, float);
+	void (*m_pfnMixRamp)(float *, const float *, unsigned int, float, float);
+
 #ifdef CONFIG_LIBSAMPLERATE
 	bool           m_bResample;
 	float          m_fResampleRatio;
@@ -305,6 +338,9 @@ private:
 
 	qtractorAudioPeakFile *m_pPeakFile;
 
+	// In-memory (integral) preload reservation (in bytes).
+	unsigned long  m_iPreloadSize;
+
 	// Buffer engine mode flags.
 	unsigned int   m_iStretcherFlags;
 
@@ -312,6 +348,11 @@ private:
 
 	// Sample-rate converter type global option.
 	static int g_iDefaultResampleType;
+
+	// In-memory (integral) preload budget global option.
+	static unsigned long g_iPreloadMaxSize;
+	static unsigned long g_iPreloadSize;
+	static QMutex g_preloadMutex;
 };
 
 
@@ -0,0 +1,241 @@
+// qtractorAudioBufferMix.h
+//
+/****************************************************************************
+   Copyright (C) 2005-2025, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#ifndef __qtractorAudioBufferMix_h
+#define __qtractorAudioBufferMix_h
+
+// Private header: only to be included by qtractorAudioBuffer.cpp
+// and the mix-down kernel micro-benchmark (bench/).
+
+//----------------------------------------------------------------------
+// Gain/panning mix-down (add) processor kernels.
+//
+
+#if defined(__SSE__)
+
+#include <xmmintrin.h>
+
+// SSE detection.
+static inline bool sse_enabled (void)
+{
+#if defined(__GNUC__)
+	unsigned int eax, ebx, ecx, edx;
+#if defined(__x86_64__) || (!defined(PIC) && !defined(__PIC__))
+	__asm__ __volatile__ (
+		"cpuid\n\t" \
+		: "=a" (eax), "=b" (ebx), "=c" (ecx), "=d" (edx) \
+		: "a" (1) : "cc");
+#else
+	__asm__ __volatile__ (
+		"push %%ebx\n\t" \
+		"cpuid\n\t" \
+		"movl %%ebx,%1\n\t" \
+		"pop %%ebx\n\t" \
+		: "=a" (eax), "=r" (ebx), "=c" (ecx), "=d" (edx) \
+		: "a" (1) : "cc");
+#endif
+	return (edx & (1 << 25));
+#else
+	return false;
+#endif
+}
+
+// SSE enabled processor versions.
+//
+// Ramp gains are always computed from the absolute frame index
+// (fGain0 + n * fGainStep), in every kernel and lane, so that the
+// very same output comes out whatever the buffers alignment is.
+//
+static inline void sse_mix_gain ( float *pFrames, const float *pBuffer,
+	unsigned int iFrames, float fGain )
+{
+	const __m128 v0 = _mm_load_ps1(&fGain);
+
+	unsigned int n = 0;
+
+	for (; n + 4 <= iFrames; n += 4) {
+		_mm_storeu_ps(pFrames + n,
+			_mm_add_ps(
+				_mm_loadu_ps(pFrames + n),
+				_mm_mul_ps(_mm_loadu_ps(pBuffer + n), v0)));
+	}
+
+	for (; n < iFrames; ++n)
+		pFrames[n] += fGain * pBuffer[n];
+}
+
+static inline void sse_mix_ramp ( float *pFrames, const float *pBuffer,
+	unsigned int iFrames, float fGain0, float fGainStep )
+{
+	const __m128 v0 = _mm_load_ps1(&fGain0);
+	const __m128 v1 = _mm_load_ps1(&fGainStep);
+	const __m128 v4 = _mm_set1_ps(4.0f);
+
+	__m128 vn = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+
+	unsigned int n = 0;
+
+	for (; n + 4 <= iFrames; n += 4) {
+		_mm_storeu_ps(pFrames + n,
+			_mm_add_ps(
+				_mm_loadu_ps(pFrames + n),
+				_mm_mul_ps(_mm_loadu_ps(pBuffer + n),
+					_mm_add_ps(v0, _mm_mul_ps(vn, v1)))));
+		vn = _mm_add_ps(vn, v4);
+	}
+
+	for (; n < iFrames; ++n)
+		pFrames[n] += (fGain0 + float(n) * fGainStep) * pBuffer[n];
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+
+#include <immintrin.h>
+
+// AVX detection (runtime, also checks for OS support).
+static inline bool avx_enabled (void)
+{
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx");
+}
+
+// AVX enabled processor versions.
+__attribute__((target("avx")))
+static void avx_mix_gain ( float *pFrames, const float *pBuffer,
+	unsigned int iFrames, float fGain )
+{
+	const __m256 v0 = _mm256_set1_ps(fGain);
+
+	unsigned int n = 0;
+
+	for (; n + 8 <= iFrames; n += 8) {
+		_mm256_storeu_ps(pFrames + n,
+			_mm256_add_ps(
+				_mm256_loadu_ps(pFrames + n),
+				_mm256_mul_ps(_mm256_loadu_ps(pBuffer + n), v0)));
+	}
+
+	for (; n < iFrames; ++n)
+		pFrames[n] += fGain * pBuffer[n];
+}
+
+__attribute__((target("avx")))
+static void avx_mix_ramp ( float *pFrames, const float *pBuffer,
+	unsigned int iFrames, float fGain0, float fGainStep )
+{
+	const __m256 v0 = _mm256_set1_ps(fGain0);
+	const __m256 v1 = _mm256_set1_ps(fGainStep);
+	const __m256 v8 = _mm256_set1_ps(8.0f);
+
+	__m256 vn = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+
+	unsigned int n = 0;
+
+	for (; n + 8 <= iFrames; n += 8) {
+		_mm256_storeu_ps(pFrames + n,
+			_mm256_add_ps(
+				_mm256_loadu_ps(pFrames + n),
+				_mm256_mul_ps(_mm256_loadu_ps(pBuffer + n),
+					_mm256_add_ps(v0, _mm256_mul_ps(vn, v1)))));
+		vn = _mm256_add_ps(vn, v8);
+	}
+
+	for (; n < iFrames; ++n)
+		pFrames[n] += (fGain0 + float(n) * fGainStep) * pBuffer[n];
+}
+
+#define QTRACTOR_AVX_MIX
+
+#endif // __GNUC__ && (__x86_64__ || __i386__)
+
+#endif // __SSE__
+
+
+#if defined(__ARM_NEON__)
+
+#include "arm_neon.h"
+
+// NEON enabled processor versions.
+static inline void neon_mix_gain ( float *pFrames, const float *pBuffer,
+	unsigned int iFrames, float fGain )
+{
+	const float32x4_t v0 = vdupq_n_f32(fGain);
+
+	unsigned int n = 0;
+
+	for (; n + 4 <= iFrames; n += 4) {
+		vst1q_f32(pFrames + n,
+			vaddq_f32(vld1q_f32(pFrames + n),
+				vmulq_f32(vld1q_f32(pBuffer + n), v0)));
+	}
+
+	for (; n < iFrames; ++n)
+		pFrames[n] += fGain * pBuffer[n];
+}
+
+static inline void neon_mix_ramp ( float *pFrames, const float *pBuffer,
+	unsigned int iFrames, float fGain0, float fGainStep )
+{
+	static const float c_fLanes[4] = { 0.0f, 1.0f, 2.0f, 3.0f };
+
+	const float32x4_t v0 = vdupq_n_f32(fGain0);
+	const float32x4_t v1 = vdupq_n_f32(fGainStep);
+	const float32x4_t v4 = vdupq_n_f32(4.0f);
+
+	float32x4_t vn = vld1q_f32(c_fLanes);
+
+	unsigned int n = 0;
+
+	for (; n + 4 <= iFrames; n += 4) {
+		vst1q_f32(pFrames + n,
+			vaddq_f32(vld1q_f32(pFrames + n),
+				vmulq_f32(vld1q_f32(pBuffer + n),
+					vaddq_f32(v0, vmulq_f32(vn, v1)))));
+		vn = vaddq_f32(vn, v4);
+	}
+
+	for (; n < iFrames; ++n)
+		pFrames[n] += (fGain0 + float(n) * fGainStep) * pBuffer[n];
+}
+
+#endif // __ARM_NEON__
+
+
+// Standard processor versions.
+static inline void std_mix_gain ( float *pFrames, const float *pBuffer,
+	unsigned int iFrames, float fGain )
+{
+	for (unsigned int n = 0; n < iFrames; ++n)
+		pFrames[n] += fGain * pBuffer[n];
+}
+
+static inline void std_mix_ramp ( float *pFrames, const float *pBuffer,
+	unsigned int iFrames, float fGain0, float fGainStep )
+{
+	for (unsigned int n = 0; n < iFrames; ++n)
+		pFrames[n] += (fGain0 + float(n) * fGainStep) * pBuffer[n];
+}
+
+
+#endif  // __qtractorAudioBufferMix_h
+
+
+// end of qtractorAudioBufferMix.h
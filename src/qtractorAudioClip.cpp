@@ -151,6 +151,11 @@ qtractorAudioClip::qtractorAudioClip ( qtractorTrack *pTrack )
 	m_iOverlap = 0;
 
 	m_pFractGains = nullptr;
+
+	m_pPolyMax = nullptr;
+	m_pPolyRms = nullptr;
+
+	m_iPolyChannels = 0;
 }
 
 // Copy constructor.
@@ -170,6 +175,11 @@ qtractorAudioClip::qtractorAudioClip ( const qtractorAudioClip& clip )
 
 	m_pFractGains = nullptr;
 
+	m_pPolyMax = nullptr;
+	m_pPolyRms = nullptr;
+
+	m_iPolyChannels = 0;
+
 	setFilename(clip.filename());
 	setClipName(clip.clipName());
 	setClipGain(clip.clipGain());
@@ -191,6 +201,11 @@ qtractorAudioClip::~qtractorAudioClip (void)
 {
 	close();
 
+	if (m_pPolyRms)
+		delete [] m_pPolyRms;
+	if (m_pPolyMax)
+		delete [] m_pPolyMax;
+
 	if (m_pPeak)
 		delete m_pPeak;
 }
@@ -291,6 +306,7 @@ bool qtractorAudioClip::openAudioFile ( const QString& sFilename, int iMode )
 							delete m_pPeak;
 						m_pPeak = pPeakFactory->createPeak(
 							sFilename, pBuff->timeStretch());
+						pPeakFactory->prefetch(m_pPeak->peakFile());
 					}
 				}
 				// Gain/panning fractionalizer(tm)...
@@ -345,6 +361,8 @@ bool qtractorAudioClip::openAudioFile ( const QString& sFilename, int iMode )
 				sFilename, pBuff->timeStretch());
 			if (bWrite)
 				pBuff->setPeakFile(m_pPeak->peakFile());
+			else
+				pPeakFactory->prefetch(m_pPeak->peakFile());
 		}
 	}
 
@@ -623,10 +641,15 @@ void qtractorAudioClip::process (
 	const unsigned long iOffset
 		= (iFrameEnd < iClipEnd ? iFrameEnd : iClipEnd) - iClipStart;
 
+	// Parallel graph node buffer, if any...
+	float **ppBuffer = track()->graphBuffer();
+	if (ppBuffer == nullptr)
+		ppBuffer = pAudioBus->buffer();
+
 	if (iClipStart > iFrameStart) {
 		if (pBuff->inSync(0, iOffset)) {
 			pBuff->readMix(
-				pAudioBus->buffer(),
+				ppBuffer,
 				iOffset,
 				pAudioBus->channels(),
 				iClipStart - iFrameStart,
@@ -635,7 +658,7 @@ void qtractorAudioClip::process (
 	} else {
 		if (pBuff->inSync(iFrameStart - iClipStart, iOffset)) {
 			pBuff->readMix(
-				pAudioBus->buffer(),
+				ppBuffer,
 				(iFrameEnd < iClipEnd ? iFrameEnd : iClipEnd) - iFrameStart,
 				pAudioBus->channels(),
 				0,
@@ -688,15 +711,24 @@ void qtractorAudioClip::draw (
 	if (iPeakLength < 1)
 		return;
 
-	// Polygon init...
+	// Polygon init (reuse previous buffers, if any)...
 	unsigned short k;
 	const unsigned short iChannels = m_pPeak->channels();
 	const unsigned int iPolyPoints = (iPeakLength << 1);
-	QPolygon **pPolyMax = new QPolygon* [iChannels];
-	QPolygon **pPolyRms = new QPolygon* [iChannels];
+	if (m_iPolyChannels != iChannels) {
+		if (m_pPolyRms)
+			delete [] m_pPolyRms;
+		if (m_pPolyMax)
+			delete [] m_pPolyMax;
+		m_pPolyMax = new QPolygon [iChannels];
+		m_pPolyRms = new QPolygon [iChannels];
+		m_iPolyChannels = iChannels;
+	}
+	QPolygon *pPolyMax = m_pPolyMax;
+	QPolygon *pPolyRms = m_pPolyRms;
 	for (k = 0; k < iChannels; ++k) {
-		pPolyMax[k] = new QPolygon(iPolyPoints);
-		pPolyRms[k] = new QPolygon(iPolyPoints);
+		pPolyMax[k].resize(iPolyPoints);
+		pPolyRms[k].resize(iPolyPoints);
 	}
 
 	// Draw peak chart...
@@ -716,29 +748,23 @@ void qtractorAudioClip::draw (
 			ymax = (h2gain * pPeakFrames->max) >> fractGain.den;
 			ymin = (h2gain * pPeakFrames->min) >> fractGain.den;
 			yrms = (h2gain * pPeakFrames->rms) >> fractGain.den;
-			pPolyMax[k]->setPoint(n, x, y - ymax);
-			pPolyMax[k]->setPoint(iPolyPoints - n - 1, x, y + ymin);
-			pPolyRms[k]->setPoint(n, x, y - yrms);
-			pPolyRms[k]->setPoint(iPolyPoints - n - 1, x, y + yrms);
+			pPolyMax[k].setPoint(n, x, y - ymax);
+			pPolyMax[k].setPoint(iPolyPoints - n - 1, x, y + ymin);
+			pPolyRms[k].setPoint(n, x, y - yrms);
+			pPolyRms[k].setPoint(iPolyPoints - n - 1, x, y + yrms);
 			y += h1; ++pPeakFrames;
 		}
 	}
 
-	// Close, draw and free the polygons...
+	// Close and draw the polygons...
 	QColor fg(track()->foreground());
 	fg.setAlpha(200);
 	pPainter->setPen(fg.lighter(140));
 	pPainter->setBrush(fg);
 	for (k = 0; k < iChannels; ++k) {
-		pPainter->drawPolygon(*pPolyMax[k]);
-		pPainter->drawPolygon(*pPolyRms[k]);
-		delete pPolyRms[k];
-		delete pPolyMax[k];
+		pPainter->drawPolygon(pPolyMax[k]);
+		pPainter->drawPolygon(pPolyRms[k]);
 	}
-
-	// Done on polygons.
-	delete [] pPolyRms;
-	delete [] pPolyMax;
 }
 
 
@@ -802,6 +828,10 @@ bool qtractorAudioClip::loadClipElement (
 			qtractorAudioClip::setStretcherFlag(
 				qtractorTimeStretcher::WsolaQuickSeek,
 				qtractorDocument::boolFromText(eChild.text()));
+		else if (eChild.tagName() == "wsola-coarse-seek")
+			qtractorAudioClip::setStretcherFlag(
+				qtractorTimeStretcher::WsolaCoarseSeek,
+				qtractorDocument::boolFromText(eChild.text()));
 	#ifdef CONFIG_LIBRUBBERBAND
 		else if (eChild.tagName() == "rubberband-formant")
 			qtractorAudioClip::setStretcherFlag(
@@ -838,6 +868,10 @@ bool qtractorAudioClip::saveClipElement (
 		qtractorDocument::textFromBool(
 			qtractorAudioClip::isStretcherFlag(
 				qtractorTimeStretcher::WsolaQuickSeek)), &eAudioClip);
+	pDocument->saveTextElement("wsola-coarse-seek",
+		qtractorDocument::textFromBool(
+			qtractorAudioClip::isStretcherFlag(
+				qtractorTimeStretcher::WsolaCoarseSeek)), &eAudioClip);
 #ifdef CONFIG_LIBRUBBERBAND
 	pDocument->saveTextElement("rubberband-formant",
 		qtractorDocument::textFromBool(
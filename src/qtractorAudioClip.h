@@ -28,6 +28,8 @@
 // Forward declarations.
 class qtractorAudioPeak;
 
+class QPolygon;
+
 
 //----------------------------------------------------------------------
 // class qtractorAudioClip -- Audio file/buffer clip.
@@ -241,6 +243,12 @@ private:
 
 	FractGain *m_pFractGains;
 
+	// Waveform polygon buffers, reused across draws.
+	QPolygon *m_pPolyMax;
+	QPolygon *m_pPolyRms;
+
+	unsigned short m_iPolyChannels;
+
 	// Most interesting key/data (ref-counted?)...
 	Key  *m_pKey;
 	Data *m_pData;
@@ -23,6 +23,7 @@
 #include "qtractorAudioEngine.h"
 #include "qtractorAudioMonitor.h"
 #include "qtractorAudioBuffer.h"
+#include "qtractorAudioGraph.h"
 
 #include "qtractorSession.h"
 
@@ -64,6 +65,8 @@
 #include <QApplication>
 #include <QProgressBar>
 #include <QDomDocument>
+#include <QElapsedTimer>
+#include <QThread>
 
 
 // Sensible defaults.
@@ -266,6 +269,32 @@ private:
 };
 
 
+//----------------------------------------------------------------------
+// qtractorAudioExportThread -- offline audio export worker thread.
+//
+
+class qtractorAudioExportThread : public QThread
+{
+public:
+
+	// Constructor.
+	qtractorAudioExportThread(
+		qtractorAudioEngine *pAudioEngine, unsigned int nframes )
+		: QThread(), m_pAudioEngine(pAudioEngine), m_nframes(nframes) {}
+
+protected:
+
+	// The main thread executive.
+	void run() { m_pAudioEngine->process_offline(m_nframes); }
+
+private:
+
+	// Instance variables.
+	qtractorAudioEngine *m_pAudioEngine;
+	unsigned int m_nframes;
+};
+
+
 //----------------------------------------------------------------------
 // qtractorAudioEngine_process -- JACK client process callback.
 //
@@ -544,6 +573,13 @@ qtractorAudioEngine::qtractorAudioEngine ( qtractorSession *pSession )
 	m_iExportEnd   = 0;
 	m_bExportDone  = true;
 
+	// Audio-export offline mode and parallel process.
+	m_bExportOffline = false;
+	m_bOffline       = false;
+	m_iExportThreads = 0;
+	m_pExportGraph   = nullptr;
+	m_fExportSpeed   = 0.0f;
+
 	// Audio metronome stuff.
 	m_bMetronome        = false;
 	m_bMetroBus         = false;
@@ -589,6 +625,17 @@ qtractorAudioEngine::qtractorAudioEngine ( qtractorSession *pSession )
 
 	// Time(base)/BBT time info.
 	::memset(&m_timeInfo, 0, sizeof(TimeInfo));
+
+	// Parallel track process graph.
+	m_iGraphThreads = 0;
+	m_bGraphDeterministic = true;
+	m_pAudioGraph = nullptr;
+
+	// Real-time parallel task pool.
+	m_iTaskThreads = 0;
+	m_bTaskPoolStarted = false;
+	m_bTaskPoolRequest = false;
+	m_pTaskPool = nullptr;
 }
 
 
@@ -617,6 +664,20 @@ void qtractorAudioEngine::notifyPortEvent (void)
 
 void qtractorAudioEngine::notifyBuffEvent ( unsigned int iBufferSize )
 {
+	// Parallel graph node work buffers must follow suit, while
+	// the process cycle is on hold; otherwise, those tracks just
+	// fall back to the serial process path, as they won't fit...
+	qtractorSession *pSession = session();
+	if (m_pAudioGraph && pSession && pSession->acquire()) {
+		const unsigned int iBufferSizeEx
+			= (iBufferSize > m_iBufferSizeEx ? iBufferSize : m_iBufferSizeEx);
+		for (qtractorTrack *pTrack = pSession->tracks().first();
+				pTrack; pTrack = pTrack->next()) {
+			pTrack->resizeGraphBuffers(iBufferSizeEx);
+		}
+		pSession->release();
+	}
+
 	if (m_iBufferSizeEx < iBufferSize) {
 		m_proxy.notifyBuffEvent(iBufferSize);
 	} else {
@@ -853,6 +914,17 @@ bool qtractorAudioEngine::activate (void)
 	// Reset all dependable monitoring...
 	resetAllMonitors();
 
+	// Parallel track process graph workers...
+	if (m_iGraphThreads > 0) {
+		m_pAudioGraph = new qtractorAudioGraph(this,
+			m_iGraphThreads, m_bGraphDeterministic);
+		m_pAudioGraph->reserve(pSession->tracks().count());
+		if (!m_pAudioGraph->start()) {
+			delete m_pAudioGraph;
+			m_pAudioGraph = nullptr;
+		}
+	}
+
 	// Time to activate ourselves...
 	jack_activate(m_pJackClient);
 
@@ -943,6 +1015,20 @@ void qtractorAudioEngine::deactivate (void)
 	// Deactivate the JACK client first.
 	if (m_pJackClient)
 		jack_deactivate(m_pJackClient);
+
+	// Parallel track process graph workers...
+	if (m_pAudioGraph) {
+		delete m_pAudioGraph;
+		m_pAudioGraph = nullptr;
+	}
+
+	// Real-time parallel task pool workers...
+	qtractorAudioTaskPool *pTaskPool = m_pTaskPool.exchange(nullptr);
+	if (pTaskPool)
+		delete pTaskPool;
+
+	m_bTaskPoolStarted = false;
+	m_bTaskPoolRequest = false;
 }
 
 
@@ -1008,6 +1094,92 @@ bool qtractorAudioEngine::isProcessing (void)
 	return g_bProcessing;
 }
 
+void qtractorAudioEngine::setProcessing ( bool bProcessing )
+{
+	g_bProcessing = bProcessing;
+}
+
+
+// Parallel track process graph (number of worker threads).
+void qtractorAudioEngine::setGraphThreads ( unsigned int iGraphThreads )
+{
+	m_iGraphThreads = iGraphThreads;
+}
+
+unsigned int qtractorAudioEngine::graphThreads (void) const
+{
+	return m_iGraphThreads;
+}
+
+
+// Parallel track process graph deterministic mode.
+void qtractorAudioEngine::setGraphDeterministic ( bool bGraphDeterministic )
+{
+	m_bGraphDeterministic = bGraphDeterministic;
+
+	if (m_pAudioGraph)
+		m_pAudioGraph->setDeterministic(bGraphDeterministic);
+}
+
+bool qtractorAudioEngine::isGraphDeterministic (void) const
+{
+	return m_bGraphDeterministic;
+}
+
+
+// Parallel track process graph accessor.
+qtractorAudioGraph *qtractorAudioEngine::graph (void) const
+{
+	return m_pAudioGraph;
+}
+
+
+// Real-time parallel task pool (number of worker threads).
+void qtractorAudioEngine::setTaskThreads ( unsigned int iTaskThreads )
+{
+	m_iTaskThreads = iTaskThreads;
+}
+
+unsigned int qtractorAudioEngine::taskThreads (void) const
+{
+	return m_iTaskThreads;
+}
+
+
+// Real-time parallel task pool accessor (RT-safe).
+qtractorAudioTaskPool *qtractorAudioEngine::taskPool (void) const
+{
+	return m_pTaskPool.load(std::memory_order_acquire);
+}
+
+
+// Real-time parallel task pool lazy start request (RT-safe).
+void qtractorAudioEngine::requestTaskPool (void)
+{
+	m_bTaskPoolRequest.store(true, std::memory_order_relaxed);
+}
+
+
+// Real-time parallel task pool deferred start (non-RT).
+void qtractorAudioEngine::updateTaskPool (void)
+{
+	if (!m_bTaskPoolRequest.exchange(false, std::memory_order_relaxed))
+		return;
+
+	// Only one try per activation...
+	if (m_bTaskPoolStarted || m_iTaskThreads < 1 || !isActivated())
+		return;
+
+	m_bTaskPoolStarted = true;
+
+	qtractorAudioTaskPool *pTaskPool
+		= new qtractorAudioTaskPool(this, m_iTaskThreads);
+	if (pTaskPool->start())
+		m_pTaskPool.store(pTaskPool, std::memory_order_release);
+	else
+		delete pTaskPool;
+}
+
 
 // Process cycle executive.
 int qtractorAudioEngine::process ( unsigned int nframes )
@@ -1016,6 +1188,13 @@ int qtractorAudioEngine::process ( unsigned int nframes )
 	if (!isActivated())
 		return 0;
 
+	// Are we actually exporting offline?...
+	// just keep our own output ports silent.
+	if (m_bOffline) {
+		process_silence(nframes);
+		return 0;
+	}
+
 	// Reset buffer offset.
 	m_iBufferOffset = 0;
 
@@ -1023,6 +1202,7 @@ int qtractorAudioEngine::process ( unsigned int nframes )
 	// notice that freewheeling has no RT requirements.
 	if (m_bFreewheel) {
 		process_export(nframes);
+		session()->midiEngine()->processJackMidiSilence(nframes);
 		return 0;
 	}
 
@@ -1037,12 +1217,20 @@ int qtractorAudioEngine::process ( unsigned int nframes )
 		return 0;
 
 	// Session RT-safeness lock...
-	if (!pSession->acquire())
+	// (JACK MIDI output ports must be cleared anyway)
+	if (!pSession->acquire()) {
+		pSession->midiEngine()->processJackMidiSilence(nframes);
 		return 0;
+	}
 
 	// We're in the audio/real-time thread...
 	g_bProcessing = true;
 
+	// JACK MIDI input/output, if any (in frame-time)...
+	pSession->midiEngine()->processJackMidiInput(nframes);
+	pSession->midiEngine()->processJackMidiOutput(
+		pAudioCursor->frameTime(), nframes);
+
 	// Track whether audio output buses
 	// buses needs monitoring while idle...
 	int iOutputBus = 0;
@@ -1385,12 +1573,17 @@ void qtractorAudioEngine::process_export ( unsigned int nframes )
 				pMidiManager = pMidiManager->next();
 			}
 			// Perform all tracks processing...
-			int iTrack = 0;
-			for (qtractorTrack *pTrack = pSession->tracks().first();
-					pTrack; pTrack = pTrack->next()) {
-				pTrack->process_export(pAudioCursor->clip(iTrack),
+			if (m_pExportGraph) {
+				m_pExportGraph->process_export(pAudioCursor,
 					iFrameStart2, iFrameEnd2);
-				++iTrack;
+			} else {
+				int iTrack = 0;
+				for (qtractorTrack *pTrack = pSession->tracks().first();
+						pTrack; pTrack = pTrack->next()) {
+					pTrack->process_export(pAudioCursor->clip(iTrack),
+						iFrameStart2, iFrameEnd2);
+					++iTrack;
+				}
 			}
 			m_iBufferOffset += (iFrameEnd2 - iFrameStart2);
 		}
@@ -1451,6 +1644,56 @@ void qtractorAudioEngine::process_export ( unsigned int nframes )
 }
 
 
+// Offline export process loop (export worker thread).
+void qtractorAudioEngine::process_offline ( unsigned int nframes )
+{
+	qtractorSession *pSession = session();
+	if (pSession == nullptr)
+		return;
+
+	// We're in the audio/real-time thread, sort of...
+	g_bProcessing = true;
+
+	// No session RT-safeness lock here: the session is
+	// already locked, on our behalf, all along the export...
+	while (m_bExporting && !m_bExportDone) {
+		m_iBufferOffset = 0;
+		process_export(nframes);
+	}
+
+	g_bProcessing = false;
+}
+
+
+// Offline process cycle silence (while exporting).
+void qtractorAudioEngine::process_silence ( unsigned int nframes )
+{
+	for (qtractorBus *pBus = buses().first();
+			pBus; pBus = pBus->next()) {
+		qtractorAudioBus *pAudioBus
+			= static_cast<qtractorAudioBus *> (pBus);
+		if (pAudioBus)
+			pAudioBus->process_silence(nframes);
+	}
+
+	for (qtractorBus *pBusEx = busesEx().first();
+			pBusEx; pBusEx = pBusEx->next()) {
+		qtractorAudioBus *pAudioBusEx
+			= static_cast<qtractorAudioBus *> (pBusEx);
+		if (pAudioBusEx)
+			pAudioBusEx->process_silence(nframes);
+	}
+
+	if (m_pMetroBus && m_bMetroBus)
+		m_pMetroBus->process_silence(nframes);
+	if (m_pPlayerBus && m_bPlayerBus)
+		m_pPlayerBus->process_silence(nframes);
+
+	// JACK MIDI output ports too...
+	session()->midiEngine()->processJackMidiSilence(nframes);
+}
+
+
 // Update time(base)/BBT info.
 void qtractorAudioEngine::updateTimeInfo ( unsigned long iFrame )
 {
@@ -1733,6 +1976,37 @@ unsigned long qtractorAudioEngine::exportLength (void) const
 }
 
 
+// Audio-export offline mode (no JACK freewheeling).
+void qtractorAudioEngine::setExportOffline ( bool bExportOffline )
+{
+	m_bExportOffline = bExportOffline;
+}
+
+bool qtractorAudioEngine::isExportOffline (void) const
+{
+	return m_bExportOffline;
+}
+
+
+// Audio-export parallel process (number of worker threads).
+void qtractorAudioEngine::setExportThreads ( unsigned int iExportThreads )
+{
+	m_iExportThreads = iExportThreads;
+}
+
+unsigned int qtractorAudioEngine::exportThreads (void) const
+{
+	return m_iExportThreads;
+}
+
+
+// Last known export speed (realtime factor).
+float qtractorAudioEngine::exportSpeed (void) const
+{
+	return m_fExportSpeed;
+}
+
+
 
 // Audio-export method.
 bool qtractorAudioEngine::fileExport (
@@ -1853,27 +2127,122 @@ bool qtractorAudioEngine::fileExport (
 	// Special initialization.
 	m_iBufferOffset = 0;
 
-	// Start export (freewheeling)...
-	jack_set_freewheel(m_pJackClient, 1);
+	// Offline export is not possible with any audio inserts around,
+	// as those depend on actual JACK processing and routing...
+	bool bOffline = m_bExportOffline;
+	for (qtractorBus *pBusEx = busesEx().first();
+			pBusEx && bOffline; pBusEx = pBusEx->next()) {
+		if (pBusEx->busMode() & qtractorBus::Input)
+			bOffline = false;
+	}
 
-	// Wait for the export to end.
-	struct timespec ts;
-	ts.tv_sec  = 0;
-	ts.tv_nsec = 20000000L; // 20msec.
+	// Parallel track processing, either with the current
+	// process graph or else a temporary one, just for export...
+	qtractorAudioGraph *pExportGraph = nullptr;
+	m_pExportGraph = m_pAudioGraph;
+	if (m_pExportGraph == nullptr && m_iExportThreads > 0) {
+		pExportGraph = new qtractorAudioGraph(this, m_iExportThreads);
+		pExportGraph->reserve(pSession->tracks().count());
+		if (pExportGraph->start())
+			m_pExportGraph = pExportGraph;
+	}
 
-	while (m_bExporting && !m_bExportDone) {
-		qtractorSession::stabilize(200);
-	#ifdef CONFIG_LV2
-	#ifdef CONFIG_LV2_TIME
-		qtractorLv2Plugin::updateTimePost();
-	#endif
-	#endif
-		::nanosleep(&ts, nullptr); // Ain't that enough?
-		pProgressBar->setValue(pSession->playHead());
+	// Keep track of export speed...
+	QElapsedTimer timer;
+	timer.start();
+
+	if (bOffline) {
+		// Switch all buses to private buffers...
+		for (qtractorBus *pBus = buses().first();
+				pBus; pBus = pBus->next()) {
+			qtractorAudioBus *pAudioBus
+				= static_cast<qtractorAudioBus *> (pBus);
+			if (pAudioBus)
+				pAudioBus->setOffline(true);
+		}
+		for (qtractorBus *pBusEx = busesEx().first();
+				pBusEx; pBusEx = pBusEx->next()) {
+			qtractorAudioBus *pAudioBusEx
+				= static_cast<qtractorAudioBus *> (pBusEx);
+			if (pAudioBusEx)
+				pAudioBusEx->setOffline(true);
+		}
+		// Start export (offline)...
+		m_bOffline = true;
+		m_bFreewheel = true;
+		// Render as fast as we can, in the very same cycle
+		// periods as if freewheeling, on a worker thread of
+		// its own, as plugins must see it as the audio thread...
+		qtractorAudioExportThread export_thread(this, bufferSize());
+		export_thread.start(QThread::HighPriority);
+		while (!export_thread.wait(50)) {
+			// Keep the user interface alive...
+			QApplication::processEvents();
+		#ifdef CONFIG_LV2
+		#ifdef CONFIG_LV2_TIME
+			qtractorLv2Plugin::updateTimePost();
+		#endif
+		#endif
+			pProgressBar->setValue(pSession->playHead());
+		}
+		// Stop export (offline)...
+		m_bFreewheel = false;
+		m_bOffline = false;
+		// Switch all buses back to JACK buffers...
+		for (qtractorBus *pBus = buses().first();
+				pBus; pBus = pBus->next()) {
+			qtractorAudioBus *pAudioBus
+				= static_cast<qtractorAudioBus *> (pBus);
+			if (pAudioBus)
+				pAudioBus->setOffline(false);
+		}
+		for (qtractorBus *pBusEx = busesEx().first();
+				pBusEx; pBusEx = pBusEx->next()) {
+			qtractorAudioBus *pAudioBusEx
+				= static_cast<qtractorAudioBus *> (pBusEx);
+			if (pAudioBusEx)
+				pAudioBusEx->setOffline(false);
+		}
+	} else {
+		// Start export (freewheeling)...
+		jack_set_freewheel(m_pJackClient, 1);
+		// Wait for the export to end.
+		struct timespec ts;
+		ts.tv_sec  = 0;
+		ts.tv_nsec = 20000000L; // 20msec.
+		while (m_bExporting && !m_bExportDone) {
+			qtractorSession::stabilize(200);
+		#ifdef CONFIG_LV2
+		#ifdef CONFIG_LV2_TIME
+			qtractorLv2Plugin::updateTimePost();
+		#endif
+		#endif
+			::nanosleep(&ts, nullptr); // Ain't that enough?
+			pProgressBar->setValue(pSession->playHead());
+		}
+		// Stop export (freewheeling)...
+		jack_set_freewheel(m_pJackClient, 0);
 	}
 
-	// Stop export (freewheeling)...
-	jack_set_freewheel(m_pJackClient, 0);
+	// Export speed, as a realtime factor...
+	const qint64 iElapsed = timer.elapsed();
+	m_fExportSpeed = 0.0f;
+	if (iElapsed > 0 && m_iSampleRate > 0) {
+		m_fExportSpeed = (1000.0f * float(exportLength()))
+			/ (float(m_iSampleRate) * float(iElapsed));
+	}
+
+#ifdef CONFIG_DEBUG
+	qDebug("qtractorAudioEngine::fileExport(\"%s\") offline=%d threads=%u elapsed=%lld speed=%gx",
+		sExportPath.toUtf8().constData(), int(bOffline),
+		(m_pExportGraph ? m_pExportGraph->threads() : 0),
+		iElapsed, m_fExportSpeed);
+#endif
+
+	// Done with parallel track processing...
+	m_pExportGraph = nullptr;
+	if (pExportGraph)
+		delete pExportGraph;
 
 	// May close the file...
 	m_pExportFile->close();
@@ -2767,8 +3136,13 @@ qtractorAudioBus::qtractorAudioBus (
 	m_ppXBuffer = nullptr;
 	m_ppYBuffer = nullptr;
 
+	m_ppIBufferEx = nullptr;
+	m_ppOBufferEx = nullptr;
+
 	m_bEnabled  = false;
 
+	ATOMIC_SET(&m_commitLock, 0);
+
 #if defined(__SSE__)
 	if (sse_enabled())
 		m_pfnBufferAdd = sse_buffer_add;
@@ -2988,6 +3362,9 @@ void qtractorAudioBus::close (void)
 		delete [] m_ppYBuffer;
 		m_ppYBuffer = nullptr;
 	}
+
+	// Free offline buffers, if any.
+	setOffline(false);
 }
 
 
@@ -3128,15 +3505,23 @@ void qtractorAudioBus::process_prepare ( unsigned int nframes )
 
 	if (busMode & qtractorBus::Input) {
 		for (i = 0; i < m_iChannels; ++i) {
-			m_ppIBuffer[i] = static_cast<float *>
-				(jack_port_get_buffer(m_ppIPorts[i], nframes));
+			if (m_ppIBufferEx) {
+				m_ppIBuffer[i] = m_ppIBufferEx[i];
+			} else {
+				m_ppIBuffer[i] = static_cast<float *>
+					(jack_port_get_buffer(m_ppIPorts[i], nframes));
+			}
 		}
 	}
 
 	if (busMode & qtractorBus::Output) {
 		for (i = 0; i < m_iChannels; ++i) {
-			m_ppOBuffer[i] = static_cast<float *>
-				(jack_port_get_buffer(m_ppOPorts[i], nframes));
+			if (m_ppOBufferEx) {
+				m_ppOBuffer[i] = m_ppOBufferEx[i];
+			} else {
+				m_ppOBuffer[i] = static_cast<float *>
+					(jack_port_get_buffer(m_ppOPorts[i], nframes));
+			}
 			// Zero-out output buffer...
 			::memset(m_ppOBuffer[i], 0, nframes * sizeof(float));
 		}
@@ -3144,6 +3529,78 @@ void qtractorAudioBus::process_prepare ( unsigned int nframes )
 }
 
 
+// Offline process mode (private port buffers).
+void qtractorAudioBus::setOffline ( bool bOffline )
+{
+	if (( bOffline &&  isOffline()) ||
+		(!bOffline && !isOffline()))
+		return;
+
+	const qtractorBus::BusMode busMode
+		= qtractorAudioBus::busMode();
+
+	unsigned short i;
+
+	if (bOffline) {
+		qtractorAudioEngine *pAudioEngine
+			= static_cast<qtractorAudioEngine *> (engine());
+		if (pAudioEngine == nullptr)
+			return;
+		const unsigned int iBufferSizeEx
+			= pAudioEngine->bufferSizeEx();
+		// Input buffers are just silent...
+		if (busMode & qtractorBus::Input) {
+			m_ppIBufferEx = new float * [m_iChannels];
+			for (i = 0; i < m_iChannels; ++i) {
+				m_ppIBufferEx[i] = new float [iBufferSizeEx];
+				::memset(m_ppIBufferEx[i], 0, iBufferSizeEx * sizeof(float));
+			}
+		}
+		if (busMode & qtractorBus::Output) {
+			m_ppOBufferEx = new float * [m_iChannels];
+			for (i = 0; i < m_iChannels; ++i)
+				m_ppOBufferEx[i] = new float [iBufferSizeEx];
+		}
+	} else {
+		if (m_ppIBufferEx) {
+			for (i = 0; i < m_iChannels; ++i)
+				delete [] m_ppIBufferEx[i];
+			delete [] m_ppIBufferEx;
+			m_ppIBufferEx = nullptr;
+		}
+		if (m_ppOBufferEx) {
+			for (i = 0; i < m_iChannels; ++i)
+				delete [] m_ppOBufferEx[i];
+			delete [] m_ppOBufferEx;
+			m_ppOBufferEx = nullptr;
+		}
+	}
+}
+
+bool qtractorAudioBus::isOffline (void) const
+{
+	return (m_ppIBufferEx != nullptr || m_ppOBufferEx != nullptr);
+}
+
+
+// Process cycle silence (while offline).
+void qtractorAudioBus::process_silence ( unsigned int nframes )
+{
+	if (!m_bEnabled || m_ppOPorts == nullptr)
+		return;
+
+	if ((busMode() & qtractorBus::Output) == 0)
+		return;
+
+	for (unsigned short i = 0; i < m_iChannels; ++i) {
+		float *pBuffer = static_cast<float *>
+			(jack_port_get_buffer(m_ppOPorts[i], nframes));
+		if (pBuffer)
+			::memset(pBuffer, 0, nframes * sizeof(float));
+	}
+}
+
+
 // Process cycle monitor.
 void qtractorAudioBus::process_monitor ( unsigned int nframes )
 {
@@ -3172,6 +3629,8 @@ void qtractorAudioBus::process_commit ( unsigned int nframes )
 	if (!m_bEnabled)
 		return;
 
+	qtractorDspLoad::Scope timing(dspLoad());
+
 	if (m_pOPluginList)
 		m_pOPluginList->process(m_ppOBuffer, nframes);
 	if (m_pOAudioMonitor)
@@ -3182,6 +3641,28 @@ void qtractorAudioBus::process_commit ( unsigned int nframes )
 // Bus-buffering methods.
 void qtractorAudioBus::buffer_prepare (
 	unsigned int nframes, qtractorAudioBus *pInputBus )
+{
+	buffer_prepare(nframes, pInputBus, m_ppXBuffer, m_ppYBuffer);
+}
+
+void qtractorAudioBus::buffer_commit ( unsigned int nframes )
+{
+	if (!m_bEnabled || (busMode() & qtractorBus::Output) == 0)
+		return;
+
+	qtractorAudioEngine *pAudioEngine
+		= static_cast<qtractorAudioEngine *> (engine());
+	if (pAudioEngine == nullptr)
+		return;
+
+	(*m_pfnBufferAdd)(m_ppOBuffer, m_ppXBuffer,
+		nframes, m_iChannels, m_iChannels, pAudioEngine->bufferOffset());
+}
+
+
+// Bus-buffering methods (external work buffers).
+void qtractorAudioBus::buffer_prepare ( unsigned int nframes,
+	qtractorAudioBus *pInputBus, float **ppXBuffer, float **ppYBuffer )
 {
 	if (!m_bEnabled)
 		return;
@@ -3196,8 +3677,8 @@ void qtractorAudioBus::buffer_prepare (
 
 	if (pInputBus == nullptr) {
 		for (unsigned short i = 0; i < m_iChannels; ++i) {
-			m_ppYBuffer[i] = m_ppXBuffer[i] + offset;
-			::memset(m_ppYBuffer[i], 0, nbytes);
+			ppYBuffer[i] = ppXBuffer[i] + offset;
+			::memset(ppYBuffer[i], 0, nbytes);
 		}
 		return;
 	}
@@ -3208,31 +3689,31 @@ void qtractorAudioBus::buffer_prepare (
 	if (m_iChannels == iBuffers) {
 		// Exact buffer copy...
 		for (unsigned short i = 0; i < iBuffers; ++i) {
-			m_ppYBuffer[i] = m_ppXBuffer[i] + offset;
-			::memcpy(m_ppYBuffer[i], ppBuffer[i] + offset, nbytes);
+			ppYBuffer[i] = ppXBuffer[i] + offset;
+			::memcpy(ppYBuffer[i], ppBuffer[i] + offset, nbytes);
 		}
 	} else {
 		// Buffer merge/multiplex...
 		unsigned short i;
 		for (i = 0; i < m_iChannels; ++i) {
-			m_ppYBuffer[i] = m_ppXBuffer[i] + offset;
-			::memset(m_ppYBuffer[i], 0, nbytes);
+			ppYBuffer[i] = ppXBuffer[i] + offset;
+			::memset(ppYBuffer[i], 0, nbytes);
 		}
 		if (m_iChannels > iBuffers) {
 			unsigned short j = 0;
 			for (i = 0; i < m_iChannels; ++i) {
-				::memcpy(m_ppYBuffer[i], ppBuffer[j] + offset, nbytes);
+				::memcpy(ppYBuffer[i], ppBuffer[j] + offset, nbytes);
 				if (++j >= iBuffers)
 					j = 0;
 			}
 		} else { // (m_iChannels < iBuffers)
-			(*m_pfnBufferAdd)(m_ppXBuffer, ppBuffer,
+			(*m_pfnBufferAdd)(ppXBuffer, ppBuffer,
 				nframes, m_iChannels, iBuffers, offset);
 		}
 	}
 }
 
-void qtractorAudioBus::buffer_commit ( unsigned int nframes )
+void qtractorAudioBus::buffer_commit ( unsigned int nframes, float **ppXBuffer )
 {
 	if (!m_bEnabled || (busMode() & qtractorBus::Output) == 0)
 		return;
@@ -3242,11 +3723,26 @@ void qtractorAudioBus::buffer_commit ( unsigned int nframes )
 	if (pAudioEngine == nullptr)
 		return;
 
-	(*m_pfnBufferAdd)(m_ppOBuffer, m_ppXBuffer,
+	(*m_pfnBufferAdd)(m_ppOBuffer, ppXBuffer,
 		nframes, m_iChannels, m_iChannels, pAudioEngine->bufferOffset());
 }
 
 
+// Concurrent (graph worker) buffer commit: never waits,
+// returns false whenever it's busy, so to be deferred.
+bool qtractorAudioBus::buffer_commit_try (
+	unsigned int nframes, float **ppXBuffer )
+{
+	if (!ATOMIC_TAS(&m_commitLock))
+		return false;
+
+	buffer_commit(nframes, ppXBuffer);
+
+	ATOMIC_SET(&m_commitLock, 0);
+	return true;
+}
+
+
 // Virtual I/O bus-monitor accessors.
 qtractorMonitor *qtractorAudioBus::monitor_in (void) const
 {
@@ -27,6 +27,8 @@
 
 #include <jack/jack.h>
 
+#include <atomic>
+
 #include <QObject>
 
 
@@ -36,6 +38,8 @@ class qtractorAudioBuffer;
 class qtractorAudioMonitor;
 class qtractorAudioFile;
 class qtractorAudioExportBuffer;
+class qtractorAudioGraph;
+class qtractorAudioTaskPool;
 class qtractorPluginList;
 class qtractorCurveList;
 
@@ -160,6 +164,17 @@ public:
 	unsigned long exportOffset() const;
 	unsigned long exportLength() const;
 
+	// Audio-export offline mode (no JACK freewheeling).
+	void setExportOffline(bool bExportOffline);
+	bool isExportOffline() const;
+
+	// Audio-export parallel process (number of worker threads).
+	void setExportThreads(unsigned int iExportThreads);
+	unsigned int exportThreads() const;
+
+	// Last known export speed (realtime factor).
+	float exportSpeed() const;
+
 	// Audio-export method.
 	bool fileExport(const QString& sExportPath,
 		const QList<qtractorAudioBus *>& exportBuses,
@@ -265,8 +280,36 @@ public:
 	// Reset all audio monitoring...
 	void resetAllMonitors();
 
+	// Offline export process loop (export worker thread only).
+	void process_offline(unsigned int nframes);
+
 	// Whether we're in the audio/real-time thread...
 	static bool isProcessing();
+	static void setProcessing(bool bProcessing);
+
+	// Parallel track process graph (number of worker threads).
+	void setGraphThreads(unsigned int iGraphThreads);
+	unsigned int graphThreads() const;
+
+	// Parallel track process graph deterministic mode.
+	void setGraphDeterministic(bool bGraphDeterministic);
+	bool isGraphDeterministic() const;
+
+	// Parallel track process graph accessor.
+	qtractorAudioGraph *graph() const;
+
+	// Real-time parallel task pool (number of worker threads).
+	void setTaskThreads(unsigned int iTaskThreads);
+	unsigned int taskThreads() const;
+
+	// Real-time parallel task pool accessor (RT-safe;
+	// null until requested and started, see below).
+	qtractorAudioTaskPool *taskPool() const;
+
+	// Real-time parallel task pool lazy start request (RT-safe)
+	// and deferred start, when so requested (non-RT).
+	void requestTaskPool();
+	void updateTaskPool();
 
 	// Time(base)/BBT info.
 	struct TimeInfo
@@ -326,6 +369,9 @@ protected:
 	// Freewheeling process cycle executive (needed for export).
 	void process_export(unsigned int nframes);
 
+	// Offline process cycle silence (while exporting).
+	void process_silence(unsigned int nframes);
+
 	// Metronome latency offset compensation.
 	unsigned long metro_offset(unsigned long iFrame) const;
 
@@ -374,6 +420,13 @@ private:
 	QList<qtractorAudioBus *> *m_pExportBuses;
 	qtractorAudioExportBuffer *m_pExportBuffer;
 
+	// Audio-export offline mode and parallel process.
+	bool                 m_bExportOffline;
+	volatile bool        m_bOffline;
+	unsigned int         m_iExportThreads;
+	qtractorAudioGraph  *m_pExportGraph;
+	float                m_fExportSpeed;
+
 	// Audio metronome stuff.
 	bool                 m_bMetronome;
 	bool                 m_bMetroBus;
@@ -421,6 +474,18 @@ private:
 
 	// Time(base)/BBT time info.
 	TimeInfo             m_timeInfo;
+
+	// Parallel track process graph.
+	unsigned int         m_iGraphThreads;
+	bool                 m_bGraphDeterministic;
+	qtractorAudioGraph  *m_pAudioGraph;
+
+	// Real-time parallel task pool (eg. plugin thread-pools).
+	unsigned int           m_iTaskThreads;
+	bool                   m_bTaskPoolStarted;
+	std::atomic<bool>      m_bTaskPoolRequest;
+
+	std::atomic<qtractorAudioTaskPool *> m_pTaskPool;
 };
 
 
@@ -460,11 +525,26 @@ public:
 	void process_monitor(unsigned int nframes);
 	void process_commit(unsigned int nframes);
 
+	// Offline process mode (private port buffers).
+	void setOffline(bool bOffline);
+	bool isOffline() const;
+
+	// Process cycle silence (while offline).
+	void process_silence(unsigned int nframes);
+
 	// Bus-buffering methods.
 	void buffer_prepare(unsigned int nframes,
 		qtractorAudioBus *pInputBus = nullptr);
 	void buffer_commit(unsigned int nframes);
 
+	// Bus-buffering methods (external work buffers).
+	void buffer_prepare(unsigned int nframes, qtractorAudioBus *pInputBus,
+		float **ppXBuffer, float **ppYBuffer);
+	void buffer_commit(unsigned int nframes, float **ppXBuffer);
+
+	// Concurrent (graph worker) buffer commit (try-lock).
+	bool buffer_commit_try(unsigned int nframes, float **ppXBuffer);
+
 	// Up-and-running predicate.
 	bool isEnabled() const { return m_bEnabled; }
 
@@ -541,10 +621,17 @@ private:
 	float       **m_ppXBuffer;
 	float       **m_ppYBuffer;
 
+	// Offline (private) port buffers.
+	float       **m_ppIBufferEx;
+	float       **m_ppOBufferEx;
+
 	// Special under-work flag...
 	// (r/w access should be atomic)
 	volatile bool m_bEnabled;
 
+	// Concurrent (graph) buffer commit try-lock.
+	qtractorAtomic m_commitLock;
+
 	// Buffer mix-down processor.
 	void (*m_pfnBufferAdd)(float **, float **, unsigned int,
 		unsigned short, unsigned short, unsigned int);
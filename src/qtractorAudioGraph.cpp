@@ -0,0 +1,589 @@
+// qtractorAudioGraph.cpp
+//
+/****************************************************************************
+   Copyright (C) 2005-2025, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#include "qtractorAbout.h"
+#include "qtractorAudioGraph.h"
+#include "qtractorAudioEngine.h"
+
+#include "qtractorSession.h"
+#include "qtractorSessionCursor.h"
+#include "qtractorTrack.h"
+
+#include <cerrno>
+
+
+// Ready queue state packing: node count and next node index.
+#define GRAPH_INDEX_BITS	12
+#define GRAPH_INDEX_MASK	((1 << GRAPH_INDEX_BITS) - 1)
+
+
+//----------------------------------------------------------------------
+// class qtractorAudioGraph -- Parallel audio track process graph.
+//
+
+// Constructor.
+qtractorAudioGraph::qtractorAudioGraph (
+	qtractorAudioEngine *pAudioEngine,
+	unsigned int iThreads, bool bDeterministic )
+	: m_pAudioEngine(pAudioEngine), m_iThreads(iThreads),
+		m_pThreads(nullptr), m_iThreadsRunning(0),
+		m_bRunState(false), m_bDeterministic(bDeterministic),
+		m_iMaxNodes(0), m_ppNodes(nullptr), m_ppClips(nullptr),
+		m_pbDeferred(nullptr),
+		m_iFrameStart(0), m_iFrameEnd(0),
+		m_bExport(false), m_bCommit(false)
+{
+	ATOMIC_SET(&m_state, 0);
+	ATOMIC_SET(&m_done, 0);
+
+	::sem_init(&m_semWork, 0, 0);
+	::sem_init(&m_semDone, 0, 0);
+
+	if (m_iThreads > 0)
+		m_pThreads = new jack_native_thread_t [m_iThreads];
+}
+
+
+// Destructor.
+qtractorAudioGraph::~qtractorAudioGraph (void)
+{
+	stop();
+
+	if (m_pThreads)
+		delete [] m_pThreads;
+
+	if (m_pbDeferred)
+		delete [] m_pbDeferred;
+	if (m_ppClips)
+		delete [] m_ppClips;
+	if (m_ppNodes)
+		delete [] m_ppNodes;
+
+	::sem_destroy(&m_semDone);
+	::sem_destroy(&m_semWork);
+}
+
+
+// Worker threads (re)start method.
+bool qtractorAudioGraph::start (void)
+{
+	stop();
+
+	jack_client_t *pJackClient = m_pAudioEngine->jackClient();
+	if (pJackClient == nullptr)
+		return false;
+
+	// Workers run at the very same priority of the JACK process thread...
+	const int iRealtime = jack_is_realtime(pJackClient);
+	const int iPriority = jack_client_real_time_priority(pJackClient);
+
+	m_bRunState = true;
+
+	for (unsigned int i = 0; i < m_iThreads; ++i) {
+		if (jack_client_create_thread(pJackClient,
+				&m_pThreads[m_iThreadsRunning], iPriority, iRealtime,
+				qtractorAudioGraph::worker_thread, this) == 0)
+			++m_iThreadsRunning;
+	}
+
+#ifdef CONFIG_DEBUG
+	qDebug("qtractorAudioGraph[%p]::start() threads=%u/%u priority=%d",
+		this, m_iThreadsRunning, m_iThreads, iPriority);
+#endif
+
+	return (m_iThreadsRunning > 0);
+}
+
+
+// Worker threads stop method.
+void qtractorAudioGraph::stop (void)
+{
+	if (m_iThreadsRunning < 1)
+		return;
+
+	m_bRunState = false;
+
+	unsigned int i;
+	for (i = 0; i < m_iThreadsRunning; ++i)
+		::sem_post(&m_semWork);
+
+	jack_client_t *pJackClient = m_pAudioEngine->jackClient();
+	for (i = 0; i < m_iThreadsRunning; ++i)
+		jack_client_stop_thread(pJackClient, m_pThreads[i]);
+
+	m_iThreadsRunning = 0;
+}
+
+
+// Number of worker threads accessor.
+unsigned int qtractorAudioGraph::threads (void) const
+{
+	return m_iThreadsRunning;
+}
+
+
+// Deterministic (bit-exact) bus commit mode accessors.
+void qtractorAudioGraph::setDeterministic ( bool bDeterministic )
+{
+	m_bDeterministic = bDeterministic;
+}
+
+bool qtractorAudioGraph::isDeterministic (void) const
+{
+	return m_bDeterministic;
+}
+
+
+// Maximum number of nodes in graph.
+unsigned int qtractorAudioGraph::maxNodes (void)
+{
+	return GRAPH_INDEX_MASK;
+}
+
+
+// Node array capacity (non RT-safe).
+void qtractorAudioGraph::reserve ( unsigned int iNodes )
+{
+	if (iNodes > GRAPH_INDEX_MASK)
+		iNodes = GRAPH_INDEX_MASK;
+	if (m_iMaxNodes >= iNodes)
+		return;
+
+	unsigned int iMaxNodes = (m_iMaxNodes > 0 ? m_iMaxNodes : 16);
+	while (iMaxNodes < iNodes)
+		iMaxNodes <<= 1;
+	if (iMaxNodes > GRAPH_INDEX_MASK)
+		iMaxNodes = GRAPH_INDEX_MASK;
+
+	qtractorTrack **ppOldNodes = m_ppNodes;
+	qtractorClip  **ppOldClips = m_ppClips;
+	bool           *pbOldDeferred = m_pbDeferred;
+
+	qtractorTrack **ppNewNodes = new qtractorTrack * [iMaxNodes];
+	qtractorClip  **ppNewClips = new qtractorClip  * [iMaxNodes];
+	bool           *pbNewDeferred = new bool [iMaxNodes];
+
+	// Swap arrays while out of the process cycle...
+	qtractorSession *pSession = m_pAudioEngine->session();
+	if (pSession)
+		pSession->lock();
+
+	m_ppNodes = ppNewNodes;
+	m_ppClips = ppNewClips;
+	m_pbDeferred = pbNewDeferred;
+	m_iMaxNodes = iMaxNodes;
+
+	if (pSession)
+		pSession->unlock();
+
+	if (pbOldDeferred)
+		delete [] pbOldDeferred;
+	if (ppOldClips)
+		delete [] ppOldClips;
+	if (ppOldNodes)
+		delete [] ppOldNodes;
+}
+
+
+// Parallel process cycle executive.
+void qtractorAudioGraph::process ( qtractorSessionCursor *pSessionCursor,
+	unsigned long iFrameStart, unsigned long iFrameEnd )
+{
+	process_graph(pSessionCursor, iFrameStart, iFrameEnd, false);
+}
+
+
+// Parallel freewheeling/offline process cycle executive (export only).
+void qtractorAudioGraph::process_export ( qtractorSessionCursor *pSessionCursor,
+	unsigned long iFrameStart, unsigned long iFrameEnd )
+{
+	process_graph(pSessionCursor, iFrameStart, iFrameEnd, true);
+}
+
+
+// Parallel process cycle executive (common).
+void qtractorAudioGraph::process_graph ( qtractorSessionCursor *pSessionCursor,
+	unsigned long iFrameStart, unsigned long iFrameEnd, bool bExport )
+{
+	qtractorSession *pSession = m_pAudioEngine->session();
+	if (pSession == nullptr)
+		return;
+
+	// Ready nodes must fit in their own work buffers...
+	const unsigned int iBufferSize
+		= m_pAudioEngine->bufferOffset() + (iFrameEnd - iFrameStart);
+
+	// Ready nodes collection, always in track order...
+	unsigned int iNodes = 0;
+	int iTrack = 0;
+	qtractorTrack *pTrack = pSession->tracks().first();
+	while (pTrack) {
+		if (pTrack->trackType() == qtractorTrack::Audio
+			&& iNodes < m_iMaxNodes && pTrack->isGraphNode(iBufferSize)) {
+			m_ppNodes[iNodes] = pTrack;
+			m_ppClips[iNodes] = pSessionCursor->clip(iTrack);
+			++iNodes;
+		}
+		pTrack = pTrack->next();
+		++iTrack;
+	}
+
+	// Not worth the dispatch for less than a couple nodes...
+	if (iNodes < 2 || m_iThreadsRunning < 1)
+		iNodes = 0;
+
+	// Track automation processing, also in track order;
+	// on export, serial tracks will take care of their own...
+	unsigned int iNode = 0;
+	pTrack = pSession->tracks().first();
+	while (pTrack) {
+		if (iNode < iNodes && m_ppNodes[iNode] == pTrack) {
+			pTrack->process_curve(iFrameStart);
+			++iNode;
+		}
+		else
+		if (!bExport)
+			pTrack->process_curve(iFrameStart);
+		pTrack = pTrack->next();
+	}
+
+	// Export is always deterministic (bit-exact)...
+	const bool bDeterministic = (m_bDeterministic || bExport);
+
+	if (iNodes > 0) {
+		m_iFrameStart = iFrameStart;
+		m_iFrameEnd = iFrameEnd;
+		m_bExport = bExport;
+		m_bCommit = !bDeterministic;
+		ATOMIC_SET(&m_done, 0);
+		// Publish the ready queue (release)...
+		const int iState = int(iNodes << GRAPH_INDEX_BITS);
+		int iOldState;
+		do { iOldState = ATOMIC_GET(&m_state); }
+		while (!ATOMIC_CAS(&m_state, iOldState, iState));
+		// Wake up just enough workers...
+		unsigned int iWake = iNodes - 1;
+		if (iWake > m_iThreadsRunning)
+			iWake = m_iThreadsRunning;
+		for (unsigned int i = 0; i < iWake; ++i)
+			::sem_post(&m_semWork);
+		// Make ourselves useful too...
+		process_nodes();
+		// Join: wait for the last node to complete...
+		while (::sem_wait(&m_semDone) < 0 && errno == EINTR)
+			;
+	}
+
+	// Serial nodes and bus commits, in track order...
+	const unsigned int nframes = iFrameEnd - iFrameStart;
+	iNode = 0;
+	iTrack = 0;
+	pTrack = pSession->tracks().first();
+	while (pTrack) {
+		if (iNode < iNodes && m_ppNodes[iNode] == pTrack) {
+			if (m_pbDeferred[iNode])
+				pTrack->process_graph_commit(nframes);
+			++iNode;
+		}
+		else
+		if (bExport) {
+			pTrack->process_export(pSessionCursor->clip(iTrack),
+				iFrameStart, iFrameEnd);
+		}
+		else
+		if (pTrack->trackType() == qtractorTrack::Audio) {
+			pTrack->process(pSessionCursor->clip(iTrack),
+				iFrameStart, iFrameEnd);
+		}
+		pTrack = pTrack->next();
+		++iTrack;
+	}
+}
+
+
+// Claim and process all ready nodes.
+void qtractorAudioGraph::process_nodes (void)
+{
+	const bool bExport = m_bExport;
+	const bool bCommit = m_bCommit;
+
+	for (;;) {
+		// Claim next ready node (lock-free)...
+		const int iState = ATOMIC_GET(&m_state);
+		const int iNodes = ((iState >> GRAPH_INDEX_BITS) & GRAPH_INDEX_MASK);
+		const int iIndex = (iState & GRAPH_INDEX_MASK);
+		if (iIndex >= iNodes)
+			break;
+		if (!ATOMIC_CAS(&m_state, iState, iState + 1))
+			continue;
+		// Process it...
+		qtractorTrack *pTrack = m_ppNodes[iIndex];
+		pTrack->process_graph(m_ppClips[iIndex],
+			m_iFrameStart, m_iFrameEnd, bExport);
+		// Commit right away, unless the bus is busy: never wait
+		// on other workers, defer it to the join instead...
+		m_pbDeferred[iIndex] = !(bCommit && pTrack->process_graph_commit(
+			m_iFrameEnd - m_iFrameStart, true));
+		// Last one signals completion...
+		if (ATOMIC_INC(&m_done) == iNodes)
+			::sem_post(&m_semDone);
+	}
+}
+
+
+// Worker thread process executive.
+void qtractorAudioGraph::run (void)
+{
+	// We're in an audio/real-time thread as well...
+	qtractorAudioEngine::setProcessing(true);
+
+	while (m_bRunState) {
+		if (::sem_wait(&m_semWork) < 0)
+			continue;
+		if (!m_bRunState)
+			break;
+		process_nodes();
+	}
+
+	qtractorAudioEngine::setProcessing(false);
+}
+
+
+// Worker thread entry point.
+void *qtractorAudioGraph::worker_thread ( void *pvArg )
+{
+	qtractorAudioGraph *pAudioGraph
+		= static_cast<qtractorAudioGraph *> (pvArg);
+	if (pAudioGraph)
+		pAudioGraph->run();
+
+	return nullptr;
+}
+
+
+//----------------------------------------------------------------------
+// class qtractorAudioTaskPool -- Real-time parallel task pool.
+//
+
+// Constructor.
+qtractorAudioTaskPool::qtractorAudioTaskPool (
+	qtractorAudioEngine *pAudioEngine, unsigned int iThreads )
+	: m_pAudioEngine(pAudioEngine), m_iThreads(iThreads),
+		m_pThreads(nullptr), m_iThreadsRunning(0), m_bRunState(false),
+		m_pfnTask(nullptr), m_pvArg(nullptr)
+{
+	ATOMIC_SET(&m_busy, 0);
+	ATOMIC_SET(&m_state, 0);
+	ATOMIC_SET(&m_done, 0);
+	ATOMIC_SET(&m_time, 0);
+
+	::sem_init(&m_semWork, 0, 0);
+	::sem_init(&m_semDone, 0, 0);
+
+	if (m_iThreads > 0)
+		m_pThreads = new jack_native_thread_t [m_iThreads];
+}
+
+
+// Destructor.
+qtractorAudioTaskPool::~qtractorAudioTaskPool (void)
+{
+	stop();
+
+	if (m_pThreads)
+		delete [] m_pThreads;
+
+	::sem_destroy(&m_semDone);
+	::sem_destroy(&m_semWork);
+}
+
+
+// Worker threads (re)start method.
+bool qtractorAudioTaskPool::start (void)
+{
+	stop();
+
+	jack_client_t *pJackClient = m_pAudioEngine->jackClient();
+	if (pJackClient == nullptr)
+		return false;
+
+	// Workers run at the very same priority of the JACK process thread...
+	const int iRealtime = jack_is_realtime(pJackClient);
+	const int iPriority = jack_client_real_time_priority(pJackClient);
+
+	m_bRunState = true;
+
+	for (unsigned int i = 0; i < m_iThreads; ++i) {
+		if (jack_client_create_thread(pJackClient,
+				&m_pThreads[m_iThreadsRunning], iPriority, iRealtime,
+				qtractorAudioTaskPool::worker_thread, this) == 0)
+			++m_iThreadsRunning;
+	}
+
+#ifdef CONFIG_DEBUG
+	qDebug("qtractorAudioTaskPool[%p]::start() threads=%u/%u priority=%d",
+		this, m_iThreadsRunning, m_iThreads, iPriority);
+#endif
+
+	return (m_iThreadsRunning > 0);
+}
+
+
+// Worker threads stop method.
+void qtractorAudioTaskPool::stop (void)
+{
+	if (m_iThreadsRunning < 1)
+		return;
+
+	m_bRunState = false;
+
+	unsigned int i;
+	for (i = 0; i < m_iThreadsRunning; ++i)
+		::sem_post(&m_semWork);
+
+	jack_client_t *pJackClient = m_pAudioEngine->jackClient();
+	for (i = 0; i < m_iThreadsRunning; ++i)
+		jack_client_stop_thread(pJackClient, m_pThreads[i]);
+
+	m_iThreadsRunning = 0;
+}
+
+
+// Number of worker threads accessor.
+unsigned int qtractorAudioTaskPool::threads (void) const
+{
+	return m_iThreadsRunning;
+}
+
+
+// Maximum number of tasks per batch.
+unsigned int qtractorAudioTaskPool::maxTasks (void)
+{
+	return GRAPH_INDEX_MASK;
+}
+
+
+// Parallel task batch executive (RT-safe, blocks until done).
+bool qtractorAudioTaskPool::exec ( TaskProc pfnTask, void *pvArg,
+	unsigned int iTasks, unsigned long *piTaskTime )
+{
+	if (m_iThreadsRunning < 1 || iTasks > GRAPH_INDEX_MASK)
+		return false;
+
+	if (iTasks < 1) {
+		if (piTaskTime)
+			*piTaskTime = 0;
+		return true;
+	}
+
+	// Only one batch at a time...
+	if (!ATOMIC_TAS(&m_busy))
+		return false;
+
+	m_pfnTask = pfnTask;
+	m_pvArg = pvArg;
+
+	ATOMIC_SET(&m_done, 0);
+	ATOMIC_SET(&m_time, 0);
+
+	// Publish the task queue (release)...
+	const int iState = int(iTasks << GRAPH_INDEX_BITS);
+	int iOldState;
+	do { iOldState = ATOMIC_GET(&m_state); }
+	while (!ATOMIC_CAS(&m_state, iOldState, iState));
+
+	// Wake up just enough workers...
+	unsigned int iWake = iTasks - 1;
+	if (iWake > m_iThreadsRunning)
+		iWake = m_iThreadsRunning;
+	for (unsigned int i = 0; i < iWake; ++i)
+		::sem_post(&m_semWork);
+
+	// Make ourselves useful too...
+	process_tasks();
+
+	// Join: wait for the last task to complete...
+	while (::sem_wait(&m_semDone) < 0 && errno == EINTR)
+		;
+
+	if (piTaskTime)
+		*piTaskTime = (unsigned long) ATOMIC_GET(&m_time);
+
+	ATOMIC_SET(&m_busy, 0);
+
+	return true;
+}
+
+
+// Claim and run all pending tasks.
+void qtractorAudioTaskPool::process_tasks (void)
+{
+	for (;;) {
+		// Claim next pending task (lock-free)...
+		const int iState = ATOMIC_GET(&m_state);
+		const int iTasks = ((iState >> GRAPH_INDEX_BITS) & GRAPH_INDEX_MASK);
+		const int iIndex = (iState & GRAPH_INDEX_MASK);
+		if (iIndex >= iTasks)
+			break;
+		if (!ATOMIC_CAS(&m_state, iState, iState + 1))
+			continue;
+		// Run it...
+		const jack_time_t t0 = jack_get_time();
+		(*m_pfnTask)(m_pvArg, iIndex);
+		ATOMIC_ADD(&m_time, int(jack_get_time() - t0));
+		// Last one signals completion...
+		if (ATOMIC_INC(&m_done) == iTasks)
+			::sem_post(&m_semDone);
+	}
+}
+
+
+// Worker thread process executive.
+void qtractorAudioTaskPool::run (void)
+{
+	// We're in an audio/real-time thread as well...
+	qtractorAudioEngine::setProcessing(true);
+
+	while (m_bRunState) {
+		if (::sem_wait(&m_semWork) < 0)
+			continue;
+		if (!m_bRunState)
+			break;
+		process_tasks();
+	}
+
+	qtractorAudioEngine::setProcessing(false);
+}
+
+
+// Worker thread entry point.
+void *qtractorAudioTaskPool::worker_thread ( void *pvArg )
+{
+	qtractorAudioTaskPool *pTaskPool
+		= static_cast<qtractorAudioTaskPool *> (pvArg);
+	if (pTaskPool)
+		pTaskPool->run();
+
+	return nullptr;
+}
+
+
+// end of qtractorAudioGraph.cpp
@@ -0,0 +1,223 @@
+// qtractorAudioGraph.h
+//
+/****************************************************************************
+   Copyright (C) 2005-2025, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#ifndef __qtractorAudioGraph_h
+#define __qtractorAudioGraph_h
+
+#include "qtractorAtomic.h"
+
+#include <jack/jack.h>
+#include <jack/thread.h>
+
+#include <semaphore.h>
+
+
+// Forward declarations.
+class qtractorAudioEngine;
+class qtractorSessionCursor;
+class qtractorTrack;
+class qtractorClip;
+
+
+//----------------------------------------------------------------------
+// class qtractorAudioGraph -- Parallel audio track process graph.
+//
+// Audio tracks that only write onto their own private node buffers
+// (ie. no audio inserts nor aux-sends in their plugin chain) are run
+// concurrently on a pool of real-time worker threads; all other tracks,
+// and the final commit onto their output buses, are then processed
+// serially, in track order, on the main JACK process thread.
+//
+
+class qtractorAudioGraph
+{
+public:
+
+	// Constructor.
+	qtractorAudioGraph(qtractorAudioEngine *pAudioEngine,
+		unsigned int iThreads, bool bDeterministic = true);
+
+	// Destructor.
+	~qtractorAudioGraph();
+
+	// Worker threads (re)start/stop methods.
+	bool start();
+	void stop();
+
+	// Number of worker threads accessor.
+	unsigned int threads() const;
+
+	// Deterministic (bit-exact) bus commit mode accessors.
+	void setDeterministic(bool bDeterministic);
+	bool isDeterministic() const;
+
+	// Node array capacity (non RT-safe).
+	void reserve(unsigned int iNodes);
+
+	// Parallel process cycle executive.
+	void process(qtractorSessionCursor *pSessionCursor,
+		unsigned long iFrameStart, unsigned long iFrameEnd);
+
+	// Parallel freewheeling/offline process cycle executive (export only).
+	void process_export(qtractorSessionCursor *pSessionCursor,
+		unsigned long iFrameStart, unsigned long iFrameEnd);
+
+	// Maximum number of nodes in graph.
+	static unsigned int maxNodes();
+
+protected:
+
+	// Parallel process cycle executive (common).
+	void process_graph(qtractorSessionCursor *pSessionCursor,
+		unsigned long iFrameStart, unsigned long iFrameEnd, bool bExport);
+
+	// Worker thread process executive.
+	void run();
+
+	// Claim and process all ready nodes.
+	void process_nodes();
+
+	// Worker thread entry point.
+	static void *worker_thread(void *pvArg);
+
+private:
+
+	// Instance variables.
+	qtractorAudioEngine *m_pAudioEngine;
+
+	unsigned int m_iThreads;
+	jack_native_thread_t *m_pThreads;
+	unsigned int m_iThreadsRunning;
+
+	volatile bool m_bRunState;
+	volatile bool m_bDeterministic;
+
+	// Ready node array (in track order).
+	unsigned int   m_iMaxNodes;
+	qtractorTrack **m_ppNodes;
+	qtractorClip  **m_ppClips;
+
+	// Node bus commits left to the join (in track order).
+	bool *m_pbDeferred;
+
+	// Lock-free ready queue state (packed node count and next index).
+	qtractorAtomic m_state;
+	qtractorAtomic m_done;
+
+	// Current cycle frame range.
+	unsigned long m_iFrameStart;
+	unsigned long m_iFrameEnd;
+
+	// Current cycle mode (export, immediate commit).
+	bool m_bExport;
+	bool m_bCommit;
+
+	// Worker wake-up and cycle completion semaphores.
+	sem_t m_semWork;
+	sem_t m_semDone;
+};
+
+
+//----------------------------------------------------------------------
+// class qtractorAudioTaskPool -- Real-time parallel task pool.
+//
+// Runs a batch of independent tasks (eg. plugin voices or bands)
+// over a pool of real-time worker threads, the calling (audio) thread
+// taking its fair share; each batch only returns when all its tasks
+// are done. One batch at a time: concurrent or nested requests are
+// just rejected, so that the callers may run their tasks serially.
+//
+
+class qtractorAudioTaskPool
+{
+public:
+
+	// Task callback prototype.
+	typedef void (*TaskProc)(void *pvArg, unsigned int iTask);
+
+	// Constructor.
+	qtractorAudioTaskPool(qtractorAudioEngine *pAudioEngine,
+		unsigned int iThreads);
+
+	// Destructor.
+	~qtractorAudioTaskPool();
+
+	// Worker threads (re)start/stop methods.
+	bool start();
+	void stop();
+
+	// Number of worker threads accessor.
+	unsigned int threads() const;
+
+	// Parallel task batch executive (RT-safe, blocks until done);
+	// optionally returns the overall time spent in tasks (usecs).
+	bool exec(TaskProc pfnTask, void *pvArg, unsigned int iTasks,
+		unsigned long *piTaskTime = nullptr);
+
+	// Maximum number of tasks per batch.
+	static unsigned int maxTasks();
+
+protected:
+
+	// Worker thread process executive.
+	void run();
+
+	// Claim and run all pending tasks.
+	void process_tasks();
+
+	// Worker thread entry point.
+	static void *worker_thread(void *pvArg);
+
+private:
+
+	// Instance variables.
+	qtractorAudioEngine *m_pAudioEngine;
+
+	unsigned int m_iThreads;
+	jack_native_thread_t *m_pThreads;
+	unsigned int m_iThreadsRunning;
+
+	volatile bool m_bRunState;
+
+	// Current batch owner flag.
+	qtractorAtomic m_busy;
+
+	// Current batch task callback.
+	TaskProc m_pfnTask;
+	void    *m_pvArg;
+
+	// Lock-free task queue state (packed task count and next index).
+	qtractorAtomic m_state;
+	qtractorAtomic m_done;
+
+	// Current batch overall task time (usecs).
+	qtractorAtomic m_time;
+
+	// Worker wake-up and batch completion semaphores.
+	sem_t m_semWork;
+	sem_t m_semDone;
+};
+
+
+#endif  // __qtractorAudioGraph_h
+
+
+// end of qtractorAudioGraph.h
@@ -0,0 +1,401 @@
+// qtractorAudioPageCache.cpp
+//
+/****************************************************************************
+   Copyright (C) 2005-2025, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#include "qtractorAbout.h"
+#include "qtractorAudioPageCache.h"
+
+#include <QFileInfo>
+#include <QDateTime>
+
+#include <cstring>
+
+
+// Decoded page size in frames per channel.
+static const unsigned int c_iPageFrames = (32 * 1024);
+
+
+//----------------------------------------------------------------------
+// class qtractorAudioPageCache::Page -- Decoded audio page.
+//
+
+// Constructor.
+qtractorAudioPageCache::Page::Page ( const Key& key,
+	unsigned short iChannels, unsigned int iFrames )
+	: m_key(key), m_iChannels(iChannels), m_iSize(iFrames), m_iFrames(0)
+{
+	m_ppBuffers = new float * [m_iChannels];
+	for (unsigned short i = 0; i < m_iChannels; ++i)
+		m_ppBuffers[i] = new float [m_iSize];
+}
+
+
+// Destructor.
+qtractorAudioPageCache::Page::~Page (void)
+{
+	for (unsigned short i = 0; i < m_iChannels; ++i)
+		delete [] m_ppBuffers[i];
+	delete [] m_ppBuffers;
+}
+
+
+// Copy frames out of this page.
+unsigned int qtractorAudioPageCache::Page::copy ( unsigned int iOffset,
+	float **ppFrames, unsigned int iDestOffset, unsigned int iFrames ) const
+{
+	if (iOffset >= m_iFrames)
+		return 0;
+
+	if (iFrames > m_iFrames - iOffset)
+		iFrames = m_iFrames - iOffset;
+
+	for (unsigned short i = 0; i < m_iChannels; ++i) {
+		::memcpy(ppFrames[i] + iDestOffset,
+			m_ppBuffers[i] + iOffset, iFrames * sizeof(float));
+	}
+
+	return iFrames;
+}
+
+
+//----------------------------------------------------------------------
+// class qtractorAudioPageCache -- Shared decoded audio page cache (singleton).
+//
+
+// Singleton instance pointer.
+qtractorAudioPageCache *qtractorAudioPageCache::g_pPageCache = nullptr;
+
+// Singleton instance accessor (static).
+qtractorAudioPageCache *qtractorAudioPageCache::getInstance (void)
+{
+	return g_pPageCache;
+}
+
+
+// Constructor.
+qtractorAudioPageCache::qtractorAudioPageCache (void)
+	: m_iMaxSize(0), m_iSize(0),
+		m_iHits(0), m_iMisses(0), m_iEvictions(0)
+{
+	// Pseudo-singleton reference setup.
+	g_pPageCache = this;
+}
+
+
+// Default destructor.
+qtractorAudioPageCache::~qtractorAudioPageCache (void)
+{
+	clear();
+
+	// Pseudo-singleton reference shut-down.
+	g_pPageCache = nullptr;
+}
+
+
+// Page size (in frames per channel).
+unsigned int qtractorAudioPageCache::pageFrames (void)
+{
+	return c_iPageFrames;
+}
+
+
+// Memory budget (in bytes; zero means disabled).
+void qtractorAudioPageCache::setMaxSize ( unsigned long iMaxSize )
+{
+	QMutexLocker locker(&m_mutex);
+
+	m_iMaxSize = iMaxSize;
+
+	evict(m_iMaxSize);
+}
+
+unsigned long qtractorAudioPageCache::maxSize (void) const
+{
+	return m_iMaxSize;
+}
+
+
+// Read-through file wrapper factory-method.
+qtractorAudioFile *qtractorAudioPageCache::createPageFile (
+	qtractorAudioFile *pFile )
+{
+	if (pFile == nullptr || !isEnabled())
+		return pFile;
+
+	return new qtractorAudioPageFile(this, pFile);
+}
+
+
+// Cached page read-out; returns -1 on cache miss.
+int qtractorAudioPageCache::read ( const Key& key, unsigned int iOffset,
+	float **ppFrames, unsigned int iDestOffset, unsigned int iFrames )
+{
+	QMutexLocker locker(&m_mutex);
+
+	Page *pPage = m_hash.value(key, nullptr);
+	if (pPage == nullptr) {
+		++m_iMisses;
+		return -1;
+	}
+
+	++m_iHits;
+
+	// Most recently used goes last...
+	if (pPage != m_list.last()) {
+		m_list.unlink(pPage);
+		m_list.append(pPage);
+	}
+
+	return int(pPage->copy(iOffset, ppFrames, iDestOffset, iFrames));
+}
+
+
+// Newly decoded page insertion (takes ownership).
+void qtractorAudioPageCache::insert ( Page *pPage )
+{
+	QMutexLocker locker(&m_mutex);
+
+	// Someone else might have been faster, or
+	// simply won't fit in whatsoever...
+	const unsigned long iBytes = pPage->bytes();
+	if (m_hash.contains(pPage->key()) || iBytes > m_iMaxSize) {
+		delete pPage;
+		return;
+	}
+
+	evict(m_iMaxSize - iBytes);
+
+	m_hash.insert(pPage->key(), pPage);
+	m_list.append(pPage);
+
+	m_iSize += iBytes;
+}
+
+
+// Least-recently used page eviction (unlocked).
+void qtractorAudioPageCache::evict ( unsigned long iMaxSize )
+{
+	while (m_iSize > iMaxSize) {
+		Page *pPage = m_list.first();
+		if (pPage == nullptr)
+			break;
+		m_list.unlink(pPage);
+		m_hash.remove(pPage->key());
+		m_iSize -= pPage->bytes();
+		++m_iEvictions;
+		delete pPage;
+	}
+}
+
+
+// Cleanup method.
+void qtractorAudioPageCache::clear (void)
+{
+	QMutexLocker locker(&m_mutex);
+
+#ifdef CONFIG_DEBUG
+	if (m_iHits > 0 || m_iMisses > 0) {
+		qDebug("qtractorAudioPageCache[%p]::clear() "
+			"hits=%lu misses=%lu (%.1f%%) evictions=%lu pages=%d size=%luKB",
+			this, m_iHits, m_iMisses,
+			100.0f * float(m_iHits) / float(m_iHits + m_iMisses),
+			m_iEvictions, m_list.count(), m_iSize >> 10);
+	}
+#endif
+
+	evict(0);
+
+	m_hash.clear();
+
+	m_iSize = 0;
+
+	m_iHits = 0;
+	m_iMisses = 0;
+	m_iEvictions = 0;
+}
+
+
+//----------------------------------------------------------------------
+// class qtractorAudioPageFile -- Page cache read-through audio file.
+//
+
+// Constructor.
+qtractorAudioPageFile::qtractorAudioPageFile (
+	qtractorAudioPageCache *pPageCache, qtractorAudioFile *pFile )
+	: m_pPageCache(pPageCache), m_pFile(pFile),
+		m_iOffset(0), m_iDecodeOffset(0), m_ppFrames(nullptr)
+{
+}
+
+
+// Destructor.
+qtractorAudioPageFile::~qtractorAudioPageFile (void)
+{
+	if (m_ppFrames)
+		delete [] m_ppFrames;
+
+	delete m_pFile;
+}
+
+
+// Open method (read-only).
+bool qtractorAudioPageFile::open ( const QString& sFilename, int iMode )
+{
+	if (iMode != Read)
+		return false;
+
+	if (!m_pFile->open(sFilename, iMode))
+		return false;
+
+	// Cache key: absolute path, last modified time and size,
+	// so that pages of a rewritten (eg. re-recorded) file won't
+	// ever match the previous contents...
+	const QFileInfo info(sFilename);
+	m_sFileKey = info.absoluteFilePath()
+		+ ':' + QString::number(info.lastModified().toMSecsSinceEpoch())
+		+ ':' + QString::number(info.size());
+
+	// Page decoding frame pointers...
+	if (m_ppFrames)
+		delete [] m_ppFrames;
+	m_ppFrames = new float * [m_pFile->channels()];
+
+	m_iOffset = 0;
+	m_iDecodeOffset = 0;
+
+	return true;
+}
+
+
+// Read method (through the page cache).
+int qtractorAudioPageFile::read ( float **ppFrames, unsigned int iFrames )
+{
+	unsigned int nread = 0;
+
+	while (nread < iFrames) {
+		const unsigned long iPage = m_iOffset / c_iPageFrames;
+		const unsigned int iOffset = m_iOffset % c_iPageFrames;
+		const qtractorAudioPageCache::Key key(m_sFileKey, iPage);
+		int n = m_pPageCache->read(key, iOffset, ppFrames, nread, iFrames - nread);
+		if (n < 0)
+			n = readPage(iPage, iOffset, ppFrames, nread, iFrames - nread);
+		if (n < 1)
+			break;
+		m_iOffset += n;
+		nread += n;
+	}
+
+	return int(nread);
+}
+
+
+// Decode a whole page through the actual file (cache miss).
+int qtractorAudioPageFile::readPage ( unsigned long iPage, unsigned int iOffset,
+	float **ppFrames, unsigned int iDestOffset, unsigned int iFrames )
+{
+	const unsigned long iPageOffset = iPage * c_iPageFrames;
+	if (m_iDecodeOffset != iPageOffset) {
+		if (!m_pFile->seek(iPageOffset))
+			return 0;
+		m_iDecodeOffset = iPageOffset;
+	}
+
+	qtractorAudioPageCache::Page *pPage
+		= new qtractorAudioPageCache::Page(
+			qtractorAudioPageCache::Key(m_sFileKey, iPage),
+			m_pFile->channels(), c_iPageFrames);
+
+	// Decode as much as a whole page...
+	float **ppBuffers = pPage->buffers();
+	const unsigned short iChannels = pPage->channels();
+	unsigned int nread = 0;
+	while (nread < c_iPageFrames) {
+		for (unsigned short i = 0; i < iChannels; ++i)
+			m_ppFrames[i] = ppBuffers[i] + nread;
+		const int n = m_pFile->read(m_ppFrames, c_iPageFrames - nread);
+		if (n < 1)
+			break;
+		nread += n;
+	}
+
+	m_iDecodeOffset += nread;
+
+	if (nread < 1) {
+		delete pPage;
+		return 0;
+	}
+
+	pPage->setFrames(nread);
+
+	const unsigned int ncopy = pPage->copy(iOffset, ppFrames, iDestOffset, iFrames);
+
+	// Share it with everybody else...
+	m_pPageCache->insert(pPage);
+
+	return int(ncopy);
+}
+
+
+// Write method (not applicable).
+int qtractorAudioPageFile::write ( float **/*ppFrames*/, unsigned int /*iFrames*/ )
+{
+	return 0;
+}
+
+
+// Seek method (deferred to next read).
+bool qtractorAudioPageFile::seek ( unsigned long iOffset )
+{
+	m_iOffset = iOffset;
+
+	return true;
+}
+
+
+// Close method.
+void qtractorAudioPageFile::close (void)
+{
+	m_pFile->close();
+}
+
+
+// Accessors (delegated).
+int qtractorAudioPageFile::mode (void) const
+{
+	return m_pFile->mode();
+}
+
+unsigned short qtractorAudioPageFile::channels (void) const
+{
+	return m_pFile->channels();
+}
+
+unsigned long qtractorAudioPageFile::frames (void) const
+{
+	return m_pFile->frames();
+}
+
+unsigned int qtractorAudioPageFile::sampleRate (void) const
+{
+	return m_pFile->sampleRate();
+}
+
+
+// end of qtractorAudioPageCache.cpp
@@ -0,0 +1,215 @@
+// qtractorAudioPageCache.h
+//
+/****************************************************************************
+   Copyright (C) 2005-2025, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#ifndef __qtractorAudioPageCache_h
+#define __qtractorAudioPageCache_h
+
+#include "qtractorAudioFile.h"
+#include "qtractorList.h"
+
+#include <QPair>
+#include <QMutex>
+
+
+//----------------------------------------------------------------------
+// class qtractorAudioPageCache -- Shared decoded audio page cache (singleton).
+//
+
+class qtractorAudioPageCache
+{
+public:
+
+	// Constructor.
+	qtractorAudioPageCache();
+	// Default destructor.
+	~qtractorAudioPageCache();
+
+	// Page key: audio filename and page index.
+	typedef QPair<QString, unsigned long> Key;
+
+	// Decoded audio page (planar, native sample-rate).
+	class Page : public qtractorList<Page>::Link
+	{
+	public:
+
+		// Constructor.
+		Page(const Key& key, unsigned short iChannels, unsigned int iFrames);
+		// Destructor.
+		~Page();
+
+		// Accessors.
+		const Key& key() const
+			{ return m_key; }
+		unsigned short channels() const
+			{ return m_iChannels; }
+		unsigned int size() const
+			{ return m_iSize; }
+
+		// Number of valid frames.
+		void setFrames(unsigned int iFrames)
+			{ m_iFrames = iFrames; }
+		unsigned int frames() const
+			{ return m_iFrames; }
+
+		// Channel buffer accessors.
+		float **buffers() const
+			{ return m_ppBuffers; }
+
+		// Copy frames out of this page.
+		unsigned int copy(unsigned int iOffset, float **ppFrames,
+			unsigned int iDestOffset, unsigned int iFrames) const;
+
+		// Memory footprint (in bytes).
+		unsigned long bytes() const
+			{ return (unsigned long) m_iChannels * m_iSize * sizeof(float); }
+
+	private:
+
+		// Instance variables.
+		Key            m_key;
+		unsigned short m_iChannels;
+		unsigned int   m_iSize;
+		unsigned int   m_iFrames;
+		float        **m_ppBuffers;
+	};
+
+	// Page size (in frames per channel).
+	static unsigned int pageFrames();
+
+	// Memory budget (in bytes; zero means disabled).
+	void setMaxSize(unsigned long iMaxSize);
+	unsigned long maxSize() const;
+
+	bool isEnabled() const
+		{ return (m_iMaxSize > 0); }
+
+	// Read-through file wrapper factory-method
+	// (takes ownership of the given file decoder).
+	qtractorAudioFile *createPageFile(qtractorAudioFile *pFile);
+
+	// Cached page read-out; returns -1 on cache miss.
+	int read(const Key& key, unsigned int iOffset, float **ppFrames,
+		unsigned int iDestOffset, unsigned int iFrames);
+
+	// Newly decoded page insertion (takes ownership).
+	void insert(Page *pPage);
+
+	// Hit/miss statistics.
+	unsigned long hits() const
+		{ return m_iHits; }
+	unsigned long misses() const
+		{ return m_iMisses; }
+	unsigned long evictions() const
+		{ return m_iEvictions; }
+
+	// Current memory usage (in bytes).
+	unsigned long size() const
+		{ return m_iSize; }
+
+	// Cleanup method.
+	void clear();
+
+	// Singleton instance accessor.
+	static qtractorAudioPageCache *getInstance();
+
+protected:
+
+	// Least-recently used page eviction (unlocked).
+	void evict(unsigned long iMaxSize);
+
+private:
+
+	// Cache mutex.
+	QMutex m_mutex;
+
+	// Page look-up table and LRU list (most recent last).
+	QHash<Key, Page *>  m_hash;
+	qtractorList<Page>  m_list;
+
+	// Memory budget and usage.
+	unsigned long m_iMaxSize;
+	unsigned long m_iSize;
+
+	// Statistics.
+	unsigned long m_iHits;
+	unsigned long m_iMisses;
+	unsigned long m_iEvictions;
+
+	// The pseudo-singleton instance.
+	static qtractorAudioPageCache *g_pPageCache;
+};
+
+
+//----------------------------------------------------------------------
+// class qtractorAudioPageFile -- Page cache read-through audio file.
+//
+
+class qtractorAudioPageFile : public qtractorAudioFile
+{
+public:
+
+	// Constructor.
+	qtractorAudioPageFile(qtractorAudioPageCache *pPageCache,
+		qtractorAudioFile *pFile);
+
+	// Destructor.
+	~qtractorAudioPageFile();
+
+	// Virtual method mockups.
+	bool open  (const QString& sFilename, int iMode = Read);
+	int  read  (float **ppFrames, unsigned int iFrames);
+	int  write (float **ppFrames, unsigned int iFrames);
+	bool seek  (unsigned long iOffset);
+	void close ();
+
+	// Virtual accessor mockups.
+	int mode() const;
+	unsigned short channels() const;
+	unsigned long frames() const;
+	unsigned int sampleRate() const;
+
+protected:
+
+	// Decode a whole page through the actual file (cache miss).
+	int readPage(unsigned long iPage, unsigned int iOffset,
+		float **ppFrames, unsigned int iDestOffset, unsigned int iFrames);
+
+private:
+
+	// Instance variables.
+	qtractorAudioPageCache *m_pPageCache;
+	qtractorAudioFile *m_pFile;
+
+	QString m_sFileKey;
+
+	// Logical and actual decoder positions.
+	unsigned long m_iOffset;
+	unsigned long m_iDecodeOffset;
+
+	// Page decoding frame pointers.
+	float **m_ppFrames;
+};
+
+
+#endif  // __qtractorAudioPageCache_h
+
+
+// end of qtractorAudioPageCache.h
@@ -50,155 +50,193 @@ static const unsigned int c_iAudioFrames = (32 * 1024);
 static const unsigned int c_iPeakFrames = (8 * 1024);
 
 // Default peak period as a digest representation in frames per channel.
-static const unsigned short c_iPeakPeriod = 1024;
+static const unsigned short c_iPeakPeriod = 64;
+
+// Number of (mipmap) peak levels, each one coarser by a factor of 4,
+// ie. 64, 256, 1024, 4096 and 16384 frames per peak, by default.
+static const unsigned short c_iPeakLevels = 5;
+static const unsigned short c_iPeakLevelShift = 2;
+
+// Peak file header magic (multi-level format).
+static const char c_szPeakMagic[4] = { 'Q', 'T', 'P', 'K' };
 
 // Default peak filename extension.
 static const QString c_sPeakFileExt = ".peak";
 
 
 //----------------------------------------------------------------------
-// class qtractorAudioPeakThread -- Audio Peak file thread.
+// class qtractorAudioPeakQueue -- Audio Peak file creation queue.
 //
 
-class qtractorAudioPeakThread : public QThread
+class qtractorAudioPeakQueue
 {
 public:
 
 	// Constructor.
-	qtractorAudioPeakThread(unsigned int iSyncSize = 128);
-	// Destructor.
-	~qtractorAudioPeakThread();
+	qtractorAudioPeakQueue();
 
-	// Thread run state accessors.
+	// Queue run state accessors.
 	void setRunState(bool bRunState);
 	bool runState() const;
 
-	// Wake from executive wait condition.
-	void sync(qtractorAudioPeakFile *pPeakFile = nullptr);
-
-protected:
-
-	// The main thread executive.
-	void run();
+	// Enqueue a peak file for creation;
+	// priority ones (eg. visible) go first.
+	void push(qtractorAudioPeakFile *pPeakFile, bool bPriority);
 
-	// Actual peak file creation methods.
-	// (this is just about to be used internally)
-	bool openPeakFile();
-	bool writePeakFile();
-	void closePeakFile();
+	// Dequeue next peak file for creation (blocking).
+	qtractorAudioPeakFile *pop();
 
-	void notifyPeakEvent() const;
+	// Abort all pending peak files.
+	void clear();
 
 private:
 
-	// The peak file queue instance reference.
-	unsigned int            m_iSyncSize;
-	unsigned int            m_iSyncMask;
-	qtractorAudioPeakFile **m_ppSyncItems;
-
-	volatile unsigned int   m_iSyncRead;
-	volatile unsigned int   m_iSyncWrite;
+	// Pending peak files, priority ones first.
+	QList<qtractorAudioPeakFile *> m_items;
+	int m_iPriority;
 
-	// Whether the thread is logically running.
+	// Whether the queue is logically running.
 	volatile bool m_bRunState;
 
-	// Thread synchronization objects.
+	// Queue synchronization objects.
 	QMutex m_mutex;
 	QWaitCondition m_cond;
-
-	// Current audio peak file instance.
-	qtractorAudioPeakFile *m_pPeakFile;
-
-	// Current audio file instance.
-	qtractorAudioFile *m_pAudioFile;
-
-	// Current audio file buffer.
-	float **m_ppAudioFrames;
 };
 
 
 // Constructor.
-qtractorAudioPeakThread::qtractorAudioPeakThread ( unsigned int iSyncSize )
+qtractorAudioPeakQueue::qtractorAudioPeakQueue (void)
+	: m_iPriority(0), m_bRunState(false)
 {
-	m_iSyncSize = (64 << 1);
-	while (m_iSyncSize < iSyncSize)
-		m_iSyncSize <<= 1;
-	m_iSyncMask = (m_iSyncSize - 1);
-	m_ppSyncItems = new qtractorAudioPeakFile * [m_iSyncSize];
-	m_iSyncRead   = 0;
-	m_iSyncWrite  = 0;
+}
 
-	::memset(m_ppSyncItems, 0, m_iSyncSize * sizeof(qtractorAudioPeakFile *));
 
-	m_bRunState = false;
+// Queue run state accessors.
+void qtractorAudioPeakQueue::setRunState ( bool bRunState )
+{
+	QMutexLocker locker(&m_mutex);
+
+	m_bRunState = bRunState;
 
-	m_pPeakFile  = nullptr;
-	m_pAudioFile = nullptr;
-	m_ppAudioFrames = nullptr;
+	if (!m_bRunState)
+		m_cond.wakeAll();
+}
+
+bool qtractorAudioPeakQueue::runState (void) const
+{
+	return m_bRunState;
 }
 
 
-// Destructor.
-qtractorAudioPeakThread::~qtractorAudioPeakThread (void)
+// Enqueue a peak file for creation.
+void qtractorAudioPeakQueue::push (
+	qtractorAudioPeakFile *pPeakFile, bool bPriority )
 {
-	delete [] m_ppSyncItems;
+	QMutexLocker locker(&m_mutex);
+
+	if (pPeakFile->isWaitSync()) {
+		// Already pending? promote it, if so...
+		if (bPriority) {
+			const int i = m_items.indexOf(pPeakFile);
+			if (i >= m_iPriority)
+				m_items.move(i, m_iPriority++);
+		}
+		return;
+	}
+
+	pPeakFile->setWaitSync(true);
+
+	if (bPriority)
+		m_items.insert(m_iPriority++, pPeakFile);
+	else
+		m_items.append(pPeakFile);
+
+	m_cond.wakeOne();
 }
 
 
-// Run state accessor.
-void qtractorAudioPeakThread::setRunState ( bool bRunState )
+// Dequeue next peak file for creation (blocking).
+qtractorAudioPeakFile *qtractorAudioPeakQueue::pop (void)
 {
-//	QMutexLocker locker(&m_mutex);
+	QMutexLocker locker(&m_mutex);
 
-	m_bRunState = bRunState;
+	while (m_bRunState) {
+		if (m_items.isEmpty()) {
+			m_cond.wait(&m_mutex);
+			continue;
+		}
+		qtractorAudioPeakFile *pPeakFile = m_items.takeFirst();
+		if (m_iPriority > 0)
+			--m_iPriority;
+		if (pPeakFile->isWaitSync())
+			return pPeakFile;
+	}
+
+	return nullptr;
 }
 
-bool qtractorAudioPeakThread::runState (void) const
+
+// Abort all pending peak files.
+void qtractorAudioPeakQueue::clear (void)
 {
-	return m_bRunState;
+	QMutexLocker locker(&m_mutex);
+
+	QListIterator<qtractorAudioPeakFile *> iter(m_items);
+	while (iter.hasNext())
+		iter.next()->setWaitSync(false);
+
+	m_items.clear();
+	m_iPriority = 0;
 }
 
 
-// Wake from executive wait condition.
-void qtractorAudioPeakThread::sync ( qtractorAudioPeakFile *pPeakFile )
+//----------------------------------------------------------------------
+// class qtractorAudioPeakThread -- Audio Peak file thread.
+//
+
+class qtractorAudioPeakThread : public QThread
 {
-	if (pPeakFile == nullptr) {
-		unsigned int r = m_iSyncRead;
-		unsigned int w = m_iSyncWrite;
-		while (r != w) {
-			qtractorAudioPeakFile *pSyncItem = m_ppSyncItems[r];
-			if (pSyncItem)
-				pSyncItem->setWaitSync(false);
-			++r &= m_iSyncMask;
-			w = m_iSyncWrite;
-		}
-	//	m_iSyncRead = r;
-	} else {
-		// !pPeakFile->isWaitSync()
-		unsigned int n;
-		unsigned int r = m_iSyncRead;
-		unsigned int w = m_iSyncWrite;
-		if (w > r) {
-			n = ((r - w + m_iSyncSize) & m_iSyncMask) - 1;
-		} else if (r > w) {
-			n = (r - w) - 1;
-		} else {
-			n = m_iSyncSize - 1;
-		}
-		if (n > 0) {
-			pPeakFile->setWaitSync(true);
-			m_ppSyncItems[w] = pPeakFile;
-			m_iSyncWrite = (w + 1) & m_iSyncMask;
-		}
-	}
+public:
 
-	if (m_mutex.tryLock()) {
-		m_cond.wakeAll();
-		m_mutex.unlock();
-	}
-#ifdef CONFIG_DEBUG_0
-	else qDebug("qtractorAudioPeakThread[%p]::sync(): tryLock() failed.", this);
-#endif
+	// Constructor.
+	qtractorAudioPeakThread(qtractorAudioPeakQueue *pPeakQueue);
+
+protected:
+
+	// The main thread executive.
+	void run();
+
+	// Actual peak file creation methods.
+	// (this is just about to be used internally)
+	bool openPeakFile();
+	bool writePeakFile();
+	void closePeakFile();
+
+	void notifyPeakEvent() const;
+
+private:
+
+	// The (shared) peak file queue reference.
+	qtractorAudioPeakQueue *m_pPeakQueue;
+
+	// Current audio peak file instance.
+	qtractorAudioPeakFile *m_pPeakFile;
+
+	// Current audio file instance (own decoder).
+	qtractorAudioFile *m_pAudioFile;
+
+	// Current audio file buffer.
+	float **m_ppAudioFrames;
+};
+
+
+// Constructor.
+qtractorAudioPeakThread::qtractorAudioPeakThread (
+	qtractorAudioPeakQueue *pPeakQueue ) : m_pPeakQueue(pPeakQueue)
+{
+	m_pPeakFile  = nullptr;
+	m_pAudioFile = nullptr;
+	m_ppAudioFrames = nullptr;
 }
 
 
@@ -209,42 +247,20 @@ void qtractorAudioPeakThread::run (void)
 	qDebug("qtractorAudioPeakThread[%p]::run(): started...", this);
 #endif
 
-	m_mutex.lock();
-
-	m_bRunState = true;
-
-	while (m_bRunState) {
-		// Do whatever we must, then wait for more...
-		unsigned int r = m_iSyncRead;
-		unsigned int w = m_iSyncWrite;
-		while (m_bRunState && r != w) {
-			m_pPeakFile = m_ppSyncItems[r];
-			if (m_pPeakFile && m_pPeakFile->isWaitSync()) {
-				if (openPeakFile()) {
-					// Go ahead with the whole bunch...
-					while (writePeakFile());
-					// We're done.
-					closePeakFile();
-				}
-				m_pPeakFile->setWaitSync(false);
-				m_pPeakFile = nullptr;
-			}
-			m_ppSyncItems[r] = nullptr;
-			++r &= m_iSyncMask;
-			w = m_iSyncWrite;
-		}
-		m_iSyncRead = r;
-		// Are we still in the game?
-		if (m_bRunState) {
-			// Send notification event, anyway...
-			notifyPeakEvent();
-			// Wait for sync...
-			m_cond.wait(&m_mutex);
+	// Do whatever we must, while waiting for more...
+	while ((m_pPeakFile = m_pPeakQueue->pop()) != nullptr) {
+		if (openPeakFile()) {
+			// Go ahead with the whole bunch...
+			while (writePeakFile());
+			// We're done.
+			closePeakFile();
 		}
+		m_pPeakFile->setWaitSync(false);
+		m_pPeakFile = nullptr;
+		// Send notification event, anyway...
+		notifyPeakEvent();
 	}
 
-	m_mutex.unlock();
-
 #ifdef CONFIG_DEBUG_0
 	qDebug("qtractorAudioPeakThread[%p]::run(): stopped.\n", this);
 #endif
@@ -294,7 +310,7 @@ bool qtractorAudioPeakThread::openPeakFile (void)
 // Create the peak file chunk.
 bool qtractorAudioPeakThread::writePeakFile (void)
 {
-	if (!m_bRunState)
+	if (!m_pPeakQueue->runState())
 		return false;
 
 	if (m_ppAudioFrames == nullptr)
@@ -323,6 +339,10 @@ void qtractorAudioPeakThread::closePeakFile (void)
 	// Always force target file close.
 	m_pPeakFile->closeWrite();
 
+	// Never leave an incomplete peak file behind...
+	if (!m_pPeakQueue->runState())
+		m_pPeakFile->remove();
+
 	// Get rid of physical used stuff.
 	if (m_ppAudioFrames) {
 		const unsigned short iChannels = m_pAudioFile->channels();
@@ -337,16 +357,13 @@ void qtractorAudioPeakThread::closePeakFile (void)
 		delete m_pAudioFile;
 		m_pAudioFile = nullptr;
 	}
-
-	// Send notification event, someway...
-	notifyPeakEvent();
 }
 
 
 // Send notification event, someway...
 void qtractorAudioPeakThread::notifyPeakEvent (void) const
 {
-	if (!m_bRunState)
+	if (!m_pPeakQueue->runState())
 		return;
 
 	qtractorAudioPeakFactory *pPeakFactory
@@ -370,13 +387,16 @@ qtractorAudioPeakFile::qtractorAudioPeakFile (
 
 	m_openMode = None;
 
-	m_peakHeader.period   = 0;
-	m_peakHeader.channels = 0;
+	::memset(&m_peakHeader, 0, sizeof(Header));
 
 	m_pBuffer      = nullptr;
 	m_iBuffSize    = 0;
 	m_iBuffLength  = 0;
 	m_iBuffOffset  = 0;
+	m_iBuffLevel   = 0;
+
+	m_pMap     = nullptr;
+	m_iMapSize = 0;
 
 	m_bWaitSync = false;
 
@@ -409,6 +429,18 @@ qtractorAudioPeakFile::~qtractorAudioPeakFile (void)
 }
 
 
+// Whether the peak file is missing or older than its audio file.
+bool qtractorAudioPeakFile::isOutdated (void) const
+{
+	// Need some preliminary file information...
+	const QFileInfo fileInfo(m_sFilename);
+	const QFileInfo peakInfo(m_peakFile.fileName());
+
+	return (!peakInfo.exists() || peakInfo.birthTime() < fileInfo.birthTime());
+	//	|| peakInfo.lastModified() < fileInfo.lastModified());
+}
+
+
 // Open an existing peak file cache.
 bool qtractorAudioPeakFile::openRead (void)
 {
@@ -417,16 +449,18 @@ bool qtractorAudioPeakFile::openRead (void)
 		return true;
 
 	// Are we still waiting for its creation?
-	if (m_bWaitSync)
+	// (promote it as visible, anyway)
+	if (m_bWaitSync) {
+		qtractorAudioPeakFactory *pPeakFactory
+			= qtractorAudioPeakFactory::getInstance();
+		if (pPeakFactory)
+			pPeakFactory->sync(this);
 		return false;
+	}
 
-	// Need some preliminary file information...
-	QFileInfo fileInfo(m_sFilename);
-	QFileInfo peakInfo(m_peakFile.fileName());
 	// Have we a peak file up-to-date,
 	// or must the peak file be (re)created?
-	if (!peakInfo.exists() || peakInfo.birthTime() < fileInfo.birthTime()) {
-	//	|| peakInfo.lastModified() < fileInfo.lastModified()) {
+	if (isOutdated()) {
 		qtractorAudioPeakFactory *pPeakFactory
 			= qtractorAudioPeakFactory::getInstance();
 		if (pPeakFactory)
@@ -442,15 +476,34 @@ bool qtractorAudioPeakFile::openRead (void)
 	if (!m_peakFile.open(QIODevice::ReadOnly))
 		return false;
 
+	// Old single-level or incomplete peak files
+	// are just discarded and (re)created anew...
 	if (m_peakFile.read((char *) &m_peakHeader, sizeof(Header))
-			!= qint64(sizeof(Header))) {
+			!= qint64(sizeof(Header))
+		|| ::memcmp(m_peakHeader.magic, c_szPeakMagic, sizeof(c_szPeakMagic))
+		|| m_peakHeader.levels < 1 || m_peakHeader.levels > MaxLevels
+		|| m_peakHeader.period < 1 || m_peakHeader.channels < 1) {
 		m_peakFile.close();
+		m_peakFile.remove();
+		::memset(&m_peakHeader, 0, sizeof(Header));
+		locker.unlock();
+		qtractorAudioPeakFactory *pPeakFactory
+			= qtractorAudioPeakFactory::getInstance();
+		if (pPeakFactory)
+			pPeakFactory->sync(this);
 		return false;
 	}
 
 	// Set open mode...
 	m_openMode = Read;
 
+	// Try mapping the whole file, read-only; otherwise
+	// fallback to (buffered) reads on demand...
+	const qint64 iMapSize = m_peakFile.size();
+	m_pMap = m_peakFile.map(0, iMapSize);
+	if (m_pMap)
+		m_iMapSize = iMapSize;
+
 #ifdef CONFIG_DEBUG_0
 	qDebug("qtractorAudioPeakFile[%p]::openRead() ---", this);
 	qDebug("name        = %s", m_peakFile.fileName().toUtf8().constData());
@@ -460,6 +513,8 @@ bool qtractorAudioPeakFile::openRead (void)
 	qDebug("frame       = %lu", sizeof(Frame));
 	qDebug("period      = %d", m_peakHeader.period);
 	qDebug("channels    = %d", m_peakHeader.channels);
+	qDebug("levels      = %u", m_peakHeader.levels);
+	qDebug("mapped      = %d", int(m_pMap != nullptr));
 	qDebug("---");
 #endif
 
@@ -476,6 +531,11 @@ void qtractorAudioPeakFile::closeRead (void)
 
 	// Close file.
 	if (m_openMode == Read) {
+		if (m_pMap) {
+			m_peakFile.unmap(m_pMap);
+			m_pMap = nullptr;
+			m_iMapSize = 0;
+		}
 		m_peakFile.close();
 		m_openMode = None;
 	}
@@ -487,6 +547,7 @@ void qtractorAudioPeakFile::closeRead (void)
 	m_iBuffSize   = 0;
 	m_iBuffLength = 0;
 	m_iBuffOffset = 0;
+	m_iBuffLevel  = 0;
 }
 
 
@@ -524,25 +585,109 @@ unsigned short qtractorAudioPeakFile::channels (void)
 	return m_peakHeader.channels;
 }
 
+unsigned short qtractorAudioPeakFile::levels (void)
+{
+	return m_peakHeader.levels;
+}
 
-// Read frames from peak file.
-qtractorAudioPeakFile::Frame *qtractorAudioPeakFile::read (
-	unsigned long iPeakOffset, unsigned int iPeakLength )
+
+// Read frames from peak file: the source frames are either copied
+// or aggregated (max over each group) into the given frame buffer,
+// all while the peak file lock is held, as the memory-map and the
+// local buffer cache may be unmapped or reallocated by the peak
+// creation threads anytime after.
+unsigned int qtractorAudioPeakFile::read (
+	Frame *pFrames, unsigned int iFrames,
+	unsigned short iPeakLevel, unsigned long iPeakOffset,
+	unsigned int iPeakLength )
 {
 	// Must be open for something...
 	if (m_openMode == None)
-		return nullptr;
+		return 0;
+
+	const unsigned short iChannels = m_peakHeader.channels;
+	if (iChannels < 1 || iFrames < 1 || iPeakLength < 1)
+		return 0;
 
 	// Make things critical...
 	QMutexLocker locker(&m_mutex);
 
+	const Frame *pPeakFrames = readFrames(iPeakLevel, iPeakOffset, iPeakLength);
+	if (pPeakFrames == nullptr)
+		return 0;
+
+	// Direct-copy...
+	const int n1 = iChannels * iPeakLength;
+	if (iFrames >= iPeakLength) {
+		::memcpy(pFrames, pPeakFrames, n1 * sizeof(Frame));
+		return iPeakLength;
+	}
+
+	// Aggregate...
+	const int n2 = iChannels * iFrames;
+	int n = 0; int i = 0;
+	while (n < n2) {
+		const int i2 = ((n + iChannels) * n1) / n2;
+		for (unsigned short k = 0; k < iChannels; ++k) {
+			Frame *pNewFrame = &pFrames[n + k];
+			pNewFrame->max = 0;
+			pNewFrame->min = 0;
+			pNewFrame->rms = 0;
+			for (int j = i; j < i2; j += iChannels) {
+				const Frame *pOldFrame = &pPeakFrames[j + k];
+				if (pNewFrame->max < pOldFrame->max)
+					pNewFrame->max = pOldFrame->max;
+				if (pNewFrame->min < pOldFrame->min)
+					pNewFrame->min = pOldFrame->min;
+				if (pNewFrame->rms < pOldFrame->rms)
+					pNewFrame->rms = pOldFrame->rms;
+			}
+		}
+		n += iChannels;
+		i = i2;
+	}
+
+	return n / iChannels;
+}
+
+
+// Read frames from peak file (mutex must be held).
+qtractorAudioPeakFile::Frame *qtractorAudioPeakFile::readFrames (
+	unsigned short iPeakLevel, unsigned long iPeakOffset, unsigned int iPeakLength )
+{
+	if (iPeakLevel >= m_peakHeader.levels)
+		return nullptr;
+
 #ifdef CONFIG_DEBUG_0
-	qDebug("qtractorAudioPeakFile[%p]::read(%lu, %u) [%lu, %u, %u]", this,
-		iPeakOffset, iPeakLength, m_iBuffOffset, m_iBuffLength, m_iBuffSize);
+	qDebug("qtractorAudioPeakFile[%p]::readFrames(%u, %lu, %u) [%u, %lu, %u, %u]",
+		this, iPeakLevel, iPeakOffset, iPeakLength,
+		m_iBuffLevel, m_iBuffOffset, m_iBuffLength, m_iBuffSize);
 #endif
 
-	// Cache effect, only valid if we're really reading...
+	// Where the requested level starts...
+	const unsigned int nsize = m_peakHeader.channels * sizeof(Frame);
+	unsigned long iLevelOffset = 0;
+	for (unsigned short i = 0; i < iPeakLevel; ++i)
+		iLevelOffset += m_peakHeader.length[i];
+
+	// Straight from the map, whenever mapped and within range...
 	const unsigned long iPeakEnd = iPeakOffset + iPeakLength;
+	if (m_pMap && iPeakEnd <= m_peakHeader.length[iPeakLevel]) {
+		const qint64 iOffset = sizeof(Header) + (iLevelOffset + iPeakOffset) * nsize;
+		if (iOffset + qint64(iPeakLength * nsize) <= m_iMapSize) {
+			g_iMapBytes.fetch_add(iPeakLength * nsize, std::memory_order_relaxed);
+			return (Frame *) (m_pMap + iOffset);
+		}
+	}
+
+	// Switching levels invalidates the whole cache...
+	if (m_iBuffLevel != iPeakLevel) {
+		m_iBuffLevel  = iPeakLevel;
+		m_iBuffLength = 0;
+		m_iBuffOffset = 0;
+	}
+
+	// Cache effect, only valid if we're really reading...
 	if (iPeakOffset >= m_iBuffOffset && m_iBuffOffset < iPeakEnd) {
 		const unsigned long iBuffEnd = m_iBuffOffset + m_iBuffLength;
 		const unsigned long iBuffOffset
@@ -587,14 +732,32 @@ unsigned int qtractorAudioPeakFile::readBuffer (
 		m_iBuffOffset, m_iBuffLength, m_iBuffSize);
 #endif
 
+	// Where the current level starts and ends...
+	unsigned long iLevelOffset = 0;
+	for (unsigned short i = 0; i < m_iBuffLevel; ++i)
+		iLevelOffset += m_peakHeader.length[i];
+	const unsigned long iLevelLength = m_peakHeader.length[m_iBuffLevel];
+
 	// Grab new contents from peak file...
 	char *pBuffer = (char *) (m_pBuffer + m_peakHeader.channels * iBuffOffset);
-	const unsigned long iOffset	= iPeakOffset * nsize;
+	const unsigned long iOffset	= (iLevelOffset + iPeakOffset) * nsize;
 	const unsigned int iLength  = iPeakLength * nsize;
 
+	// Never read beyond the current level...
+	unsigned int iLength2 = 0;
+	if (iPeakOffset < iLevelLength) {
+		iLength2 = iLength;
+		if (iPeakOffset + iPeakLength > iLevelLength)
+			iLength2 = (iLevelLength - iPeakOffset) * nsize;
+	}
+
 	int nread = 0;
-	if (m_peakFile.seek(sizeof(Header) + iOffset))
-		nread = int(m_peakFile.read(&pBuffer[0], iLength));
+	if (iLength2 > 0 && m_peakFile.seek(sizeof(Header) + iOffset))
+		nread = int(m_peakFile.read(&pBuffer[0], iLength2));
+	if (nread < 0)
+		nread = 0;
+
+	g_iReadBytes.fetch_add(nread, std::memory_order_relaxed);
 
 	// Zero the remaining...
 	if (nread < int(iLength))
@@ -623,6 +786,11 @@ bool qtractorAudioPeakFile::openWrite (
 
 	// We'll force (re)open if already reading (duh?)
 	if (m_openMode == Read) {
+		if (m_pMap) {
+			m_peakFile.unmap(m_pMap);
+			m_pMap = nullptr;
+			m_iMapSize = 0;
+		}
 		m_peakFile.close();
 		m_openMode = None;
 	}
@@ -634,11 +802,13 @@ bool qtractorAudioPeakFile::openWrite (
 	// Set open mode...
 	m_openMode = Write;
 
-	// Initialize header...
+	// Initialize header (levels are only known on close)...
+	::memset(&m_peakHeader, 0, sizeof(Header));
+	::memcpy(m_peakHeader.magic, c_szPeakMagic, sizeof(c_szPeakMagic));
 	m_peakHeader.period   = pPeakFactory->peakPeriod();
 	m_peakHeader.channels = iChannels;
 
-	// Write peak file header.
+	// Write peak file header (placeholder).
 	if (m_peakFile.write((const char *) &m_peakHeader, sizeof(Header))
 			!= qint64(sizeof(Header))) {
 		m_peakFile.close();
@@ -650,8 +820,8 @@ bool qtractorAudioPeakFile::openWrite (
 	qDebug("name        = %s", m_peakFile.fileName().toUtf8().constData());
 	qDebug("filename    = %s", m_sFilename.toUtf8().constData());
 	qDebug("timeStretch = %g", m_fTimeStretch);
-	qDebug("header      = %u", sizeof(Header));
-	qDebug("frame       = %u", sizeof(Frame));
+	qDebug("header      = %lu", sizeof(Header));
+	qDebug("frame       = %lu", sizeof(Frame));
 	qDebug("period      = %d", m_peakHeader.period);
 	qDebug("channels    = %d", m_peakHeader.channels);
 	qDebug("---");
@@ -668,6 +838,18 @@ bool qtractorAudioPeakFile::openWrite (
 	for (unsigned short i = 0; i < m_peakHeader.channels; ++i)
 		m_pWriter->amax[i] = m_pWriter->amin[i] = m_pWriter->arms[i] = 0.0f;
 
+	// Upper (mipmap) peak level accumulators...
+	for (unsigned short j = 1; j < c_iPeakLevels; ++j) {
+		Writer::Level& level = m_pWriter->levels[j];
+		level.amax = new float [m_peakHeader.channels];
+		level.amin = new float [m_peakHeader.channels];
+		level.arms = new float [m_peakHeader.channels];
+		for (unsigned short i = 0; i < m_peakHeader.channels; ++i)
+			level.amax[i] = level.amin[i] = level.arms[i] = 0.0f;
+		level.npeak = 0;
+		level.nfeed = 0;
+	}
+
 	// Get resample/timestretch-aware internal peak period ratio...
 	m_pWriter->period_p = iSampleRate;
 	qtractorAudioEngine *pAudioEngine = nullptr;
@@ -707,13 +889,43 @@ void qtractorAudioPeakFile::closeWrite (void)
 
 	// Flush and close...
 	if (m_openMode == Write) {
-		if (m_pWriter && m_pWriter->npeak > 0)
-			writeFrame();
+		if (m_pWriter) {
+			if (m_pWriter->npeak > 0)
+				writeFrame();
+			unsigned short j;
+			// Flush all upper levels, in order...
+			for (j = 1; j < c_iPeakLevels; ++j) {
+				if (m_pWriter->levels[j].nfeed > 0)
+					writeLevel(j);
+			}
+			// Append all upper levels, in order...
+			const unsigned int nsize = m_peakHeader.channels * sizeof(Frame);
+			m_peakHeader.length[0] = m_pWriter->offset / nsize;
+			qint64 iOffset = sizeof(Header) + m_pWriter->offset;
+			for (j = 1; j < c_iPeakLevels; ++j) {
+				const QByteArray& frames = m_pWriter->levels[j].frames;
+				if (!m_peakFile.seek(iOffset)
+					|| m_peakFile.write(frames) != qint64(frames.size()))
+					break;
+				m_peakHeader.length[j] = frames.size() / nsize;
+				iOffset += frames.size();
+			}
+			// Rewrite the final peak file header...
+			m_peakHeader.levels = j;
+			if (m_peakFile.seek(0))
+				m_peakFile.write((const char *) &m_peakHeader, sizeof(Header));
+		}
 		m_peakFile.close();
 		m_openMode = None;
 	}
 
 	if (m_pWriter) {
+		for (unsigned short j = 1; j < c_iPeakLevels; ++j) {
+			Writer::Level& level = m_pWriter->levels[j];
+			delete [] level.amax;
+			delete [] level.amin;
+			delete [] level.arms;
+		}
 		delete [] m_pWriter->amax;
 		delete [] m_pWriter->amin;
 		delete [] m_pWriter->arms;
@@ -785,6 +997,12 @@ void qtractorAudioPeakFile::writeFrame (void)
 	if (!m_peakFile.seek(sizeof(Header) + m_pWriter->offset))
 		return;
 
+	// Feed the next upper level first...
+	if (c_iPeakLevels > 1) {
+		feedLevel(1, m_pWriter->amax, m_pWriter->amin, m_pWriter->arms,
+			m_pWriter->npeak);
+	}
+
 	Frame frame;
 	for (unsigned short k = 0; k < m_peakHeader.channels; ++k) {
 		// Write the denormalized peak values...
@@ -802,6 +1020,77 @@ void qtractorAudioPeakFile::writeFrame (void)
 }
 
 
+// Accumulate lower level peak values into an upper (mipmap) level.
+void qtractorAudioPeakFile::feedLevel ( unsigned short iPeakLevel,
+	const float *pfMax, const float *pfMin, const float *pfRms,
+	unsigned long iPeakFrames )
+{
+	Writer::Level& level = m_pWriter->levels[iPeakLevel];
+
+	for (unsigned short k = 0; k < m_peakHeader.channels; ++k) {
+		if (level.amax[k] < pfMax[k] || level.nfeed == 0)
+			level.amax[k] = pfMax[k];
+		if (level.amin[k] > pfMin[k] || level.nfeed == 0)
+			level.amin[k] = pfMin[k];
+		level.arms[k] += pfRms[k];
+	}
+
+	level.npeak += iPeakFrames;
+
+	if (++level.nfeed >= (1 << c_iPeakLevelShift))
+		writeLevel(iPeakLevel);
+}
+
+
+// Append an upper (mipmap) level peak frame.
+void qtractorAudioPeakFile::writeLevel ( unsigned short iPeakLevel )
+{
+	Writer::Level& level = m_pWriter->levels[iPeakLevel];
+
+	// Feed the next upper level first...
+	if (iPeakLevel + 1 < c_iPeakLevels) {
+		feedLevel(iPeakLevel + 1, level.amax, level.amin, level.arms,
+			level.npeak);
+	}
+
+	Frame frame;
+	for (unsigned short k = 0; k < m_peakHeader.channels; ++k) {
+		float& fmax = level.amax[k];
+		float& fmin = level.amin[k];
+		float& frms = level.arms[k];
+		frame.max = unormf(::fabsf(fmax));
+		frame.min = unormf(::fabsf(fmin));
+		frame.rms = unormf(::sqrtf(frms / float(level.npeak)));
+		fmax = fmin = frms = 0.0f;
+		level.frames.append((const char *) &frame, sizeof(Frame));
+	}
+
+	level.npeak = 0;
+	level.nfeed = 0;
+}
+
+
+// Peak file read statistics (eg. per redraw).
+std::atomic<unsigned long> qtractorAudioPeakFile::g_iReadBytes(0);
+std::atomic<unsigned long> qtractorAudioPeakFile::g_iMapBytes(0);
+
+void qtractorAudioPeakFile::resetReadBytes (void)
+{
+	g_iReadBytes.store(0, std::memory_order_relaxed);
+	g_iMapBytes.store(0, std::memory_order_relaxed);
+}
+
+unsigned long qtractorAudioPeakFile::readBytes (void)
+{
+	return g_iReadBytes.load(std::memory_order_relaxed);
+}
+
+unsigned long qtractorAudioPeakFile::mapBytes (void)
+{
+	return g_iMapBytes.load(std::memory_order_relaxed);
+}
+
+
 // Reference count methods.
 void qtractorAudioPeakFile::addRef (void)
 {
@@ -900,10 +1189,23 @@ qtractorAudioPeakFile::Frame *qtractorAudioPeak::peakFrames (
 		return nullptr;
 
 	// Just in case resolutions might change...
-	const unsigned short iPeakPeriod = m_pPeakFile->period();
+	unsigned long iPeakPeriod = m_pPeakFile->period();
 	if (iPeakPeriod < 1)
 		return nullptr;
 
+	// Pick the coarsest level that still has
+	// at least one peak frame per pixel...
+	unsigned short iPeakLevel = 0;
+	if (width > 0) {
+		const unsigned long iPixelFrames = (iFrameLength / width);
+		const unsigned short iPeakLevels = m_pPeakFile->levels();
+		while (iPeakLevel + 1 < iPeakLevels
+			&& (iPeakPeriod << c_iPeakLevelShift) <= iPixelFrames) {
+			iPeakPeriod <<= c_iPeakLevelShift;
+			++iPeakLevel;
+		}
+	}
+
 	// Peak frames length estimation...
 	const unsigned int iPeakLength = (iFrameLength / iPeakPeriod);
 	if (iPeakLength < 1)
@@ -933,53 +1235,22 @@ qtractorAudioPeakFile::Frame *qtractorAudioPeak::peakFrames (
 		m_iPeakLength = 0;
 	}
 
-	// Grab them in...
+	// Check if we better aggregate over the frame buffer...
+	const int p1 = int(iPeakLength);
+	int w2 = p1;
+	if (width < p1 && width > 1 && 2 >= iChannels)
+		w2 = (width >> 1) + 1;
+
+	// Grab them in, aggregated straight from the
+	// peak file memory-map (or buffer cache)...
 	const unsigned long iPeakOffset = (iFrameOffset / iPeakPeriod);
-	qtractorAudioPeakFile::Frame *pPeakFrames
-		= m_pPeakFile->read(iPeakOffset, iPeakLength);
-	if (pPeakFrames == nullptr)
+	m_pPeakFrames = new qtractorAudioPeakFile::Frame [iChannels * w2];
+	m_iPeakLength = m_pPeakFile->read(m_pPeakFrames, w2,
+		iPeakLevel, iPeakOffset, iPeakLength);
+	if (m_iPeakLength < 1) {
+		delete [] m_pPeakFrames;
+		m_pPeakFrames = nullptr;
 		return nullptr;
-
-	// Check if we better aggregate over the frame buffer....
-	const int p1 = int(iPeakLength);
-	const int n1 = iChannels * p1;
-
-	if (width < p1 && width > 1 && 2 >= iChannels) {
-		const int w2 = (width >> 1) + 1;
-		const int n2 = iChannels * w2;
-		m_pPeakFrames = new qtractorAudioPeakFile::Frame [n2];
-		int n = 0; int i = 0;
-		while (n < n2) {
-			const int i2 = ((n + iChannels) * n1) / n2;
-			for (unsigned short k = 0; k < iChannels; ++k) {
-				qtractorAudioPeakFile::Frame *pNewFrame = &m_pPeakFrames[n + k];
-				pNewFrame->max = 0;
-				pNewFrame->min = 0;
-				pNewFrame->rms = 0;
-				for (int j = i; j < i2; j += iChannels) {
-					qtractorAudioPeakFile::Frame *pOldFrame = &pPeakFrames[j + k];
-					if (pNewFrame->max < pOldFrame->max)
-						pNewFrame->max = pOldFrame->max;
-					if (pNewFrame->min < pOldFrame->min)
-						pNewFrame->min = pOldFrame->min;
-					if (pNewFrame->rms < pOldFrame->rms)
-						pNewFrame->rms = pOldFrame->rms;
-				}
-			}
-			n += iChannels;
-			i = i2;
-		}
-		// New-indirect frame buffer length...
-		m_iPeakLength = n / iChannels;
-		// Done-indirect.
-	} else {
-		// Direct-copy frame-buffer...
-		m_pPeakFrames = new qtractorAudioPeakFile::Frame [n1];
-		::memcpy(m_pPeakFrames, pPeakFrames,
-			n1 * sizeof(qtractorAudioPeakFile::Frame));
-		// New-direct frame buffer length...
-		m_iPeakLength = iPeakLength;
-		// Done-direct.
 	}
 
 	return m_pPeakFrames;
@@ -1003,8 +1274,19 @@ qtractorAudioPeakFactory *qtractorAudioPeakFactory::getInstance (void)
 // Constructor.
 qtractorAudioPeakFactory::qtractorAudioPeakFactory ( QObject *pParent )
 	: QObject(pParent), m_bAutoRemove(false),
-		m_pPeakThread(nullptr), m_iPeakPeriod(c_iPeakPeriod)
+		m_pPeakQueue(nullptr), m_iPeakThreads(1),
+		m_iPeakPeriod(c_iPeakPeriod)
 {
+	m_pPeakQueue = new qtractorAudioPeakQueue();
+
+	ATOMIC_SET(&m_peakEvent, 0);
+
+	// Pending peak ready events are reset first...
+	QObject::connect(this,
+		SIGNAL(peakEvent()),
+		SLOT(peakEventReset()),
+		Qt::QueuedConnection);
+
 	// Pseudo-singleton reference setup.
 	g_pPeakFactory = this;
 }
@@ -1013,23 +1295,81 @@ qtractorAudioPeakFactory::qtractorAudioPeakFactory ( QObject *pParent )
 // Default destructor.
 qtractorAudioPeakFactory::~qtractorAudioPeakFactory (void)
 {
-	if (m_pPeakThread) {
-		if (m_pPeakThread->isRunning()) do {
-			m_pPeakThread->setRunState(false);
-		//	m_pPeakThread->terminate();
-			m_pPeakThread->sync();
-		} while (!m_pPeakThread->wait(100));
-		delete m_pPeakThread;
-		m_pPeakThread = nullptr;
-	}
+	stopPeakThreads();
 
 	cleanup();
 
+	delete m_pPeakQueue;
+
 	// Pseudo-singleton reference shut-down.
 	g_pPeakFactory = nullptr;
 }
 
 
+// Peak file creation threads accessors.
+void qtractorAudioPeakFactory::setPeakThreads ( unsigned int iPeakThreads )
+{
+	if (iPeakThreads < 1)
+		iPeakThreads = 1;
+
+	if (iPeakThreads == m_iPeakThreads)
+		return;
+
+	QMutexLocker locker(&m_mutex);
+
+	m_iPeakThreads = iPeakThreads;
+
+	// Restart if already running...
+	if (!m_peakThreads.isEmpty()) {
+		stopPeakThreads();
+		startPeakThreads();
+	}
+}
+
+unsigned int qtractorAudioPeakFactory::peakThreads (void) const
+{
+	return m_iPeakThreads;
+}
+
+
+// Peak file creation threads start.
+void qtractorAudioPeakFactory::startPeakThreads (void)
+{
+	m_pPeakQueue->setRunState(true);
+
+	for (unsigned int i = 0; i < m_iPeakThreads; ++i) {
+		qtractorAudioPeakThread *pPeakThread
+			= new qtractorAudioPeakThread(m_pPeakQueue);
+		pPeakThread->start(QThread::LowPriority);
+		m_peakThreads.append(pPeakThread);
+	}
+
+#ifdef CONFIG_DEBUG
+	qDebug("qtractorAudioPeakFactory[%p]::startPeakThreads() threads=%u",
+		this, m_iPeakThreads);
+#endif
+}
+
+
+// Peak file creation threads stop.
+void qtractorAudioPeakFactory::stopPeakThreads (void)
+{
+	if (m_peakThreads.isEmpty())
+		return;
+
+	m_pPeakQueue->setRunState(false);
+
+	QListIterator<qtractorAudioPeakThread *> iter(m_peakThreads);
+	while (iter.hasNext()) {
+		qtractorAudioPeakThread *pPeakThread = iter.next();
+		pPeakThread->wait();
+		delete pPeakThread;
+	}
+
+	m_peakThreads.clear();
+}
+
+
 // The peak period accessors.
 void qtractorAudioPeakFactory::setPeakPeriod ( unsigned short iPeakPeriod )
 {
@@ -1048,7 +1388,7 @@ void qtractorAudioPeakFactory::setPeakPeriod ( unsigned short iPeakPeriod )
 	for ( ; iter != iter_end; ++iter) {
 		qtractorAudioPeakFile *pPeakFile = iter.value();
 		pPeakFile->cleanup(true);
-		sync(pPeakFile);
+		prefetch(pPeakFile);
 	}
 }
 
@@ -1065,10 +1405,8 @@ qtractorAudioPeak* qtractorAudioPeakFactory::createPeak (
 {
 	QMutexLocker locker(&m_mutex);
 
-	if (m_pPeakThread == nullptr) {
-		m_pPeakThread = new qtractorAudioPeakThread();
-		m_pPeakThread->start();
-	}
+	if (m_peakThreads.isEmpty())
+		startPeakThreads();
 
 	const QString& sPeakName
 		= qtractorAudioPeakFile::peakName(sFilename, fTimeStretch);
@@ -1094,17 +1432,40 @@ bool qtractorAudioPeakFactory::isAutoRemove (void) const
 }
 
 
-// Event notifier.
+// Event notifier (batched).
 void qtractorAudioPeakFactory::notifyPeakEvent (void)
 {
-	emit peakEvent();
+	// Only one pending event at a time, whatever
+	// the number of peak files created meanwhile...
+	if (ATOMIC_CAS(&m_peakEvent, 0, 1))
+		emit peakEvent();
 }
 
 
-// Base sync method.
+// Peak ready event batch reset.
+void qtractorAudioPeakFactory::peakEventReset (void)
+{
+	ATOMIC_SET(&m_peakEvent, 0);
+}
+
+
+// Base sync method (priority, eg. visible).
 void qtractorAudioPeakFactory::sync ( qtractorAudioPeakFile *pPeakFile )
 {
-	if (m_pPeakThread) m_pPeakThread->sync(pPeakFile);
+	if (pPeakFile)
+		m_pPeakQueue->push(pPeakFile, true);
+	else
+		m_pPeakQueue->clear();
+}
+
+
+// Background (low priority) peak file creation.
+void qtractorAudioPeakFactory::prefetch ( qtractorAudioPeakFile *pPeakFile )
+{
+	if (pPeakFile->isWaitSync() || !pPeakFile->isOutdated())
+		return;
+
+	m_pPeakQueue->push(pPeakFile, false);
 }
 
 
@@ -22,6 +22,8 @@
 #ifndef __qtractorAudioPeak_h
 #define __qtractorAudioPeak_h
 
+#include "qtractorAtomic.h"
+
 #include <QString>
 #include <QFile>
 #include <QHash>
@@ -30,8 +32,11 @@
 
 #include <QStringList>
 
+#include <atomic>
+
 
 // Forward declarations.
+class qtractorAudioPeakQueue;
 class qtractorAudioPeakThread;
 
 
@@ -59,12 +64,19 @@ public:
 	QString name() const;
 	unsigned short period();
 	unsigned short channels();
+	unsigned short levels();
+
+	// Maximum number of (mipmap) peak levels.
+	enum { MaxLevels = 8 };
 
 	// Audio peak file header.
 	struct Header
 	{
+		char           magic[4];
 		unsigned short period;
 		unsigned short channels;
+		unsigned int   levels;
+		unsigned int   length[MaxLevels];
 	};
 
 	// Audio peak file frame record.
@@ -75,11 +87,21 @@ public:
 		unsigned char rms;
 	};
 
+	// Whether the peak file is missing or older than its audio file.
+	bool isOutdated() const;
+
 	// Peak cache file methods.
 	bool openRead();
-	Frame *read(unsigned long iPeakOffset, unsigned int iPeakLength);
+	unsigned int read(Frame *pFrames, unsigned int iFrames,
+		unsigned short iPeakLevel, unsigned long iPeakOffset,
+		unsigned int iPeakLength);
 	void closeRead();
 
+	// Peak file read statistics (eg. per redraw).
+	static void resetReadBytes();
+	static unsigned long readBytes();
+	static unsigned long mapBytes();
+
 	// Write peak from audio frame methods.
 	bool openWrite(unsigned short iChannels, unsigned int iSampleRate);
 	int write(float **ppAudioFrames, unsigned int iAudioFrames);
@@ -107,7 +129,16 @@ protected:
 	// Internal creational methods.
 	void writeFrame();
 
+	// Upper (mipmap) peak level creational methods.
+	void feedLevel(unsigned short iPeakLevel, const float *pfMax,
+		const float *pfMin, const float *pfRms, unsigned long iPeakFrames);
+	void writeLevel(unsigned short iPeakLevel);
+
 	// Read frames from peak file into local buffer cache.
+	// Read frames from peak file (mutex must be held).
+	Frame *readFrames(unsigned short iPeakLevel,
+		unsigned long iPeakOffset, unsigned int iPeakLength);
+
 	unsigned int readBuffer(unsigned int iBuffOffset,
 		unsigned long iPeakOffset, unsigned int iPeakFrames);
 
@@ -127,6 +158,11 @@ private:
 	unsigned int   m_iBuffSize;
 	unsigned int   m_iBuffLength;
 	unsigned long  m_iBuffOffset;
+	unsigned short m_iBuffLevel;
+
+	// Read-only memory-map, if any.
+	uchar         *m_pMap;
+	qint64         m_iMapSize;
 
 	QMutex         m_mutex;
 
@@ -135,6 +171,10 @@ private:
 	// Current reference count.
 	unsigned int   m_iRefCount;
 
+	// Read statistics (bytes read and mapped).
+	static std::atomic<unsigned long> g_iReadBytes;
+	static std::atomic<unsigned long> g_iMapBytes;
+
 	// Peak-writer context state.
 	struct Writer
 	{
@@ -150,6 +190,18 @@ private:
 		unsigned long  nread;
 		unsigned long  nwrite;
 
+		// Upper (mipmap) peak levels.
+		struct Level
+		{
+			float         *amax;
+			float         *amin;
+			float         *arms;
+			unsigned long  npeak;
+			unsigned short nfeed;
+			QByteArray     frames;
+
+		} levels[MaxLevels];
+
 	} *m_pWriter;
 };
 
@@ -232,12 +284,19 @@ public:
 	void setAutoRemove(bool bAutoRemove);
 	bool isAutoRemove() const;
 
-	// Peak ready event notification.
+	// Peak file creation threads accessors.
+	void setPeakThreads(unsigned int iPeakThreads);
+	unsigned int peakThreads() const;
+
+	// Peak ready event notification (batched).
 	void notifyPeakEvent();
 
-	// Base sync method.
+	// Base sync method (priority, eg. visible).
 	void sync(qtractorAudioPeakFile *pPeakFile = nullptr);
 
+	// Background (low priority) peak file creation.
+	void prefetch(qtractorAudioPeakFile *pPeakFile);
+
 	// Cleanup method.
 	void cleanup();
 
@@ -249,6 +308,17 @@ signals:
 	// Peak ready signal.
 	void peakEvent();
 
+protected slots:
+
+	// Peak ready event batch reset.
+	void peakEventReset();
+
+protected:
+
+	// Peak file creation threads start/stop.
+	void startPeakThreads();
+	void stopPeakThreads();
+
 private:
 
 	// Factory mutex.
@@ -262,8 +332,15 @@ private:
 	// Auto-delete property.
 	bool m_bAutoRemove;
 
-	// The peak file creation detached thread.
-	qtractorAudioPeakThread *m_pPeakThread;
+	// The peak file creation queue and detached threads.
+	qtractorAudioPeakQueue *m_pPeakQueue;
+
+	QList<qtractorAudioPeakThread *> m_peakThreads;
+
+	unsigned int m_iPeakThreads;
+
+	// Pending peak ready event (batch) flag.
+	qtractorAtomic m_peakEvent;
 
 	// The current running peak-period.
 	unsigned short m_iPeakPeriod;
@@ -0,0 +1,523 @@
+// qtractorAudioRender.cpp
+//
+/****************************************************************************
+   Copyright (C) 2005-2025, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#include "qtractorAbout.h"
+#include "qtractorAudioRender.h"
+#include "qtractorAudioFile.h"
+
+#include "qtractorTimeStretcher.h"
+
+#include "qtractorSession.h"
+
+#include <QFileInfo>
+#include <QFile>
+#include <QDir>
+
+#include <QThread>
+#include <QWaitCondition>
+#include <QList>
+
+#include <QDateTime>
+
+
+// Audio file buffer size in frames per channel.
+static const unsigned int c_iRenderFrames = (16 * 1024);
+
+// Rendered file extension and (float) sample format.
+static const QString c_sRenderFileExt = ".wav";
+static const int c_iRenderFileFormat = 3;
+
+
+//----------------------------------------------------------------------
+// class qtractorAudioRenderThread -- Audio render file thread.
+//
+
+class qtractorAudioRenderThread : public QThread
+{
+public:
+
+	// Constructor.
+	qtractorAudioRenderThread();
+
+	// Render file queue methods.
+	void push(qtractorAudioRenderFile *pRenderFile);
+	void clear();
+
+	// Run-state accessors.
+	void setRunState(bool bRunState);
+	bool runState() const
+		{ return m_bRunState; }
+
+protected:
+
+	// The main thread executive.
+	void run();
+
+private:
+
+	// Whether the thread is logically running.
+	volatile bool m_bRunState;
+
+	// The pending render file queue.
+	QList<qtractorAudioRenderFile *> m_items;
+
+	// Thread synchronization objects.
+	QMutex m_mutex;
+	QWaitCondition m_cond;
+};
+
+
+// Constructor.
+qtractorAudioRenderThread::qtractorAudioRenderThread (void)
+	: QThread(), m_bRunState(false)
+{
+}
+
+
+// Render file queue methods.
+void qtractorAudioRenderThread::push ( qtractorAudioRenderFile *pRenderFile )
+{
+	QMutexLocker locker(&m_mutex);
+
+	if (pRenderFile->isWaitSync())
+		return;
+
+	pRenderFile->setWaitSync(true);
+	m_items.append(pRenderFile);
+
+	m_cond.wakeAll();
+}
+
+
+void qtractorAudioRenderThread::clear (void)
+{
+	QMutexLocker locker(&m_mutex);
+
+	QListIterator<qtractorAudioRenderFile *> iter(m_items);
+	while (iter.hasNext())
+		iter.next()->setWaitSync(false);
+
+	m_items.clear();
+}
+
+
+// Run-state accessors.
+void qtractorAudioRenderThread::setRunState ( bool bRunState )
+{
+	QMutexLocker locker(&m_mutex);
+
+	m_bRunState = bRunState;
+
+	if (!m_bRunState)
+		m_cond.wakeAll();
+}
+
+
+// The main thread executive cycle.
+void qtractorAudioRenderThread::run (void)
+{
+#ifdef CONFIG_DEBUG_0
+	qDebug("qtractorAudioRenderThread[%p]::run(): started...", this);
+#endif
+
+	m_mutex.lock();
+
+	while (m_bRunState) {
+		// Wait for something to render...
+		if (m_items.isEmpty()) {
+			m_cond.wait(&m_mutex);
+			continue;
+		}
+		qtractorAudioRenderFile *pRenderFile = m_items.takeFirst();
+		m_mutex.unlock();
+		// Do whatever we must, unlocked...
+		const bool bReady = pRenderFile->render(&m_bRunState);
+		m_mutex.lock();
+		pRenderFile->setReady(bReady);
+		pRenderFile->setWaitSync(false);
+	}
+
+	m_mutex.unlock();
+
+#ifdef CONFIG_DEBUG_0
+	qDebug("qtractorAudioRenderThread[%p]::run(): stopped.\n", this);
+#endif
+}
+
+
+//----------------------------------------------------------------------
+// class qtractorAudioRenderFile -- Pre-rendered time-stretch/pitch-shift
+//                                  audio file cache entry.
+//
+
+// Constructor.
+qtractorAudioRenderFile::qtractorAudioRenderFile ( const QString& sFilename,
+	float fTimeStretch, float fPitchShift, unsigned int iStretcherFlags )
+{
+	// Initialize instance variables.
+	m_sFilename       = sFilename;
+	m_fTimeStretch    = fTimeStretch;
+	m_fPitchShift     = fPitchShift;
+	m_iStretcherFlags = iStretcherFlags;
+
+	m_bReady    = false;
+	m_bWaitSync = false;
+
+	m_iRefCount = 0;
+
+	// Set (unique) render filename...
+	QDir dir;
+	qtractorSession *pSession = qtractorSession::getInstance();
+	if (pSession)
+		dir.setPath(pSession->sessionDir());
+
+	const QFileInfo fileInfo(sFilename);
+	const QString& sRenderFilePrefix
+		= QFileInfo(dir, fileInfo.completeBaseName()).filePath();
+	const QString& sRenderName = renderName(sFilename,
+		fTimeStretch, fPitchShift, iStretcherFlags);
+	const QFileInfo renderInfo(sRenderFilePrefix + '_'
+		+ QString::number(qHash(sRenderName), 16)
+		+ c_sRenderFileExt);
+
+	m_sRenderFilename = renderInfo.absoluteFilePath();
+}
+
+
+// Whether the rendered file is missing or older than its source.
+bool qtractorAudioRenderFile::isOutdated (void) const
+{
+	const QFileInfo fileInfo(m_sFilename);
+	const QFileInfo renderInfo(m_sRenderFilename);
+
+	// The rendered file is written anew (renamed over) after its
+	// source contents, so the source must not be modified since...
+	return (!renderInfo.exists()
+		|| renderInfo.lastModified() < fileInfo.lastModified());
+}
+
+
+// Actual rendering (blocking, render thread only).
+bool qtractorAudioRenderFile::render ( volatile bool *pbRunState )
+{
+	// Open the source audio file (own decoder)...
+	qtractorAudioFile *pInpFile
+		= qtractorAudioFileFactory::createAudioFile(m_sFilename);
+	if (pInpFile == nullptr)
+		return false;
+
+	if (!pInpFile->open(m_sFilename)) {
+		delete pInpFile;
+		return false;
+	}
+
+	const unsigned short iChannels = pInpFile->channels();
+	const unsigned int iSampleRate = pInpFile->sampleRate();
+
+	if (iChannels < 1 || iSampleRate < 1) {
+		delete pInpFile;
+		return false;
+	}
+
+	// Render onto a temporary file first (native sample rate)...
+	const QFileInfo renderInfo(m_sRenderFilename);
+	const QString& sTempFilename
+		= QFileInfo(renderInfo.dir(), renderInfo.completeBaseName()).filePath()
+		+ ".tmp" + c_sRenderFileExt;
+
+	qtractorAudioFile *pOutFile
+		= qtractorAudioFileFactory::createAudioFile(sTempFilename,
+			iChannels, iSampleRate, c_iRenderFrames, c_iRenderFileFormat);
+	if (pOutFile == nullptr) {
+		delete pInpFile;
+		return false;
+	}
+
+	if (!pOutFile->open(sTempFilename, qtractorAudioFile::Write)) {
+		delete pOutFile;
+		delete pInpFile;
+		return false;
+	}
+
+#ifdef CONFIG_DEBUG
+	qDebug("qtractorAudioRenderFile[%p]::render(\"%s\") started...",
+		this, m_sRenderFilename.toUtf8().constData());
+#endif
+
+	// Allocate audio file frame buffer...
+	unsigned short i;
+	float **ppFrames = new float * [iChannels];
+	for (i = 0; i < iChannels; ++i)
+		ppFrames[i] = new float [c_iRenderFrames];
+
+	// The off-line time-stretch/pitch-shift engine...
+	qtractorTimeStretcher *pTimeStretcher
+		= new qtractorTimeStretcher(iChannels, iSampleRate,
+			m_fTimeStretch, m_fPitchShift, m_iStretcherFlags, c_iRenderFrames);
+
+	// Make sure audio file decoder makes no head-start...
+	pInpFile->seek(0);
+
+	bool bFlush = false;
+	bool bResult = true;
+
+	while (bResult && *pbRunState) {
+		// Read another bunch of frames from the source...
+		if (!bFlush) {
+			const int nread = pInpFile->read(ppFrames, c_iRenderFrames);
+			if (nread > 0) {
+				pTimeStretcher->process(ppFrames, nread);
+			} else {
+				pTimeStretcher->flush();
+				bFlush = true;
+			}
+		}
+		// Retrieve and write whatever is done so far...
+		unsigned int nahead = pTimeStretcher->available();
+		while (nahead > 0 && bResult) {
+			if (nahead > c_iRenderFrames)
+				nahead = c_iRenderFrames;
+			nahead = pTimeStretcher->retrieve(ppFrames, nahead);
+			if (pOutFile->write(ppFrames, nahead) < int(nahead))
+				bResult = false;
+			nahead = pTimeStretcher->available();
+		}
+		// Are we done?
+		if (bFlush)
+			break;
+	}
+
+	// Release everything...
+	delete pTimeStretcher;
+
+	for (i = 0; i < iChannels; ++i)
+		delete [] ppFrames[i];
+	delete [] ppFrames;
+
+	pOutFile->close();
+	delete pOutFile;
+
+	pInpFile->close();
+	delete pInpFile;
+
+	// Never leave an incomplete render file behind...
+	if (!*pbRunState)
+		bResult = false;
+
+	if (bResult) {
+		QFile::remove(m_sRenderFilename);
+		bResult = QFile::rename(sTempFilename, m_sRenderFilename);
+	}
+
+	if (!bResult)
+		QFile::remove(sTempFilename);
+
+#ifdef CONFIG_DEBUG
+	qDebug("qtractorAudioRenderFile[%p]::render(\"%s\") done=%d.",
+		this, m_sRenderFilename.toUtf8().constData(), int(bResult));
+#endif
+
+	return bResult;
+}
+
+
+// Physical removal.
+void qtractorAudioRenderFile::remove (void)
+{
+	m_bReady = false;
+
+	QFile::remove(m_sRenderFilename);
+}
+
+
+// Render filename standard (key).
+QString qtractorAudioRenderFile::renderName ( const QString& sFilename,
+	float fTimeStretch, float fPitchShift, unsigned int iStretcherFlags )
+{
+	return sFilename
+		+ '_' + QString::number(fTimeStretch)
+		+ '_' + QString::number(fPitchShift)
+		+ '_' + QString::number(iStretcherFlags);
+}
+
+
+//----------------------------------------------------------------------
+// class qtractorAudioRenderFactory -- Pre-rendered time-stretch/pitch-shift
+//                                     audio file cache factory (singleton).
+//
+
+// Singleton instance pointer.
+qtractorAudioRenderFactory *qtractorAudioRenderFactory::g_pRenderFactory = nullptr;
+
+// Singleton instance accessor (static).
+qtractorAudioRenderFactory *qtractorAudioRenderFactory::getInstance (void)
+{
+	return g_pRenderFactory;
+}
+
+
+// Constructor.
+qtractorAudioRenderFactory::qtractorAudioRenderFactory (void)
+	: m_bEnabled(false), m_bAutoRemove(false), m_pRenderThread(nullptr)
+{
+	// Pseudo-singleton reference setup.
+	g_pRenderFactory = this;
+}
+
+
+// Default destructor.
+qtractorAudioRenderFactory::~qtractorAudioRenderFactory (void)
+{
+	cleanup();
+
+	// Pseudo-singleton reference shut-down.
+	g_pRenderFactory = nullptr;
+}
+
+
+// Enablement property.
+void qtractorAudioRenderFactory::setEnabled ( bool bEnabled )
+{
+	m_bEnabled = bEnabled;
+}
+
+bool qtractorAudioRenderFactory::isEnabled (void) const
+{
+	return m_bEnabled;
+}
+
+
+// Auto-delete property.
+void qtractorAudioRenderFactory::setAutoRemove ( bool bAutoRemove )
+{
+	m_bAutoRemove = bAutoRemove;
+}
+
+bool qtractorAudioRenderFactory::isAutoRemove (void) const
+{
+	return m_bAutoRemove;
+}
+
+
+// The render file factory-method.
+qtractorAudioRenderFile *qtractorAudioRenderFactory::createRenderFile (
+	const QString& sFilename, float fTimeStretch, float fPitchShift,
+	unsigned int iStretcherFlags )
+{
+	if (!m_bEnabled)
+		return nullptr;
+
+	QMutexLocker locker(&m_mutex);
+
+	const QString& sKey = qtractorAudioRenderFile::renderName(
+		sFilename, fTimeStretch, fPitchShift, iStretcherFlags);
+
+	qtractorAudioRenderFile *pRenderFile = m_renders.value(sKey, nullptr);
+	if (pRenderFile == nullptr) {
+		// Parameters have changed: get rid of any stale ones...
+		purge();
+		pRenderFile = new qtractorAudioRenderFile(
+			sFilename, fTimeStretch, fPitchShift, iStretcherFlags);
+		m_renders.insert(sKey, pRenderFile);
+	}
+
+	pRenderFile->addRef();
+
+	// Schedule (re)rendering, whether needed...
+	if (!pRenderFile->isWaitSync()) {
+		const bool bReady = !pRenderFile->isOutdated();
+		pRenderFile->setReady(bReady);
+		if (!bReady) {
+			if (m_pRenderThread == nullptr) {
+				m_pRenderThread = new qtractorAudioRenderThread();
+				m_pRenderThread->setRunState(true);
+				m_pRenderThread->start(QThread::LowPriority);
+			}
+			m_pRenderThread->push(pRenderFile);
+		}
+	}
+
+	return pRenderFile;
+}
+
+
+// Give back a cache entry reference.
+void qtractorAudioRenderFactory::releaseRenderFile (
+	qtractorAudioRenderFile *pRenderFile )
+{
+	QMutexLocker locker(&m_mutex);
+
+	pRenderFile->removeRef();
+}
+
+
+// Stale (unreferenced) entries and files removal.
+// (factory lock held; entries still pending on the
+// render thread are left for a later turn)
+void qtractorAudioRenderFactory::purge (void)
+{
+	RenderFiles::Iterator iter = m_renders.begin();
+	while (iter != m_renders.end()) {
+		qtractorAudioRenderFile *pRenderFile = iter.value();
+		if (pRenderFile->refCount() > 0 || pRenderFile->isWaitSync()) {
+			++iter;
+			continue;
+		}
+	#ifdef CONFIG_DEBUG
+		qDebug("qtractorAudioRenderFactory::purge(\"%s\")",
+			pRenderFile->renderFilename().toUtf8().constData());
+	#endif
+		pRenderFile->remove();
+		delete pRenderFile;
+		iter = m_renders.erase(iter);
+	}
+}
+
+
+// Cleanup method.
+void qtractorAudioRenderFactory::cleanup (void)
+{
+	QMutexLocker locker(&m_mutex);
+
+	// Abort any pending or on-going render...
+	if (m_pRenderThread) {
+		m_pRenderThread->clear();
+		m_pRenderThread->setRunState(false);
+		m_pRenderThread->wait();
+		delete m_pRenderThread;
+		m_pRenderThread = nullptr;
+	}
+
+	// Remove all rendered files, if applicable...
+	RenderFiles::ConstIterator iter = m_renders.constBegin();
+	const RenderFiles::ConstIterator& iter_end = m_renders.constEnd();
+	for ( ; iter != iter_end; ++iter) {
+		qtractorAudioRenderFile *pRenderFile = iter.value();
+		if (m_bAutoRemove)
+			pRenderFile->remove();
+		delete pRenderFile;
+	}
+
+	m_renders.clear();
+}
+
+
+// end of qtractorAudioRender.cpp
@@ -0,0 +1,179 @@
+// qtractorAudioRender.h
+//
+/****************************************************************************
+   Copyright (C) 2005-2025, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#ifndef __qtractorAudioRender_h
+#define __qtractorAudioRender_h
+
+#include <QString>
+#include <QHash>
+
+#include <QMutex>
+
+
+// Forward declarations.
+class qtractorAudioRenderThread;
+
+
+//----------------------------------------------------------------------
+// class qtractorAudioRenderFile -- Pre-rendered time-stretch/pitch-shift
+//                                  audio file cache entry.
+//
+
+class qtractorAudioRenderFile
+{
+public:
+
+	// Constructor.
+	qtractorAudioRenderFile(const QString& sFilename,
+		float fTimeStretch, float fPitchShift, unsigned int iStretcherFlags);
+
+	// Source audio properties accessors.
+	const QString& filename() const
+		{ return m_sFilename; }
+	float timeStretch() const
+		{ return m_fTimeStretch; }
+	float pitchShift() const
+		{ return m_fPitchShift; }
+	unsigned int stretcherFlags() const
+		{ return m_iStretcherFlags; }
+
+	// Rendered audio file path.
+	const QString& renderFilename() const
+		{ return m_sRenderFilename; }
+
+	// Whether the rendered file is missing or older than its source.
+	bool isOutdated() const;
+
+	// Whether the rendered file is ready for playback.
+	void setReady(bool bReady)
+		{ m_bReady = bReady; }
+	bool isReady() const
+		{ return m_bReady; }
+
+	// Whether the rendered file is pending (queued or in progress).
+	void setWaitSync(bool bWaitSync)
+		{ m_bWaitSync = bWaitSync; }
+	bool isWaitSync() const
+		{ return m_bWaitSync; }
+
+	// Reference count methods (factory lock held).
+	void addRef()
+		{ ++m_iRefCount; }
+	void removeRef()
+		{ if (m_iRefCount > 0) --m_iRefCount; }
+	unsigned int refCount() const
+		{ return m_iRefCount; }
+
+	// Actual rendering (blocking, render thread only).
+	bool render(volatile bool *pbRunState);
+
+	// Physical removal.
+	void remove();
+
+	// Render filename standard (key).
+	static QString renderName(const QString& sFilename,
+		float fTimeStretch, float fPitchShift, unsigned int iStretcherFlags);
+
+private:
+
+	// Instance variables.
+	QString      m_sFilename;
+	float        m_fTimeStretch;
+	float        m_fPitchShift;
+	unsigned int m_iStretcherFlags;
+
+	QString      m_sRenderFilename;
+
+	volatile bool m_bReady;
+	volatile bool m_bWaitSync;
+
+	unsigned int m_iRefCount;
+};
+
+
+//----------------------------------------------------------------------
+// class qtractorAudioRenderFactory -- Pre-rendered time-stretch/pitch-shift
+//                                     audio file cache factory (singleton).
+//
+
+class qtractorAudioRenderFactory
+{
+public:
+
+	// Constructor.
+	qtractorAudioRenderFactory();
+	// Default destructor.
+	~qtractorAudioRenderFactory();
+
+	// Enablement property.
+	void setEnabled(bool bEnabled);
+	bool isEnabled() const;
+
+	// Auto-delete property.
+	void setAutoRemove(bool bAutoRemove);
+	bool isAutoRemove() const;
+
+	// The render file factory-method: returns the (referenced)
+	// cache entry for the given source and parameters, scheduling
+	// its (re)rendering in background whenever not up-to-date.
+	qtractorAudioRenderFile *createRenderFile(const QString& sFilename,
+		float fTimeStretch, float fPitchShift, unsigned int iStretcherFlags);
+
+	// Give back a cache entry reference.
+	void releaseRenderFile(qtractorAudioRenderFile *pRenderFile);
+
+	// Cleanup method.
+	void cleanup();
+
+	// Singleton instance accessor.
+	static qtractorAudioRenderFactory *getInstance();
+
+private:
+
+	// Stale (unreferenced) entries and files removal.
+	void purge();
+
+	// Factory mutex.
+	QMutex m_mutex;
+
+	// The list of managed render files.
+	typedef QHash<QString, qtractorAudioRenderFile *> RenderFiles;
+
+	RenderFiles m_renders;
+
+	// Enablement property.
+	bool m_bEnabled;
+
+	// Auto-delete property.
+	bool m_bAutoRemove;
+
+	// The render file creation detached thread.
+	qtractorAudioRenderThread *m_pRenderThread;
+
+	// The pseudo-singleton instance.
+	static qtractorAudioRenderFactory *g_pRenderFactory;
+};
+
+
+#endif  // __qtractorAudioRender_h
+
+
+// end of qtractorAudioRender.h
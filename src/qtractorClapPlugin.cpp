@@ -27,6 +27,7 @@
 
 #include "qtractorSession.h"
 #include "qtractorAudioEngine.h"
+#include "qtractorAudioGraph.h"
 #include "qtractorMidiManager.h"
 #include "qtractorCurve.h"
 
@@ -47,6 +48,8 @@
 
 #include <QRegularExpression>
 
+#include <climits>
+
 #if QT_VERSION >= QT_VERSION_CHECK(5, 10, 0)
 #include <QCoreApplication>
 #endif
@@ -642,9 +645,16 @@ public:
 		unsigned long offset, unsigned short port);
 	void process (float **ins, float **outs, unsigned int nframes);
 
+	// Keep the steady time running while idle (skipped).
+	void process_idle (unsigned int nframes)
+		{ if (m_processing) m_process.steady_time += nframes; }
+
 	// Plugin current latency (in frames);
 	unsigned long latency () const;
 
+	// Plugin current tail (in frames; negative if unknown).
+	long tail () const;
+
 	// Total parameter count.
 	unsigned long getParameterCount() const
 		{ return m_param_infos.count(); }
@@ -657,7 +667,7 @@ public:
 		{ return m_param_infos.value(id, nullptr); }
 
 	// Set/add a parameter value/point.
-	void setParameter (clap_id id, double alue);
+	void setParameter (clap_id id, double alue, uint32_t offset = 0);
 
 	// Get current parameter value.
 	double getParameter (clap_id id) const;
@@ -740,6 +750,20 @@ public:
 		bool empty () const
 			{ return (m_etail == m_ehead); }
 
+		// Sort events by time (stable, mostly sorted already).
+		void sort ()
+		{
+			const uint32_t nsize = m_elist.size();
+			for (uint32_t i = m_ihead + 1; i < nsize; ++i) {
+				const uint32_t ntail = m_elist.at(i);
+				const uint32_t time = event_time(ntail);
+				uint32_t j = i;
+				for ( ; j > m_ihead && event_time(m_elist.at(j - 1)) > time; --j)
+					m_elist[j] = m_elist.at(j - 1);
+				m_elist[j] = ntail;
+			}
+		}
+
 		void clear ()
 		{
 			m_ehead = m_eheap;
@@ -750,6 +774,12 @@ public:
 
 	protected:
 
+		uint32_t event_time ( uint32_t ntail ) const
+		{
+			return reinterpret_cast<const clap_event_header *> (
+				m_eheap + ntail)->time;
+		}
+
 		void resize ( uint32_t nsize )
 		{
 			uint8_t *old_eheap = m_eheap;
@@ -1012,6 +1042,16 @@ protected:
 		Impl::host_thread_pool_request_exec,
 	};
 
+	bool plugin_thread_pool_request_exec (uint32_t num_tasks);
+
+	static void plugin_thread_pool_task (void *arg, unsigned int task_index);
+
+	// Plugin thread-pool statistics.
+	unsigned long threadPoolTasks() const
+		{ return m_thread_pool_tasks; }
+	unsigned long threadPoolSaved() const
+		{ return m_thread_pool_saved; }
+
 	// Host state callbacks...
 	//
 	static void host_state_mark_dirty (
@@ -1057,12 +1097,22 @@ private:
 
 	const clap_plugin_note_name *m_note_names;
 
+	const clap_plugin_thread_pool *m_thread_pool;
+
+	const clap_plugin_tail *m_tail;
+
+	unsigned long m_thread_pool_tasks;
+	unsigned long m_thread_pool_saved;
+
 	volatile bool m_params_flush;
 
 	volatile bool m_activated;
 	volatile bool m_sleeping;
 	volatile bool m_processing;
 	volatile bool m_restarting;
+	volatile bool m_process_call;
+
+	clap_process_status m_process_status;
 
 	clap_host m_host;
 
@@ -1343,9 +1393,11 @@ qtractorClapPlugin::Impl::Impl ( qtractorClapPlugin *pPlugin )
 	: m_pPlugin(pPlugin), m_plugin(nullptr), m_params(nullptr),
 		m_timer_support(nullptr), m_posix_fd_support(nullptr),
 		m_gui(nullptr), m_state(nullptr), m_note_names(nullptr),
+		m_thread_pool(nullptr), m_tail(nullptr),
+		m_thread_pool_tasks(0), m_thread_pool_saved(0),
 		m_params_flush(false), m_activated(false), m_sleeping(false),
-		m_processing(false), m_restarting(false),
-		m_srate(44100), m_nframes(0), m_nframes_max(0)
+		m_processing(false), m_restarting(false), m_process_call(false),
+		m_process_status(CLAP_PROCESS_CONTINUE), m_srate(44100), m_nframes(0), m_nframes_max(0)
 {
 	qtractorClapPluginHost::setup(&m_host, this);
 	m_host.get_extension = qtractorClapPlugin::Impl::get_extension;
@@ -1394,6 +1446,12 @@ void qtractorClapPlugin::Impl::initialize (void)
 	m_note_names = static_cast<const clap_plugin_note_name *> (
 		m_plugin->get_extension(m_plugin, CLAP_EXT_NOTE_NAME));
 
+	m_thread_pool = static_cast<const clap_plugin_thread_pool *> (
+		m_plugin->get_extension(m_plugin, CLAP_EXT_THREAD_POOL));
+
+	m_tail = static_cast<const clap_plugin_tail *> (
+		m_plugin->get_extension(m_plugin, CLAP_EXT_TAIL));
+
 	addParamInfos();
 }
 
@@ -1420,6 +1478,10 @@ void qtractorClapPlugin::Impl::deinitialize (void)
 	m_gui = nullptr;
 	m_state = nullptr;
 	m_note_names = nullptr;
+
+	m_thread_pool = nullptr;
+
+	m_tail = nullptr;
 }
 
 
@@ -1496,7 +1558,9 @@ void qtractorClapPlugin::Impl::deactivate ( bool force )
 	m_plugin->deactivate(m_plugin);
 
 #ifdef CONFIG_DEBUG
-	qDebug("qtractorClapPlugin::Impl[%p]::deactivate() processing=%d", this, int(m_processing));
+	qDebug("qtractorClapPlugin::Impl[%p]::deactivate() processing=%d"
+		" thread-pool tasks=%lu saved=%lu us", this, int(m_processing),
+		m_thread_pool_tasks, m_thread_pool_saved);
 #endif
 }
 
@@ -1665,6 +1729,7 @@ void qtractorClapPlugin::Impl::process (
 	if (m_processing && (m_sleeping || m_restarting)) {
 		m_plugin->stop_processing(m_plugin);
 		m_processing = false;
+		m_process_status = CLAP_PROCESS_CONTINUE;
 		g_host.transportReleaseRef();
 		if (m_plugin->reset && !m_restarting)
 			m_plugin->reset(m_plugin);
@@ -1676,7 +1741,9 @@ void qtractorClapPlugin::Impl::process (
 		m_audio_outs.data32 = outs;
 		m_events_out.clear();
 		m_process.frames_count = nframes;
-		m_plugin->process(m_plugin, &m_process);
+		m_process_call = true;
+		m_process_status = m_plugin->process(m_plugin, &m_process);
+		m_process_call = false;
 		m_process.steady_time += nframes;
 		m_events_in.clear();
 		// Transfer parameter changes...
@@ -1700,9 +1767,33 @@ unsigned long qtractorClapPlugin::Impl::latency (void) const
 }
 
 
+// Plugin current tail (in frames; negative if unknown),
+// as of the last process call status.
+long qtractorClapPlugin::Impl::tail (void) const
+{
+	switch (m_process_status) {
+	case CLAP_PROCESS_SLEEP:
+	case CLAP_PROCESS_CONTINUE_IF_NOT_QUIET:
+		return 0;
+	case CLAP_PROCESS_TAIL:
+		if (m_tail && m_tail->get) {
+			const uint32_t tail = m_tail->get(m_plugin);
+			return (tail < uint32_t(INT32_MAX) ? long(tail) : LONG_MAX);
+		}
+		break;
+	case CLAP_PROCESS_CONTINUE:
+		return LONG_MAX;
+	default:
+		break;
+	}
+
+	return -1;
+}
+
+
 // Set/add a parameter value/point.
 void qtractorClapPlugin::Impl::setParameter (
-	clap_id id, double value )
+	clap_id id, double value, uint32_t offset )
 {
 	if (m_plugin) {
 		const clap_param_info *param_info
@@ -1710,7 +1801,7 @@ void qtractorClapPlugin::Impl::setParameter (
 		if (param_info) {
 			 clap_event_param_value ev;
 			 ::memset(&ev, 0, sizeof(ev));
-			 ev.header.time = 0;
+			 ev.header.time = offset;
 			 ev.header.type = CLAP_EVENT_PARAM_VALUE;
 			 ev.header.space_id = CLAP_CORE_EVENT_SPACE_ID;
 			 ev.header.flags = 0;
@@ -1974,8 +2065,8 @@ void qtractorClapPlugin::Impl::plugin_request_restart (void)
 
 void qtractorClapPlugin::Impl::plugin_request_process (void)
 {
-	// TODO: ?...
-	//
+	// Wake up, if idle...
+	m_pPlugin->resetIdle();
 }
 
 
@@ -2385,12 +2476,56 @@ bool qtractorClapPlugin::Impl::host_is_audio_thread (
 bool qtractorClapPlugin::Impl::host_thread_pool_request_exec (
 	const clap_host *host, uint32_t num_tasks )
 {
-#ifdef CONFIG_DEBUG
-	qDebug("qtractorClapPlugin::Impl::host_thread_pool_request_exec(%p, %d)", host, num_tasks);
-#endif
-	// TODO: ?...
-	//
-	return false;
+	Impl *pImpl = static_cast<Impl *> (host->host_data);
+	return (pImpl ? pImpl->plugin_thread_pool_request_exec(num_tasks) : false);
+}
+
+
+// Plugin thread-pool callbacks...
+//
+bool qtractorClapPlugin::Impl::plugin_thread_pool_request_exec (
+	uint32_t num_tasks )
+{
+	// Only ever from within the plugin process call...
+	if (!m_process_call || !m_thread_pool || !m_thread_pool->exec)
+		return false;
+
+	qtractorSession *pSession = qtractorSession::getInstance();
+	if (pSession == nullptr)
+		return false;
+
+	qtractorAudioEngine *pAudioEngine = pSession->audioEngine();
+	if (pAudioEngine == nullptr)
+		return false;
+
+	// Workers are started on first demand, later on...
+	qtractorAudioTaskPool *pTaskPool = pAudioEngine->taskPool();
+	if (pTaskPool == nullptr) {
+		pAudioEngine->requestTaskPool();
+		return false;
+	}
+
+	// Rejected requests are run serially by the plugin itself...
+	unsigned long iTaskTime = 0;
+	const jack_time_t t0 = jack_get_time();
+	if (!pTaskPool->exec(Impl::plugin_thread_pool_task,
+			this, num_tasks, &iTaskTime))
+		return false;
+	const unsigned long iExecTime = (unsigned long) (jack_get_time() - t0);
+
+	m_thread_pool_tasks += num_tasks;
+	if (iTaskTime > iExecTime)
+		m_thread_pool_saved += (iTaskTime - iExecTime);
+
+	return true;
+}
+
+
+void qtractorClapPlugin::Impl::plugin_thread_pool_task (
+	void *arg, unsigned int task_index )
+{
+	Impl *pImpl = static_cast<Impl *> (arg);
+	pImpl->m_thread_pool->exec(pImpl->m_plugin, task_index);
 }
 
 
@@ -2898,6 +3033,10 @@ void qtractorClapPlugin::updateParam (
 		this, pParam->index(), fValue, int(bUpdate));
 #endif
 
+	// Already delivered from within the process cycle?
+	if (isProcessCurve(pParam))
+		return;
+
 	const clap_id id = pClapParam->impl()->param_info().id;
 	const double value = double(fValue);
 	m_pImpl->setParameter(id, value);
@@ -3348,6 +3487,26 @@ void qtractorClapPlugin::process_midi_in (
 }
 
 
+// Intra-cycle parameter point procedure (offset in frames).
+void qtractorClapPlugin::process_curve (
+	qtractorPlugin::Param *pParam, float fValue, unsigned int iOffset )
+{
+	Param *pClapParam = static_cast<Param *> (pParam);
+	if (pClapParam->impl() == nullptr)
+		return;
+
+	const clap_id id = pClapParam->impl()->param_info().id;
+	m_pImpl->setParameter(id, double(fValue), iOffset);
+}
+
+
+// Idle sleep, instead of processing (RT-safe).
+void qtractorClapPlugin::process_idle ( unsigned int nframes )
+{
+	m_pImpl->process_idle(nframes);
+}
+
+
 void qtractorClapPlugin::process (
 	float **ppIBuffer, float **ppOBuffer, unsigned int nframes )
 {
@@ -3399,6 +3558,12 @@ void qtractorClapPlugin::process (
 			m_ppOBuffer[i] = m_pfODummy; // dummy output!
 	}
 
+	// Sample-accurate automation, if any...
+	if (process_curves(nframes)) {
+		// Keep input events in time order...
+		m_pImpl->events_in().sort();
+	}
+
 	// Run the main processor routine...
 	//
 	m_pImpl->process(m_ppIBuffer, m_ppOBuffer, nframes);
@@ -3474,6 +3639,25 @@ unsigned long qtractorClapPlugin::latency (void) const
 }
 
 
+// Plugin current tail (in frames; negative if unknown).
+long qtractorClapPlugin::tail (void) const
+{
+	return m_pImpl->tail();
+}
+
+
+// Plugin thread-pool statistics (tasks dispatched, time saved in usecs).
+unsigned long qtractorClapPlugin::threadPoolTasks (void) const
+{
+	return m_pImpl->threadPoolTasks();
+}
+
+unsigned long qtractorClapPlugin::threadPoolSaved (void) const
+{
+	return m_pImpl->threadPoolSaved();
+}
+
+
 // Plugin preset i/o (configuration from/to state files).
 bool qtractorClapPlugin::loadPresetFile ( const QString& sFilename )
 {
@@ -172,9 +172,19 @@ public:
 		unsigned long offset, unsigned short port);
 	void process(float **ppIBuffer, float **ppOBuffer, unsigned int nframes);
 
+	// Idle sleep, instead of processing (RT-safe).
+	void process_idle(unsigned int nframes);
+
 	// Plugin current latency (in frames);
 	unsigned long latency() const;
 
+	// Plugin current tail (in frames; negative if unknown).
+	long tail() const;
+
+	// Plugin thread-pool statistics (tasks dispatched, time saved in usecs).
+	unsigned long threadPoolTasks() const;
+	unsigned long threadPoolSaved() const;
+
 	// Plugin preset i/o (configuration from/to state files).
 	bool loadPresetFile(const QString& sFilename);
 	bool savePresetFile(const QString& sFilename);
@@ -212,6 +222,10 @@ protected:
 	// Make up some others dirty...
 	void updateDirtyCount();
 
+	// Intra-cycle parameter point procedure (offset in frames).
+	void process_curve(
+		qtractorPlugin::Param *pParam, float fValue, unsigned int iOffset);
+
 private:
 
 	// Instance variables.
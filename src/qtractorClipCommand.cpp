@@ -31,6 +31,7 @@
 #include "qtractorMidiEngine.h"
 #include "qtractorMidiClip.h"
 #include "qtractorTracks.h"
+#include "qtractorTrackView.h"
 #include "qtractorFiles.h"
 
 #include "qtractorMidiEditCommand.h"
@@ -628,6 +629,10 @@ bool qtractorClipCommand::execute ( bool bRedo )
 
 	pSession->lock();
 
+	// Whether the whole track view is due for a refresh,
+	// or just the clips that were changed in place...
+	int iRefresh = m_trackCommands.count();
+
 	QListIterator<qtractorTrackCommand *> track(m_trackCommands);
 	while (track.hasNext()) {
 	    qtractorTrackCommand *pTrackCommand = track.next();
@@ -652,6 +657,21 @@ bool qtractorClipCommand::execute ( bool bRedo )
 		qtractorTrack *pTrack = pItem->track;
 		// Execute the command item...
 		switch (pItem->command) {
+		case FileClip:
+		case RenameClip:
+		case GainClip:
+		case PanningClip:
+		case MuteClip:
+		case FadeInClip:
+		case FadeOutClip:
+		case PitchShiftClip:
+		case StretcherFlagsClip:
+			break;
+		default:
+			++iRefresh;
+			break;
+		}
+		switch (pItem->command) {
 		case AddClip: {
 			if (bRedo)
 				pTrack->addClip(pClip);
@@ -883,6 +903,19 @@ bool qtractorClipCommand::execute ( bool bRedo )
 
 	pSession->unlock();
 
+	// Damage just the clips changed in place, if that's all...
+	setRefresh(iRefresh > 0);
+	if (iRefresh == 0) {
+		qtractorMainForm *pMainForm = qtractorMainForm::getInstance();
+		qtractorTracks *pTracks = (pMainForm ? pMainForm->tracks() : nullptr);
+		if (pTracks) {
+			qtractorTrackView *pTrackView = pTracks->trackView();
+			QListIterator<Item *> iter(m_items);
+			while (iter.hasNext())
+				pTrackView->updateClip(iter.next()->clip);
+		}
+	}
+
 	return true;
 }
 
@@ -205,6 +205,9 @@ qtractorClipForm::qtractorClipForm ( QWidget *pParent )
 	QObject::connect(m_ui.WsolaQuickSeekCheckBox,
 		SIGNAL(stateChanged(int)),
 		SLOT(changed()));
+	QObject::connect(m_ui.WsolaCoarseSeekCheckBox,
+		SIGNAL(stateChanged(int)),
+		SLOT(changed()));
 #ifdef CONFIG_LIBRUBBERBAND
 	QObject::connect(m_ui.RubberBandFormantCheckBox,
 		SIGNAL(stateChanged(int)),
@@ -334,6 +337,8 @@ void qtractorClipForm::setClip ( qtractorClip *pClip )
 	#endif
 		m_ui.WsolaQuickSeekCheckBox->setChecked(
 			pAudioClip->isStretcherFlag(qtractorTimeStretcher::WsolaQuickSeek));
+		m_ui.WsolaCoarseSeekCheckBox->setChecked(
+			pAudioClip->isStretcherFlag(qtractorTimeStretcher::WsolaCoarseSeek));
 		break;
 	}
 	case qtractorTrack::Midi: {
@@ -427,6 +432,8 @@ void qtractorClipForm::accept (void)
 				iStretcherFlags |= qtractorTimeStretcher::WsolaTimeStretch;
 			if (m_ui.WsolaQuickSeekCheckBox->isChecked())
 				iStretcherFlags |= qtractorTimeStretcher::WsolaQuickSeek;
+			if (m_ui.WsolaCoarseSeekCheckBox->isChecked())
+				iStretcherFlags |= qtractorTimeStretcher::WsolaCoarseSeek;
 		#ifdef CONFIG_LIBRUBBERBAND
 			if (m_ui.RubberBandFormantCheckBox->isChecked())
 				iStretcherFlags |= qtractorTimeStretcher::RubberBandFormant;
@@ -686,6 +693,7 @@ void qtractorClipForm::stabilizeForm (void)
 		= bTimeStretch && m_ui.WsolaTimeStretchCheckBox->isChecked();
 	m_ui.WsolaTimeStretchCheckBox->setEnabled(bTimeStretch);
 	m_ui.WsolaQuickSeekCheckBox->setEnabled(bWsolaTimeStretch);
+	m_ui.WsolaCoarseSeekCheckBox->setEnabled(bWsolaTimeStretch);
 
 	const bool bPitchShift
 		= (qAbs(float(m_ui.PitchShiftSpinBox->value())) > 0.0f);
@@ -568,6 +568,40 @@ float qtractorCurve::value ( unsigned long iFrame )
 }
 
 
+// Next intra-cycle value change, if any (RT-safe):
+// steps through node boundaries and, on interpolated
+// segments, every given frames; iFrame is advanced
+// and fValue set only when there's an actual change.
+bool qtractorCurve::processNext (
+	unsigned long& iFrame, unsigned long iFrameEnd,
+	float& fValue, unsigned int iStep )
+{
+	unsigned long iNextFrame = iFrame;
+
+	while (iNextFrame < iFrameEnd) {
+		Node *pNode = m_cursor.seek(iNextFrame + 1);
+		if (m_mode == Hold)
+			iNextFrame = iFrameEnd;
+		else
+			iNextFrame += iStep;
+		if (pNode && pNode->frame < iNextFrame)
+			iNextFrame = pNode->frame;
+		if (iNextFrame >= iFrameEnd)
+			break;
+		const float fNextValue
+			= m_observer.safeValue(value(m_cursor.seek(iNextFrame), iNextFrame));
+		if (fNextValue != fValue) {
+			iFrame = iNextFrame;
+			fValue = fNextValue;
+			return true;
+		}
+	}
+
+	iFrame = iFrameEnd;
+	return false;
+}
+
+
 // Normalized scale converters.
 float qtractorCurve::valueFromScale ( float fScale ) const 
 {
@@ -208,6 +208,13 @@ public:
 
 	void process() { process(m_cursor.frame()); }
 
+	// Sample-accurate automation (intra-cycle) resolution.
+	static const unsigned int c_iProcessStep = 32;
+
+	// Next intra-cycle value change, if any (RT-safe).
+	bool processNext(unsigned long& iFrame, unsigned long iFrameEnd,
+		float& fValue, unsigned int iStep = c_iProcessStep);
+
 	// Record automation procedure.
 	void capture(unsigned long iFrame)
 	{
@@ -441,7 +448,7 @@ public:
 
 	// Constructor.
 	qtractorCurveList() : m_iProcess(0), m_iCapture(0), m_iLocked(0),
-		m_pCurrentCurve(nullptr) { setAutoDelete(true); }
+		m_pCurrentCurve(nullptr), m_iFrame(0) { setAutoDelete(true); }
 
 	// ~Destructor.
 	~qtractorCurveList() { clearAll(); }
@@ -491,6 +498,8 @@ public:
 	// The meta-processing automation procedure.
 	void process(unsigned long iFrame)
 	{
+		m_iFrame = iFrame;
+
 		qtractorCurve *pCurve = first();
 		while (pCurve) {
 			pCurve->process(iFrame);
@@ -498,6 +507,10 @@ public:
 		}
 	}
 
+	// Last processed (cycle start) frame.
+	unsigned long frame() const
+		{ return m_iFrame; }
+
 	// Process management.
 	void updateProcess(bool bProcess)
 	{
@@ -0,0 +1,381 @@
+// qtractorDspLoad.cpp
+//
+/****************************************************************************
+   Copyright (C) 2005-2025, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#include "qtractorAbout.h"
+#include "qtractorDspLoad.h"
+
+#include "qtractorSession.h"
+#include "qtractorAudioEngine.h"
+#include "qtractorMidiEngine.h"
+#include "qtractorPlugin.h"
+
+#include <QTextStream>
+
+#include <QFile>
+
+// Deprecated QTextStreamFunctions/Qt namespaces workaround.
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+#define endl	Qt::endl
+#endif
+
+#if defined(_WIN32)
+#include <QElapsedTimer>
+#else
+#include <time.h>
+#endif
+
+#include <cstring>
+
+
+//----------------------------------------------------------------------
+// class qtractorDspLoad -- Process call timing statistics.
+//
+
+// Global profiling state.
+qtractorAtomic qtractorDspLoad::g_enabled;
+
+
+// Constructor.
+qtractorDspLoad::qtractorDspLoad (void)
+{
+	reset();
+}
+
+
+// Record one process call time in nanoseconds (RT-safe).
+void qtractorDspLoad::record ( uint64_t iTime )
+{
+	Bank& bank = m_banks[ATOMIC_GET(&m_bank) & 1];
+
+	if (bank.count == 0 || bank.min > iTime)
+		bank.min = iTime;
+	if (bank.max < iTime)
+		bank.max = iTime;
+
+	bank.total += iTime;
+	++bank.count;
+
+	++bank.hist[timeBin(iTime)];
+}
+
+
+// Period statistics update (GUI thread).
+void qtractorDspLoad::update ( uint64_t iNow )
+{
+	// Profiling is off: start all over...
+	if (!isEnabled()) {
+		reset();
+		return;
+	}
+
+	// The bank left behind on the previous update
+	// has not been written ever since: read it...
+	const int iBank = ATOMIC_GET(&m_bank);
+	Bank& bank = m_banks[(iBank + 1) & 1];
+
+	m_iCalls = bank.count;
+
+	if (m_iCalls > 0) {
+		m_fMinTime = 0.001f * float(bank.min);
+		m_fMaxTime = 0.001f * float(bank.max);
+		m_fAvgTime = 0.001f * float(bank.total) / float(m_iCalls);
+		// Approximate 99th percentile, off the histogram...
+		const unsigned int iRank = m_iCalls - (m_iCalls / 100);
+		unsigned int iCount = 0;
+		unsigned int iBin = 0;
+		for ( ; iBin < Bins - 1; ++iBin) {
+			iCount += bank.hist[iBin];
+			if (iCount >= iRank)
+				break;
+		}
+		uint64_t iP99Time = binTime(iBin);
+		if (iP99Time > bank.max)
+			iP99Time = bank.max;
+		m_fP99Time = 0.001f * float(iP99Time);
+		// Calls per second and time spent over wall time...
+		if (m_iPeriod > 0) {
+			m_fRate = 1E+9f * float(m_iCalls) / float(m_iPeriod);
+			m_fLoad = 100.0f * float(bank.total) / float(m_iPeriod);
+		} else {
+			m_fRate = 0.0f;
+			m_fLoad = 0.0f;
+		}
+	} else {
+		m_fRate = 0.0f;
+		m_fMinTime = 0.0f;
+		m_fAvgTime = 0.0f;
+		m_fMaxTime = 0.0f;
+		m_fP99Time = 0.0f;
+		m_fLoad = 0.0f;
+	}
+
+	// Clear it and hand it over to the real-time thread...
+	::memset(&bank, 0, sizeof(Bank));
+
+	ATOMIC_SET(&m_bank, (iBank + 1) & 1);
+
+	// That's the period of the bank just left behind...
+	m_iPeriod = (m_iFlipTime > 0 && iNow > m_iFlipTime ? iNow - m_iFlipTime : 0);
+	m_iFlipTime = iNow;
+}
+
+
+// Reset all statistics.
+void qtractorDspLoad::reset (void)
+{
+	::memset(m_banks, 0, sizeof(m_banks));
+
+	ATOMIC_SET(&m_bank, 0);
+
+	m_iFlipTime = 0;
+	m_iPeriod = 0;
+
+	m_iCalls = 0;
+	m_fRate = 0.0f;
+
+	m_fMinTime = 0.0f;
+	m_fAvgTime = 0.0f;
+	m_fMaxTime = 0.0f;
+	m_fP99Time = 0.0f;
+
+	m_fLoad = 0.0f;
+}
+
+
+// Pretty statistics text (usecs).
+QString qtractorDspLoad::text (void) const
+{
+	if (!isValid())
+		return QString();
+
+	if (m_fAvgTime < 1000.0f)
+		return QString::number(m_fAvgTime, 'f', 1) + QObject::tr(" us");
+	else
+		return QString::number(0.001f * m_fAvgTime, 'f', 2) + QObject::tr(" ms");
+}
+
+
+QString qtractorDspLoad::toolTip (void) const
+{
+	if (!isValid())
+		return QString();
+
+	return QObject::tr("DSP: %1 calls/s, %2% load\n"
+		"min/avg/max/p99: %3/%4/%5/%6 us")
+		.arg(m_fRate, 0, 'f', 0)
+		.arg(m_fLoad, 0, 'f', 2)
+		.arg(m_fMinTime, 0, 'f', 1)
+		.arg(m_fAvgTime, 0, 'f', 1)
+		.arg(m_fMaxTime, 0, 'f', 1)
+		.arg(m_fP99Time, 0, 'f', 1);
+}
+
+
+// Global profiling state.
+void qtractorDspLoad::setEnabled ( bool bEnabled )
+{
+	ATOMIC_SET(&g_enabled, bEnabled ? 1 : 0);
+}
+
+bool qtractorDspLoad::isEnabled (void)
+{
+	return (ATOMIC_GET(&g_enabled) != 0);
+}
+
+
+// Monotonic high-resolution clock (nanoseconds).
+uint64_t qtractorDspLoad::timeNow (void)
+{
+#if defined(_WIN32)
+	static QElapsedTimer s_timer;
+	if (!s_timer.isValid())
+		s_timer.start();
+	return uint64_t(s_timer.nsecsElapsed());
+#else
+	struct timespec ts;
+	::clock_gettime(CLOCK_MONOTONIC, &ts);
+	return uint64_t(ts.tv_sec) * 1000000000ULL + uint64_t(ts.tv_nsec);
+#endif
+}
+
+
+// Histogram bin helpers: bin 0 is anything under 64ns,
+// then four bins for each octave above that.
+unsigned int qtractorDspLoad::timeBin ( uint64_t iTime )
+{
+	if (iTime < 64)
+		return 0;
+
+	unsigned int iOctave = 6;
+	while (iTime >> (iOctave + 1))
+		++iOctave;
+
+	const unsigned int iBin = ((iOctave - 6) << 2)
+		+ ((iTime >> (iOctave - 2)) & 3) + 1;
+
+	return (iBin < Bins ? iBin : Bins - 1);
+}
+
+
+// Upper bound time of a histogram bin (nanoseconds).
+uint64_t qtractorDspLoad::binTime ( unsigned int iBin )
+{
+	if (iBin < 1)
+		return 64;
+
+	const unsigned int iOctave = ((iBin - 1) >> 2) + 6;
+	const uint64_t iStep = ((iBin - 1) & 3) + 5;
+
+	return (iStep << (iOctave - 2));
+}
+
+
+// Session-wide statistics update (GUI thread).
+void qtractorDspLoad::updateSession ( qtractorSession *pSession )
+{
+	if (pSession == nullptr)
+		return;
+
+	const uint64_t iNow = timeNow();
+
+	// Tracks and their plugin chains...
+	for (qtractorTrack *pTrack = pSession->tracks().first();
+			pTrack; pTrack = pTrack->next()) {
+		pTrack->dspLoad()->update(iNow);
+		updatePluginList(pTrack->pluginList(), iNow);
+	}
+
+	// Buses and their plugin chains...
+	updateEngine(pSession->audioEngine(), iNow);
+	updateEngine(pSession->midiEngine(), iNow);
+}
+
+
+void qtractorDspLoad::updateEngine (
+	qtractorEngine *pEngine, uint64_t iNow )
+{
+	if (pEngine == nullptr)
+		return;
+
+	for (qtractorBus *pBus = pEngine->buses().first();
+			pBus; pBus = pBus->next()) {
+		pBus->dspLoad()->update(iNow);
+		updatePluginList(pBus->pluginList_in(), iNow);
+		updatePluginList(pBus->pluginList_out(), iNow);
+	}
+}
+
+
+void qtractorDspLoad::updatePluginList (
+	qtractorPluginList *pPluginList, uint64_t iNow )
+{
+	if (pPluginList == nullptr)
+		return;
+
+	for (qtractorPlugin *pPlugin = pPluginList->first();
+			pPlugin; pPlugin = pPlugin->next()) {
+		pPlugin->dspLoad()->update(iNow);
+	}
+}
+
+
+// Session-wide statistics CSV dump (GUI thread).
+bool qtractorDspLoad::saveSession (
+	qtractorSession *pSession, const QString& sFilename )
+{
+	if (pSession == nullptr)
+		return false;
+
+	QFile file(sFilename);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+		return false;
+
+	QTextStream ts(&file);
+
+	ts << "kind,name,calls_per_sec,load_percent,"
+		"min_us,avg_us,max_us,p99_us" << endl;
+
+	// Tracks and their plugin chains...
+	for (qtractorTrack *pTrack = pSession->tracks().first();
+			pTrack; pTrack = pTrack->next()) {
+		const QString& sTrackName = pTrack->trackName();
+		saveLine(ts, "track", sTrackName, *pTrack->dspLoad());
+		savePluginList(ts, sTrackName, pTrack->pluginList());
+	}
+
+	// Buses and their plugin chains...
+	saveEngine(ts, pSession->audioEngine());
+	saveEngine(ts, pSession->midiEngine());
+
+	file.close();
+
+	return true;
+}
+
+
+void qtractorDspLoad::saveEngine ( QTextStream& ts, qtractorEngine *pEngine )
+{
+	if (pEngine == nullptr)
+		return;
+
+	for (qtractorBus *pBus = pEngine->buses().first();
+			pBus; pBus = pBus->next()) {
+		const QString& sBusName = pBus->busName();
+		saveLine(ts, "bus", sBusName, *pBus->dspLoad());
+		savePluginList(ts, sBusName + " (in)", pBus->pluginList_in());
+		savePluginList(ts, sBusName + " (out)", pBus->pluginList_out());
+	}
+}
+
+
+void qtractorDspLoad::savePluginList ( QTextStream& ts,
+	const QString& sName, qtractorPluginList *pPluginList )
+{
+	if (pPluginList == nullptr)
+		return;
+
+	for (qtractorPlugin *pPlugin = pPluginList->first();
+			pPlugin; pPlugin = pPlugin->next()) {
+		saveLine(ts, "plugin", sName + " / " + pPlugin->title(),
+			*pPlugin->dspLoad());
+	}
+}
+
+
+void qtractorDspLoad::saveLine ( QTextStream& ts,
+	const QString& sKind, const QString& sName,
+	const qtractorDspLoad& dspLoad )
+{
+	// Quote the name, doubling any embedded quotes...
+	QString sText = sName;
+	sText.replace('"', "\"\"");
+
+	ts << sKind << ",\"" << sText << "\","
+		<< QString::number(dspLoad.rate(), 'f', 1) << ','
+		<< QString::number(dspLoad.load(), 'f', 3) << ','
+		<< QString::number(dspLoad.minTime(), 'f', 3) << ','
+		<< QString::number(dspLoad.avgTime(), 'f', 3) << ','
+		<< QString::number(dspLoad.maxTime(), 'f', 3) << ','
+		<< QString::number(dspLoad.p99Time(), 'f', 3) << endl;
+}
+
+
+// end of qtractorDspLoad.cpp
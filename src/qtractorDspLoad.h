@@ -0,0 +1,170 @@
+// qtractorDspLoad.h
+//
+/****************************************************************************
+   Copyright (C) 2005-2025, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#ifndef __qtractorDspLoad_h
+#define __qtractorDspLoad_h
+
+#include "qtractorAtomic.h"
+
+#include <QString>
+
+#include <stdint.h>
+
+
+// Forward declarations.
+class qtractorSession;
+class qtractorEngine;
+class qtractorPluginList;
+class QTextStream;
+
+
+//----------------------------------------------------------------------
+// class qtractorDspLoad -- Process call timing statistics.
+//
+// The real-time thread only ever writes to the current bank, while
+// the GUI thread flips banks on each update() and reads the one left
+// behind in the previous period, so no locking is ever needed.
+
+class qtractorDspLoad
+{
+public:
+
+	// Constructor.
+	qtractorDspLoad();
+
+	// Process call time recorder (RT-safe, scoped).
+	class Scope
+	{
+	public:
+
+		Scope(qtractorDspLoad *pDspLoad)
+			: m_pDspLoad(qtractorDspLoad::isEnabled() ? pDspLoad : nullptr),
+				m_iStart(m_pDspLoad ? qtractorDspLoad::timeNow() : 0) {}
+
+		~Scope()
+			{ if (m_pDspLoad) m_pDspLoad->record(qtractorDspLoad::timeNow() - m_iStart); }
+
+	private:
+
+		qtractorDspLoad *m_pDspLoad;
+		uint64_t m_iStart;
+	};
+
+	// Record one process call time in nanoseconds (RT-safe).
+	void record(uint64_t iTime);
+
+	// Period statistics update (GUI thread).
+	void update(uint64_t iNow);
+
+	// Reset all statistics.
+	void reset();
+
+	// Last period statistics accessors (GUI thread).
+	unsigned int calls() const { return m_iCalls; }
+	float rate() const { return m_fRate; }
+	float minTime() const { return m_fMinTime; }
+	float avgTime() const { return m_fAvgTime; }
+	float maxTime() const { return m_fMaxTime; }
+	float p99Time() const { return m_fP99Time; }
+	float load() const { return m_fLoad; }
+
+	// Whether there's anything to show at all.
+	bool isValid() const { return (m_iCalls > 0); }
+
+	// Pretty statistics text (usecs).
+	QString text() const;
+	QString toolTip() const;
+
+	// Global profiling state.
+	static void setEnabled(bool bEnabled);
+	static bool isEnabled();
+
+	// Monotonic high-resolution clock (nanoseconds).
+	static uint64_t timeNow();
+
+	// Session-wide statistics update (GUI thread).
+	static void updateSession(qtractorSession *pSession);
+
+	// Session-wide statistics CSV dump (GUI thread).
+	static bool saveSession(qtractorSession *pSession, const QString& sFilename);
+
+protected:
+
+	// Histogram bin helpers.
+	static unsigned int timeBin(uint64_t iTime);
+	static uint64_t binTime(unsigned int iBin);
+
+	// Bus and plugin chain helpers.
+	static void updateEngine(qtractorEngine *pEngine, uint64_t iNow);
+	static void updatePluginList(qtractorPluginList *pPluginList, uint64_t iNow);
+
+	static void saveEngine(QTextStream& ts, qtractorEngine *pEngine);
+	static void savePluginList(QTextStream& ts,
+		const QString& sName, qtractorPluginList *pPluginList);
+
+	static void saveLine(QTextStream& ts,
+		const QString& sKind, const QString& sName,
+		const qtractorDspLoad& dspLoad);
+
+private:
+
+	// Log-scale histogram: 4 bins per octave, from 64ns up.
+	enum { Bins = 128 };
+
+	// Per-period statistics bank.
+	struct Bank
+	{
+		unsigned int count;
+		uint64_t     total;
+		uint64_t     min;
+		uint64_t     max;
+		unsigned int hist[Bins];
+	};
+
+	Bank m_banks[2];
+
+	// Current RT written bank index.
+	qtractorAtomic m_bank;
+
+	// Last flip time (nanoseconds).
+	uint64_t m_iFlipTime;
+	uint64_t m_iPeriod;
+
+	// Last period statistics (usecs).
+	unsigned int m_iCalls;
+	float        m_fRate;
+
+	float m_fMinTime;
+	float m_fAvgTime;
+	float m_fMaxTime;
+	float m_fP99Time;
+
+	// Time spent over wall time (percent).
+	float m_fLoad;
+
+	// Global profiling state.
+	static qtractorAtomic g_enabled;
+};
+
+
+#endif  // __qtractorDspLoad_h
+
+// end of qtractorDspLoad.h
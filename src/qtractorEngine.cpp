@@ -30,6 +30,8 @@
 #include "qtractorEngineCommand.h"
 
 #include "qtractorMonitor.h"
+#include "qtractorMidiManager.h"
+#include "qtractorPlugin.h"
 
 #include "qtractorDocument.h"
 #include "qtractorCurveFile.h"
@@ -525,6 +527,22 @@ qtractorTrack::TrackType qtractorBus::busType (void) const
 }
 
 
+// Process call timing statistics: MIDI buses get their
+// output plugin chain timed by the MIDI manager, if any, instead.
+qtractorDspLoad *qtractorBus::dspLoad (void)
+{
+	if (busType() == qtractorTrack::Midi) {
+		qtractorPluginList *pPluginList = pluginList_out();
+		qtractorMidiManager *pMidiManager
+			= (pPluginList ? pPluginList->midiManager() : nullptr);
+		if (pMidiManager)
+			return pMidiManager->dspLoad();
+	}
+
+	return &m_dspLoad;
+}
+
+
 // Bus name accessors.
 void qtractorBus::setBusName ( const QString& sBusName )
 {
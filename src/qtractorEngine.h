@@ -23,6 +23,7 @@
 #define __qtractorEngine_h
 
 #include "qtractorTrack.h"
+#include "qtractorDspLoad.h"
 
 
 // Forward declarations.
@@ -290,6 +291,9 @@ public:
 		}
 	};
 
+	// Process call timing statistics (output commit).
+	qtractorDspLoad *dspLoad();
+
 	// Connection lists accessors.
 	ConnectList& inputs()  { return m_inputs;  }
 	ConnectList& outputs() { return m_outputs; }
@@ -381,6 +385,9 @@ private:
 
 	qtractorMidiControl::Controllers m_controllers_in;
 	qtractorMidiControl::Controllers m_controllers_out;
+
+	// Process call timing statistics.
+	qtractorDspLoad m_dspLoad;
 };
 
 
@@ -804,8 +804,9 @@ void qtractorExportTrackForm::accept (void)
 				else pMainForm->addAudioFile(sExportPath);
 				// Log the success...
 				pMainForm->appendMessages(
-					tr("Audio file export: \"%1\" complete.")
-					.arg(sExportPath));
+					tr("Audio file export: \"%1\" complete (%2x real-time).")
+					.arg(sExportPath)
+					.arg(pAudioEngine->exportSpeed(), 0, 'f', 1));
 			} else {
 				// Log the failure...
 				pMainForm->appendMessagesError(
@@ -1543,12 +1543,14 @@ void qtractorAudioAuxSendPlugin::process (
 // Do the actual activation.
 void qtractorAudioAuxSendPlugin::activate (void)
 {
+	list()->setAudioAuxSendActivated(true);
 }
 
 
 // Do the actual deactivation.
 void qtractorAudioAuxSendPlugin::deactivate (void)
 {
+	list()->setAudioAuxSendActivated(false);
 }
 
 
@@ -427,6 +427,15 @@ void qtractorLadspaPlugin::deactivate (void)
 // The main plugin processing procedure.
 void qtractorLadspaPlugin::process (
 	float **ppIBuffer, float **ppOBuffer, unsigned int nframes )
+{
+	// Sample-accurate automation, in sub-blocks if needed...
+	process_split(ppIBuffer, ppOBuffer, nframes);
+}
+
+
+// Sub-block processing procedure (plain control ports).
+void qtractorLadspaPlugin::process_block (
+	float **ppIBuffer, float **ppOBuffer, unsigned int nframes )
 {
 	if (m_phInstances == nullptr)
 		return;
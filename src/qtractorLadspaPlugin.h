@@ -116,6 +116,9 @@ public:
 
 protected:
 
+	// Sub-block processing procedure (plain control ports).
+	void process_block(float **ppIBuffer, float **ppOBuffer, unsigned int nframes);
+
 	// Instance variables.
 	LADSPA_Handle *m_phInstances;
 
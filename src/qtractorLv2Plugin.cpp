@@ -3098,6 +3098,32 @@ void qtractorLv2Plugin::deactivate (void)
 // The main plugin processing procedure.
 void qtractorLv2Plugin::process (
 	float **ppIBuffer, float **ppOBuffer, unsigned int nframes )
+{
+#if defined(CONFIG_LV2_EVENT) || defined(CONFIG_LV2_ATOM)
+	// Event/atom buffers can't be split, run it whole...
+	qtractorLv2PluginType *pLv2Type
+		= static_cast<qtractorLv2PluginType *> (type());
+	unsigned short iEvents = 0;
+#ifdef CONFIG_LV2_EVENT
+	iEvents += pLv2Type->eventIns() + pLv2Type->eventOuts();
+#endif
+#ifdef CONFIG_LV2_ATOM
+	iEvents += pLv2Type->atomIns() + pLv2Type->atomOuts();
+#endif
+	if (iEvents > 0) {
+		process_block(ppIBuffer, ppOBuffer, nframes);
+		return;
+	}
+#endif
+
+	// Sample-accurate automation, in sub-blocks if needed...
+	process_split(ppIBuffer, ppOBuffer, nframes);
+}
+
+
+// Sub-block processing procedure (plain control ports).
+void qtractorLv2Plugin::process_block (
+	float **ppIBuffer, float **ppOBuffer, unsigned int nframes )
 {
 	if (m_ppInstances == nullptr)
 		return;
@@ -464,6 +464,9 @@ public:
 
 protected:
 
+	// Sub-block processing procedure (plain control ports).
+	void process_block(float **ppIBuffer, float **ppOBuffer, unsigned int nframes);
+
 	// Update instrument/programs cache.
 	void updateInstruments();
 
@@ -40,6 +40,8 @@
 #include "qtractorMonitor.h"
 
 #include "qtractorAudioPeak.h"
+#include "qtractorAudioRender.h"
+#include "qtractorAudioPageCache.h"
 #include "qtractorAudioBuffer.h"
 #include "qtractorAudioEngine.h"
 #include "qtractorMidiEngine.h"
@@ -80,6 +82,7 @@
 #include "qtractorMessageList.h"
 
 #include "qtractorPluginFactory.h"
+#include "qtractorDspLoad.h"
 
 #ifdef CONFIG_DSSI
 #include "qtractorDssiPlugin.h"
@@ -127,6 +130,7 @@
 #include <QLabel>
 #include <QTimer>
 #include <QDateTime>
+#include <QThread>
 #include <QClipboard>
 #include <QProgressBar>
 
@@ -275,6 +279,9 @@ qtractorMainForm::qtractorMainForm (
 
 	m_iPlayerTimer = 0;
 
+	m_iIdleSkipTimer = 0;
+	m_iDspLoadTimer = 0;
+
 	m_pNsmClient = nullptr;
 	m_bNsmDirty  = false;
 
@@ -1114,6 +1121,12 @@ qtractorMainForm::qtractorMainForm (
 	QObject::connect(m_ui.viewToolTipsAction,
 		SIGNAL(triggered(bool)),
 		SLOT(viewToolTips(bool)));
+	QObject::connect(m_ui.viewDspLoadAction,
+		SIGNAL(triggered(bool)),
+		SLOT(viewDspLoad(bool)));
+	QObject::connect(m_ui.viewDspLoadSaveAction,
+		SIGNAL(triggered(bool)),
+		SLOT(viewDspLoadSave()));
 	QObject::connect(m_ui.viewRefreshAction,
 		SIGNAL(triggered(bool)),
 		SLOT(viewRefresh()));
@@ -1448,6 +1461,8 @@ void qtractorMainForm::setup ( qtractorOptions *pOptions )
 	m_ui.viewSnapZebraAction->setChecked(pOptions->bTrackViewSnapZebra);
 	m_ui.viewSnapGridAction->setChecked(pOptions->bTrackViewSnapGrid);
 	m_ui.viewToolTipsAction->setChecked(pOptions->bTrackViewToolTips);
+	m_ui.viewDspLoadAction->setChecked(pOptions->bAudioDspLoad);
+	qtractorDspLoad::setEnabled(pOptions->bAudioDspLoad);
 
 	m_ui.transportCountInAction->setChecked(m_pOptions->bCountIn);
 	m_ui.transportMetroAction->setChecked(m_pOptions->bMetronome);
@@ -1529,10 +1544,13 @@ void qtractorMainForm::setup ( qtractorOptions *pOptions )
 	updateTransportModePost();
 	updateTimebase();
 	updateAudioPlayer();
+	updateAudioTaskThreads();
 	updateAudioMetronome();
 	updateMidiControlModes();
 	updateMidiQueueTimer();
 	updateMidiDriftCorrect();
+	updateMidiJackOutput();
+	updateMidiJackInput();
 	updateMidiPlayer();
 	updateMidiControl();
 	updateMidiMetronome();
@@ -1555,12 +1573,17 @@ void qtractorMainForm::setup ( qtractorOptions *pOptions )
 	// Set default audio-buffer quality...
 	qtractorAudioBuffer::setDefaultResampleType(
 		m_pOptions->iAudioResampleType);
+	// Set in-memory (integral) preload budget (in MB)...
+	qtractorAudioBuffer::setPreloadMaxSize(m_pOptions->iAudioPreloadSize > 0
+		? (unsigned long) m_pOptions->iAudioPreloadSize << 20 : 0);
 
 	unsigned int iStretcherFlags = 0;
 	if (m_pOptions->bAudioWsolaTimeStretch)
 		iStretcherFlags |= qtractorTimeStretcher::WsolaTimeStretch;
 	if (m_pOptions->bAudioWsolaQuickSeek)
 		iStretcherFlags |= qtractorTimeStretcher::WsolaQuickSeek;
+	if (m_pOptions->bAudioWsolaCoarseSeek)
+		iStretcherFlags |= qtractorTimeStretcher::WsolaCoarseSeek;
 #ifdef CONFIG_LIBRUBBERBAND
 	if (m_pOptions->bAudioRubberBandFormant)
 		iStretcherFlags |= qtractorTimeStretcher::RubberBandFormant;
@@ -1586,8 +1609,42 @@ void qtractorMainForm::setup ( qtractorOptions *pOptions )
 
 	// Some special defaults...
 	qtractorAudioEngine *pAudioEngine = m_pSession->audioEngine();
-	if (pAudioEngine)
+	if (pAudioEngine) {
 		pAudioEngine->setMasterAutoConnect(m_pOptions->bAudioMasterAutoConnect);
+		pAudioEngine->setGraphThreads(
+			m_pOptions->iAudioGraphThreads > 0 ? m_pOptions->iAudioGraphThreads : 0);
+		pAudioEngine->setGraphDeterministic(m_pOptions->bAudioGraphDeterministic);
+		qtractorPlugin::setGraphSerialPlugins(m_pOptions->audioGraphSerialPlugins);
+		pAudioEngine->setExportOffline(m_pOptions->bAudioExportOffline);
+		int iExportThreads = m_pOptions->iAudioExportThreads;
+		if (iExportThreads < 0) // Auto: all cores but one.
+			iExportThreads = QThread::idealThreadCount() - 1;
+		pAudioEngine->setExportThreads(iExportThreads > 0 ? iExportThreads : 0);
+	}
+
+	// Peak file creation threads...
+	qtractorAudioPeakFactory *pPeakFactory
+		= m_pSession->audioPeakFactory();
+	if (pPeakFactory) {
+		int iPeakThreads = m_pOptions->iPeakThreads;
+		if (iPeakThreads < 0) // Auto: all cores but one.
+			iPeakThreads = QThread::idealThreadCount() - 1;
+		pPeakFactory->setPeakThreads(iPeakThreads > 0 ? iPeakThreads : 1);
+	}
+
+	// Pre-rendered time-stretch/pitch-shift cache...
+	qtractorAudioRenderFactory *pRenderFactory
+		= m_pSession->audioRenderFactory();
+	if (pRenderFactory)
+		pRenderFactory->setEnabled(m_pOptions->bAudioRenderCache);
+
+	// Shared decoded audio page cache budget (in MB)...
+	qtractorAudioPageCache *pPageCache = m_pSession->audioPageCache();
+	if (pPageCache) {
+		const int iPageCacheSize = m_pOptions->iAudioPageCacheSize;
+		pPageCache->setMaxSize(iPageCacheSize > 0
+			? (unsigned long) iPageCacheSize << 20 : 0);
+	}
 	
 	// Final widget slot connections....
 	QObject::connect(m_pFileSystem->toggleViewAction(),
@@ -1799,6 +1856,7 @@ bool qtractorMainForm::queryClose (void)
 			m_pOptions->bTrackViewSnapZebra = m_ui.viewSnapZebraAction->isChecked();
 			m_pOptions->bTrackViewSnapGrid = m_ui.viewSnapGridAction->isChecked();
 			m_pOptions->bTrackViewToolTips = m_ui.viewToolTipsAction->isChecked();
+			m_pOptions->bAudioDspLoad = m_ui.viewDspLoadAction->isChecked();
 			m_pOptions->bTrackViewCurveEdit = m_ui.editSelectModeCurveAction->isChecked();
 			m_pOptions->bCountIn = m_ui.transportCountInAction->isChecked();
 			m_pOptions->bMetronome = m_ui.transportMetroAction->isChecked();
@@ -5204,6 +5262,58 @@ void qtractorMainForm::viewToolTips ( bool bOn )
 }
 
 
+// Set DSP load profiling mode.
+void qtractorMainForm::viewDspLoad ( bool bOn )
+{
+	qtractorDspLoad::setEnabled(bOn);
+
+	// Either start or clear all statistics over...
+	m_iDspLoadTimer = 0;
+	qtractorDspLoad::updateSession(m_pSession);
+
+	if (m_pMixer)
+		m_pMixer->updateDspLoads();
+}
+
+
+// Save current DSP load statistics.
+void qtractorMainForm::viewDspLoadSave (void)
+{
+	QString sFilename = QFileInfo(m_pSession->sessionDir(),
+		qtractorSession::sanitize(m_pSession->sessionName())
+		+ "-dsp.csv").absoluteFilePath();
+
+	const QString& sTitle
+		= tr("Save DSP Load");
+	const QString& sFilter
+		= tr("CSV files (*.csv)") + ";;" + tr("All files (*.*)");
+	QWidget *pParentWidget = nullptr;
+	QFileDialog::Options options;
+	if (m_pOptions->bDontUseNativeDialogs) {
+		options |= QFileDialog::DontUseNativeDialog;
+		pParentWidget = QWidget::window();
+	}
+	sFilename = QFileDialog::getSaveFileName(pParentWidget,
+		sTitle, sFilename, sFilter, nullptr, options);
+
+	// Have we cancelled it?
+	if (sFilename.isEmpty())
+		return;
+	// Enforce extension...
+	if (QFileInfo(sFilename).suffix().isEmpty())
+		sFilename += ".csv";
+
+	if (qtractorDspLoad::saveSession(m_pSession, sFilename)) {
+		appendMessages(tr("DSP load statistics saved: \"%1\".")
+			.arg(sFilename));
+	} else {
+		appendMessagesError(
+			tr("Could not save DSP load statistics:\n\n\"%1\".\n\nSorry.")
+			.arg(sFilename));
+	}
+}
+
+
 // Change snap-per-beat setting via menu.
 void qtractorMainForm::viewSnap (void)
 {
@@ -5346,6 +5456,7 @@ void qtractorMainForm::viewOptions (void)
 	const int     iOldResampleType       = m_pOptions->iAudioResampleType;
 	const bool    bOldWsolaTimeStretch   = m_pOptions->bAudioWsolaTimeStretch;
 	const bool    bOldWsolaQuickSeek     = m_pOptions->bAudioWsolaQuickSeek;
+	const bool    bOldWsolaCoarseSeek    = m_pOptions->bAudioWsolaCoarseSeek;
 	const bool    bOldRubberBandFormant  = m_pOptions->bAudioRubberBandFormant;
 	const bool    bOldRubberBandFinerR3  = m_pOptions->bAudioRubberBandFinerR3;
 	const bool    bOldAudioPlayerAutoConnect = m_pOptions->bAudioPlayerAutoConnect;
@@ -5361,6 +5472,9 @@ void qtractorMainForm::viewOptions (void)
 	const int     iOldMidiCaptureQuantize = m_pOptions->iMidiCaptureQuantize;
 	const int     iOldMidiQueueTimer     = m_pOptions->iMidiQueueTimer;
 	const bool    bOldMidiDriftCorrect   = m_pOptions->bMidiDriftCorrect;
+	const bool    bOldMidiJackOutput     = m_pOptions->bMidiJackOutput;
+	const bool    bOldMidiJackInput      = m_pOptions->bMidiJackInput;
+	const int     iOldAudioTaskThreads   = m_pOptions->iAudioTaskThreads;
 	const bool    bOldMidiPlayerBus      = m_pOptions->bMidiPlayerBus;
 	const QString sOldMetroBarFilename   = m_pOptions->sMetroBarFilename;
 	const float   fOldMetroBarGain       = m_pOptions->fMetroBarGain;
@@ -5411,6 +5525,8 @@ void qtractorMainForm::viewOptions (void)
 			(!bOldWsolaTimeStretch  &&  m_pOptions->bAudioWsolaTimeStretch)  ||
 			( bOldWsolaQuickSeek    && !m_pOptions->bAudioWsolaQuickSeek)    ||
 			(!bOldWsolaQuickSeek    &&  m_pOptions->bAudioWsolaQuickSeek)    ||
+			( bOldWsolaCoarseSeek   && !m_pOptions->bAudioWsolaCoarseSeek)   ||
+			(!bOldWsolaCoarseSeek   &&  m_pOptions->bAudioWsolaCoarseSeek)   ||
 			( bOldRubberBandFormant && !m_pOptions->bAudioRubberBandFormant) ||
 			(!bOldRubberBandFormant &&  m_pOptions->bAudioRubberBandFormant) ||
 			( bOldRubberBandFinerR3 && !m_pOptions->bAudioRubberBandFinerR3) ||
@@ -5420,6 +5536,8 @@ void qtractorMainForm::viewOptions (void)
 				iStretcherFlags |= qtractorTimeStretcher::WsolaTimeStretch;
 			if (m_pOptions->bAudioWsolaQuickSeek)
 				iStretcherFlags |= qtractorTimeStretcher::WsolaQuickSeek;
+			if (m_pOptions->bAudioWsolaCoarseSeek)
+				iStretcherFlags |= qtractorTimeStretcher::WsolaCoarseSeek;
 		#ifdef CONFIG_LIBRUBBERBAND
 			if (m_pOptions->bAudioRubberBandFormant)
 				iStretcherFlags |= qtractorTimeStretcher::RubberBandFormant;
@@ -5544,10 +5662,27 @@ void qtractorMainForm::viewOptions (void)
 			( bOldAudioPlayerAutoConnect && !m_pOptions->bAudioPlayerAutoConnect) ||
 			(!bOldAudioPlayerAutoConnect &&  m_pOptions->bAudioPlayerAutoConnect))
 			updateAudioPlayer();
+		// Audio engine real-time task pool option...
+		if (iOldAudioTaskThreads != m_pOptions->iAudioTaskThreads) {
+			updateAudioTaskThreads();
+			iNeedRestart |= RestartSession;
+		}
 		// MIDI engine drift correction option...
 		if (( bOldMidiDriftCorrect && !m_pOptions->bMidiDriftCorrect) ||
 			(!bOldMidiDriftCorrect &&  m_pOptions->bMidiDriftCorrect))
 			updateMidiDriftCorrect();
+		// MIDI engine output through JACK option...
+		if (( bOldMidiJackOutput && !m_pOptions->bMidiJackOutput) ||
+			(!bOldMidiJackOutput &&  m_pOptions->bMidiJackOutput)) {
+			updateMidiJackOutput();
+			iNeedRestart |= RestartSession;
+		}
+		// MIDI engine capture through JACK option...
+		if (( bOldMidiJackInput && !m_pOptions->bMidiJackInput) ||
+			(!bOldMidiJackInput &&  m_pOptions->bMidiJackInput)) {
+			updateMidiJackInput();
+			iNeedRestart |= RestartSession;
+		}
 		// MIDI engine player options...
 		if (( bOldMidiPlayerBus && !m_pOptions->bMidiPlayerBus) ||
 			(!bOldMidiPlayerBus &&  m_pOptions->bMidiPlayerBus))
@@ -7209,6 +7344,11 @@ void qtractorMainForm::updatePeakAutoRemove (void)
 		= m_pSession->audioPeakFactory();
 	if (pPeakFactory)
 		pPeakFactory->setAutoRemove(m_pOptions->bPeakAutoRemove);
+
+	qtractorAudioRenderFactory *pRenderFactory
+		= m_pSession->audioRenderFactory();
+	if (pRenderFactory)
+		pRenderFactory->setAutoRemove(m_pOptions->bPeakAutoRemove);
 }
 
 
@@ -7227,6 +7367,21 @@ void qtractorMainForm::updateDisplayFormat (void)
 }
 
 
+// Update audio real-time task pool size (effective on next activation).
+void qtractorMainForm::updateAudioTaskThreads (void)
+{
+	if (m_pOptions == nullptr)
+		return;
+
+	int iTaskThreads = m_pOptions->iAudioTaskThreads;
+	if (iTaskThreads < 0) // Auto: all cores but one.
+		iTaskThreads = QThread::idealThreadCount() - 1;
+
+	m_pSession->audioEngine()->setTaskThreads(
+		iTaskThreads > 0 ? iTaskThreads : 0);
+}
+
+
 // Update audio player parameters.
 void qtractorMainForm::updateAudioPlayer (void)
 {
@@ -7345,6 +7500,28 @@ void qtractorMainForm::updateMidiDriftCorrect (void)
 }
 
 
+// Update MIDI output through JACK (effective on next bus activation).
+void qtractorMainForm::updateMidiJackOutput (void)
+{
+	if (m_pOptions == nullptr)
+		return;
+
+	// Configure the MIDI engine output mode...
+	m_pSession->midiEngine()->setJackMidiOutput(m_pOptions->bMidiJackOutput);
+}
+
+
+// Update MIDI capture through JACK (effective on next bus activation).
+void qtractorMainForm::updateMidiJackInput (void)
+{
+	if (m_pOptions == nullptr)
+		return;
+
+	// Configure the MIDI engine input mode...
+	m_pSession->midiEngine()->setJackMidiInput(m_pOptions->bMidiJackInput);
+}
+
+
 // Update MIDI player parameters.
 void qtractorMainForm::updateMidiPlayer (void)
 {
@@ -8218,6 +8395,9 @@ void qtractorMainForm::slowTimerSlot (void)
 	qtractorAudioEngine *pAudioEngine = m_pSession->audioEngine();
 	qtractorMidiEngine  *pMidiEngine  = m_pSession->midiEngine();
 
+	// Start the real-time task pool workers, if requested...
+	pAudioEngine->updateTaskPool();
+
 	// Read JACK transport state...
 	jack_client_t *pJackClient = pAudioEngine->jackClient();
 	if (pJackClient && !pAudioEngine->isFreewheel()) {
@@ -8301,6 +8481,8 @@ void qtractorMainForm::slowTimerSlot (void)
 					++m_iTransportUpdate;
 				}
 			}
+			// Keep captured MIDI event storage topped up...
+			pMidiEngine->reserveInpEvents();
 			// Recording visual feedback...
 			m_pTracks->updateContentsRecord();
 			m_pSession->updateSession(0, iPlayHead);
@@ -8423,6 +8605,52 @@ void qtractorMainForm::slowTimerSlot (void)
 		}
 	}
 
+	// Idle plugin calls skipped, per second...
+	m_iIdleSkipTimer += QTRACTOR_TIMER_DELAY;
+	if (m_iIdleSkipTimer >= 1000) {
+		const unsigned int iIdleSkipCount
+			= qtractorPluginList::takeIdleSkipCount();
+		const unsigned int iIdleSkipRate
+			= (iIdleSkipCount * 1000) / m_iIdleSkipTimer;
+		m_iIdleSkipTimer = 0;
+		m_statusItems[StatusSize]->setToolTip(
+			tr("Session buffer size\n(idle plugin calls skipped: %1/s)")
+			.arg(iIdleSkipRate));
+		// MIDI output jitter (JACK and ALSA) and MIDI input
+		// offset, since playback start...
+		QString sRateToolTip = tr("Session sample rate");
+		if (pMidiEngine->jitterCount(qtractorMidiEngine::JackJitter) > 0) {
+			sRateToolTip += '\n';
+			sRateToolTip += tr("(JACK MIDI output jitter: avg %1, max %2 frames)")
+				.arg(pMidiEngine->jitterAvg(qtractorMidiEngine::JackJitter), 0, 'f', 1)
+				.arg(pMidiEngine->jitterMax(qtractorMidiEngine::JackJitter));
+		}
+		if (pMidiEngine->jitterCount(qtractorMidiEngine::AlsaJitter) > 0) {
+			sRateToolTip += '\n';
+			sRateToolTip += tr("(ALSA MIDI output jitter: avg %1, max %2 frames)")
+				.arg(pMidiEngine->jitterAvg(qtractorMidiEngine::AlsaJitter), 0, 'f', 1)
+				.arg(pMidiEngine->jitterMax(qtractorMidiEngine::AlsaJitter));
+		}
+		if (pMidiEngine->inputOffsetCount() > 0) {
+			sRateToolTip += '\n';
+			sRateToolTip += tr("(MIDI input offset: avg %1, max %2 frames)")
+				.arg(pMidiEngine->inputOffsetAvg(), 0, 'f', 1)
+				.arg(pMidiEngine->inputOffsetMax());
+		}
+		m_statusItems[StatusRate]->setToolTip(sRateToolTip);
+	}
+
+	// DSP load statistics, per second...
+	if (qtractorDspLoad::isEnabled()) {
+		m_iDspLoadTimer += QTRACTOR_TIMER_DELAY;
+		if (m_iDspLoadTimer >= 1000) {
+			m_iDspLoadTimer = 0;
+			qtractorDspLoad::updateSession(m_pSession);
+			if (m_pMixer && m_pMixer->isVisible())
+				m_pMixer->updateDspLoads();
+		}
+	}
+
 	// Slower plugin UI idle cycle...
 #ifdef CONFIG_DSSI
 #ifdef CONFIG_LIBLO
@@ -9301,7 +9529,28 @@ void qtractorMainForm::changeNotifySlot ( qtractorMidiEditor *pMidiEditor )
 	qDebug("qtractorMainForm::changeNotifySlot(%p)", pMidiEditor);
 #endif
 
-	updateContents(pMidiEditor, true);
+	qtractorMidiClip *pMidiClip
+		= (pMidiEditor ? pMidiEditor->midiClip() : nullptr);
+	if (pMidiClip == nullptr || m_pTracks == nullptr) {
+		updateContents(pMidiEditor, true);
+		return;
+	}
+
+	// Redraw just the edited (linked) clips, unless
+	// the session has grown or shrunk meanwhile...
+	const unsigned long iSessionEnd = m_pSession->sessionEnd();
+	updateContents(pMidiEditor, false);
+	if (m_pSession->sessionEnd() != iSessionEnd) {
+		m_pTracks->updateContents(true);
+	} else {
+		qtractorTrackView *pTrackView = m_pTracks->trackView();
+		QList<qtractorMidiClip *> clips = pMidiClip->linkedClips();
+		if (clips.isEmpty())
+			clips.append(pMidiClip);
+		QListIterator<qtractorMidiClip *> iter(clips);
+		while (iter.hasNext())
+			pTrackView->updateClip(iter.next(), true);
+	}
 }
 
 
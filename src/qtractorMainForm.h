@@ -262,6 +262,8 @@ public slots:
 	void viewSnapZebra(bool bOn);
 	void viewSnapGrid(bool bOn);
 	void viewToolTips(bool bOn);
+	void viewDspLoad(bool bOn);
+	void viewDspLoadSave();
 	void viewSnap();
 	void viewRefresh();
 	void viewInstruments();
@@ -431,8 +433,11 @@ protected:
 	void updateTimebase();
 	void updateMidiControlModes();
 	void updateAudioPlayer();
+	void updateAudioTaskThreads();
 	void updateMidiQueueTimer();
 	void updateMidiDriftCorrect();
+	void updateMidiJackOutput();
+	void updateMidiJackInput();
 	void updateMidiPlayer();
 	void updateMidiControl();
 	void updateAudioMetronome();
@@ -517,6 +522,8 @@ private:
 	int m_iAudioRefreshTimer;
 	int m_iMidiRefreshTimer;
 	int m_iPlayerTimer;
+	int m_iIdleSkipTimer;
+	int m_iDspLoadTimer;
 	int m_iAutoSaveTimer;
 	int m_iAutoSavePeriod;
 	int m_iAudioPropertyChange;
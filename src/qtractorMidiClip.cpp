@@ -196,6 +196,9 @@ qtractorMidiClip::qtractorMidiClip ( qtractorTrack *pTrack )
 	m_iStepInputTailTime = 0;
 	m_iStepInputLast = 0;
 
+	m_pSchedule = nullptr;
+	m_iScheduleEpoch = 0;
+
 	clearInpEvents();
 }
 
@@ -235,6 +238,9 @@ qtractorMidiClip::qtractorMidiClip ( const qtractorMidiClip& clip )
 
 	m_iBeatsPerBar2 = clip.beatsPerBar2();
 	m_iBeatDivisor2 = clip.beatDivisor2();
+
+	m_pSchedule = nullptr;
+	m_iScheduleEpoch = 0;
 }
 
 
@@ -249,6 +255,8 @@ qtractorMidiClip::~qtractorMidiClip (void)
 	}
 
 	closeMidiFile();
+
+	freeSchedules(true);
 }
 
 
@@ -551,6 +559,8 @@ void qtractorMidiClip::closeMidiFile (void)
 {
 	clearInpEvents();
 
+	clearSchedule();
+
 	if (m_pData) {
 		m_pData->detach(this);
 		if (m_pData->count() < 1) {
@@ -968,13 +978,51 @@ void qtractorMidiClip::process (
 		|| (pSession->soloTracks() && !pTrack->isSolo()));
 
 	const unsigned long iClipStart = clipStart();
+
+	// Enqueue the requested events...
+	const float fGain = clipGain();
+
+	// Pre-computed schedule, if published and current...
+	m_iScheduleEpoch.fetch_add(1);
+	const Schedule *pSchedule = m_pSchedule.load();
+	if (pSchedule && pSchedule->seq == pSeq && pSeq->isIndexed()
+		&& pSchedule->seq_serial == pSeq->serial()
+		&& pSchedule->time_serial == pSession->timeScale()->serial()
+		&& pSchedule->clip_start == iClipStart) {
+		// Find the first event due, by frame...
+		const ScheduleItem *items = pSchedule->items;
+		const unsigned int iCount = pSchedule->count;
+		unsigned int i = 0;
+		unsigned int j = iCount;
+		while (i < j) {
+			const unsigned int k = (i + j) >> 1;
+			if (items[k].frame < iFrameStart)
+				i = k + 1;
+			else
+				j = k;
+		}
+		// Walk on the array, till window ends...
+		for ( ; i < iCount; ++i) {
+			const ScheduleItem& item = items[i];
+			if (item.frame >= iFrameEnd)
+				break;
+			qtractorMidiEvent *pEvent = item.event;
+			if (!bMute || pEvent->type() != qtractorMidiEvent::NOTEON)
+				pMidiEngine->enqueue(pTrack, pEvent,
+					item.time, item.frame, item.frame_off,
+					fGain * fadeInOutGain(item.frame > iClipStart
+						? item.frame - iClipStart : 0));
+		}
+		m_iScheduleEpoch.fetch_add(1);
+		return;
+	}
+	m_iScheduleEpoch.fetch_add(1);
+
 	const unsigned long t0 = pSession->tickFromFrame(iClipStart);
 
 	const unsigned long iTimeStart = pSession->tickFromFrame(iFrameStart);
 	const unsigned long iTimeEnd   = pSession->tickFromFrame(iFrameEnd);
 
-	// Enqueue the requested events...
-	const float fGain = clipGain();
 	qtractorMidiEvent *pEvent
 		= m_playCursor.seek(pSeq, iTimeStart > t0 ? iTimeStart - t0 : 0);
 	while (pEvent) {
@@ -990,6 +1038,122 @@ void qtractorMidiClip::process (
 }
 
 
+// Playback schedule (re)build, if stale (GUI thread);
+// the output thread falls back to the tick-based walk
+// whenever the published one doesn't match anymore.
+void qtractorMidiClip::updateSchedule (void)
+{
+	// Reclaim retired schedules, if safe by now...
+	freeSchedules(false);
+
+	qtractorTrack *pTrack = track();
+	if (pTrack == nullptr)
+		return;
+
+	qtractorSession *pSession = pTrack->session();
+	if (pSession == nullptr)
+		return;
+
+	qtractorTimeScale *pTimeScale = pSession->timeScale();
+	if (pTimeScale == nullptr)
+		return;
+
+	qtractorMidiSequence *pSeq = sequence();
+	if (pSeq == nullptr || !pSeq->isIndexed())
+		return;
+
+	const unsigned int iSeqSerial = pSeq->serial();
+	const unsigned int iTimeSerial = pTimeScale->serial();
+	const unsigned long iClipStart = clipStart();
+
+	const Schedule *pOldSchedule = m_pSchedule.load();
+	if (pOldSchedule
+		&& pOldSchedule->seq == pSeq
+		&& pOldSchedule->seq_serial == iSeqSerial
+		&& pOldSchedule->time_serial == iTimeSerial
+		&& pOldSchedule->clip_start == iClipStart)
+		return;
+
+	// Convert all event times, in one go...
+	const unsigned int iCount = pSeq->events().count();
+
+	Schedule *pSchedule = new Schedule;
+	pSchedule->items = new ScheduleItem [iCount > 0 ? iCount : 1];
+
+	qtractorTimeScale::Cursor cursor(pTimeScale);
+	qtractorTimeScale::Node *pNode = cursor.seekFrame(iClipStart);
+	const unsigned long t0 = pNode->tickFromFrame(iClipStart);
+
+	unsigned int i = 0;
+	qtractorMidiEvent *pEvent = pSeq->events().first();
+	for ( ; pEvent && i < iCount; pEvent = pEvent->next(), ++i) {
+		const unsigned long t1 = t0 + pEvent->time();
+		pNode = cursor.seekTick(t1);
+		ScheduleItem& item = pSchedule->items[i];
+		item.time  = t1;
+		item.frame = pNode->frameFromTick(t1);
+		item.frame_off = item.frame;
+		if (pEvent->type() == qtractorMidiEvent::NOTEON
+			&& pEvent->duration() > 0) {
+			const unsigned long t2 = t1 + (pEvent->duration() - 1);
+			pNode = cursor.seekTick(t2);
+			item.frame_off = pNode->frameFromTick(t2);
+		}
+		item.event = pEvent;
+	}
+
+	pSchedule->count = i;
+
+	pSchedule->clip_start  = iClipStart;
+	pSchedule->seq         = pSeq;
+	pSchedule->seq_serial  = iSeqSerial;
+	pSchedule->time_serial = iTimeSerial;
+	pSchedule->epoch       = 0;
+
+	setSchedule(pSchedule);
+}
+
+
+// Playback schedule publish (GUI thread); the previous one
+// is retired, till the output thread is done with it.
+void qtractorMidiClip::setSchedule ( Schedule *pSchedule )
+{
+	Schedule *pOldSchedule = m_pSchedule.exchange(pSchedule);
+	if (pOldSchedule) {
+		pOldSchedule->epoch = m_iScheduleEpoch.load();
+		m_schedulesOld.append(pOldSchedule);
+	}
+
+	freeSchedules(false);
+}
+
+
+// Playback schedule invalidation.
+void qtractorMidiClip::clearSchedule (void)
+{
+	setSchedule(nullptr);
+}
+
+
+// Retired playback schedules reclaim (GUI thread):
+// either not in use when retired, or not anymore.
+void qtractorMidiClip::freeSchedules ( bool bForce )
+{
+	const unsigned int iEpoch = m_iScheduleEpoch.load();
+
+	QMutableListIterator<Schedule *> iter(m_schedulesOld);
+	while (iter.hasNext()) {
+		Schedule *pSchedule = iter.next();
+		if (bForce || (pSchedule->epoch & 1) == 0
+			|| pSchedule->epoch != iEpoch) {
+			delete [] pSchedule->items;
+			delete pSchedule;
+			iter.remove();
+		}
+	}
+}
+
+
 // MIDI clip freewheeling process cycle executive (needed for export).
 void qtractorMidiClip::process_export (
 	unsigned long iFrameStart, unsigned long iFrameEnd )
@@ -1846,6 +2010,8 @@ bool qtractorMidiClip::processInpEvents (
 
 	m_pInpEventsCommand->adjust();
 
+	pSeq->updateIndex();
+
 	setDirtyEx(true);
 	update();
 	updateEditorContents();
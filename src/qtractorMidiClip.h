@@ -31,10 +31,13 @@
 #include <QPoint>
 #include <QSize>
 
+#include <atomic>
+
 
 // Forward declarations.
 class qtractorMidiEditorForm;
 class qtractorMidiEditCommand;
+class qtractorSession;
 
 
 //----------------------------------------------------------------------
@@ -56,6 +59,9 @@ public:
 	// Clip (re)open method.
 	void open();
 
+	// Playback schedule (re)build, if stale (GUI thread).
+	void updateSchedule();
+
 	// Brand new clip contents new method.
 	bool createMidiFile(const QString& sFilename, int iTrackChannel = 0);
 
@@ -358,6 +364,36 @@ protected:
 	void enqueue_export(qtractorTrack *pTrack,
 		qtractorMidiEvent *pEvent, unsigned long iTime, float fGain) const;
 
+	// Pre-computed playback schedule (event -> absolute
+	// tick and frames), built on the GUI thread.
+	struct ScheduleItem
+	{
+		unsigned long time;
+		unsigned long frame;
+		unsigned long frame_off;
+		qtractorMidiEvent *event;
+	};
+
+	struct Schedule
+	{
+		ScheduleItem *items;
+		unsigned int  count;
+
+		// What it was built against.
+		unsigned long clip_start;
+		qtractorMidiSequence *seq;
+		unsigned int  seq_serial;
+		unsigned int  time_serial;
+
+		// Output thread epoch, when retired.
+		unsigned int  epoch;
+	};
+
+	// Playback schedule publish, retire and reclaim (GUI thread).
+	void setSchedule(Schedule *pSchedule);
+	void clearSchedule();
+	void freeSchedules(bool bForce);
+
 private:
 
 	// Instance variables.
@@ -384,6 +420,14 @@ private:
 	qtractorMidiCursor m_playCursor;
 	qtractorMidiCursor m_drawCursor;
 
+	// Current (published) playback schedule and the output
+	// thread epoch (odd while in use); retired ones are
+	// only reclaimed when the epoch moves on.
+	std::atomic<Schedule *>   m_pSchedule;
+	std::atomic<unsigned int> m_iScheduleEpoch;
+
+	QList<Schedule *> m_schedulesOld;
+
 	// This clip editor form widget.
 	qtractorMidiEditorForm *m_pMidiEditorForm;
 
@@ -1,7 +1,7 @@
 // qtractorMidiCursor.cpp
 //
 /****************************************************************************
-   Copyright (C) 2005-2019, rncbc aka Rui Nuno Capela. All rights reserved.
+   Copyright (C) 2005-2025, rncbc aka Rui Nuno Capela. All rights reserved.
 
    This program is free software; you can redistribute it and/or
    modify it under the terms of the GNU General Public License
@@ -42,6 +42,20 @@ qtractorMidiEvent *qtractorMidiCursor::seek (
 		m_pEvent = pSeq->events().first();
 	}
 	else
+	if (pSeq->isIndexed()) {
+		// Indexed seek (logarithmic)...
+		qtractorMidiEvent *pEvent = pSeq->seekIndex(iTime);
+		if (pEvent == nullptr)
+			pEvent = pSeq->events().first();
+		// Skip to checkpoint, unless current one is closer...
+		if (m_pEvent == nullptr || iTime < m_iTime
+			|| (pEvent && m_pEvent->time() < pEvent->time()))
+			m_pEvent = pEvent;
+		while (m_pEvent && m_pEvent->next()
+			&& (m_pEvent->next())->time() < iTime)
+			m_pEvent = m_pEvent->next();
+	}
+	else
 	if (iTime > m_iTime) {
 		// Seek forward...
 		if (m_pEvent == nullptr)
@@ -73,6 +87,9 @@ qtractorMidiEvent *qtractorMidiCursor::reset (
 	qtractorMidiSequence *pSeq, unsigned long iTime )
 {
 	// Reset-seek forward...
+	if (pSeq->isIndexed())
+		m_pEvent = pSeq->resetIndex(iTime);
+	else
 	if (m_iTime >= iTime)
 		m_pEvent = nullptr;
 	if (m_pEvent == nullptr)
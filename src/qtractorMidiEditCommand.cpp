@@ -236,7 +236,7 @@ bool qtractorMidiEditCommand::execute ( bool bRedo )
 			pSeq->unlinkEvent(pEvent);
 			pEvent->setTime(pItem->time);
 			if (pEvent->type() == qtractorMidiEvent::NOTEON)
-				pEvent->setDuration(pItem->duration);
+				pSeq->setEventDuration(pEvent, pItem->duration);
 			pSeq->insertEvent(pEvent);
 			pItem->time = iOldTime;
 			pItem->duration = iOldDuration;
@@ -277,7 +277,7 @@ bool qtractorMidiEditCommand::execute ( bool bRedo )
 				const unsigned long iOldDuration = pEvent->duration();
 				if (iOldDuration != pItem->duration &&
 					pEvent->type() == qtractorMidiEvent::NOTEON) {
-					pEvent->setDuration(pItem->duration);
+					pSeq->setEventDuration(pEvent, pItem->duration);
 					pItem->duration = iOldDuration;
 				}
 			}
@@ -341,6 +341,9 @@ bool qtractorMidiEditCommand::execute ( bool bRedo )
 		}
 	}
 
+	// Rebuild the sequence time index, lazily...
+	pSeq->updateIndex();
+
 	// Just reset/update editor internals...
 	m_pMidiClip->updateEditorEx(iSelectClear > 0);
 
@@ -415,7 +418,7 @@ bool qtractorMidiEditCommand::adjust (void)
 						// Left-side outer event...
 						const unsigned long iDuration
 							= pPrevEvent->duration();
-						pPrevEvent->setDuration(iTime - iPrevTime);
+						pSeq->setEventDuration(pPrevEvent, iTime - iPrevTime);
 						if (!findEvent(pPrevEvent, ResizeEventTime))
 							resizeEventTime(pPrevEvent, iPrevTime, iDuration);
 						// Right-side outer event...
@@ -444,7 +447,7 @@ bool qtractorMidiEditCommand::adjust (void)
 							if (iTimeEnd < iPrevTimeEnd) {
 								// Short over large...
 								unsigned long iDuration = pPrevEvent->duration();
-								pPrevEvent->setDuration(pEvent->duration());
+								pSeq->setEventDuration(pPrevEvent, pEvent->duration());
 								if (!findEvent(pPrevEvent, ResizeEventTime))
 									resizeEventTime(pPrevEvent, iPrevTime, iDuration);
 								iDuration = pEvent->duration();
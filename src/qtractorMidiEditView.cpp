@@ -43,6 +43,10 @@
 
 #include <QStyle>
 
+#ifdef CONFIG_DEBUG
+#include <QElapsedTimer>
+#endif
+
 #ifdef CONFIG_GRADIENT
 #include <QLinearGradient>
 #endif
@@ -55,6 +59,10 @@
 //----------------------------------------------------------------------------
 // qtractorMidiEditView -- MIDI sequence main view widget.
 
+// Pixmap tile width (pixels).
+static const int c_iTileWidth = 256;
+
+
 // Constructor.
 qtractorMidiEditView::qtractorMidiEditView (
 	qtractorMidiEditor *pEditor, QWidget *pParent )
@@ -67,6 +75,10 @@ qtractorMidiEditView::qtractorMidiEditView (
 	m_iNoteOn  = -1;
 	m_iNoteVel = -1;
 
+	m_iTilesY = 0;
+	m_iTilesHeight = 0;
+	m_bTilesScroll = false;
+
 	// Zoom tool widgets
 	m_pVzoomIn    = new QToolButton(this);
 	m_pVzoomOut   = new QToolButton(this);
@@ -188,6 +200,9 @@ void qtractorMidiEditView::updateContentsWidth ( int iContentsWidth )
 // Local rectangular contents update.
 void qtractorMidiEditView::updateContents ( const QRect& rect )
 {
+	if (!m_bTilesScroll)
+		m_tiles.clear();
+
 	updatePixmap(
 		qtractorScrollView::contentsX(),
 		qtractorScrollView::contentsY());
@@ -199,6 +214,9 @@ void qtractorMidiEditView::updateContents ( const QRect& rect )
 // Overall contents update.
 void qtractorMidiEditView::updateContents (void)
 {
+	if (!m_bTilesScroll)
+		m_tiles.clear();
+
 	updatePixmap(
 		qtractorScrollView::contentsX(),
 		qtractorScrollView::contentsY());
@@ -304,7 +322,16 @@ void qtractorMidiEditView::resizeEvent ( QResizeEvent *pResizeEvent )
 }
 
 
-// (Re)create the complete track view pixmap.
+// Horizontal scrolling keeps the tile cache.
+void qtractorMidiEditView::scrollContentsBy ( int dx, int dy )
+{
+	m_bTilesScroll = (dy == 0);
+	qtractorScrollView::scrollContentsBy(dx, dy);
+	m_bTilesScroll = false;
+}
+
+
+// (Re)create the complete MIDI editor view pixmap.
 void qtractorMidiEditView::updatePixmap ( int cx, int cy )
 {
 	QWidget *pViewport = qtractorScrollView::viewport();
@@ -314,6 +341,69 @@ void qtractorMidiEditView::updatePixmap ( int cx, int cy )
 	if (w < 1 || h < 1)
 		return;
 
+#ifdef CONFIG_DEBUG
+	QElapsedTimer timer;
+	timer.start();
+	int iTiles = 0;
+#endif
+
+	// Cached tiles are only good for the same vertical extent...
+	if (m_iTilesY != cy || m_iTilesHeight != h) {
+		m_tiles.clear();
+		m_iTilesY = cy;
+		m_iTilesHeight = h;
+	}
+
+	if (m_pixmap.width() != w || m_pixmap.height() != h)
+		m_pixmap = QPixmap(w, h);
+
+	// Compose from column tiles, rendering just the missing ones...
+	const int k1 = cx / c_iTileWidth;
+	const int k2 = (cx + w - 1) / c_iTileWidth;
+
+	QPainter painter(&m_pixmap);
+	for (int k = k1; k <= k2; ++k) {
+		const int x = k * c_iTileWidth;
+		QHash<int, QPixmap>::ConstIterator iter = m_tiles.constFind(k);
+		if (iter == m_tiles.constEnd()) {
+			QPixmap tile(c_iTileWidth, h);
+			renderPixmap(tile, x, cy);
+			iter = m_tiles.insert(k, tile);
+		#ifdef CONFIG_DEBUG
+			++iTiles;
+		#endif
+		}
+		painter.drawPixmap(x - cx, 0, iter.value());
+	}
+
+	// Drop tiles farther than a viewport width away...
+	const int kd = k2 - k1 + 1;
+	QHash<int, QPixmap>::Iterator iter = m_tiles.begin();
+	while (iter != m_tiles.end()) {
+		const int k = iter.key();
+		if (k < k1 - kd || k > k2 + kd)
+			iter = m_tiles.erase(iter);
+		else
+			++iter;
+	}
+
+#ifdef CONFIG_DEBUG
+	// Paint time, per redraw (only when tiles got rendered)...
+	if (iTiles > 0) {
+		qDebug("qtractorMidiEditView::updatePixmap(%d, %d) "
+			"tiles=%d/%d (%lld us).",
+			cx, cy, iTiles, k2 - k1 + 1, timer.nsecsElapsed() / 1000);
+	}
+#endif
+}
+
+
+// Render a MIDI editor view (tile) pixmap at some contents position.
+void qtractorMidiEditView::renderPixmap ( QPixmap& pixmap, int cx, int cy )
+{
+	const int w = pixmap.width();
+	const int h = pixmap.height();
+
 	const QPalette& pal = qtractorScrollView::palette();
 	const QColor& rgbBase  = pal.base().color();
 	const QColor& rgbLine  = pal.mid().color();
@@ -321,8 +411,7 @@ void qtractorMidiEditView::updatePixmap ( int cx, int cy )
 	const QColor& rgbDark  = rgbBase.darker(110);
 	const bool bDark = (rgbBase.value() < 128);
 
-	m_pixmap = QPixmap(w, h);
-	m_pixmap.fill(rgbBase);
+	pixmap.fill(rgbBase);
 
 	qtractorSession *pSession = qtractorSession::getInstance();
 	if (pSession == nullptr)
@@ -332,7 +421,7 @@ void qtractorMidiEditView::updatePixmap ( int cx, int cy )
 	if (pTimeScale == nullptr)
 		return;
 
-	QPainter painter(&m_pixmap);
+	QPainter painter(&pixmap);
 //	painter.initFrom(this);
 	painter.setFont(qtractorScrollView::font());
 
@@ -435,7 +524,8 @@ void qtractorMidiEditView::updatePixmap ( int cx, int cy )
 		const unsigned short iBeatsPerBar2 = pNode->beatsPerBar2();
 		const float q2 = float(x2 - x) / float(iBeatsPerBar2);
 		if (q2 > 8.0f) {
-			float p2 = float(x);
+			// (absolute positions, so that adjacent tiles match)
+			float p2 = float(x + dx);
 			for (int i = 0; i < iBeatsPerBar2; ++i) {
 				if (iSnapPerBeat > 1) {
 					const float q1 = q2 / float(iSnapPerBeat);
@@ -444,12 +534,12 @@ void qtractorMidiEditView::updatePixmap ( int cx, int cy )
 							? rgbLight.darker(105) : rgbLight.lighter(120));
 						float p1 = p2;
 						for (int j = 1; j < iSnapPerBeat; ++j) {
-							const int x1 = int(p1 += q1);
+							const int x1 = int(p1 += q1) - dx;
 							painter.drawLine(x1, 0, x1, h);
 						}
 					}
 				}
-				x = int(p2 += q2);
+				x = int(p2 += q2) - dx;
 				if (x > w)
 					break;
 				if (i < iBeatsPerBar2 - 1) {
@@ -490,9 +580,12 @@ void qtractorMidiEditView::updatePixmap ( int cx, int cy )
 	if (pSeq == nullptr)
 		return;
 
-	pNode = cursor.seekPixel(x = dx);
+	// Widen by an item height, as drum-mode diamonds may
+	// otherwise get cut short at the tile boundaries...
+	const int h1x = (dx > h1 ? h1 : dx);
+	pNode = cursor.seekPixel(x = dx - h1x);
 	const unsigned long iTickStart = pNode->tickFromPixel(x);
-	pNode = cursor.seekPixel(x += w);
+	pNode = cursor.seekPixel(x += w + h1x + h1);
 	const unsigned long iTickEnd = pNode->tickFromPixel(x);
 
 	const unsigned long f1 = f0 + m_pEditor->length();
@@ -502,7 +595,7 @@ void qtractorMidiEditView::updatePixmap ( int cx, int cy )
 	// Draw ghost-track events in dimmed transparecncy (alpha=55)...
 	qtractorTrack *pGhostTrack = m_pEditor->ghostTrack();
 	if (pGhostTrack) {
-		// Don't draw beyhond the right-most position (x = dx + w)...
+		// Don't draw beyhond the right-most position (x = dx + w + h1)...
 		const unsigned long f2 = pTimeScale->frameFromPixel(x);
 		const bool bDrumMode = pGhostTrack->isMidiDrums();
 		qtractorClip *pClip = pGhostTrack->clips().first();
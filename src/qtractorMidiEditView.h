@@ -28,6 +28,7 @@
 
 #include <QPixmap>
 #include <QBrush>
+#include <QHash>
 
 
 // Forward declarations.
@@ -84,6 +85,12 @@ protected:
 	// Resize event handler.
 	void resizeEvent(QResizeEvent *pResizeEvent);
 
+	// Horizontal scrolling keeps the tile cache.
+	void scrollContentsBy(int dx, int dy);
+
+	// Render a track view pixmap at some contents position.
+	void renderPixmap(QPixmap& pixmap, int cx, int cy);
+
 	// Draw the track view events.
 	void drawEvents(QPainter& painter, int dx, int dy,
 		qtractorMidiSequence *pSeq, unsigned long t0,
@@ -133,6 +140,12 @@ private:
 	// Local double-buffering pixmap.
 	QPixmap m_pixmap;
 
+	// Column tile cache, keyed by contents-x / tile width.
+	QHash<int, QPixmap> m_tiles;
+	int  m_iTilesY;
+	int  m_iTilesHeight;
+	bool m_bTilesScroll;
+
 	// Current selection holder.
 	qtractorMidiEvent::EventType m_eventType;
 
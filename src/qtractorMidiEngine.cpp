@@ -33,6 +33,7 @@
 
 #include "qtractorMidiClip.h"
 #include "qtractorMidiManager.h"
+#include "qtractorMidiBuffer.h"
 #include "qtractorMidiControl.h"
 #include "qtractorMidiTimer.h"
 #include "qtractorMidiSysex.h"
@@ -57,6 +58,11 @@
 
 #include <QElapsedTimer>
 
+#include <jack/midiport.h>
+
+#include <unistd.h>
+#include <fcntl.h>
+
 #include <cmath>
 
 
@@ -115,6 +121,9 @@ public:
 	void setRunState(bool bRunState);
 	bool runState() const;
 
+	// Wake from poll wait (RT-safe).
+	void sync();
+
 protected:
 
 	// The main thread executive.
@@ -127,9 +136,16 @@ private:
 
 	// Whether the thread is logically running.
 	bool m_bRunState;
+
+	// Wake-up notification pipe (JACK MIDI input).
+	int m_fds[2];
 };
 
 
+// Spare event storage chunks kept in reserve for capture.
+static const unsigned int c_iInpSpareChunks = 16;
+
+
 //----------------------------------------------------------------------
 // class qtractorMidiOutputThread -- MIDI output thread (singleton).
 //
@@ -358,6 +374,14 @@ qtractorMidiInputThread::qtractorMidiInputThread (
 {
 	m_pMidiEngine = pMidiEngine;
 	m_bRunState   = false;
+
+	// Wake-up notification pipe, non-blocking...
+	if (::pipe(m_fds) == 0) {
+		::fcntl(m_fds[0], F_SETFL, ::fcntl(m_fds[0], F_GETFL, 0) | O_NONBLOCK);
+		::fcntl(m_fds[1], F_SETFL, ::fcntl(m_fds[1], F_GETFL, 0) | O_NONBLOCK);
+	} else {
+		m_fds[0] = m_fds[1] = -1;
+	}
 }
 
 
@@ -370,6 +394,11 @@ qtractorMidiInputThread::~qtractorMidiInputThread (void)
 		setRunState(false);
 	//	terminate();
 	} while (!wait(100));
+
+	if (m_fds[0] >= 0)
+		::close(m_fds[0]);
+	if (m_fds[1] >= 0)
+		::close(m_fds[1]);
 }
 
 
@@ -385,6 +414,18 @@ bool qtractorMidiInputThread::runState (void) const
 }
 
 
+// Wake from poll wait (RT-safe).
+void qtractorMidiInputThread::sync (void)
+{
+	if (m_fds[1] >= 0) {
+		const char c = 0;
+		if (::write(m_fds[1], &c, 1) < 0) {
+			// Pipe full: already pending anyway...
+		}
+	}
+}
+
+
 // The main thread executive.
 void qtractorMidiInputThread::run (void)
 {
@@ -400,9 +441,14 @@ void qtractorMidiInputThread::run (void)
 	struct pollfd *pfds;
 
 	nfds = snd_seq_poll_descriptors_count(pAlsaSeq, POLLIN);
-	pfds = (struct pollfd *) alloca(nfds * sizeof(struct pollfd));
+	pfds = (struct pollfd *) alloca((nfds + 1) * sizeof(struct pollfd));
 	snd_seq_poll_descriptors(pAlsaSeq, pfds, nfds, POLLIN);
 
+	// JACK MIDI input wake-up notification...
+	pfds[nfds].fd = m_fds[0];
+	pfds[nfds].events = POLLIN;
+	pfds[nfds].revents = 0;
+
 	qtractorMidiInputRpn xrpn;
 
 	m_bRunState = true;
@@ -410,10 +456,31 @@ void qtractorMidiInputThread::run (void)
 	int iPoll = 0;
 	while (m_bRunState && iPoll >= 0) {
 		// Wait for events...
-		iPoll = poll(pfds, nfds, 200);
+		iPoll = poll(pfds, (m_fds[0] >= 0 ? nfds + 1 : nfds), 200);
 		// Timeout?
 		if (iPoll == 0)
 			xrpn.flush();
+		// JACK MIDI input events, if any...
+		if (iPoll > 0 && m_fds[0] >= 0 && (pfds[nfds].revents & POLLIN)) {
+			char buf[64];
+			while (::read(m_fds[0], buf, sizeof(buf)) > 0)
+				;
+			snd_seq_event_t ev;
+			while (m_pMidiEngine->dequeueJackMidiInput(&ev)) {
+				if (!xrpn.process(&ev))
+					m_pMidiEngine->capture(&ev, false);
+			}
+			while (xrpn.isPending()) {
+				if (xrpn.dequeue(&ev))
+					m_pMidiEngine->capture(&ev, false);
+			}
+			// Any ALSA input still pending?
+			int i = 0;
+			while (i < nfds && pfds[i].revents == 0)
+				++i;
+			if (i >= nfds)
+				iPoll = 0;
+		}
 		while (iPoll > 0) {
 			snd_seq_event_t *pEv = nullptr;
 			snd_seq_event_input(pAlsaSeq, &pEv);
@@ -495,6 +562,8 @@ void qtractorMidiOutputThread::run (void)
 	#ifdef CONFIG_DEBUG_0
 		qDebug("qtractorMidiOutputThread[%p]::run(): waked.", this);
 	#endif
+		// JACK MIDI input monitoring, plugins feeding.
+		m_pMidiEngine->dequeueJackMidiMonitor();
 		// Only if playing, the output process cycle.
 		if (m_pMidiEngine->isPlaying())
 			m_pMidiEngine->process();
@@ -1091,6 +1160,35 @@ unsigned long qtractorMidiPlayer::queueFrame (void) const
 // class qtractorMidiEngine -- ALSA sequencer client instance (singleton).
 //
 
+// Step-input event queue size (must be a power-of-two).
+static const unsigned int c_iInpSize = 4096;
+
+// JACK MIDI input capture ring-buffer size (bytes).
+static const size_t c_iJackMidiInputSize = (64 * 1024);
+
+// JACK MIDI input maximum decoded SysEx size (bytes).
+static const size_t c_iJackMidiInputSysexSize = (32 * 1024);
+
+// JACK MIDI input capture record header.
+struct JackMidiInputHeader
+{
+	unsigned long time;		// Frame-time (latency compensated).
+	int           port;		// Bus ALSA port (for capture routing).
+	unsigned int  size;		// Raw MIDI data size (bytes).
+};
+
+// JACK MIDI input monitoring ring-buffer size (bytes).
+static const size_t c_iJackMidiMonitorSize = (64 * 1024);
+
+// JACK MIDI input monitoring record.
+struct JackMidiMonitorEvent
+{
+	unsigned long   time;	// Plugin process frame-time.
+	int             port;	// Bus ALSA port (for monitor routing).
+	snd_seq_event_t ev;		// Sequencer event (no SysEx).
+};
+
+
 // Constructor.
 qtractorMidiEngine::qtractorMidiEngine ( qtractorSession *pSession )
 	: qtractorEngine(pSession, qtractorTrack::Midi)
@@ -1109,6 +1207,17 @@ qtractorMidiEngine::qtractorMidiEngine ( qtractorSession *pSession )
 	m_pInputThread  = nullptr;
 	m_pOutputThread = nullptr;
 
+	m_pInpItems = nullptr;
+	m_iInpSize  = 0;
+	m_iInpMask  = 0;
+	m_iInpRead  = 0;
+	m_iInpWrite = 0;
+	m_bInpSpill = false;
+
+	ATOMIC_SET(&m_inpPending, 0);
+
+	m_pInpArena = nullptr;
+
 	m_bDriftCorrect = true;
 
 	m_iDriftCheck   = 0;
@@ -1117,6 +1226,23 @@ qtractorMidiEngine::qtractorMidiEngine ( qtractorSession *pSession )
 	m_iTimeDrift    = 0;
 	m_iFrameDrift   = 0;
 
+	m_bJackMidiOutput = false;
+
+	ATOMIC_SET(&m_jackMidiPortsLock, 0);
+
+	resetJitter();
+
+	m_bJackMidiInput = false;
+
+	m_pJackMidiInput = nullptr;
+	m_pJackMidiInputCoder = nullptr;
+
+	m_pJackMidiMonitor = nullptr;
+
+	m_iInputOffsetCount = 0;
+	m_iInputOffsetTotal = 0;
+	m_iInputOffsetMax   = 0;
+
 	m_iTimeStart    = 0;
 	m_iFrameStart   = 0;
 
@@ -1397,6 +1523,24 @@ void qtractorMidiEngine::process (void)
 	// Flush the MIDI engine output queue...
 	snd_seq_drain_output(m_pAlsaSeq);
 
+	// ALSA output jitter: the earliest event scheduled on
+	// this cycle, against the current queue time...
+	if (m_iAlsaJitterTick >= 0) {
+		const long iQueueTick = long(queueTime()) - timeStart();
+		unsigned long iJitter = 0;
+		if (iQueueTick > m_iAlsaJitterTick) {
+			const long t0 = m_iAlsaJitterTick + timeStart();
+			const unsigned long iTime = (t0 > 0 ? t0 : 0);
+			const unsigned long iLate = iQueueTick - m_iAlsaJitterTick;
+			qtractorTimeScale::Cursor& cursor = pSession->timeScale()->cursor();
+			qtractorTimeScale::Node *pNode = cursor.seekTick(iTime);
+			iJitter = pNode->frameFromTick(iTime + iLate)
+				- pNode->frameFromTick(iTime);
+		}
+		updateJitter(AlsaJitter, iJitter);
+		m_iAlsaJitterTick = -1;
+	}
+
 	// Always do the queue drift stats
 	// at the bottom of the pack...
 	driftCheck();
@@ -1666,7 +1810,7 @@ void qtractorMidiEngine::removeInputBuffer ( int iAlsaPort )
 
 
 // MIDI event capture method.
-void qtractorMidiEngine::capture ( snd_seq_event_t *pEv )
+void qtractorMidiEngine::capture ( snd_seq_event_t *pEv, bool bMidiManagers )
 {
 	qtractorSession *pSession = session();
 	if (pSession == nullptr)
@@ -1686,6 +1830,19 @@ void qtractorMidiEngine::capture ( snd_seq_event_t *pEv )
 
 	unsigned long tick = pSession->timeq(pEv->time.tick);
 
+	// - input-to-timeline offset stats...
+	if (isPlaying()) {
+		const long iFrameStartEx
+			= long(pSession->frameFromTick(m_iTimeStartEx));
+		const long iEventFrame
+			= long(pSession->frameFromTick(m_iTimeStartEx + tick))
+			- iFrameStartEx;
+		qtractorSessionCursor *pAudioCursor
+			= pSession->audioEngine()->sessionCursor();
+		if (pAudioCursor)
+			updateInputOffset(long(pAudioCursor->frameTime()) - iEventFrame);
+	}
+
 	// - capture quantization...
 	if (m_iCaptureQuantize > 0) {
 		const unsigned long q
@@ -1873,6 +2030,10 @@ void qtractorMidiEngine::capture ( snd_seq_event_t *pEv )
 	// Whether to notify any step input/overdub...
 	unsigned short iInpEvents = 0;
 
+	// Whether we're on the (owner) MIDI input thread...
+	const bool bInputThread
+		= (m_pInputThread && QThread::currentThread() == m_pInputThread);
+
 	// Now check which bus and track we're into...
 	for (qtractorTrack *pTrack = pSession->tracks().first();
 			pTrack; pTrack = pTrack->next()) {
@@ -1928,14 +2089,14 @@ void qtractorMidiEngine::capture ( snd_seq_event_t *pEv )
 						pSeq = nullptr;
 					// Yep, maybe we have a new MIDI event on record...
 					if (pSeq) {
-						qtractorMidiEvent *pEvent = new qtractorMidiEvent(
-							tick, type, param, value, duration);
+						qtractorMidiEvent *pEvent
+							= new (bInputThread ? m_pInpArena : nullptr)
+								qtractorMidiEvent(tick, type, param, value, duration);
 						if (pSysex)
-							pEvent->setSysex(pSysex, iSysex);
+							pEvent->setSysex(pSysex, iSysex,
+								bInputThread ? m_pInpArena : nullptr);
 						if (pTrack->isClipRecordEx()) {
-							m_inpMutex.lock();
-							m_inpEvents.insert(pMidiClip, pEvent);
-							m_inpMutex.unlock();
+							enqueueInpEvent(pMidiClip, pEvent, bInputThread);
 							++iInpEvents;
 						}
 						else
@@ -1965,12 +2126,12 @@ void qtractorMidiEngine::capture ( snd_seq_event_t *pEv )
 						pMidiBus->midiMonitor_out()->enqueue(type, value);
 						// Do it for the MIDI plugins too...
 						pMidiManager = (pTrack->pluginList())->midiManager();
-						if (pMidiManager)
+						if (pMidiManager && bMidiManagers)
 							pMidiManager->direct(pEv); //queued(pEv,t1[,t2]);
 						if (!pMidiBus->isMonitor()
 							&& pMidiBus->pluginList_out()) {
 							pMidiManager = (pMidiBus->pluginList_out())->midiManager();
-							if (pMidiManager)
+							if (pMidiManager && bMidiManagers)
 								pMidiManager->direct(pEv); //queued(pEv,t1[,t2]);
 						}
 						// FIXME: MIDI-thru channel filtering epilog...
@@ -1990,7 +2151,7 @@ void qtractorMidiEngine::capture ( snd_seq_event_t *pEv )
 		// Do it for the MIDI input plugins too...
 		if (pMidiBus->pluginList_in()) {
 			pMidiManager = (pMidiBus->pluginList_in())->midiManager();
-			if (pMidiManager)
+			if (pMidiManager && bMidiManagers)
 				pMidiManager->direct(pEv); //queued(pEv,t1[,t2]);
 		}
 		// Output monitoring on passthru...
@@ -1998,7 +2159,7 @@ void qtractorMidiEngine::capture ( snd_seq_event_t *pEv )
 			// Do it for the MIDI output plugins too...
 			if (pMidiBus->pluginList_out()) {
 				pMidiManager = (pMidiBus->pluginList_out())->midiManager();
-				if (pMidiManager)
+				if (pMidiManager && bMidiManagers)
 					pMidiManager->direct(pEv); //queued(pEv,t1[,t2]);
 			}
 			if (pMidiBus->midiMonitor_out()) {
@@ -2029,8 +2190,8 @@ void qtractorMidiEngine::capture ( snd_seq_event_t *pEv )
 			qtractorCtlEvent(type, channel, param, value));
 	}
 
-	// Notify step-input events...
-	if (iInpEvents > 0) {
+	// Notify step-input events, unless already pending...
+	if (iInpEvents > 0 && ATOMIC_TAS(&m_inpPending)) {
 		// Post the stuffed event(s)...
 		m_proxy.notifyInpEvent(InpEvent);
 	}
@@ -2045,6 +2206,29 @@ void qtractorMidiEngine::enqueue ( qtractorTrack *pTrack,
 	if (pSession == nullptr)
 		return;
 
+	// Note-on/off frames, the hard way...
+	qtractorTimeScale::Cursor& cursor = pSession->timeScale()->cursor();
+	qtractorTimeScale::Node *pNode = cursor.seekTick(iTime);
+	const unsigned long iFrame = pNode->frameFromTick(iTime);
+	unsigned long iFrameOff = iFrame;
+	if (pEvent->type() == qtractorMidiEvent::NOTEON && pEvent->duration() > 0) {
+		const unsigned long iTimeOff = iTime + (pEvent->duration() - 1);
+		pNode = cursor.seekTick(iTimeOff);
+		iFrameOff = pNode->frameFromTick(iTimeOff);
+	}
+
+	enqueue(pTrack, pEvent, iTime, iFrame, iFrameOff, fGain);
+}
+
+
+void qtractorMidiEngine::enqueue ( qtractorTrack *pTrack,
+	qtractorMidiEvent *pEvent, unsigned long iTime,
+	unsigned long iFrame, unsigned long iFrameOff, float fGain )
+{
+	qtractorSession *pSession = session();
+	if (pSession == nullptr)
+		return;
+
 	// Target MIDI bus...
 	qtractorMidiBus *pMidiBus
 		= static_cast<qtractorMidiBus *> (pTrack->outputBus());
@@ -2060,6 +2244,9 @@ void qtractorMidiEngine::enqueue ( qtractorTrack *pTrack,
 #endif
 	const int iAlsaPort = pMidiBus->alsaPort();
 
+	// JACK MIDI output: no queue scheduling whatsoever...
+	const bool bJackMidi = (pMidiBus->jackMidiPort() != nullptr);
+
 	// Scheduled delivery: take into account
 	// the time playback/queue started...
 	const unsigned long tick
@@ -2096,6 +2283,10 @@ void qtractorMidiEngine::enqueue ( qtractorTrack *pTrack,
 	// Scheduled delivery...
 	snd_seq_ev_schedule_tick(&ev, m_iAlsaQueue, 0, pSession->timep(tick));
 
+	// Keep the earliest for ALSA output jitter stats...
+	if (!bJackMidi && (m_iAlsaJitterTick < 0 || m_iAlsaJitterTick > long(tick)))
+		m_iAlsaJitterTick = long(tick);
+
 	unsigned long iDuration = 0;
 
 	// Set proper event data...
@@ -2107,10 +2298,14 @@ void qtractorMidiEngine::enqueue ( qtractorTrack *pTrack,
 			ev.data.note.velocity = int(fGain * float(pEvent->value())) & 0x7f;
 			iDuration = pEvent->duration();
 			if (pSession->isLooping()) {
-				const unsigned long iLoopEndTime
-					= pSession->tickFromFrame(pSession->loopEnd());
-				if (iLoopEndTime > iTime && iLoopEndTime < iTime + pEvent->duration())
+				// Cut short on loop-end...
+				const unsigned long iLoopEndTime = pSession->loopEndTime();
+				if (iLoopEndTime > iTime && iLoopEndTime < iTime + iDuration) {
 					iDuration = iLoopEndTime - iTime;
+					const unsigned long iLoopEnd = pSession->loopEnd();
+					if (iLoopEnd > iFrame && iLoopEnd <= iFrameOff)
+						iFrameOff = iLoopEnd - 1;
+				}
 			}
 			ev.data.note.duration = pSession->timep(iDuration);
 			break;
@@ -2213,7 +2408,8 @@ void qtractorMidiEngine::enqueue ( qtractorTrack *pTrack,
 	}
 
 	// Pump it into the queue.
-	snd_seq_event_output(m_pAlsaSeq, &ev);
+	if (!bJackMidi)
+		snd_seq_event_output(m_pAlsaSeq, &ev);
 
 	// MIDI track monitoring...
 	qtractorMidiMonitor *pMidiMonitor
@@ -2226,18 +2422,24 @@ void qtractorMidiEngine::enqueue ( qtractorTrack *pTrack,
 			pEvent->type(), pEvent->value(), tick);
 
 	// Do it for the MIDI track plugins too...
-	qtractorTimeScale::Cursor& cursor = pSession->timeScale()->cursor();
-	qtractorTimeScale::Node *pNode = cursor.seekTick(iTime);
 	const long f0 = m_iFrameStart + (pTrack->pluginList())->latency();
-	const unsigned long t0 = pNode->frameFromTick(iTime);
+	const unsigned long t0 = iFrame;
 	const unsigned long t1 = (long(t0) < f0 ? t0 : t0 - f0);
 	unsigned long t2 = t1;
 
 	if (ev.type == SND_SEQ_EVENT_NOTE && iDuration > 0) {
 		const unsigned long iTimeOff = iTime + (iDuration - 1);
-		pMidiBus->enqueueNoteOff(&ev, iTime, iTimeOff);
-		pNode = cursor.seekTick(iTimeOff);
-		t2 += (pNode->frameFromTick(iTimeOff) - t0);
+		if (!bJackMidi)
+			pMidiBus->enqueueNoteOff(&ev, iTime, iTimeOff);
+		if (iFrameOff > t0)
+			t2 += (iFrameOff - t0);
+	}
+
+	// JACK MIDI output, in frame-time (sans plugin latency)...
+	if (bJackMidi) {
+		const unsigned long j1
+			= (long(t0) < m_iFrameStart ? t0 : t0 - m_iFrameStart);
+		pMidiBus->enqueueJackMidi(&ev, j1, j1 + (t2 - t1));
 	}
 
 	qtractorMidiManager *pMidiManager
@@ -2281,6 +2483,9 @@ void qtractorMidiEngine::resetDrift (void)
 // Do ouput queue status (audio vs. MIDI)...
 void qtractorMidiEngine::driftCheck (void)
 {
+	// No queue drift whatsoever on JACK MIDI output...
+	if (m_bJackMidiOutput)
+		return;
 	if (!m_bDriftCorrect)
 		return;
 	if (++m_iDriftCheck < m_iDriftCount)
@@ -2436,6 +2641,15 @@ bool qtractorMidiEngine::init (void)
 	// Time-scale cursor (tempo/time-signature map)
 	m_pMetroCursor = new qtractorTimeScale::Cursor(pSession->timeScale());
 
+	// JACK MIDI input capture ring-buffer and decoder...
+	m_pJackMidiInput = ::jack_ringbuffer_create(c_iJackMidiInputSize);
+	snd_midi_event_new(c_iJackMidiInputSysexSize, &m_pJackMidiInputCoder);
+	if (m_pJackMidiInputCoder)
+		snd_midi_event_no_status(m_pJackMidiInputCoder, 1);
+
+	// JACK MIDI input monitoring ring-buffer...
+	m_pJackMidiMonitor = ::jack_ringbuffer_create(c_iJackMidiMonitorSize);
+
 	return true;
 }
 
@@ -2458,6 +2672,18 @@ bool qtractorMidiEngine::activate (void)
 	// Set the read-ahead in frames (0.5s)...
 	m_iReadAhead = (pSession->sampleRate() >> 1);
 
+	// Step-input event queue and captured event storage...
+	m_iInpSize  = c_iInpSize;
+	m_iInpMask  = m_iInpSize - 1;
+	m_iInpRead  = 0;
+	m_iInpWrite = 0;
+	m_bInpSpill = false;
+	m_pInpItems = new InpItem [m_iInpSize];
+	m_pInpArena = new qtractorMidiEventArena();
+
+	// Pre-allocate spare storage, so that capture won't hit the heap...
+	m_pInpArena->reserve(c_iInpSpareChunks);
+
 	// Create and start our own MIDI input queue thread...
 	m_pInputThread = new qtractorMidiInputThread(this);
 	m_pInputThread->start(QThread::TimeCriticalPriority);
@@ -2514,6 +2740,8 @@ bool qtractorMidiEngine::start (void)
 
 	// Reset output queue drift compensator...
 	resetDrift();
+	resetJitter();
+	resetInputOffset();
 
 	// Start queue timer...
 	m_iFrameStart = long(pMidiCursor->frame());
@@ -2576,6 +2804,26 @@ void qtractorMidiEngine::stop (void)
 
 	flush();
 
+#ifdef CONFIG_DEBUG
+	qDebug("qtractorMidiEngine::stop(): JACK output jitter: "
+		"count=%lu avg=%.1f max=%lu (frames)",
+		jitterCount(JackJitter), jitterAvg(JackJitter), jitterMax(JackJitter));
+	qDebug("qtractorMidiEngine::stop(): ALSA output jitter: "
+		"count=%lu avg=%.1f max=%lu (frames)",
+		jitterCount(AlsaJitter), jitterAvg(AlsaJitter), jitterMax(AlsaJitter));
+	qDebug("qtractorMidiEngine::stop(): %s input offset: "
+		"count=%lu avg=%.1f max=%lu (frames)",
+		m_bJackMidiInput ? "JACK" : "ALSA",
+		inputOffsetCount(), inputOffsetAvg(), inputOffsetMax());
+	qDebug("qtractorMidiEngine::stop(): event storage: "
+		"capture mallocs=%u heap allocs=%u slot reuses=%u chunks=%u spares=%u",
+		m_pInpArena ? m_pInpArena->mallocs() : 0,
+		qtractorMidiEventArena::heapAllocs(),
+		qtractorMidiEventArena::slotReuses(),
+		qtractorMidiEventArena::chunks(),
+		qtractorMidiEventArena::spares());
+#endif
+
 	// Shut-off all MIDI buses...
 	shutOffAllBuses();
 
@@ -2600,9 +2848,6 @@ void qtractorMidiEngine::deactivate (void)
 // Device engine cleanup method.
 void qtractorMidiEngine::clean (void)
 {
-	// Clean any (pending?) step-input/overdub events...
-	m_inpEvents.clear();
-
 	// Clean control/metronome buses...
 	deleteControlBus();
 	deleteMetroBus();
@@ -2633,6 +2878,36 @@ void qtractorMidiEngine::clean (void)
 		m_pInputThread = nullptr;
 	}
 
+	// Clean any (pending?) step-input/overdub events...
+	clearInpEvents();
+
+	// Step-input event queue and captured event storage...
+	if (m_pInpItems) {
+		delete [] m_pInpItems;
+		m_pInpItems = nullptr;
+	}
+
+	if (m_pInpArena) {
+		delete m_pInpArena;
+		m_pInpArena = nullptr;
+	}
+
+	// JACK MIDI input capture ring-buffer and decoder...
+	if (m_pJackMidiInputCoder) {
+		snd_midi_event_free(m_pJackMidiInputCoder);
+		m_pJackMidiInputCoder = nullptr;
+	}
+
+	if (m_pJackMidiInput) {
+		::jack_ringbuffer_free(m_pJackMidiInput);
+		m_pJackMidiInput = nullptr;
+	}
+
+	if (m_pJackMidiMonitor) {
+		::jack_ringbuffer_free(m_pJackMidiMonitor);
+		m_pJackMidiMonitor = nullptr;
+	}
+
 	// Time-scale cursor (tempo/time-signature map)
 	if (m_pMetroCursor) {
 		delete m_pMetroCursor;
@@ -2723,6 +2998,11 @@ void qtractorMidiEngine::trackMute ( qtractorTrack *pTrack, bool bMute )
 		// Immediate all current notes off.
 		qtractorMidiBus *pMidiBus
 			= static_cast<qtractorMidiBus *> (pTrack->outputBus());
+		if (pMidiBus && pMidiBus->jackMidiPort()) {
+			pSession->lock();
+			pMidiBus->dropJackMidi(pTrack->midiTag(), pTrack->midiChannel());
+			pSession->unlock();
+		}
 		if (pMidiBus)
 			pMidiBus->setController(pTrack, ALL_NOTES_OFF);
 		// Clear/reset track monitor...
@@ -2779,6 +3059,11 @@ void qtractorMidiEngine::metroMute ( bool bMute )
 			| SND_SEQ_REMOVE_DEST_CHANNEL | SND_SEQ_REMOVE_IGNORE_OFF
 			| SND_SEQ_REMOVE_TAG_MATCH);
 		snd_seq_remove_events(m_pAlsaSeq, pre);
+		if (m_pMetroBus && m_pMetroBus->jackMidiPort()) {
+			pSession->lock();
+			m_pMetroBus->dropJackMidi(0xff, m_iMetroChannel);
+			pSession->unlock();
+		}
 		// Done metronome mute.
 	} else {
 		// Must redirect to MIDI ouput thread:
@@ -3488,8 +3773,18 @@ void qtractorMidiEngine::processMetro (
 				ev.data.note.velocity = m_iMetroBeatVelocity;
 				ev.data.note.duration = m_iMetroBeatDuration;
 			}
-			// Pump it into the queue.
-			snd_seq_event_output(m_pAlsaSeq, &ev);
+			// Pump it into the queue...
+			if (m_pMetroBus && m_pMetroBus->jackMidiPort()) {
+				// JACK MIDI output, in frame-time...
+				const unsigned long iFrameOn
+					= pNode->frameFromTick(iTimeOffset);
+				const unsigned long iFrameOff
+					= pNode->frameFromTick(iTimeOffset + ev.data.note.duration);
+				const unsigned long j1 = (long(iFrameOn) < m_iFrameStart
+					? iFrameOn : iFrameOn - m_iFrameStart);
+				m_pMetroBus->enqueueJackMidi(&ev, j1, j1 + (iFrameOff - iFrameOn));
+			}
+			else snd_seq_event_output(m_pAlsaSeq, &ev);
 			// MIDI track monitoring...
 			if (m_pMetroBus && m_pMetroBus->midiMonitor_out()) {
 				m_pMetroBus->midiMonitor_out()->enqueue(
@@ -4062,6 +4357,386 @@ bool qtractorMidiEngine::isDriftCorrect (void) const
 }
 
 
+// JACK MIDI output mode accessors
+// (effective on next bus activation).
+void qtractorMidiEngine::setJackMidiOutput ( bool bJackMidiOutput )
+{
+	m_bJackMidiOutput = bJackMidiOutput;
+}
+
+bool qtractorMidiEngine::isJackMidiOutput (void) const
+{
+	return m_bJackMidiOutput;
+}
+
+
+// JACK MIDI output process cycle (RT).
+void qtractorMidiEngine::processJackMidiOutput (
+	unsigned long iFrameTime, unsigned int nframes )
+{
+	qtractorBus *pBus;
+	for (pBus = buses().first(); pBus; pBus = pBus->next()) {
+		qtractorMidiBus *pMidiBus = static_cast<qtractorMidiBus *> (pBus);
+		if (pMidiBus && pMidiBus->jackMidiPort())
+			pMidiBus->processJackMidi(iFrameTime, nframes);
+	}
+
+	for (pBus = busesEx().first(); pBus; pBus = pBus->next()) {
+		qtractorMidiBus *pMidiBus = static_cast<qtractorMidiBus *> (pBus);
+		if (pMidiBus && pMidiBus->jackMidiPort())
+			pMidiBus->processJackMidi(iFrameTime, nframes);
+	}
+}
+
+
+// JACK MIDI output silence cycle (RT; no session lock).
+void qtractorMidiEngine::processJackMidiSilence ( unsigned int nframes )
+{
+	// Bus ports are being (un)registered right now?
+	if (!ATOMIC_TAS(&m_jackMidiPortsLock))
+		return;
+
+	const int iCount = m_jackMidiPorts.count();
+	for (int i = 0; i < iCount; ++i) {
+		void *pPortBuffer
+			= ::jack_port_get_buffer(m_jackMidiPorts.at(i), nframes);
+		if (pPortBuffer)
+			::jack_midi_clear_buffer(pPortBuffer);
+	}
+
+	ATOMIC_SET(&m_jackMidiPortsLock, 0);
+}
+
+
+// JACK MIDI output port registry (silence cycle).
+void qtractorMidiEngine::addJackMidiPort ( jack_port_t *pJackMidiPort )
+{
+	while (!ATOMIC_TAS(&m_jackMidiPortsLock))
+		;
+
+	m_jackMidiPorts.append(pJackMidiPort);
+
+	ATOMIC_SET(&m_jackMidiPortsLock, 0);
+}
+
+void qtractorMidiEngine::removeJackMidiPort ( jack_port_t *pJackMidiPort )
+{
+	while (!ATOMIC_TAS(&m_jackMidiPortsLock))
+		;
+
+	m_jackMidiPorts.removeAll(pJackMidiPort);
+
+	ATOMIC_SET(&m_jackMidiPortsLock, 0);
+}
+
+
+// MIDI output jitter statistics (scheduled event lateness,
+// in frames), either on JACK MIDI or on ALSA sequencer outputs.
+void qtractorMidiEngine::resetJitter (void)
+{
+	for (int i = 0; i < 2; ++i) {
+		Jitter& jitter = m_jitter[i];
+		jitter.count.store(0, std::memory_order_relaxed);
+		jitter.total.store(0, std::memory_order_relaxed);
+		jitter.max.store(0, std::memory_order_relaxed);
+	}
+
+	m_iAlsaJitterTick = -1;
+}
+
+void qtractorMidiEngine::updateJitter (
+	JitterType jitterType, unsigned long iJitter )
+{
+	Jitter& jitter = m_jitter[jitterType];
+	jitter.count.fetch_add(1, std::memory_order_relaxed);
+	jitter.total.fetch_add(iJitter, std::memory_order_relaxed);
+	unsigned long iJitterMax = jitter.max.load(std::memory_order_relaxed);
+	while (iJitterMax < iJitter && !jitter.max.compare_exchange_weak(
+		iJitterMax, iJitter, std::memory_order_relaxed))
+		;
+}
+
+unsigned long qtractorMidiEngine::jitterCount ( JitterType jitterType ) const
+{
+	return m_jitter[jitterType].count.load(std::memory_order_relaxed);
+}
+
+unsigned long qtractorMidiEngine::jitterMax ( JitterType jitterType ) const
+{
+	return m_jitter[jitterType].max.load(std::memory_order_relaxed);
+}
+
+float qtractorMidiEngine::jitterAvg ( JitterType jitterType ) const
+{
+	const Jitter& jitter = m_jitter[jitterType];
+	const unsigned long iJitterCount
+		= jitter.count.load(std::memory_order_relaxed);
+	return (iJitterCount > 0 ? float(jitter.total.load(
+		std::memory_order_relaxed)) / float(iJitterCount) : 0.0f);
+}
+
+
+// JACK MIDI input mode accessors
+// (effective on next bus activation).
+void qtractorMidiEngine::setJackMidiInput ( bool bJackMidiInput )
+{
+	m_bJackMidiInput = bJackMidiInput;
+}
+
+bool qtractorMidiEngine::isJackMidiInput (void) const
+{
+	return m_bJackMidiInput;
+}
+
+
+// JACK MIDI input process cycle (RT).
+void qtractorMidiEngine::processJackMidiInput ( unsigned int nframes )
+{
+	if (!m_bJackMidiInput)
+		return;
+
+	qtractorSession *pSession = session();
+	if (pSession == nullptr)
+		return;
+
+	qtractorSessionCursor *pAudioCursor
+		= pSession->audioEngine()->sessionCursor();
+	if (pAudioCursor == nullptr)
+		return;
+
+	// Capture goes in frame-time, while plugins
+	// go in whatever time their process cycle is...
+	const unsigned long iFrameTime = pAudioCursor->frameTime();
+	const unsigned long iFrameQueued
+		= (isPlaying() ? iFrameTime : pAudioCursor->frame());
+
+	unsigned int iEvents = 0;
+	unsigned int iMonitors = 0;
+
+	for (qtractorBus *pBus = buses().first(); pBus; pBus = pBus->next()) {
+		qtractorMidiBus *pMidiBus = static_cast<qtractorMidiBus *> (pBus);
+		if (pMidiBus && pMidiBus->jackMidiInputPort()) {
+			iEvents += pMidiBus->processJackMidiInput(
+				iFrameTime, iFrameQueued, nframes, iMonitors);
+		}
+	}
+
+	// Wake up the capture thread, if anything's due...
+	if (iEvents > 0 && m_pInputThread)
+		m_pInputThread->sync();
+
+	// Wake up the output thread, if anything's monitored...
+	if (iMonitors > 0 && m_pOutputThread)
+		m_pOutputThread->sync();
+}
+
+
+// JACK MIDI input capture hand-over (RT).
+bool qtractorMidiEngine::enqueueJackMidiInput ( int iAlsaPort,
+	unsigned long iFrameTime, const unsigned char *pData, unsigned int iSize )
+{
+	if (m_pJackMidiInput == nullptr)
+		return false;
+
+	JackMidiInputHeader head;
+	head.port = iAlsaPort;
+	head.time = iFrameTime;
+	head.size = iSize;
+
+	if (::jack_ringbuffer_write_space(m_pJackMidiInput)
+			< sizeof(head) + iSize)
+		return false;
+
+	::jack_ringbuffer_write(m_pJackMidiInput,
+		(const char *) &head, sizeof(head));
+	::jack_ringbuffer_write(m_pJackMidiInput,
+		(const char *) pData, iSize);
+
+	return true;
+}
+
+
+// JACK MIDI input capture dequeue (input thread).
+bool qtractorMidiEngine::dequeueJackMidiInput ( snd_seq_event_t *pEv )
+{
+	if (m_pJackMidiInput == nullptr || m_pJackMidiInputCoder == nullptr)
+		return false;
+
+	qtractorSession *pSession = session();
+	if (pSession == nullptr)
+		return false;
+
+	JackMidiInputHeader head;
+	while (::jack_ringbuffer_read_space(m_pJackMidiInput) >= sizeof(head)) {
+		::jack_ringbuffer_peek(m_pJackMidiInput, (char *) &head, sizeof(head));
+		if (::jack_ringbuffer_read_space(m_pJackMidiInput)
+				< sizeof(head) + head.size)
+			break;
+		::jack_ringbuffer_read_advance(m_pJackMidiInput, sizeof(head));
+		m_jackMidiInputData.resize(head.size);
+		::jack_ringbuffer_read(m_pJackMidiInput,
+			m_jackMidiInputData.data(), head.size);
+		// Encode into a sequencer event...
+		snd_seq_ev_clear(pEv);
+		snd_midi_event_reset_encode(m_pJackMidiInputCoder);
+		snd_midi_event_encode(m_pJackMidiInputCoder,
+			(const unsigned char *) m_jackMidiInputData.constData(),
+			m_jackMidiInputData.size(), pEv);
+		if (pEv->type == SND_SEQ_EVENT_NONE)
+			continue;
+		// Frame-time to (relative) queue-time...
+		const unsigned long iFrameStartEx
+			= pSession->frameFromTick(m_iTimeStartEx);
+		const unsigned long iTime
+			= pSession->tickFromFrame(iFrameStartEx + head.time);
+		const unsigned long tick = pSession->timep(
+			iTime > m_iTimeStartEx ? iTime - m_iTimeStartEx : 0);
+		snd_seq_ev_set_dest(pEv, m_iAlsaClient, head.port);
+		snd_seq_ev_schedule_tick(pEv, m_iAlsaQueue, 0, tick);
+		return true;
+	}
+
+	return false;
+}
+
+
+// JACK MIDI input monitoring hand-over (RT).
+bool qtractorMidiEngine::enqueueJackMidiMonitor ( int iAlsaPort,
+	snd_seq_event_t *pEv, unsigned long iTime )
+{
+	if (m_pJackMidiMonitor == nullptr)
+		return false;
+
+	if (::jack_ringbuffer_write_space(m_pJackMidiMonitor)
+			< sizeof(JackMidiMonitorEvent))
+		return false;
+
+	JackMidiMonitorEvent event;
+	event.time = iTime;
+	event.port = iAlsaPort;
+	event.ev   = *pEv;
+
+	::jack_ringbuffer_write(m_pJackMidiMonitor,
+		(const char *) &event, sizeof(event));
+
+	return true;
+}
+
+
+// JACK MIDI input monitoring dequeue (output thread).
+void qtractorMidiEngine::dequeueJackMidiMonitor (void)
+{
+	if (m_pJackMidiMonitor == nullptr)
+		return;
+
+	JackMidiMonitorEvent event;
+	while (::jack_ringbuffer_read_space(m_pJackMidiMonitor) >= sizeof(event)) {
+		::jack_ringbuffer_read(m_pJackMidiMonitor,
+			(char *) &event, sizeof(event));
+		qtractorMidiBus *pMidiBus = m_inputBuses.value(event.port, nullptr);
+		if (pMidiBus)
+			queuedMidiManagers(pMidiBus, &event.ev, event.time);
+	}
+}
+
+
+// JACK MIDI input plugin feeding, sample-accurate (output thread).
+void qtractorMidiEngine::queuedMidiManagers (
+	qtractorMidiBus *pMidiBus, snd_seq_event_t *pEv, unsigned long iTime )
+{
+	qtractorSession *pSession = session();
+	if (pSession == nullptr)
+		return;
+
+	const unsigned short iChannel
+		= (snd_seq_ev_is_channel_type(pEv) ? pEv->data.note.channel : 0);
+
+	qtractorMidiManager *pMidiManager;
+
+	// Tracks on input monitoring (MIDI-thru)...
+	for (qtractorTrack *pTrack = pSession->tracks().first();
+			pTrack; pTrack = pTrack->next()) {
+		if (pTrack->trackType() != qtractorTrack::Midi)
+			continue;
+		if (pTrack->inputBus() != pMidiBus)
+			continue;
+		if (!pSession->isTrackMonitor(pTrack)
+			|| !pSession->isTrackMidiChannel(pTrack, iChannel))
+			continue;
+		qtractorMidiBus *pOutputBus
+			= static_cast<qtractorMidiBus *> (pTrack->outputBus());
+		if (pOutputBus == nullptr || pOutputBus->midiMonitor_out() == nullptr)
+			continue;
+		const unsigned short iOldChannel = pEv->data.note.channel;
+		if (snd_seq_ev_is_channel_type(pEv))
+			pEv->data.note.channel = pTrack->midiChannel();
+		pMidiManager = (pTrack->pluginList())->midiManager();
+		if (pMidiManager)
+			pMidiManager->queued(pEv, iTime);
+		if (!pOutputBus->isMonitor() && pOutputBus->pluginList_out()) {
+			pMidiManager = (pOutputBus->pluginList_out())->midiManager();
+			if (pMidiManager)
+				pMidiManager->queued(pEv, iTime);
+		}
+		pEv->data.note.channel = iOldChannel;
+	}
+
+	// Bus input plugins...
+	if (pMidiBus->pluginList_in()) {
+		pMidiManager = (pMidiBus->pluginList_in())->midiManager();
+		if (pMidiManager)
+			pMidiManager->queued(pEv, iTime);
+	}
+
+	// Bus output plugins, on passthru...
+	if (pMidiBus->isMonitor() && pMidiBus->pluginList_out()) {
+		pMidiManager = (pMidiBus->pluginList_out())->midiManager();
+		if (pMidiManager)
+			pMidiManager->queued(pEv, iTime);
+	}
+}
+
+
+// MIDI input-to-timeline offset statistics (in frames).
+void qtractorMidiEngine::resetInputOffset (void)
+{
+	m_iInputOffsetCount.store(0, std::memory_order_relaxed);
+	m_iInputOffsetTotal.store(0, std::memory_order_relaxed);
+	m_iInputOffsetMax.store(0, std::memory_order_relaxed);
+}
+
+void qtractorMidiEngine::updateInputOffset ( long iInputOffset )
+{
+	m_iInputOffsetCount.fetch_add(1, std::memory_order_relaxed);
+	m_iInputOffsetTotal.fetch_add(iInputOffset, std::memory_order_relaxed);
+	const unsigned long iAbsOffset = qAbs(iInputOffset);
+	unsigned long iInputOffsetMax
+		= m_iInputOffsetMax.load(std::memory_order_relaxed);
+	while (iInputOffsetMax < iAbsOffset
+		&& !m_iInputOffsetMax.compare_exchange_weak(
+			iInputOffsetMax, iAbsOffset, std::memory_order_relaxed))
+		;
+}
+
+unsigned long qtractorMidiEngine::inputOffsetCount (void) const
+{
+	return m_iInputOffsetCount.load(std::memory_order_relaxed);
+}
+
+unsigned long qtractorMidiEngine::inputOffsetMax (void) const
+{
+	return m_iInputOffsetMax.load(std::memory_order_relaxed);
+}
+
+float qtractorMidiEngine::inputOffsetAvg (void) const
+{
+	const unsigned long iInputOffsetCount
+		= m_iInputOffsetCount.load(std::memory_order_relaxed);
+	return (iInputOffsetCount > 0 ? float(m_iInputOffsetTotal.load(
+		std::memory_order_relaxed)) / float(iInputOffsetCount) : 0.0f);
+}
+
+
 // MMC device-id accessors.
 void qtractorMidiEngine::setMmcDevice ( unsigned char mmcDevice )
 {
@@ -4129,25 +4804,120 @@ void qtractorMidiEngine::processInpEvents (void)
 	if (pSession == nullptr)
 		return;
 
-	QMutexLocker locker(&m_inpMutex);
+	// Any events from now on will need another notification...
+	ATOMIC_SET(&m_inpPending, 0);
+
+	// Keep captured event storage topped up...
+	reserveInpEvents();
+
+	// Gather all pending events, per clip, in arrival order...
+	QList<qtractorMidiClip *> keys;
+	QHash<qtractorMidiClip *, QList<qtractorMidiEvent *> > events;
+
+	// Ring first, then the spill-over: the ring is drained up to
+	// a write index (re)read under the lock, as the input thread
+	// never writes the ring once anything has been spilled over;
+	// so that all of the ring precedes all of the spill-over...
+	QList<InpItem> spill;
+
+	m_inpMutex.lock();
+	if (m_pInpItems) {
+		unsigned int iRead = m_iInpRead.load(std::memory_order_relaxed);
+		const unsigned int iWrite = m_iInpWrite.load(std::memory_order_acquire);
+		while (iRead != iWrite) {
+			const InpItem& item = m_pInpItems[iRead];
+			if (!events.contains(item.clip))
+				keys.append(item.clip);
+			events[item.clip].append(item.event);
+			iRead = (iRead + 1) & m_iInpMask;
+		}
+		m_iInpRead.store(iRead, std::memory_order_release);
+	}
+	spill.swap(m_inpSpill);
+	m_bInpSpill.store(false, std::memory_order_release);
+	m_inpMutex.unlock();
+
+	QListIterator<InpItem> spill_iter(spill);
+	while (spill_iter.hasNext()) {
+		const InpItem& item = spill_iter.next();
+		if (!events.contains(item.clip))
+			keys.append(item.clip);
+		events[item.clip].append(item.event);
+	}
 
+	// Step input/overdub control, one batch per clip...
 	const bool bOverdub = isPlaying();
-	QList<qtractorMidiClip *> keys; // Avoid duplicates...
-	QListIterator<qtractorMidiClip *> iter(m_inpEvents.keys());
+	QListIterator<qtractorMidiClip *> iter(keys);
 	while (iter.hasNext()) {
 		qtractorMidiClip *pMidiClip = iter.next();
-		if (keys.contains(pMidiClip))
-			continue;
-		keys.append(pMidiClip);
-		// Step input/overdub control...
-		const QList<qtractorMidiEvent *>& events
-			= m_inpEvents.values(pMidiClip);
 		// Apply command *iif* MIDI clip editor is up there,
 		// otherwise make it global to session...
-		pMidiClip->processInpEvents(events, bOverdub);
+		pMidiClip->processInpEvents(events.value(pMidiClip), bOverdub);
+	}
+}
+
+
+// Captured event storage top-up (GUI thread).
+void qtractorMidiEngine::reserveInpEvents (void)
+{
+	if (m_pInpArena)
+		m_pInpArena->reserve(c_iInpSpareChunks);
+}
+
+
+// Step-input event queue producer.
+void qtractorMidiEngine::enqueueInpEvent ( qtractorMidiClip *pMidiClip,
+	qtractorMidiEvent *pEvent, bool bInputThread )
+{
+	// Lock-free, when on the input thread, there's room
+	// and nothing's been spilled over (yet)...
+	if (bInputThread && m_pInpItems
+		&& !m_bInpSpill.load(std::memory_order_acquire)) {
+		const unsigned int iWrite = m_iInpWrite.load(std::memory_order_relaxed);
+		const unsigned int iWriteNext = (iWrite + 1) & m_iInpMask;
+		if (iWriteNext != m_iInpRead.load(std::memory_order_acquire)) {
+			m_pInpItems[iWrite].clip  = pMidiClip;
+			m_pInpItems[iWrite].event = pEvent;
+			m_iInpWrite.store(iWriteNext, std::memory_order_release);
+			return;
+		}
 	}
 
-	m_inpEvents.clear();
+	// Otherwise spill-over...
+	InpItem item;
+	item.clip  = pMidiClip;
+	item.event = pEvent;
+
+	m_inpMutex.lock();
+	m_inpSpill.append(item);
+	m_bInpSpill.store(true, std::memory_order_release);
+	m_inpMutex.unlock();
+}
+
+
+// Step-input event queue cleanup.
+void qtractorMidiEngine::clearInpEvents (void)
+{
+	if (m_pInpItems) {
+		unsigned int iRead = m_iInpRead.load(std::memory_order_relaxed);
+		const unsigned int iWrite = m_iInpWrite.load(std::memory_order_acquire);
+		while (iRead != iWrite) {
+			delete m_pInpItems[iRead].event;
+			iRead = (iRead + 1) & m_iInpMask;
+		}
+		m_iInpRead.store(iRead, std::memory_order_release);
+	}
+
+	QMutexLocker locker(&m_inpMutex);
+
+	QListIterator<InpItem> iter(m_inpSpill);
+	while (iter.hasNext())
+		delete iter.next().event;
+
+	m_inpSpill.clear();
+	m_bInpSpill.store(false, std::memory_order_release);
+
+	ATOMIC_SET(&m_inpPending, 0);
 }
 
 
@@ -4155,6 +4925,18 @@ void qtractorMidiEngine::processInpEvents (void)
 // class qtractorMidiBus -- Managed ALSA sequencer port set
 //
 
+// JACK MIDI output scheduled event buffer size (events).
+static const unsigned int c_iJackMidiBufferSize = 4096;
+
+// JACK MIDI output direct event ring-buffer size (bytes).
+static const size_t c_iJackMidiDirectSize = (64 * 1024);
+
+// JACK MIDI output maximum decoded event size (bytes).
+static const size_t c_iJackMidiEventSize = 32;
+
+// JACK MIDI output queued SysEx payload slots.
+static const unsigned int c_iJackMidiSysexSlots = 64;
+
 // Constructor.
 qtractorMidiBus::qtractorMidiBus ( qtractorMidiEngine *pMidiEngine,
 	const QString& sBusName, BusMode busMode, bool bMonitor )
@@ -4179,12 +4961,30 @@ qtractorMidiBus::qtractorMidiBus ( qtractorMidiEngine *pMidiEngine,
 		m_pOPluginList  = nullptr;
 		m_pSysexList    = nullptr;
 	}
+
+	m_pJackMidiPort    = nullptr;
+	m_pJackQueued      = nullptr;
+	m_pJackPosted      = nullptr;
+	m_pJackCoder       = nullptr;
+	m_pJackDirectCoder = nullptr;
+	m_pJackDirect      = nullptr;
+
+	ATOMIC_SET(&m_jackDirectLock, 0);
+	ATOMIC_SET(&m_jackReset, 0);
+
+	m_pJackSysex = nullptr;
+	m_iJackSysex = 0;
+
+	m_pJackMidiInputPort  = nullptr;
+	m_pJackMidiInputCoder = nullptr;
 }
 
 // Destructor.
 qtractorMidiBus::~qtractorMidiBus (void)
 {
 	close();
+	closeJackMidi();
+	closeJackMidiInput();
 
 	if (m_pIMidiMonitor)
 		delete m_pIMidiMonitor;
@@ -4254,6 +5054,12 @@ bool qtractorMidiBus::open (void)
 	if (snd_seq_set_port_info(pAlsaSeq, m_iAlsaPort, pinfo) < 0)
 		return false;
 
+	// JACK MIDI output, optionally (otherwise fall back to ALSA)...
+	if ((busMode & qtractorBus::Output) && pMidiEngine->isJackMidiOutput())
+		openJackMidi();
+	if ((busMode & qtractorBus::Input) && pMidiEngine->isJackMidiInput())
+		openJackMidiInput();
+
 	// Update monitor subject names...
 	qtractorMidiBus::updateBusName();
 
@@ -4289,6 +5095,9 @@ void qtractorMidiBus::close (void)
 
 	shutOff(true);
 
+	closeJackMidi();
+	closeJackMidiInput();
+
 	snd_seq_delete_simple_port(pAlsaSeq, m_iAlsaPort);
 
 	m_iAlsaPort = -1;
@@ -4390,6 +5199,11 @@ void qtractorMidiBus::shutOff ( bool bClose )
 	qDebug("qtractorMidiBus[%p]::shutOff(%d)", this, int(bClose));
 #endif
 
+	// Drop all JACK MIDI scheduled events on next cycle,
+	// all pending note-offs flushed out first...
+	if (m_pJackMidiPort)
+		ATOMIC_SET(&m_jackReset, 1);
+
 	dequeueNoteOffs(pMidiEngine->queueTime());
 
 	QHash<unsigned short, Patch>::ConstIterator iter
@@ -4488,7 +5302,7 @@ void qtractorMidiBus::setPatch ( unsigned short iChannel,
 			ev.data.control.value = (iBank & 0x3f80) >> 7;
 		else
 			ev.data.control.value = (iBank & 0x007f);
-		snd_seq_event_output_direct(pAlsaSeq, &ev);
+		outputDirect(&ev);
 		if (pTrackMidiManager)
 			pTrackMidiManager->direct(&ev);
 		if (pBusMidiManager)
@@ -4501,7 +5315,7 @@ void qtractorMidiBus::setPatch ( unsigned short iChannel,
 		ev.data.control.channel = iChannel;
 		ev.data.control.param   = BANK_SELECT_LSB;
 		ev.data.control.value   = (iBank & 0x007f);
-		snd_seq_event_output_direct(pAlsaSeq, &ev);
+		outputDirect(&ev);
 		if (pTrackMidiManager)
 			pTrackMidiManager->direct(&ev);
 		if (pBusMidiManager)
@@ -4513,7 +5327,7 @@ void qtractorMidiBus::setPatch ( unsigned short iChannel,
 		ev.type = SND_SEQ_EVENT_PGMCHANGE;
 		ev.data.control.channel = iChannel;
 		ev.data.control.value   = iProg;
-		snd_seq_event_output_direct(pAlsaSeq, &ev);
+		outputDirect(&ev);
 		if (pTrackMidiManager)
 			pTrackMidiManager->direct(&ev);
 		if (pBusMidiManager)
@@ -4591,7 +5405,7 @@ void qtractorMidiBus::setControllerEx ( unsigned short iChannel,
 	ev.data.control.channel = iChannel;
 	ev.data.control.param   = iController;
 	ev.data.control.value   = iValue;
-	snd_seq_event_output_direct(pAlsaSeq, &ev);
+	outputDirect(&ev);
 
 	// Do it for the MIDI plugins too...
 	if (pTrack && (pTrack->pluginList())->midiManager())
@@ -4700,7 +5514,7 @@ void qtractorMidiBus::sendEvent ( qtractorMidiEvent::EventType etype,
 		break;
 	}
 
-	snd_seq_event_output_direct(pAlsaSeq, &ev);
+	outputDirect(&ev);
 }
 
 
@@ -4747,7 +5561,7 @@ void qtractorMidiBus::sendNote (
 	ev.data.note.channel  = iChannel;
 	ev.data.note.note     = iNote;
 	ev.data.note.velocity = iVelocity;
-	snd_seq_event_output_direct(pAlsaSeq, &ev);
+	outputDirect(&ev);
 
 	// Do it for the MIDI plugins too...
 	if ((pTrack->pluginList())->midiManager())
@@ -4820,7 +5634,7 @@ void qtractorMidiBus::sendSysex (
 	// Just set SYSEX stuff and send it out..
 	ev.type = SND_SEQ_EVENT_SYSEX;
 	snd_seq_ev_set_sysex(&ev, iSysex, pSysex);
-	snd_seq_event_output_direct(pAlsaSeq, &ev);
+	outputDirect(&ev);
 
 //	pMidiEngine->flush();
 }
@@ -4869,7 +5683,10 @@ void qtractorMidiBus::sendSysexList (void) const
 		// Just set SYSEX stuff and send it out..
 		ev.type = SND_SEQ_EVENT_SYSEX;
 		snd_seq_ev_set_sysex(&ev, pSysex->size(), pSysex->data());
-		snd_seq_event_output(pAlsaSeq, &ev);
+		if (m_pJackMidiPort)
+			outputDirect(&ev);
+		else
+			snd_seq_event_output(pAlsaSeq, &ev);
 		// AG: Do it for the MIDI plugins too...
 		if (pluginList_out() && pluginList_out()->midiManager())
 			(pluginList_out()->midiManager())->direct(&ev);
@@ -5606,6 +6423,497 @@ void qtractorMidiBus::dequeueNoteOffs ( unsigned long iQueueTime )
 }
 
 
+// JACK MIDI output port accessor.
+jack_port_t *qtractorMidiBus::jackMidiPort (void) const
+{
+	return m_pJackMidiPort;
+}
+
+
+// JACK MIDI output port registration.
+void qtractorMidiBus::openJackMidi (void)
+{
+	closeJackMidi();
+
+	qtractorSession *pSession = engine()->session();
+	if (pSession == nullptr)
+		return;
+
+	qtractorAudioEngine *pAudioEngine = pSession->audioEngine();
+	if (pAudioEngine == nullptr)
+		return;
+
+	jack_client_t *pJackClient = pAudioEngine->jackClient();
+	if (pJackClient == nullptr)
+		return;
+
+	// Scheduled (queued/posted) and direct event buffers...
+	m_pJackQueued = new qtractorMidiBuffer(c_iJackMidiBufferSize);
+	m_pJackPosted = new qtractorMidiBuffer(c_iJackMidiBufferSize);
+	m_pJackDirect = ::jack_ringbuffer_create(c_iJackMidiDirectSize);
+
+	// Queued SysEx payload slots (all free)...
+	m_pJackSysex = new JackSysex [c_iJackMidiSysexSlots];
+	for (unsigned int i = 0; i < c_iJackMidiSysexSlots; ++i) {
+		JackSysex *pSysex = &m_pJackSysex[i];
+		pSysex->data = nullptr;
+		pSysex->size = 0;
+		pSysex->busy.store(false, std::memory_order_relaxed);
+	}
+	m_iJackSysex = 0;
+
+	// Sequencer event to raw MIDI decoders...
+	snd_midi_event_new(c_iJackMidiEventSize, &m_pJackCoder);
+	snd_midi_event_new(c_iJackMidiEventSize, &m_pJackDirectCoder);
+	if (m_pJackCoder)
+		snd_midi_event_no_status(m_pJackCoder, 1);
+	if (m_pJackDirectCoder)
+		snd_midi_event_no_status(m_pJackDirectCoder, 1);
+
+	ATOMIC_SET(&m_jackDirectLock, 0);
+	ATOMIC_SET(&m_jackReset, 0);
+
+	// Finally, the output port itself...
+	jack_port_t *pJackMidiPort = nullptr;
+	if (m_pJackDirect && m_pJackCoder && m_pJackDirectCoder) {
+		pJackMidiPort = ::jack_port_register(pJackClient,
+			QString(busName() + "/midi_out").toUtf8().constData(),
+			JACK_DEFAULT_MIDI_TYPE, JackPortIsOutput, 0);
+	}
+
+	if (pJackMidiPort == nullptr) {
+		closeJackMidi();
+		return;
+	}
+
+	pSession->lock();
+	m_pJackMidiPort = pJackMidiPort;
+	pSession->unlock();
+
+	// Also cleared on the silence cycle...
+	qtractorMidiEngine *pMidiEngine
+		= static_cast<qtractorMidiEngine *> (engine());
+	if (pMidiEngine)
+		pMidiEngine->addJackMidiPort(pJackMidiPort);
+}
+
+
+// JACK MIDI output port unregistration.
+void qtractorMidiBus::closeJackMidi (void)
+{
+	jack_port_t *pJackMidiPort = m_pJackMidiPort;
+	if (pJackMidiPort) {
+		// Make sure we're out of the silence cycle...
+		qtractorMidiEngine *pMidiEngine
+			= static_cast<qtractorMidiEngine *> (engine());
+		if (pMidiEngine)
+			pMidiEngine->removeJackMidiPort(pJackMidiPort);
+		// Make sure we're out of the process cycle...
+		qtractorSession *pSession = engine()->session();
+		if (pSession)
+			pSession->lock();
+		m_pJackMidiPort = nullptr;
+		if (pSession)
+			pSession->unlock();
+		qtractorAudioEngine *pAudioEngine
+			= (pSession ? pSession->audioEngine() : nullptr);
+		jack_client_t *pJackClient
+			= (pAudioEngine ? pAudioEngine->jackClient() : nullptr);
+		if (pJackClient)
+			::jack_port_unregister(pJackClient, pJackMidiPort);
+	}
+
+	if (m_pJackDirectCoder) {
+		snd_midi_event_free(m_pJackDirectCoder);
+		m_pJackDirectCoder = nullptr;
+	}
+
+	if (m_pJackCoder) {
+		snd_midi_event_free(m_pJackCoder);
+		m_pJackCoder = nullptr;
+	}
+
+	if (m_pJackDirect) {
+		::jack_ringbuffer_free(m_pJackDirect);
+		m_pJackDirect = nullptr;
+	}
+
+	if (m_pJackPosted) {
+		delete m_pJackPosted;
+		m_pJackPosted = nullptr;
+	}
+
+	if (m_pJackQueued) {
+		delete m_pJackQueued;
+		m_pJackQueued = nullptr;
+	}
+
+	if (m_pJackSysex) {
+		for (unsigned int i = 0; i < c_iJackMidiSysexSlots; ++i)
+			delete [] m_pJackSysex[i].data;
+		delete [] m_pJackSysex;
+		m_pJackSysex = nullptr;
+	}
+}
+
+
+// JACK MIDI output scheduling (frame-time).
+void qtractorMidiBus::enqueueJackMidi (
+	snd_seq_event_t *pEv, unsigned long iTime, unsigned long iTimeOff )
+{
+	if (m_pJackMidiPort == nullptr)
+		return;
+
+	// Split notes into note-on/off pairs...
+	if (pEv->type == SND_SEQ_EVENT_NOTE && iTime < iTimeOff) {
+		snd_seq_event_t ev = *pEv;
+		ev.type = SND_SEQ_EVENT_NOTEON;
+		if (!m_pJackQueued->insert(&ev, iTime))
+			return;
+		ev.type = SND_SEQ_EVENT_NOTEOFF;
+		ev.data.note.velocity = 0;
+		ev.data.note.duration = 0;
+		m_pJackPosted->insert(&ev, iTimeOff);
+	}
+	else
+	if (pEv->type == SND_SEQ_EVENT_NOTEOFF)
+		m_pJackPosted->insert(pEv, iTime);
+	else
+	if (pEv->type == SND_SEQ_EVENT_SYSEX) {
+		// Copy the payload, as the source storage
+		// may well be gone by the time it's sent...
+		JackSysex *pSysex = nullptr;
+		for (unsigned int i = 0; i < c_iJackMidiSysexSlots; ++i) {
+			JackSysex *pSlot = &m_pJackSysex[m_iJackSysex];
+			if (++m_iJackSysex >= c_iJackMidiSysexSlots)
+				m_iJackSysex = 0;
+			if (!pSlot->busy.load(std::memory_order_acquire)) {
+				pSysex = pSlot;
+				break;
+			}
+		}
+		if (pSysex == nullptr)
+			return;
+		const unsigned int iSize = pEv->data.ext.len;
+		if (pSysex->size < iSize) {
+			delete [] pSysex->data;
+			pSysex->data = new unsigned char [iSize];
+			pSysex->size = iSize;
+		}
+		::memcpy(pSysex->data, pEv->data.ext.ptr, iSize);
+		pSysex->busy.store(true, std::memory_order_relaxed);
+		snd_seq_event_t ev = *pEv;
+		ev.data.ext.ptr = pSysex;
+		if (!m_pJackQueued->insert(&ev, iTime))
+			pSysex->busy.store(false, std::memory_order_relaxed);
+	}
+	else
+		m_pJackQueued->insert(pEv, iTime);
+}
+
+
+// JACK MIDI output scheduled events removal
+// (posted note-offs are kept; must be called under session lock).
+void qtractorMidiBus::dropJackMidi ( unsigned char tag, unsigned short iChannel )
+{
+	if (m_pJackMidiPort == nullptr)
+		return;
+
+	const unsigned int iCount = m_pJackQueued->count();
+	for (unsigned int i = 0; i < iCount; ++i) {
+		snd_seq_event_t *pEv = m_pJackQueued->at(i);
+		if (pEv->tag == tag && snd_seq_ev_is_channel_type(pEv)
+			&& pEv->data.note.channel == iChannel)
+			pEv->type = SND_SEQ_EVENT_NONE;
+	}
+}
+
+
+// Direct event output helper (either ALSA or JACK MIDI).
+void qtractorMidiBus::outputDirect ( snd_seq_event_t *pEv ) const
+{
+	if (m_pJackMidiPort == nullptr) {
+		qtractorMidiEngine *pMidiEngine
+			= static_cast<qtractorMidiEngine *> (engine());
+		snd_seq_t *pAlsaSeq
+			= (pMidiEngine ? pMidiEngine->alsaSeq() : nullptr);
+		if (pAlsaSeq)
+			snd_seq_event_output_direct(pAlsaSeq, pEv);
+		return;
+	}
+
+	// Concurrent producers lock...
+	while (!ATOMIC_TAS(&m_jackDirectLock))
+		;
+
+	unsigned char data[c_iJackMidiEventSize];
+	const unsigned char *pData = data;
+	long iSize = 0;
+
+	if (pEv->type == SND_SEQ_EVENT_SYSEX) {
+		pData = (const unsigned char *) pEv->data.ext.ptr;
+		iSize = long(pEv->data.ext.len);
+	} else {
+		snd_midi_event_reset_decode(m_pJackDirectCoder);
+		iSize = snd_midi_event_decode(m_pJackDirectCoder, data, sizeof(data), pEv);
+	}
+
+	// Write out one record per MIDI message (SysEx is a whole)...
+	long i = 0;
+	while (i < iSize) {
+		long j = i + 1;
+		if (pData[i] == 0xf0)
+			j = iSize;
+		else
+		while (j < iSize && (pData[j] & 0x80) == 0)
+			++j;
+		const unsigned short iRecord = (unsigned short) (j - i);
+		if (long(iRecord) != (j - i) || ::jack_ringbuffer_write_space(
+				m_pJackDirect) < sizeof(iRecord) + iRecord)
+			break;
+		::jack_ringbuffer_write(m_pJackDirect,
+			(const char *) &iRecord, sizeof(iRecord));
+		::jack_ringbuffer_write(m_pJackDirect,
+			(const char *) (pData + i), iRecord);
+		i = j;
+	}
+
+	ATOMIC_SET(&m_jackDirectLock, 0);
+}
+
+
+// JACK MIDI output process cycle (RT).
+void qtractorMidiBus::processJackMidi (
+	unsigned long iFrameTime, unsigned int nframes )
+{
+	void *pPortBuffer = ::jack_port_get_buffer(m_pJackMidiPort, nframes);
+	if (pPortBuffer == nullptr)
+		return;
+
+	::jack_midi_clear_buffer(pPortBuffer);
+
+	// Shut-off requested? drop all scheduled events, but
+	// the pending note-offs, which go out right away...
+	// (nb. reader side only, as the output thread may
+	// be still writing; buffers never get clear()'ed).
+	if (ATOMIC_CAS(&m_jackReset, 1, 0)) {
+		snd_seq_event_t *pEv;
+		while ((pEv = m_pJackQueued->pop()) != nullptr) {
+			if (pEv->type == SND_SEQ_EVENT_SYSEX) {
+				JackSysex *pSysex = static_cast<JackSysex *> (pEv->data.ext.ptr);
+				pSysex->busy.store(false, std::memory_order_release);
+			}
+		}
+		unsigned char data[c_iJackMidiEventSize];
+		while ((pEv = m_pJackPosted->pop()) != nullptr) {
+			if (pEv->type != SND_SEQ_EVENT_NOTEOFF)
+				continue;
+			snd_midi_event_reset_decode(m_pJackCoder);
+			const long iSize
+				= snd_midi_event_decode(m_pJackCoder, data, sizeof(data), pEv);
+			if (iSize > 0)
+				::jack_midi_event_write(pPortBuffer, 0, data, iSize);
+		}
+	}
+
+	// Direct events go first, immediately...
+	unsigned short iRecord = 0;
+	while (::jack_ringbuffer_read_space(m_pJackDirect) >= sizeof(iRecord)) {
+		::jack_ringbuffer_peek(m_pJackDirect, (char *) &iRecord, sizeof(iRecord));
+		if (::jack_ringbuffer_read_space(m_pJackDirect)
+				< sizeof(iRecord) + iRecord)
+			break;
+		::jack_ringbuffer_read_advance(m_pJackDirect, sizeof(iRecord));
+		jack_midi_data_t *pData
+			= ::jack_midi_event_reserve(pPortBuffer, 0, iRecord);
+		if (pData)
+			::jack_ringbuffer_read(m_pJackDirect, (char *) pData, iRecord);
+		else
+			::jack_ringbuffer_read_advance(m_pJackDirect, iRecord);
+	}
+
+	qtractorMidiEngine *pMidiEngine
+		= static_cast<qtractorMidiEngine *> (engine());
+
+	// Queued/posted events, merged (note-offs first)...
+	const unsigned long iFrameEnd = iFrameTime + nframes;
+
+	snd_seq_event_t *pEv1 = m_pJackQueued->peek();
+	snd_seq_event_t *pEv2 = m_pJackPosted->peek();
+
+	for (;;) {
+		const bool bEv1 = (pEv1 && pEv1->time.tick < iFrameEnd);
+		const bool bEv2 = (pEv2 && pEv2->time.tick < iFrameEnd);
+		snd_seq_event_t *pEv = nullptr;
+		if (bEv2 && (!bEv1 || pEv2->time.tick <= pEv1->time.tick)) {
+			pEv = pEv2;
+			pEv2 = m_pJackPosted->next();
+		}
+		else
+		if (bEv1) {
+			pEv = pEv1;
+			pEv1 = m_pJackQueued->next();
+		}
+		else break;
+		// Dropped (muted) event?
+		if (pEv->type == SND_SEQ_EVENT_NONE)
+			continue;
+		// Actual lateness, if any...
+		const unsigned long iTime = pEv->time.tick;
+		const jack_nframes_t iOffset
+			= (iTime > iFrameTime ? iTime - iFrameTime : 0);
+		if (pMidiEngine)
+			pMidiEngine->updateJitter(qtractorMidiEngine::JackJitter,
+				iTime < iFrameTime ? iFrameTime - iTime : 0);
+		// Write it out (SysEx as a whole, from its own slot)...
+		if (pEv->type == SND_SEQ_EVENT_SYSEX) {
+			JackSysex *pSysex = static_cast<JackSysex *> (pEv->data.ext.ptr);
+			::jack_midi_event_write(pPortBuffer, iOffset,
+				pSysex->data, pEv->data.ext.len);
+			pSysex->busy.store(false, std::memory_order_release);
+			continue;
+		}
+		unsigned char data[c_iJackMidiEventSize];
+		snd_midi_event_reset_decode(m_pJackCoder);
+		const long iSize
+			= snd_midi_event_decode(m_pJackCoder, data, sizeof(data), pEv);
+		long i = 0;
+		while (i < iSize) {
+			long j = i + 1;
+			while (j < iSize && (data[j] & 0x80) == 0)
+				++j;
+			::jack_midi_event_write(pPortBuffer, iOffset, data + i, j - i);
+			i = j;
+		}
+	}
+}
+
+
+// JACK MIDI input port accessor.
+jack_port_t *qtractorMidiBus::jackMidiInputPort (void) const
+{
+	return m_pJackMidiInputPort;
+}
+
+
+// JACK MIDI input port registration.
+void qtractorMidiBus::openJackMidiInput (void)
+{
+	closeJackMidiInput();
+
+	qtractorSession *pSession = engine()->session();
+	if (pSession == nullptr)
+		return;
+
+	qtractorAudioEngine *pAudioEngine = pSession->audioEngine();
+	if (pAudioEngine == nullptr)
+		return;
+
+	jack_client_t *pJackClient = pAudioEngine->jackClient();
+	if (pJackClient == nullptr)
+		return;
+
+	// Raw MIDI to sequencer event encoder (plugins feed)...
+	snd_midi_event_new(c_iJackMidiEventSize, &m_pJackMidiInputCoder);
+	if (m_pJackMidiInputCoder == nullptr)
+		return;
+
+	jack_port_t *pJackMidiInputPort = ::jack_port_register(pJackClient,
+		QString(busName() + "/midi_in").toUtf8().constData(),
+		JACK_DEFAULT_MIDI_TYPE, JackPortIsInput, 0);
+
+	if (pJackMidiInputPort == nullptr) {
+		closeJackMidiInput();
+		return;
+	}
+
+	pSession->lock();
+	m_pJackMidiInputPort = pJackMidiInputPort;
+	pSession->unlock();
+}
+
+
+// JACK MIDI input port unregistration.
+void qtractorMidiBus::closeJackMidiInput (void)
+{
+	jack_port_t *pJackMidiInputPort = m_pJackMidiInputPort;
+	if (pJackMidiInputPort) {
+		// Make sure we're out of the process cycle...
+		qtractorSession *pSession = engine()->session();
+		if (pSession)
+			pSession->lock();
+		m_pJackMidiInputPort = nullptr;
+		if (pSession)
+			pSession->unlock();
+		qtractorAudioEngine *pAudioEngine
+			= (pSession ? pSession->audioEngine() : nullptr);
+		jack_client_t *pJackClient
+			= (pAudioEngine ? pAudioEngine->jackClient() : nullptr);
+		if (pJackClient)
+			::jack_port_unregister(pJackClient, pJackMidiInputPort);
+	}
+
+	if (m_pJackMidiInputCoder) {
+		snd_midi_event_free(m_pJackMidiInputCoder);
+		m_pJackMidiInputCoder = nullptr;
+	}
+}
+
+
+// JACK MIDI input process cycle (RT).
+unsigned int qtractorMidiBus::processJackMidiInput ( unsigned long iFrameTime,
+	unsigned long iFrameQueued, unsigned int nframes, unsigned int& iMonitors )
+{
+	void *pPortBuffer = ::jack_port_get_buffer(m_pJackMidiInputPort, nframes);
+	if (pPortBuffer == nullptr)
+		return 0;
+
+	qtractorMidiEngine *pMidiEngine
+		= static_cast<qtractorMidiEngine *> (engine());
+	if (pMidiEngine == nullptr)
+		return 0;
+
+	// Capture latency compensation...
+	jack_latency_range_t range;
+	::jack_port_get_latency_range(m_pJackMidiInputPort,
+		JackCaptureLatency, &range);
+	const unsigned long iLatency = range.max;
+
+	unsigned int iEvents = 0;
+
+	const jack_nframes_t iEventCount
+		= ::jack_midi_get_event_count(pPortBuffer);
+	for (jack_nframes_t i = 0; i < iEventCount; ++i) {
+		jack_midi_event_t event;
+		if (::jack_midi_event_get(&event, pPortBuffer, i) != 0)
+			continue;
+		if (event.size < 1)
+			continue;
+		// Hand it over for recording, timestamped...
+		const unsigned long iTime = iFrameTime + event.time;
+		if (pMidiEngine->enqueueJackMidiInput(m_iAlsaPort,
+				(iTime > iLatency ? iTime - iLatency : 0),
+				event.buffer, event.size))
+			++iEvents;
+		// Feed the plugins, sample-accurately, through the output
+		// thread (but not SysEx, as it won't outlive this cycle)...
+		if (event.buffer[0] == 0xf0)
+			continue;
+		snd_seq_event_t ev;
+		snd_seq_ev_clear(&ev);
+		snd_midi_event_reset_encode(m_pJackMidiInputCoder);
+		snd_midi_event_encode(m_pJackMidiInputCoder,
+			event.buffer, event.size, &ev);
+		if (ev.type != SND_SEQ_EVENT_NONE
+			&& pMidiEngine->enqueueJackMidiMonitor(m_iAlsaPort,
+				&ev, iFrameQueued + event.time))
+			++iMonitors;
+	}
+
+	return iEvents;
+}
+
+
 // Update all aux-sends to this very bus...
 //
 void qtractorMidiBus::updateMidiAuxSends ( const QString& sMidiBusName )
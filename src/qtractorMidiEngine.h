@@ -26,23 +26,33 @@
 #include "qtractorTimeScale.h"
 #include "qtractorMmcEvent.h"
 #include "qtractorCtlEvent.h"
+#include "qtractorAtomic.h"
 
 #include <alsa/asoundlib.h>
 
+#include <jack/jack.h>
+#include <jack/ringbuffer.h>
+
+#include <QByteArray>
+#include <QList>
 #include <QMultiHash>
 #include <QMutex>
 #include <QObject>
 
+#include <atomic>
+
 // Forward declarations.
 class qtractorMidiBus;
 class qtractorMidiClip;
 class qtractorMidiEvent;
+class qtractorMidiEventArena;
 class qtractorMidiSequence;
 class qtractorMidiInputThread;
 class qtractorMidiOutputThread;
 class qtractorMidiMonitor;
 class qtractorMidiSysexList;
 class qtractorMidiInputBuffer;
+class qtractorMidiBuffer;
 class qtractorMidiPlayer;
 class qtractorPluginList;
 class qtractorCurveList;
@@ -155,11 +165,15 @@ public:
 	void removeInputBuffer(int iAlsaPort);
 
 	// MIDI event capture method.
-	void capture(snd_seq_event_t *pEv);
+	void capture(snd_seq_event_t *pEv, bool bMidiManagers = true);
 
-	// MIDI event enqueue method.
+	// MIDI event enqueue methods (the later
+	// with pre-computed note-on/off frames).
 	void enqueue(qtractorTrack *pTrack, qtractorMidiEvent *pEvent,
 		unsigned long iTime, float fGain = 1.0f);
+	void enqueue(qtractorTrack *pTrack, qtractorMidiEvent *pEvent,
+		unsigned long iTime, unsigned long iFrame,
+		unsigned long iFrameOff, float fGain);
 
 	// Flush ouput queue (if necessary)...
 	void flush();
@@ -284,6 +298,65 @@ public:
 	void setDriftCorrect(bool bDriftCorrect);
 	bool isDriftCorrect() const;
 
+	// JACK MIDI output mode accessors
+	// (effective on next bus activation).
+	void setJackMidiOutput(bool bJackMidiOutput);
+	bool isJackMidiOutput() const;
+
+	// JACK MIDI output process cycle (RT).
+	void processJackMidiOutput(unsigned long iFrameTime, unsigned int nframes);
+	void processJackMidiSilence(unsigned int nframes);
+
+	// JACK MIDI output port registry (silence cycle).
+	void addJackMidiPort(jack_port_t *pJackMidiPort);
+	void removeJackMidiPort(jack_port_t *pJackMidiPort);
+
+	// MIDI output jitter statistics (scheduled event lateness,
+	// in frames), either on JACK MIDI output ports (process cycle)
+	// or on the ALSA sequencer queue (queue vs. scheduled time).
+	enum JitterType { JackJitter = 0, AlsaJitter = 1 };
+
+	void resetJitter();
+	void updateJitter(JitterType jitterType, unsigned long iJitter);
+
+	unsigned long jitterCount(JitterType jitterType) const;
+	unsigned long jitterMax(JitterType jitterType) const;
+	float jitterAvg(JitterType jitterType) const;
+
+	// JACK MIDI input mode accessors
+	// (effective on next bus activation).
+	void setJackMidiInput(bool bJackMidiInput);
+	bool isJackMidiInput() const;
+
+	// JACK MIDI input process cycle (RT).
+	void processJackMidiInput(unsigned int nframes);
+
+	// JACK MIDI input capture hand-over (RT).
+	bool enqueueJackMidiInput(int iAlsaPort, unsigned long iFrameTime,
+		const unsigned char *pData, unsigned int iSize);
+
+	// JACK MIDI input capture dequeue (input thread).
+	bool dequeueJackMidiInput(snd_seq_event_t *pEv);
+
+	// JACK MIDI input monitoring hand-over (RT).
+	bool enqueueJackMidiMonitor(int iAlsaPort,
+		snd_seq_event_t *pEv, unsigned long iTime);
+
+	// JACK MIDI input monitoring dequeue (output thread).
+	void dequeueJackMidiMonitor();
+
+	// JACK MIDI input plugin feeding, sample-accurate (output thread).
+	void queuedMidiManagers(qtractorMidiBus *pMidiBus,
+		snd_seq_event_t *pEv, unsigned long iTime);
+
+	// MIDI input-to-timeline offset statistics (in frames).
+	void resetInputOffset();
+	void updateInputOffset(long iInputOffset);
+
+	unsigned long inputOffsetCount() const;
+	unsigned long inputOffsetMax() const;
+	float inputOffsetAvg() const;
+
 	// MMC device-id accessors.
 	void setMmcDevice(unsigned char mmcDevice);
 	unsigned char mmcDevice() const;
@@ -313,6 +386,9 @@ public:
 	// Process pending step-input events...
 	void processInpEvents();
 
+	// Captured event storage top-up (GUI thread).
+	void reserveInpEvents();
+
 protected:
 
 	// Concrete device (de)activation methods.
@@ -386,6 +462,46 @@ private:
 	long m_iTimeDrift;
 	long m_iFrameDrift;
 
+	// Whether to output MIDI through JACK instead.
+	bool m_bJackMidiOutput;
+
+	// MIDI output jitter statistics (JACK and ALSA).
+	struct Jitter
+	{
+		std::atomic<unsigned long> count;
+		std::atomic<unsigned long> total;
+		std::atomic<unsigned long> max;
+	};
+
+	Jitter m_jitter[2];
+
+	// ALSA output jitter: earliest tick scheduled
+	// on the current output cycle (-1 if none).
+	long m_iAlsaJitterTick;
+
+	// JACK MIDI output port registry and its lock
+	// (GUI producer; RT consumer, try-lock only).
+	QList<jack_port_t *> m_jackMidiPorts;
+
+	qtractorAtomic m_jackMidiPortsLock;
+
+	// Whether to capture MIDI through JACK too.
+	bool m_bJackMidiInput;
+
+	// JACK MIDI input capture ring-buffer and decoder.
+	jack_ringbuffer_t *m_pJackMidiInput;
+	snd_midi_event_t  *m_pJackMidiInputCoder;
+	QByteArray         m_jackMidiInputData;
+
+	// JACK MIDI input monitoring ring-buffer
+	// (single producer: RT; single consumer: output thread).
+	jack_ringbuffer_t *m_pJackMidiMonitor;
+
+	// MIDI input-to-timeline offset statistics.
+	std::atomic<unsigned long> m_iInputOffsetCount;
+	std::atomic<long>          m_iInputOffsetTotal;
+	std::atomic<unsigned long> m_iInputOffsetMax;
+
 	// The delta-time/frame when playback started.
 	long m_iTimeStart;
 	long m_iFrameStart;
@@ -458,11 +574,38 @@ private:
 	unsigned short m_iClockCount;
 	float          m_fClockTempo;
 
-	// Step-input event data...
-	typedef QMultiHash<qtractorMidiClip *, qtractorMidiEvent *> InpEvents;
+	// Step-input event queue (input thread to GUI).
+	struct InpItem
+	{
+		qtractorMidiClip  *clip;
+		qtractorMidiEvent *event;
+	};
+
+	// Step-input event queue helpers.
+	void enqueueInpEvent(qtractorMidiClip *pMidiClip,
+		qtractorMidiEvent *pEvent, bool bInputThread);
+	void clearInpEvents();
+
+	// Step-input event ring (lock-free, single producer/consumer).
+	InpItem       *m_pInpItems;
+	unsigned int   m_iInpSize;
+	unsigned int   m_iInpMask;
+
+	std::atomic<unsigned int> m_iInpRead;
+	std::atomic<unsigned int> m_iInpWrite;
 
-	InpEvents m_inpEvents;
-	QMutex    m_inpMutex;
+	// Step-input event overflow (and foreign thread) spill-over;
+	// while not empty, the ring is bypassed, to keep arrival order
+	// (flag is only set/reset under the mutex).
+	QList<InpItem>    m_inpSpill;
+	QMutex            m_inpMutex;
+	std::atomic<bool> m_bInpSpill;
+
+	// Step-input notification pending flag (batched updates).
+	qtractorAtomic m_inpPending;
+
+	// Captured event storage (input thread owned).
+	qtractorMidiEventArena *m_pInpArena;
 };
 
 
@@ -585,8 +728,42 @@ public:
 	// Update all aux-sends to this very bus...
 	void updateMidiAuxSends(const QString& sMidiBusName);
 
+	// JACK MIDI output port accessor.
+	jack_port_t *jackMidiPort() const;
+
+	// JACK MIDI output scheduling (frame-time).
+	void enqueueJackMidi(snd_seq_event_t *pEv,
+		unsigned long iTime, unsigned long iTimeOff);
+
+	// JACK MIDI output scheduled events removal
+	// (must be called under session lock).
+	void dropJackMidi(unsigned char tag, unsigned short iChannel);
+
+	// JACK MIDI output process cycle (RT).
+	void processJackMidi(unsigned long iFrameTime, unsigned int nframes);
+
+	// JACK MIDI input port accessor.
+	jack_port_t *jackMidiInputPort() const;
+
+	// JACK MIDI input process cycle (RT);
+	// returns the number of events captured
+	// (and adds up the number of events monitored).
+	unsigned int processJackMidiInput(unsigned long iFrameTime,
+		unsigned long iFrameQueued, unsigned int nframes,
+		unsigned int& iMonitors);
+
 protected:
 
+	// Direct event output helper (either ALSA or JACK MIDI).
+	void outputDirect(snd_seq_event_t *pEv) const;
+
+	// JACK MIDI output port (un)registration.
+	void openJackMidi();
+	void closeJackMidi();
+
+	void openJackMidiInput();
+	void closeJackMidiInput();
+
 	// Direct MIDI controller common helper.
 	void setControllerEx(unsigned short iChannel, int iController,
 		int iValue = 0, qtractorTrack *pTrack = nullptr) const;
@@ -651,6 +828,39 @@ private:
 	typedef QHash<unsigned short, NoteOff> NoteOffs;
 
 	NoteOffs m_noteOffs;
+
+	// JACK MIDI output port and scheduled event buffers.
+	jack_port_t        *m_pJackMidiPort;
+	qtractorMidiBuffer *m_pJackQueued;
+	qtractorMidiBuffer *m_pJackPosted;
+
+	// JACK MIDI output event decoders (RT and direct).
+	snd_midi_event_t   *m_pJackCoder;
+	snd_midi_event_t   *m_pJackDirectCoder;
+
+	// JACK MIDI output direct events (raw) and producers lock.
+	jack_ringbuffer_t  *m_pJackDirect;
+
+	mutable qtractorAtomic m_jackDirectLock;
+
+	// JACK MIDI output reset request (shut-off).
+	qtractorAtomic m_jackReset;
+
+	// JACK MIDI output queued SysEx payload slots
+	// (filled by the output thread, released on RT).
+	struct JackSysex
+	{
+		unsigned char     *data;
+		unsigned int       size;
+		std::atomic<bool>  busy;
+	};
+
+	JackSysex    *m_pJackSysex;
+	unsigned int  m_iJackSysex;
+
+	// JACK MIDI input port and plugin feed encoder.
+	jack_port_t        *m_pJackMidiInputPort;
+	snd_midi_event_t   *m_pJackMidiInputCoder;
 };
 
 
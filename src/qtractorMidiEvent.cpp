@@ -0,0 +1,414 @@
+// qtractorMidiEvent.cpp
+//
+/****************************************************************************
+   Copyright (C) 2005-2025, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#include "qtractorAbout.h"
+#include "qtractorMidiEvent.h"
+
+#include "qtractorAtomic.h"
+
+#include <QMutex>
+
+#include <new>
+
+#include <stdint.h>
+#include <stdlib.h>
+
+
+// Arena chunk size, also its alignment (must be a power-of-two).
+static const size_t c_iChunkSize = (16 * 1024);
+
+// Allocation granularity (pointer-sized words).
+static const size_t c_iAlignSize = sizeof(void *);
+
+// Maximum number of global spare (recycled) chunks.
+static const unsigned int c_iSpareChunks = 64;
+
+// Sysex payloads up to this size go into the side-buffer arena.
+static const unsigned short c_iSysexSize = 256;
+
+// Event slot size, rounded up to granularity.
+static const size_t c_iSlotSize
+	= (sizeof(qtractorMidiEvent) + c_iAlignSize - 1) & ~(c_iAlignSize - 1);
+
+
+//----------------------------------------------------------------------
+// struct qtractorMidiEventArena::Chunk -- Arena chunk header.
+//
+
+struct qtractorMidiEventArena::Chunk
+{
+	// Live allocations, biased while still current.
+	qtractorAtomic refs;
+
+	// Bump allocation offset and count (owner only).
+	size_t offset;
+	int count;
+
+	// Freed event slots, for owner reuse while still current
+	// (lock-free stack, linked through their first word).
+	std::atomic<void *> slots;
+
+	// Spare chunk list link.
+	Chunk *next;
+};
+
+// Chunk header size, rounded up to granularity.
+static const size_t c_iChunkHead
+	= (sizeof(qtractorMidiEventArena::Chunk) + 15) & ~size_t(15);
+
+
+// Reference count bias, while the chunk is still current,
+// so that its owner won't need an atomic op per allocation.
+static const int c_iChunkBias = (1 << 30);
+
+// Freed event slots stack sentinel, once the chunk is retired
+// (slots are then just released, as any other allocation).
+static void *const c_pSlotsClosed = reinterpret_cast<void *> (uintptr_t(1));
+
+// Number of currently allocated chunks.
+static qtractorAtomic g_iChunks;
+
+// Heap allocations and slot reuses (statistics).
+static qtractorAtomic g_iHeapAllocs;
+static qtractorAtomic g_iSlotReuses;
+
+// Global spare (recycled) chunks, still warm in memory
+// (never hit on the capture path, as arenas reserve their own).
+static qtractorMidiEventArena::Chunk *g_pSpareChunks = nullptr;
+static unsigned int g_iSpareChunks = 0;
+
+static QMutex g_spareMutex;
+
+
+// Chunk of a given allocation.
+static inline qtractorMidiEventArena::Chunk *chunk_of ( void *pv )
+{
+	return (qtractorMidiEventArena::Chunk *)
+		(uintptr_t(pv) & ~uintptr_t(c_iChunkSize - 1));
+}
+
+
+// Chunk allocator (global spares first, then heap).
+static qtractorMidiEventArena::Chunk *chunk_alloc ( unsigned int *piMallocs )
+{
+	g_spareMutex.lock();
+	qtractorMidiEventArena::Chunk *pChunk = g_pSpareChunks;
+	if (pChunk) {
+		g_pSpareChunks = pChunk->next;
+		--g_iSpareChunks;
+	}
+	g_spareMutex.unlock();
+
+	if (pChunk)
+		return pChunk;
+
+	void *pv = nullptr;
+	if (::posix_memalign(&pv, c_iChunkSize, c_iChunkSize) != 0)
+		throw std::bad_alloc();
+
+	ATOMIC_INC(&g_iChunks);
+	ATOMIC_INC(&g_iHeapAllocs);
+
+	if (piMallocs)
+		++(*piMallocs);
+
+	return new (pv) qtractorMidiEventArena::Chunk;
+}
+
+
+// Chunk deallocator (global spares first, then heap).
+static void chunk_free ( qtractorMidiEventArena::Chunk *pChunk )
+{
+	g_spareMutex.lock();
+	if (g_iSpareChunks < c_iSpareChunks) {
+		pChunk->next = g_pSpareChunks;
+		g_pSpareChunks = pChunk;
+		++g_iSpareChunks;
+		pChunk = nullptr;
+	}
+	g_spareMutex.unlock();
+
+	if (pChunk) {
+		ATOMIC_DEC(&g_iChunks);
+		pChunk->~Chunk();
+		::free(pChunk);
+	}
+}
+
+
+// Chunk reference release.
+static void chunk_unref (
+	qtractorMidiEventArena::Chunk *pChunk, int iRefs = 1 )
+{
+	if (ATOMIC_ADD(&pChunk->refs, -iRefs) <= 0)
+		chunk_free(pChunk);
+}
+
+
+//----------------------------------------------------------------------
+// class qtractorMidiEventArena -- Contiguous (chunked) event storage.
+//
+
+// Default (shared) arenas: events and sysex payloads.
+static qtractorMidiEventArena *g_pDefaultArena = nullptr;
+static qtractorMidiEventArena *g_pSysexArena = nullptr;
+
+static QMutex g_mutex;
+
+
+// Constructor.
+qtractorMidiEventArena::qtractorMidiEventArena (void)
+	: m_pChunk(nullptr), m_pSlots(nullptr),
+		m_iSpareRead(0), m_iSpareWrite(0), m_iMallocs(0)
+{
+}
+
+
+// Destructor.
+qtractorMidiEventArena::~qtractorMidiEventArena (void)
+{
+	reset();
+
+	// Give back all reserved spares...
+	unsigned int iRead = m_iSpareRead.load(std::memory_order_relaxed);
+	const unsigned int iWrite = m_iSpareWrite.load(std::memory_order_acquire);
+	while (iRead != iWrite) {
+		chunk_free(m_ppSpares[iRead % MaxSpares]);
+		++iRead;
+	}
+}
+
+
+// Allocate from the current chunk (owner thread only).
+void *qtractorMidiEventArena::alloc ( size_t iSize )
+{
+	iSize = (iSize + c_iAlignSize - 1) & ~(c_iAlignSize - 1);
+
+	// Recycled event slot first...
+	if (iSize == c_iSlotSize && m_pChunk) {
+		void *pv = allocSlot();
+		if (pv)
+			return pv;
+	}
+
+	if (m_pChunk == nullptr || m_pChunk->offset + iSize > c_iChunkSize) {
+		if (m_pChunk)
+			retireChunk();
+		m_pChunk = newChunk();
+	}
+
+	void *pv = (char *) m_pChunk + m_pChunk->offset;
+	m_pChunk->offset += iSize;
+	++m_pChunk->count;
+
+	return pv;
+}
+
+
+// Start over on a fresh chunk.
+void qtractorMidiEventArena::reset (void)
+{
+	if (m_pChunk) {
+		retireChunk();
+		m_pChunk = nullptr;
+	}
+}
+
+
+// Spare chunks reservation, in advance (non real-time;
+// single thread, other than the owner's, or the owner itself).
+void qtractorMidiEventArena::reserve ( unsigned int iChunks )
+{
+	if (iChunks > MaxSpares)
+		iChunks = MaxSpares;
+
+	unsigned int iWrite = m_iSpareWrite.load(std::memory_order_relaxed);
+	while (iWrite - m_iSpareRead.load(std::memory_order_acquire) < iChunks) {
+		m_ppSpares[iWrite % MaxSpares] = chunk_alloc(nullptr);
+		m_iSpareWrite.store(++iWrite, std::memory_order_release);
+	}
+}
+
+
+// Recycled event slot from current chunk, if any.
+void *qtractorMidiEventArena::allocSlot (void)
+{
+	if (m_pSlots == nullptr
+		&& m_pChunk->slots.load(std::memory_order_relaxed) != nullptr)
+		m_pSlots = m_pChunk->slots.exchange(nullptr, std::memory_order_acquire);
+
+	void *pv = m_pSlots;
+	if (pv) {
+		m_pSlots = *(void **) pv;
+		ATOMIC_INC(&g_iSlotReuses);
+	}
+
+	return pv;
+}
+
+
+// New current chunk (owner thread only).
+qtractorMidiEventArena::Chunk *qtractorMidiEventArena::newChunk (void)
+{
+	Chunk *pChunk = nullptr;
+
+	// Reserved spares first...
+	const unsigned int iRead = m_iSpareRead.load(std::memory_order_relaxed);
+	if (iRead != m_iSpareWrite.load(std::memory_order_acquire)) {
+		pChunk = m_ppSpares[iRead % MaxSpares];
+		m_iSpareRead.store(iRead + 1, std::memory_order_release);
+	}
+	else pChunk = chunk_alloc(&m_iMallocs);
+
+	ATOMIC_SET(&pChunk->refs, c_iChunkBias);
+	pChunk->offset = c_iChunkHead;
+	pChunk->count = 0;
+	pChunk->slots.store(nullptr, std::memory_order_relaxed);
+	pChunk->next = nullptr;
+
+	return pChunk;
+}
+
+
+// Retire current chunk (owner thread only; unbiased).
+void qtractorMidiEventArena::retireChunk (void)
+{
+	Chunk *pChunk = m_pChunk;
+
+	// Close the freed slots stack; all slots still
+	// there or held here are released as well...
+	int iSlots = 0;
+	void *pv = pChunk->slots.exchange(c_pSlotsClosed, std::memory_order_acquire);
+	for ( ; pv; pv = *(void **) pv)
+		++iSlots;
+	for (pv = m_pSlots; pv; pv = *(void **) pv)
+		++iSlots;
+	m_pSlots = nullptr;
+
+	chunk_unref(pChunk, c_iChunkBias - pChunk->count + iSlots);
+}
+
+
+// Release a previous allocation (any thread).
+void qtractorMidiEventArena::release ( void *pv )
+{
+	if (pv == nullptr)
+		return;
+
+	chunk_unref(chunk_of(pv));
+}
+
+
+// Release a previous event-sized allocation, for reuse (any thread).
+void qtractorMidiEventArena::releaseSlot ( void *pv, size_t iSize )
+{
+	if (pv == nullptr)
+		return;
+
+	Chunk *pChunk = chunk_of(pv);
+
+	// Back to its own chunk, if still current...
+	iSize = (iSize + c_iAlignSize - 1) & ~(c_iAlignSize - 1);
+	if (iSize == c_iSlotSize) {
+		void *pHead = pChunk->slots.load(std::memory_order_relaxed);
+		while (pHead != c_pSlotsClosed) {
+			*(void **) pv = pHead;
+			if (pChunk->slots.compare_exchange_weak(pHead, pv,
+					std::memory_order_release, std::memory_order_relaxed))
+				return;
+		}
+	}
+
+	chunk_unref(pChunk);
+}
+
+
+// Default (shared) arena allocation (thread-safe).
+void *qtractorMidiEventArena::allocDefault ( size_t iSize )
+{
+	QMutexLocker locker(&g_mutex);
+
+	if (g_pDefaultArena == nullptr)
+		g_pDefaultArena = new qtractorMidiEventArena();
+
+	return g_pDefaultArena->alloc(iSize);
+}
+
+
+// Sysex payload side-buffer (thread-safe,
+// unless an owned arena is given).
+unsigned char *qtractorMidiEventArena::allocSysex (
+	unsigned short iSysex, qtractorMidiEventArena *pArena )
+{
+	if (iSysex > c_iSysexSize) {
+		ATOMIC_INC(&g_iHeapAllocs);
+		if (pArena)
+			++pArena->m_iMallocs;
+		return new unsigned char [iSysex];
+	}
+
+	if (pArena)
+		return (unsigned char *) pArena->alloc(iSysex > 0 ? iSysex : 1);
+
+	QMutexLocker locker(&g_mutex);
+
+	if (g_pSysexArena == nullptr)
+		g_pSysexArena = new qtractorMidiEventArena();
+
+	return (unsigned char *) g_pSysexArena->alloc(iSysex > 0 ? iSysex : 1);
+}
+
+
+void qtractorMidiEventArena::freeSysex (
+	unsigned char *pSysex, unsigned short iSysex )
+{
+	if (iSysex > c_iSysexSize)
+		delete [] pSysex;
+	else
+		release(pSysex);
+}
+
+
+// Allocation statistics.
+unsigned int qtractorMidiEventArena::chunks (void)
+{
+	return ATOMIC_GET(&g_iChunks);
+}
+
+unsigned int qtractorMidiEventArena::spares (void)
+{
+	QMutexLocker locker(&g_spareMutex);
+
+	return g_iSpareChunks;
+}
+
+unsigned int qtractorMidiEventArena::heapAllocs (void)
+{
+	return ATOMIC_GET(&g_iHeapAllocs);
+}
+
+unsigned int qtractorMidiEventArena::slotReuses (void)
+{
+	return ATOMIC_GET(&g_iSlotReuses);
+}
+
+
+// end of qtractorMidiEvent.cpp
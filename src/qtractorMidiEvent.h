@@ -27,6 +27,107 @@
 #include <stdio.h>
 #include <string.h>
 
+#include <atomic>
+
+
+//----------------------------------------------------------------------
+// class qtractorMidiEventArena -- Contiguous (chunked) event storage.
+//
+// Events are bump-allocated, in creation order, out of fixed-size
+// aligned chunks, each one reference counted by its live allocations;
+// a chunk is released as soon as its last event is gone, wherever it
+// might belong by then (sequence, clipboard or undo/redo command).
+// Freed event slots go back to their own chunk (lock-free), to be
+// reused by its owner arena only while the chunk is still current;
+// spare chunks may be reserved per arena, in advance, so that steady
+// state allocation (eg. on capture) never has to hit the heap nor
+// block on a mutex.
+//
+// Note that a single live event keeps its whole chunk allocated (eg.
+// a few events moved to the clipboard or some undo/redo command, out
+// of an otherwise deleted sequence); chunks are kept fairly small
+// (16KB, some three hundred events) to bound that.
+//
+
+class qtractorMidiEventArena
+{
+public:
+
+	// Constructor.
+	qtractorMidiEventArena();
+
+	// Destructor.
+	~qtractorMidiEventArena();
+
+	// Allocate from the current chunk (owner thread only).
+	void *alloc(size_t iSize);
+
+	// Start over on a fresh chunk.
+	void reset();
+
+	// Spare chunks reservation, in advance (non real-time;
+	// single thread, other than the owner's, or the owner itself).
+	void reserve(unsigned int iChunks);
+
+	// Number of heap allocations made by this arena (statistics).
+	unsigned int mallocs() const { return m_iMallocs; }
+
+	// Release a previous allocation (any thread).
+	static void release(void *pv);
+
+	// Release a previous event-sized allocation, for reuse (any thread).
+	static void releaseSlot(void *pv, size_t iSize);
+
+	// Default (shared) arena allocation (thread-safe).
+	static void *allocDefault(size_t iSize);
+
+	// Sysex payload side-buffer (thread-safe,
+	// unless an owned arena is given).
+	static unsigned char *allocSysex(unsigned short iSysex,
+		qtractorMidiEventArena *pArena = nullptr);
+	static void freeSysex(unsigned char *pSysex, unsigned short iSysex);
+
+	// Allocation statistics.
+	static unsigned int chunks();
+	static unsigned int spares();
+	static unsigned int heapAllocs();
+	static unsigned int slotReuses();
+
+	// Chunk header (opaque).
+	struct Chunk;
+
+	// Maximum number of reserved spare chunks, per arena.
+	enum { MaxSpares = 16 };
+
+protected:
+
+	// Recycled event slot from current chunk, if any.
+	void *allocSlot();
+
+	// New current chunk (owner thread only).
+	Chunk *newChunk();
+
+	// Retire current chunk (owner thread only).
+	void retireChunk();
+
+private:
+
+	// Current chunk.
+	Chunk *m_pChunk;
+
+	// Recycled event slots, taken from current chunk (owner only).
+	void *m_pSlots;
+
+	// Reserved spare chunks (lock-free, single producer/consumer).
+	Chunk *m_ppSpares[MaxSpares];
+
+	std::atomic<unsigned int> m_iSpareRead;
+	std::atomic<unsigned int> m_iSpareWrite;
+
+	// Heap allocation count (owner thread only).
+	unsigned int m_iMallocs;
+};
+
 
 //----------------------------------------------------------------------
 // class qtractorMidiEvent -- The generic MIDI event element.
@@ -80,13 +181,15 @@ public:
 		: m_time(time), m_type(type)
 		{ m_v.param = param; m_v.value = value; m_u.duration = duration; }
 
-	// Copy constructor.
-	qtractorMidiEvent(const qtractorMidiEvent& e)
+	// Copy constructor (sysex payload copy
+	// from the given arena, if any).
+	qtractorMidiEvent(const qtractorMidiEvent& e,
+		qtractorMidiEventArena *pArena = nullptr)
 		: m_time(e.m_time), m_type(e.m_type)
 	{
 		if (m_type == SYSEX) {
 			m_v.iSysex = e.m_v.iSysex;
-			m_u.pSysex = new unsigned char [m_v.iSysex];
+			m_u.pSysex = qtractorMidiEventArena::allocSysex(m_v.iSysex, pArena);
 			::memcpy(m_u.pSysex, e.m_u.pSysex, m_v.iSysex);
 		} else {
 			m_v.param = e.m_v.param;
@@ -97,7 +200,21 @@ public:
 
 	// Destructor.
 	~qtractorMidiEvent()
-		{ if (m_type == SYSEX && m_u.pSysex) delete [] m_u.pSysex; }
+	{
+		if (m_type == SYSEX && m_u.pSysex)
+			qtractorMidiEventArena::freeSysex(m_u.pSysex, m_v.iSysex);
+	}
+
+	// Arena-backed allocation operators.
+	static void *operator new (size_t iSize)
+		{ return qtractorMidiEventArena::allocDefault(iSize); }
+	static void *operator new (size_t iSize, qtractorMidiEventArena *pArena)
+		{ return (pArena ? pArena->alloc(iSize)
+			: qtractorMidiEventArena::allocDefault(iSize)); }
+	static void operator delete (void *pv, size_t iSize)
+		{ qtractorMidiEventArena::releaseSlot(pv, iSize); }
+	static void operator delete (void *pv, qtractorMidiEventArena *)
+		{ qtractorMidiEventArena::release(pv); }
 
 	// Event properties accessors (getters).
 	unsigned long time()       const { return m_time; }
@@ -137,11 +254,13 @@ public:
 	unsigned short sysex_len() const { return m_v.iSysex; }
 
 	// Allocate and set a new sysex buffer.
-	void setSysex(unsigned char *pSysex, unsigned short iSysex)
+	void setSysex(unsigned char *pSysex, unsigned short iSysex,
+		qtractorMidiEventArena *pArena = nullptr)
 	{
-		if (m_type == SYSEX && m_u.pSysex) delete [] m_u.pSysex;
+		if (m_type == SYSEX && m_u.pSysex)
+			qtractorMidiEventArena::freeSysex(m_u.pSysex, m_v.iSysex);
 		m_v.iSysex = iSysex;
-		m_u.pSysex = new unsigned char [m_v.iSysex];
+		m_u.pSysex = qtractorMidiEventArena::allocSysex(m_v.iSysex, pArena);
 		::memcpy(m_u.pSysex, pSysex, m_v.iSysex);
 	}
 
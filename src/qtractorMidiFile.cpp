@@ -26,7 +26,10 @@
 
 #include "qtractorMidiRpn.h"
 
+#include "qtractorAtomic.h"
+
 #include <QRegularExpression>
+#include <QThread>
 #include <QDir>
 
 
@@ -49,6 +52,9 @@
 #define DATA_MSB  0x06
 #define DATA_LSB  0x26
 
+// Minimum file size worth reading tracks in parallel.
+static const int c_iParallelSize = (32 * 1024);
+
 //----------------------------------------------------------------------
 // class qtractorMidiFileRpn -- MIDI RPN/NRPN file parser.
 //
@@ -97,8 +103,8 @@ public:
 				default:
 					continue;
 				}
-				qtractorMidiEvent *pEvent = new qtractorMidiEvent(
-					event.time, type, event.param, event.value);
+				qtractorMidiEvent *pEvent = new (pSeq->arena())
+					qtractorMidiEvent(event.time, type, event.param, event.value);
 				pSeq->addEvent(pEvent);
 				pSeq->setChannel(event.status & 0x0f);
 			}
@@ -107,6 +113,56 @@ public:
 };
 
 
+//----------------------------------------------------------------------
+// class qtractorMidiFileTrackThread -- MIDI file track reader thread.
+//
+class qtractorMidiFileTrackThread : public QThread
+{
+public:
+
+	// Shared reading job.
+	struct Job
+	{
+		const qtractorMidiFile *file;
+		qtractorMidiSequence  **seqs;
+		unsigned short          nseqs;
+		unsigned short          tracks;
+		QList<qtractorMidiFile::TempoItem> *items;
+		qtractorAtomic          next;
+		qtractorAtomic          errors;
+	};
+
+	// Constructor.
+	qtractorMidiFileTrackThread(Job *pJob) : QThread(), m_pJob(pJob) {}
+
+	// Destructor.
+	~qtractorMidiFileTrackThread() { wait(); }
+
+	// Read next pending track, while any (any thread).
+	static void process ( Job *pJob )
+	{
+		for (;;) {
+			const int iSeqTrack = ATOMIC_INC(&pJob->next) - 1;
+			if (iSeqTrack >= pJob->tracks)
+				break;
+			if (!pJob->file->readTrackEvents(iSeqTrack,
+					pJob->seqs, pJob->nseqs, iSeqTrack,
+					pJob->items[iSeqTrack]))
+				ATOMIC_INC(&pJob->errors);
+		}
+	}
+
+protected:
+
+	// The main thread executive.
+	void run() { process(m_pJob); }
+
+private:
+
+	// Instance variables.
+	Job *m_pJob;
+};
+
 
 //----------------------------------------------------------------------
 // class qtractorMidiFile -- A SMF (Standard MIDI File) class.
@@ -120,6 +176,9 @@ qtractorMidiFile::qtractorMidiFile (void)
 	m_pFile         = nullptr;
 	m_iOffset       = 0;
 
+	m_iDataOffset   = 0;
+	m_iFileSize     = 0;
+
 	// Header informational data.
 	m_iFormat       = 0;
 	m_iTracks       = 0;
@@ -160,9 +219,27 @@ bool qtractorMidiFile::open ( const QString& sFilename, int iMode )
 	if (m_iMode == Write)
 		return true;
 
+	// Just the header and track chunk map, for now;
+	// track contents are only read in on demand...
+	long iFileSize = -1;
+	if (::fseek(m_pFile, 0, SEEK_END) == 0)
+		iFileSize = ::ftell(m_pFile);
+	if (iFileSize < 14) {
+		close();
+		return false;
+	}
+
+	m_iFileSize = iFileSize;
+
+	if (!loadData(0, 14)) {
+		close();
+		return false;
+	}
+
 	// First word must identify the file as a SMF;
 	// must be literal "MThd"
 	char header[5];
+	header[0] = (char) 0;
 	readData((unsigned char *) &header[0], 4); header[4] = (char) 0;
 	if (::strcmp(header, SMF_MTHD)) {
 		close();
@@ -170,7 +247,7 @@ bool qtractorMidiFile::open ( const QString& sFilename, int iMode )
 	}
 
 	// Second word should be the total header chunk length...
-	int iMThdLength = readInt(4);
+	const int iMThdLength = readInt(4);
 	if (iMThdLength < 6) {
 		close();
 		return false;
@@ -181,42 +258,51 @@ bool qtractorMidiFile::open ( const QString& sFilename, int iMode )
 	m_iTracks = (unsigned short) readInt(2);
 	m_iTicksPerBeat = (unsigned short) readInt(2);
 	// Should skip any extra bytes...
-	while (iMThdLength > 6) {
-		if (::fgetc(m_pFile) < 0) {
-			close();
-			return false;
-		}
-		++m_iOffset;
-		--iMThdLength;
+	m_iOffset += (iMThdLength - 6);
+	if (m_iOffset > m_iFileSize) {
+		close();
+		return false;
 	}
 
 	// Allocate the track map.
 	m_pTrackInfo = new TrackInfo [m_iTracks];
 	for (int iTrack = 0; iTrack < m_iTracks; ++iTrack) {
+		// Track chunk header...
+		if (!loadData(m_iOffset, 8)) {
+			close();
+			return false;
+		}
 		// Must be a track header "MTrk"...
+		header[0] = (char) 0;
 		readData((unsigned char *) &header[0], 4); header[4] = (char) 0;
 		if (::strcmp(header, SMF_MTRK)) {
 			close();
 			return false;
 		}
 		// Check track chunk length...
-		const int iMTrkLength = readInt(4);
+		int iMTrkLength = readInt(4);
 		if (iMTrkLength < 0) {
 			close();
 			return false;
 		}
+		// Truncated track chunk?
+		if (m_iOffset + iMTrkLength > m_iFileSize)
+			iMTrkLength = m_iFileSize - m_iOffset;
 		// Set this one track info.
 		m_pTrackInfo[iTrack].length = iMTrkLength;
 		m_pTrackInfo[iTrack].offset = m_iOffset;
-		// Set next track offset...
-		m_iOffset += iMTrkLength;
+		m_pTrackInfo[iTrack].scanned = false;
 		// Advance to next one...
-		if (::fseek(m_pFile, m_iOffset, SEEK_SET)) {
-			close();
-			return false;
-		}
+		m_iOffset += iMTrkLength;
 	}
 
+	// No need for the file (nor its header) anymore...
+	::fclose(m_pFile);
+	m_pFile = nullptr;
+
+	m_data.clear();
+	m_iDataOffset = 0;
+
 	// Special tempo/time-signature map.
 	m_pTempoMap = new qtractorMidiFileTempo(this);
 
@@ -233,6 +319,10 @@ void qtractorMidiFile::close (void)
 		m_pFile = nullptr;
 	}
 
+	m_data.clear();
+	m_iDataOffset = 0;
+	m_iFileSize = 0;
+
 	if (m_pTrackInfo) {
 		delete [] m_pTrackInfo;
 		m_pTrackInfo = nullptr;
@@ -249,328 +339,424 @@ void qtractorMidiFile::close (void)
 bool qtractorMidiFile::readTracks ( qtractorMidiSequence **ppSeqs,
 	unsigned short iSeqs, unsigned short iTrackChannel )
 {
-	if (m_pFile == nullptr)
+	if (m_pTrackInfo == nullptr)
 		return false;
 	if (m_pTempoMap == nullptr)
 		return false;
 	if (m_iMode != Read)
 		return false;
 
-	// Expedite RPN/NRPN controllers processor...
-	qtractorMidiFileRpn xrpn;
-
 	// So, how many tracks are we reading in a row?...
 	const unsigned short iSeqTracks = (iSeqs > 1 ? m_iTracks : 1);
 
-	// Go fetch them...
+	// Read in the whole file, or just the one track chunk
+	// (eg. clip import, one track per clip)...
+	if (iSeqTracks > 1) {
+		if (!loadData(0, m_iFileSize))
+			return false;
+	}
+	else
+	if (!loadTrack(m_iFormat == 1 ? iTrackChannel : 0))
+		return false;
+
+	// Tempo/time-signature map items, per track...
+	QList<TempoItem> *pItems = new QList<TempoItem> [iSeqTracks];
+
+	bool bResult = true;
+
+	// Whether each track goes into its own sequence (SMF format 1),
+	// so they can be read in parallel...
+	int iThreads = 0;
+	if (iSeqTracks > 1 && m_iFormat == 1 && m_iFileSize > c_iParallelSize) {
+		iThreads = QThread::idealThreadCount() - 1;
+		if (iThreads > iSeqTracks - 1)
+			iThreads = iSeqTracks - 1;
+	}
+
+	if (iThreads > 0) {
+		qtractorMidiFileTrackThread::Job job;
+		job.file   = this;
+		job.seqs   = ppSeqs;
+		job.nseqs  = iSeqs;
+		job.tracks = iSeqTracks;
+		job.items  = pItems;
+		ATOMIC_SET(&job.next, 0);
+		ATOMIC_SET(&job.errors, 0);
+		QList<qtractorMidiFileTrackThread *> threads;
+		for (int i = 0; i < iThreads; ++i) {
+			qtractorMidiFileTrackThread *pThread
+				= new qtractorMidiFileTrackThread(&job);
+			pThread->start();
+			threads.append(pThread);
+		}
+		// Do our share, then wait for the others...
+		qtractorMidiFileTrackThread::process(&job);
+		qDeleteAll(threads);
+		bResult = (ATOMIC_GET(&job.errors) == 0);
+	} else {
+		// Go fetch them, one at a time...
+		for (unsigned short iSeqTrack = 0; iSeqTrack < iSeqTracks; ++iSeqTrack) {
+			// If under a format 0 file, we'll filter for one single channel.
+			if (iSeqTracks > 1)
+				iTrackChannel = iSeqTrack;
+			if (!readTrackEvents(iSeqTrack, ppSeqs, iSeqs,
+					iTrackChannel, pItems[iSeqTrack])) {
+				bResult = false;
+				break;
+			}
+		}
+	}
+
+	// Commit the tempo/time-signature map, in track order...
 	for (unsigned short iSeqTrack = 0; iSeqTrack < iSeqTracks; ++iSeqTrack) {
+		for (const TempoItem& item : pItems[iSeqTrack]) {
+			switch (item.meta) {
+			case qtractorMidiEvent::TEMPO:
+				m_pTempoMap->addNodeTempo(item.time,
+					qtractorTimeScale::uroundf(60000000.0f / float(item.val1)));
+				break;
+			case qtractorMidiEvent::TIMESIG:
+				m_pTempoMap->addNodeTime(item.time,
+					(unsigned short) item.val1,
+					(unsigned short) item.val2);
+				break;
+			case qtractorMidiEvent::KEYSIG:
+				m_pTempoMap->addMarker(item.time, QString(),
+					item.val1, bool(item.val2));
+				break;
+			case qtractorMidiEvent::MARKER:
+				m_pTempoMap->addMarker(item.time, item.text);
+				break;
+			default:
+				break;
+			}
+		}
+	}
 
-		// If under a format 0 file, we'll filter for one single channel.
-		if (iSeqTracks > 1)
-			iTrackChannel = iSeqTrack;
+	delete [] pItems;
 
-		const unsigned short iTrack = (m_iFormat == 1 ? iTrackChannel : 0);
-		if (iTrack >= m_iTracks)
-			return false;
+	// No need for the file contents anymore...
+	m_data.clear();
+	m_iDataOffset = 0;
 
-		const unsigned short iChannelFilter
-			= (m_iFormat == 1 || iSeqs > 1 ? 0xf0 : iTrackChannel);
+	if (!bResult)
+		return false;
 
-		// Locate the desired track stuff...
-		const unsigned long iTrackStart = m_pTrackInfo[iTrack].offset;
-		if (iTrackStart != m_iOffset) {
-			if (::fseek(m_pFile, iTrackStart, SEEK_SET))
-				return false;
-			m_iOffset = iTrackStart;
+	// FIXME: Commit the sequence(s) length...
+	for (unsigned short iSeq = 0; iSeq < iSeqs; ++iSeq)
+		ppSeqs[iSeq]->close();
+
+#ifdef CONFIG_DEBUG_0
+	for (unsigned short iSeq = 0; iSeq < iSeqs; ++iSeq) {
+		qtractorMidiSequence *pSeq = ppSeqs[iSeq];
+		qDebug("qtractorMidiFile::readTrack([%u]%p,%u,%u)"
+			" name=\"%s\" events=%d duration=%lu",
+			iSeq, pSeq, iSeqs, iTrackChannel,
+			pSeq->name().toUtf8().constData(),
+			pSeq->events().count(), pSeq->duration());
+	}
+#endif
+
+	return true;
+}
+
+
+// Single track events reader (thread-safe,
+// as long as each track has its own sequence).
+bool qtractorMidiFile::readTrackEvents ( unsigned short iSeqTrack,
+	qtractorMidiSequence **ppSeqs, unsigned short iSeqs,
+	unsigned short iTrackChannel, QList<TempoItem>& items ) const
+{
+	const unsigned short iTrack = (m_iFormat == 1 ? iTrackChannel : 0);
+	if (iTrack >= m_iTracks)
+		return false;
+
+	const unsigned short iChannelFilter
+		= (m_iFormat == 1 || iSeqs > 1 ? 0xf0 : iTrackChannel);
+
+	// Expedite RPN/NRPN controllers processor...
+	qtractorMidiFileRpn xrpn;
+
+	// Locate the desired track stuff...
+	unsigned long iOffset = m_pTrackInfo[iTrack].offset;
+
+	// Now we're going into business...
+	const unsigned long iTrackEnd
+		= iOffset + m_pTrackInfo[iTrack].length;
+
+	unsigned long iTrackTime  = 0;
+	unsigned int  iLastStatus = 0;
+	unsigned long iTimeout    = 0;
+
+	qtractorMidiSequence *pSeq = nullptr;
+
+	// While this track lasts...
+	while (iOffset < iTrackEnd) {
+
+		// Read delta timestamp...
+		iTrackTime += readInt(iOffset);
+
+		// Read probable status byte...
+		unsigned int iStatus = readInt(iOffset, 1);
+		// Maybe a running status byte?
+		if ((iStatus & 0x80) == 0) {
+			// Go back one byte...
+			--iOffset;
+			iStatus = iLastStatus;
+		} else {
+			iLastStatus = iStatus;
 		}
 
-		// Now we're going into business...
-		const unsigned long iTrackEnd
-			= m_iOffset + m_pTrackInfo[iTrack].length;
+		const unsigned short iChannel = (iStatus & 0x0f);
 
-		unsigned long iTrackTime  = 0;
-		unsigned int  iLastStatus = 0;
-		unsigned long iTimeout    = 0;
+		qtractorMidiEvent *pEvent;
+		qtractorMidiEvent::EventType type
+			= qtractorMidiEvent::EventType(iStatus & 0xf0);
+		if (iStatus == qtractorMidiEvent::META)
+			type = qtractorMidiEvent::META;
 
-		// While this track lasts...
-		while (m_iOffset < iTrackEnd) {
+		// Make proper sequence reference...
+		unsigned short iSeq = 0;
+		if (iSeqs > 1)
+			iSeq = (m_iFormat == 0 ? iChannel : iTrack);
+		pSeq = ppSeqs[iSeq];
 
-			// Read delta timestamp...
-			iTrackTime += readInt();
+		// Event time converted to sequence resolution...
+		const unsigned long iTime
+			= pSeq->timeq(iTrackTime, m_iTicksPerBeat);
 
-			// Read probable status byte...
-			unsigned int iStatus = readInt(1);
-			// Maybe a running status byte?
-			if ((iStatus & 0x80) == 0) {
-				// Go back one byte...
-				::ungetc(iStatus, m_pFile);
-				--m_iOffset;
-				iStatus = iLastStatus;
-			} else {
-				iLastStatus = iStatus;
-			}
+		// Check for sequence time length, if any...
+		if (pSeq->timeLength() > 0
+			&& iTime >= pSeq->timeOffset() + pSeq->timeLength())
+			break;
 
-			const unsigned short iChannel = (iStatus & 0x0f);
+		// Flush/timeout RPN/NRPN stuff...
+		if (iTimeout < iTime || type != qtractorMidiEvent::CONTROLLER) {
+			iTimeout = iTime + (pSeq->ticksPerBeat() >> 2);
+			xrpn.flush();
+		}
 
-			qtractorMidiEvent *pEvent;
-			qtractorMidiEvent::EventType type
-				= qtractorMidiEvent::EventType(iStatus & 0xf0);
-			if (iStatus == qtractorMidiEvent::META)
-				type = qtractorMidiEvent::META;
-
-			// Make proper sequence reference...
-			unsigned short iSeq = 0;
-			if (iSeqs > 1)
-				iSeq = (m_iFormat == 0 ? iChannel : iTrack);
-			qtractorMidiSequence *pSeq = ppSeqs[iSeq];
-
-			// Event time converted to sequence resolution...
-			const unsigned long iTime
-				= pSeq->timeq(iTrackTime, m_iTicksPerBeat);
-
-			// Check for sequence time length, if any...
-			if (pSeq->timeLength() > 0
-				&& iTime >= pSeq->timeOffset() + pSeq->timeLength()) {
-				xrpn.flush();
-				xrpn.dequeue(pSeq);
-				break;
-			}
+		// Check whether it won't be channel filtered...
+		const bool bChannelEvent = (iTime >= pSeq->timeOffset()
+			&& ((iChannelFilter & 0xf0) || (iChannelFilter == iChannel)));
 
-			// Flush/timeout RPN/NRPN stuff...
-			if (iTimeout < iTime || type != qtractorMidiEvent::CONTROLLER) {
-				iTimeout = iTime + (pSeq->ticksPerBeat() >> 2);
-				xrpn.flush();
-			}
+		unsigned char *data, data1, data2;
+		unsigned int len, meta, bank;
 
-			// Check whether it won't be channel filtered...
-			const bool bChannelEvent = (iTime >= pSeq->timeOffset()
-				&& ((iChannelFilter & 0xf0) || (iChannelFilter == iChannel)));
-
-			unsigned char *data, data1, data2;
-			unsigned int len, meta, bank;
-
-			switch (type) {
-			case qtractorMidiEvent::NOTEOFF:
-			case qtractorMidiEvent::NOTEON:
-				data1 = readInt(1);
-				data2 = readInt(1);
-				// Check if its channel filtered...
-				if (bChannelEvent) {
-					if (data2 == 0 && type == qtractorMidiEvent::NOTEON)
-						type = qtractorMidiEvent::NOTEOFF;
-					pEvent = new qtractorMidiEvent(iTime, type, data1, data2);
+		switch (type) {
+		case qtractorMidiEvent::NOTEOFF:
+		case qtractorMidiEvent::NOTEON:
+			data1 = readInt(iOffset, 1);
+			data2 = readInt(iOffset, 1);
+			// Check if its channel filtered...
+			if (bChannelEvent) {
+				if (data2 == 0 && type == qtractorMidiEvent::NOTEON)
+					type = qtractorMidiEvent::NOTEOFF;
+				// Note-offs are just folded into their note-on
+				// durations, so they don't need any event storage...
+				if (type == qtractorMidiEvent::NOTEOFF) {
+					pSeq->addNoteOff(iTime, data1);
+				} else {
+					pEvent = new (pSeq->arena())
+						qtractorMidiEvent(iTime, type, data1, data2);
 					pSeq->addEvent(pEvent);
-					pSeq->setChannel(iChannel);
 				}
-				break;
-			case qtractorMidiEvent::KEYPRESS:
-				data1 = readInt(1);
-				data2 = readInt(1);
-				// Check if its channel filtered...
-				if (bChannelEvent) {
-					// Create the new event...
-					pEvent = new qtractorMidiEvent(iTime, type, data1, data2);
-					pSeq->addEvent(pEvent);
-					pSeq->setChannel(iChannel);
+				pSeq->setChannel(iChannel);
+			}
+			break;
+		case qtractorMidiEvent::KEYPRESS:
+			data1 = readInt(iOffset, 1);
+			data2 = readInt(iOffset, 1);
+			// Check if its channel filtered...
+			if (bChannelEvent) {
+				// Create the new event...
+				pEvent = new (pSeq->arena()) qtractorMidiEvent(iTime, type, data1, data2);
+				pSeq->addEvent(pEvent);
+				pSeq->setChannel(iChannel);
+			}
+			break;
+		case qtractorMidiEvent::CONTROLLER:
+			data1 = readInt(iOffset, 1);
+			data2 = readInt(iOffset, 1);
+			// Check if its channel filtered...
+			if (bChannelEvent) {
+				// Check for RPN/NRPN stuff...
+				if (xrpn.process(iTime, iSeqTrack,
+					(qtractorMidiRpn::CC | iChannel), data1, data2)) {
+					iTimeout = iTime + (pSeq->ticksPerBeat() >> 2);
+					break;
 				}
-				break;
-			case qtractorMidiEvent::CONTROLLER:
-				data1 = readInt(1);
-				data2 = readInt(1);
-				// Check if its channel filtered...
-				if (bChannelEvent) {
-					// Check for RPN/NRPN stuff...
-					if (xrpn.process(iTime, iSeqTrack,
-						(qtractorMidiRpn::CC | iChannel), data1, data2)) {
-						iTimeout = iTime + (pSeq->ticksPerBeat() >> 2);
+				// Create the new event...
+				pEvent = new (pSeq->arena()) qtractorMidiEvent(iTime, type, data1, data2);
+				pSeq->addEvent(pEvent);
+				pSeq->setChannel(iChannel);
+				// Set the primordial bank patch...
+				switch (data1) {
+				case BANK_MSB:
+					// Bank MSB
+					if (pSeq->bankSelMethod() < 0)
+						pSeq->setBankSelMethod(1);
+					// Bank-select method (MSB)...
+					switch (pSeq->bankSelMethod()) {
+					case 1: // Bank MSB (current)
+						pSeq->setBank(data2);
+						break;
+					case 2: // Bank LSB (previous)
+						pSeq->setBankSelMethod(0);
+						// Fall thru...
+					case 0:
+					default:
+						bank = (pSeq->bank() < 0 ? 0 : (pSeq->bank() & 0x007f));
+						pSeq->setBank(bank | (data2 << 7));
 						break;
 					}
-					// Create the new event...
-					pEvent = new qtractorMidiEvent(iTime, type, data1, data2);
-					pSeq->addEvent(pEvent);
-					pSeq->setChannel(iChannel);
-					// Set the primordial bank patch...
-					switch (data1) {
-					case BANK_MSB:
-						// Bank MSB
-						if (pSeq->bankSelMethod() < 0)
-							pSeq->setBankSelMethod(1);
-						// Bank-select method (MSB)...
-						switch (pSeq->bankSelMethod()) {
-						case 1: // Bank MSB (current)
-							pSeq->setBank(data2);
-							break;
-						case 2: // Bank LSB (previous)
-							pSeq->setBankSelMethod(0);
-							// Fall thru...
-						case 0:
-						default:
-							bank = (pSeq->bank() < 0 ? 0 : (pSeq->bank() & 0x007f));
-							pSeq->setBank(bank | (data2 << 7));
-							break;
-						}
+					break;
+				case BANK_LSB:
+					// Bank LSB
+					if (pSeq->bankSelMethod() < 0)
+						pSeq->setBankSelMethod(2);
+					// Bank-select method (LSB)...
+					switch (pSeq->bankSelMethod()) {
+					case 1: // Bank MSB (previous)
+						bank = (pSeq->bank() < 0 ? 0 : (pSeq->bank() & 0x007f));
+						pSeq->setBank((bank << 7) | data2);
+						pSeq->setBankSelMethod(0);
 						break;
-					case BANK_LSB:
-						// Bank LSB
-						if (pSeq->bankSelMethod() < 0)
-							pSeq->setBankSelMethod(2);
-						// Bank-select method (LSB)...
-						switch (pSeq->bankSelMethod()) {
-						case 1: // Bank MSB (previous)
-							bank = (pSeq->bank() < 0 ? 0 : (pSeq->bank() & 0x007f));
-							pSeq->setBank((bank << 7) | data2);
-							pSeq->setBankSelMethod(0);
-							break;
-						case 2: // Bank LSB (current)
-							pSeq->setBank(data2);
-							break;
-						case 0: // Normal
-						default:
-							bank = (pSeq->bank() < 0 ? 0 : (pSeq->bank() & 0x3f80));
-							pSeq->setBank(bank | data2);
-							break;
-						}
+					case 2: // Bank LSB (current)
+						pSeq->setBank(data2);
 						break;
+					case 0: // Normal
 					default:
+						bank = (pSeq->bank() < 0 ? 0 : (pSeq->bank() & 0x3f80));
+						pSeq->setBank(bank | data2);
 						break;
 					}
+					break;
+				default:
+					break;
 				}
+			}
+			break;
+		case qtractorMidiEvent::PGMCHANGE:
+			data1 = readInt(iOffset, 1);
+			data2 = 0x7f;
+			// Check if its channel filtered...
+			if (bChannelEvent) {
+				// Create the new event...
+				pEvent = new (pSeq->arena()) qtractorMidiEvent(iTime, type, data1, data2);
+				pSeq->addEvent(pEvent);
+				pSeq->setChannel(iChannel);
+				// Set the primordial program patch...
+				if (pSeq->prog() < 0)
+					pSeq->setProg(data1);
+			}
+			break;
+		case qtractorMidiEvent::CHANPRESS:
+			data1 = 0;
+			data2 = readInt(iOffset, 1);
+			// Check if its channel filtered...
+			if (bChannelEvent) {
+				// Create the new event...
+				pEvent = new (pSeq->arena()) qtractorMidiEvent(iTime, type, data1, data2);
+				pSeq->addEvent(pEvent);
+				pSeq->setChannel(iChannel);
+			}
+			break;
+		case qtractorMidiEvent::PITCHBEND:
+			data1 = readInt(iOffset, 1);
+			data2 = readInt(iOffset, 1);
+			// Check if its channel filtered...
+			if (bChannelEvent) {
+				const unsigned short value = (data2 << 7) | data1;
+				// Create the new event...
+				pEvent = new (pSeq->arena()) qtractorMidiEvent(iTime, type, 0, value);
+				pSeq->addEvent(pEvent);
+				pSeq->setChannel(iChannel);
+			}
+			break;
+		case qtractorMidiEvent::SYSEX:
+			len = readInt(iOffset);
+			if ((int) len < 1) {
+				iOffset = iTrackEnd; // Force EoT!
 				break;
-			case qtractorMidiEvent::PGMCHANGE:
-				data1 = readInt(1);
-				data2 = 0x7f;
-				// Check if its channel filtered...
-				if (bChannelEvent) {
-					// Create the new event...
-					pEvent = new qtractorMidiEvent(iTime, type, data1, data2);
-					pSeq->addEvent(pEvent);
-					pSeq->setChannel(iChannel);
-					// Set the primordial program patch...
-					if (pSeq->prog() < 0)
-						pSeq->setProg(data1);
-				}
-				break;
-			case qtractorMidiEvent::CHANPRESS:
-				data1 = 0;
-				data2 = readInt(1);
-				// Check if its channel filtered...
-				if (bChannelEvent) {
-					// Create the new event...
-					pEvent = new qtractorMidiEvent(iTime, type, data1, data2);
-					pSeq->addEvent(pEvent);
-					pSeq->setChannel(iChannel);
-				}
-				break;
-			case qtractorMidiEvent::PITCHBEND:
-				data1 = readInt(1);
-				data2 = readInt(1);
-				// Check if its channel filtered...
-				if (bChannelEvent) {
-					const unsigned short value = (data2 << 7) | data1;
-					// Create the new event...
-					pEvent = new qtractorMidiEvent(iTime, type, 0, value);
-					pSeq->addEvent(pEvent);
-					pSeq->setChannel(iChannel);
-				}
+			}
+			data = new unsigned char [1 + len];
+			data[0] = (unsigned char) type;	// Skip 0xf0 head.
+			if (readData(iOffset, &data[1], len) < (int) len) {
+				delete [] data;
+				return false;
+			}
+			// Check if its channel filtered...
+			if (bChannelEvent) {
+				pEvent = new (pSeq->arena()) qtractorMidiEvent(iTime, type);
+				pEvent->setSysex(data, 1 + len, pSeq->arena());
+				pSeq->addEvent(pEvent);
+				pSeq->setChannel(iChannel);
+			}
+			delete [] data;
+			break;
+		case qtractorMidiEvent::META:
+			meta = qtractorMidiEvent::MetaType(readInt(iOffset, 1));
+			// Get the meta data...
+			len = readInt(iOffset);
+			if ((int) len < 1) {
+			//	iOffset = iTrackEnd; // Force EoT!
 				break;
-			case qtractorMidiEvent::SYSEX:
-				len = readInt();
-				if ((int) len < 1) {
-					m_iOffset = iTrackEnd; // Force EoT!
-					break;
-				}
-				data = new unsigned char [1 + len];
-				data[0] = (unsigned char) type;	// Skip 0xf0 head.
-				if (readData(&data[1], len) < (int) len) {
+			}
+			if (meta == qtractorMidiEvent::TEMPO) {
+				items.append(TempoItem(meta, iTrackTime, readInt(iOffset, len)));
+			} else {
+				data = new unsigned char [len + 1];
+				if (readData(iOffset, data, len) < (int) len) {
 					delete [] data;
 					return false;
 				}
-				// Check if its channel filtered...
-				if (bChannelEvent) {
-					pEvent = new qtractorMidiEvent(iTime, type);
-					pEvent->setSysex(data, 1 + len);
-					pSeq->addEvent(pEvent);
-					pSeq->setChannel(iChannel);
-				}
-				delete [] data;
-				break;
-			case qtractorMidiEvent::META:
-				meta = qtractorMidiEvent::MetaType(readInt(1));
-				// Get the meta data...
-				len = readInt();
-				if ((int) len < 1) {
-				//	m_iOffset = iTrackEnd; // Force EoT!
+				data[len] = (unsigned char) 0;
+				// Now, we'll deal only with some...
+				switch (meta) {
+				case qtractorMidiEvent::TRACKNAME:
+					pSeq->setName(
+						QString::fromLatin1((const char *) data).simplified());
 					break;
-				}
-				if (meta == qtractorMidiEvent::TEMPO) {
-					m_pTempoMap->addNodeTempo(iTrackTime,
-						qtractorTimeScale::uroundf(
-							60000000.0f / float(readInt(len))));
-				} else {
-					data = new unsigned char [len + 1];
-					if (readData(data, len) < (int) len) {
-						delete [] data;
-						return false;
-					}
-					data[len] = (unsigned char) 0;
-					// Now, we'll deal only with some...
-					switch (meta) {
-					case qtractorMidiEvent::TRACKNAME:
-						pSeq->setName(
-							QString::fromLatin1((const char *) data).simplified());
-						break;
-					case qtractorMidiEvent::TIMESIG:
-						// Beats per bar is the numerator of time signature...
-						if ((unsigned short) data[0] > 0) {
-							m_pTempoMap->addNodeTime(iTrackTime,
-								(unsigned short) data[0],
-								(unsigned short) data[1]);
-						}
-						break;
-					case qtractorMidiEvent::KEYSIG:
-						m_pTempoMap->addMarker(iTrackTime, QString(),
-							int(char(data[0])), bool(data[1]));
-						break;
-					case qtractorMidiEvent::MARKER:
-						m_pTempoMap->addMarker(iTrackTime,
-							QString::fromLatin1((const char *) data).simplified());
-						break;
-					default:
-						// Ignore all others...
-						break;
+				case qtractorMidiEvent::TIMESIG:
+					// Beats per bar is the numerator of time signature...
+					if ((unsigned short) data[0] > 0) {
+						items.append(TempoItem(meta, iTrackTime, data[0], data[1]));
 					}
-					delete [] data;
+					break;
+				case qtractorMidiEvent::KEYSIG:
+					items.append(TempoItem(meta, iTrackTime,
+						int(char(data[0])), int(bool(data[1]))));
+					break;
+				case qtractorMidiEvent::MARKER:
+					items.append(TempoItem(meta, iTrackTime, 0, 0,
+						QString::fromLatin1((const char *) data).simplified()));
+					break;
+				default:
+					// Ignore all others...
+					break;
 				}
-				// Fall thru...
-			default:
-				break;
+				delete [] data;
 			}
-
-			// Flush/pending RPN/NRPN stuff...
-			xrpn.dequeue(pSeq);
+			// Fall thru...
+		default:
+			break;
 		}
-	}
 
-	// FIXME: Commit the sequence(s) length...
-	for (unsigned short iSeq = 0; iSeq < iSeqs; ++iSeq)
-		ppSeqs[iSeq]->close();
+		// Flush/pending RPN/NRPN stuff...
+		xrpn.dequeue(pSeq);
+	}
 
-#ifdef CONFIG_DEBUG_0
-	for (unsigned short iSeq = 0; iSeq < iSeqs; ++iSeq) {
-		qtractorMidiSequence *pSeq = ppSeqs[iSeq];
-		qDebug("qtractorMidiFile::readTrack([%u]%p,%u,%u)"
-			" name=\"%s\" events=%d duration=%lu",
-			iSeq, pSeq, iSeqs, iTrackChannel,
-			pSeq->name().toUtf8().constData(),
-			pSeq->events().count(), pSeq->duration());
+	// Flush/pending RPN/NRPN leftovers...
+	if (pSeq) {
+		xrpn.flush();
+		xrpn.dequeue(pSeq);
 	}
-#endif
 
 	return true;
 }
 
 
-
 bool qtractorMidiFile::readTrack ( qtractorMidiSequence *pSeq,
 	unsigned short iTrackChannel )
 {
@@ -581,7 +767,7 @@ bool qtractorMidiFile::readTrack ( qtractorMidiSequence *pSeq,
 // Sequence/track/channel duration reader helper.
 unsigned long qtractorMidiFile::readTrackDuration ( unsigned short iTrackChannel )
 {
-	if (m_pFile == nullptr)
+	if (m_pTrackInfo == nullptr)
 		return 0;
 	if (m_iMode != Read)
 		return 0;
@@ -593,45 +779,58 @@ unsigned long qtractorMidiFile::readTrackDuration ( unsigned short iTrackChannel
 	const unsigned short iChannelFilter
 		= (m_iFormat == 1 ? 0xf0 : iTrackChannel);
 
-	// Locate the desired track stuff...
-	const unsigned long iTrackStart = m_pTrackInfo[iTrack].offset;
-	if (iTrackStart != m_iOffset) {
-		if (::fseek(m_pFile, iTrackStart, SEEK_SET))
+	// Pre-scan the whole track, once...
+	TrackInfo& info = m_pTrackInfo[iTrack];
+	if (!info.scanned) {
+		if (!loadTrack(iTrack))
 			return 0;
-		m_iOffset = iTrackStart;
+		scanTrack(iTrack);
 	}
 
-	// Now we're going into business...
-	const unsigned long iTrackEnd
-		= m_iOffset + m_pTrackInfo[iTrack].length;
+	if (iChannelFilter & 0xf0)
+		return info.duration[16];
+	else
+	if (iChannelFilter < 16)
+		return info.duration[iChannelFilter];
+	else
+		return 0;
+}
+
+
+// Track pre-scan, for duration look-ups:
+// last event time, per channel and overall.
+void qtractorMidiFile::scanTrack ( unsigned short iTrack )
+{
+	TrackInfo& info = m_pTrackInfo[iTrack];
 
-	unsigned long iTrackDuration = 0;
+	for (int i = 0; i < 17; ++i)
+		info.duration[i] = 0;
+
+	unsigned long iOffset = info.offset;
+	const unsigned long iTrackEnd = iOffset + info.length;
 
 	unsigned long iTrackTime  = 0;
 	unsigned int  iLastStatus = 0;
 
 	// While this track lasts...
-	while (m_iOffset < iTrackEnd) {
+	while (iOffset < iTrackEnd) {
 
 		// Read delta timestamp...
-		iTrackTime += readInt();
+		iTrackTime += readInt(iOffset);
 
 		// Read probable status byte...
-		unsigned int iStatus = readInt(1);
+		unsigned int iStatus = readInt(iOffset, 1);
 		// Maybe a running status byte?
 		if ((iStatus & 0x80) == 0) {
 			// Go back one byte...
-			::ungetc(iStatus, m_pFile);
-			--m_iOffset;
+			--iOffset;
 			iStatus = iLastStatus;
 		} else {
 			iLastStatus = iStatus;
 		}
 
-		// Check whether it won't be channel filtered...
-		const unsigned short iChannel = (iStatus & 0x0f);
-		if ((iChannelFilter & 0xf0) || (iChannelFilter == iChannel))
-			iTrackDuration = iTrackTime;
+		info.duration[iStatus & 0x0f] = iTrackTime;
+		info.duration[16] = iTrackTime;
 
 		qtractorMidiEvent::EventType type
 			= qtractorMidiEvent::EventType(iStatus & 0xf0);
@@ -644,29 +843,29 @@ unsigned long qtractorMidiFile::readTrackDuration ( unsigned short iTrackChannel
 		case qtractorMidiEvent::KEYPRESS:
 		case qtractorMidiEvent::CONTROLLER:
 		case qtractorMidiEvent::PITCHBEND:
-			readInt(2);
+			iOffset += 2;
 			break;
 		case qtractorMidiEvent::PGMCHANGE:
 		case qtractorMidiEvent::CHANPRESS:
-			readInt(1);
+			iOffset += 1;
 			break;
 		case qtractorMidiEvent::META:
-			readInt(1);
+			iOffset += 1;
 			// Fall thru...
 		case qtractorMidiEvent::SYSEX:
 		{
-			int n = readInt();
-			if (n < 1 || ::fseek(m_pFile, m_iOffset + n, SEEK_SET))
-				m_iOffset = iTrackEnd; // Force EoT!
+			const int n = readInt(iOffset);
+			if (n < 1)
+				iOffset = iTrackEnd; // Force EoT!
 			else
-				m_iOffset += n;
+				iOffset += n;
 		}	// Fall thru...
 		default:
 			break;
 		}
 	}
 
-	return iTrackDuration;
+	info.scanned = true;
 }
 
 
@@ -1184,27 +1383,45 @@ bool qtractorMidiFile::writeTrack ( qtractorMidiSequence *pSeq )
 // Integer read method.
 int qtractorMidiFile::readInt ( unsigned short n )
 {
+	return readInt(m_iOffset, n);
+}
+
+
+// Raw data read method.
+int qtractorMidiFile::readData ( unsigned char *pData, unsigned short n )
+{
+	return readData(m_iOffset, pData, n);
+}
+
+
+// Integer read method (in-memory, from given offset).
+int qtractorMidiFile::readInt ( unsigned long& iOffset, unsigned short n ) const
+{
+	const unsigned char *pData = (const unsigned char *) m_data.constData();
+	const unsigned long iSize = m_iDataOffset + m_data.size();
+
+	if (iOffset < m_iDataOffset)
+		return -1;
+
 	int c, val = 0;
-	
+
 	if (n > 0) {
 		// Fixed length (n bytes) integer read.
 		for (int i = 0; i < n; ++i) {
 			val <<= 8;
-			c = ::fgetc(m_pFile);
-			if (c < 0)
+			if (iOffset >= iSize)
 				return -1;
+			c = pData[iOffset++ - m_iDataOffset];
 			val |= c;
-			++m_iOffset;
 		}
 	} else {
 		// Variable length integer read.
 		do {
-			c = ::fgetc(m_pFile);
-			if (c < 0)
+			if (iOffset >= iSize)
 				return -1;
+			c = pData[iOffset++ - m_iDataOffset];
 			val <<= 7;
 			val |= (c & 0x7f);
-			++m_iOffset;
 		}
 		while ((c & 0x80) == 0x80);
 	}
@@ -1213,16 +1430,78 @@ int qtractorMidiFile::readInt ( unsigned short n )
 }
 
 
-// Raw data read method.
-int qtractorMidiFile::readData ( unsigned char *pData, unsigned short n )
+// Raw data read method (in-memory, from given offset).
+int qtractorMidiFile::readData ( unsigned long& iOffset,
+	unsigned char *pData, unsigned short n ) const
 {
-	const int nread = ::fread(pData, sizeof(unsigned char), n, m_pFile);
-	if (nread > 0)
-		m_iOffset += nread;
+	const unsigned long iSize = m_iDataOffset + m_data.size();
+	if (iOffset < m_iDataOffset || iOffset >= iSize)
+		return 0;
+
+	int nread = n;
+	if (iOffset + nread > iSize)
+		nread = iSize - iOffset;
+
+	::memcpy(pData, m_data.constData() + (iOffset - m_iDataOffset), nread);
+	iOffset += nread;
+
 	return nread;
 }
 
 
+// File contents read-in, from given offset (read mode);
+// the file gets (re)opened on demand, if not already.
+bool qtractorMidiFile::loadData ( unsigned long iOffset, unsigned long iLength )
+{
+	// Already in?
+	if (iOffset >= m_iDataOffset
+		&& iOffset + iLength <= m_iDataOffset + m_data.size())
+		return true;
+
+	// Truncated file?
+	if (iOffset >= m_iFileSize)
+		iLength = 0;
+	else
+	if (iOffset + iLength > m_iFileSize)
+		iLength = m_iFileSize - iOffset;
+
+	FILE *pFile = m_pFile;
+	if (pFile == nullptr) {
+		const QByteArray aFilename = m_sFilename.toUtf8();
+		pFile = ::fopen(aFilename.constData(), "rb");
+		if (pFile == nullptr)
+			return false;
+	}
+
+	m_data.resize(iLength);
+	m_iDataOffset = iOffset;
+
+	const bool bResult = (::fseek(pFile, iOffset, SEEK_SET) == 0
+		&& ::fread(m_data.data(), 1, iLength, pFile) == size_t(iLength));
+
+	if (pFile != m_pFile)
+		::fclose(pFile);
+
+	if (!bResult) {
+		m_data.clear();
+		m_iDataOffset = 0;
+	}
+
+	return bResult;
+}
+
+
+// Track chunk contents read-in (read mode).
+bool qtractorMidiFile::loadTrack ( unsigned short iTrack )
+{
+	if (iTrack >= m_iTracks)
+		return false;
+
+	const TrackInfo& info = m_pTrackInfo[iTrack];
+	return loadData(info.offset, info.length);
+}
+
+
 // Integer write method.
 int qtractorMidiFile::writeInt ( int val, unsigned short n )
 {
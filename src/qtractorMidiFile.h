@@ -26,6 +26,8 @@
 
 #include "qtractorMidiFileTempo.h"
 
+#include <QByteArray>
+
 class qtractorTimeScale;
 
 
@@ -88,12 +90,43 @@ public:
 	static QString createFilePathRevision(
 		const QString& sFilename, int iRevision = 0);
 
+	// Tempo/time-signature map item, as read from a track.
+	struct TempoItem
+	{
+		TempoItem(int m, unsigned long t,
+			int v1 = 0, int v2 = 0, const QString& s = QString())
+			: meta(m), time(t), val1(v1), val2(v2), text(s) {}
+
+		int           meta;
+		unsigned long time;
+		int           val1;
+		int           val2;
+		QString       text;
+	};
+
+	// Single track events reader (thread-safe).
+	bool readTrackEvents(unsigned short iSeqTrack,
+		qtractorMidiSequence **ppSeqs, unsigned short iSeqs,
+		unsigned short iTrackChannel, QList<TempoItem>& items) const;
+
 protected:
 
 	// Read methods.
 	int readInt   (unsigned short n = 0);
 	int readData  (unsigned char *pData, unsigned short n);
 
+	// Read methods (in-memory, from given offset).
+	int readInt   (unsigned long& iOffset, unsigned short n = 0) const;
+	int readData  (unsigned long& iOffset,
+		unsigned char *pData, unsigned short n) const;
+
+	// Track pre-scan, for duration look-ups.
+	void scanTrack(unsigned short iTrack);
+
+	// File contents read-in (read mode).
+	bool loadData(unsigned long iOffset, unsigned long iLength);
+	bool loadTrack(unsigned short iTrack);
+
 	// Write methods.
 	int writeInt  (int val, unsigned short n = 0);
 	int writeData (unsigned char *pData, unsigned short n);
@@ -114,6 +147,12 @@ private:
 	FILE          *m_pFile;
 	unsigned long  m_iOffset;
 
+	// File contents (read mode): either the whole
+	// file or just the one track chunk being read.
+	QByteArray     m_data;
+	unsigned long  m_iDataOffset;
+	unsigned long  m_iFileSize;
+
 	// Header informational data.
 	unsigned short m_iFormat;
 	unsigned short m_iTracks;
@@ -123,6 +162,9 @@ private:
 	struct TrackInfo {
 		unsigned int  length;
 		unsigned long offset;
+		// Pre-scanned durations, per channel (and any).
+		bool          scanned;
+		unsigned long duration[17];
 	} *m_pTrackInfo;
 
 	// Special tempo/time-signature map.
@@ -651,6 +651,7 @@ void qtractorMidiManager::process (
 
 	// Now's time to process the plugins as usual...
 	if (m_pAudioOutputBus) {
+		qtractorDspLoad::Scope timing(&m_dspLoad);
 		const unsigned int nframes = iTimeEnd - iTimeStart;
 		if (m_bAudioOutputBus) {
 			m_pAudioOutputBus->process_prepare(nframes);
@@ -56,6 +56,7 @@
 #endif
 
 #include "qtractorInstrument.h"
+#include "qtractorDspLoad.h"
 
 
 // Forward declarations.
@@ -320,6 +321,10 @@ public:
 	qtractorAudioOutputMonitor *audioOutputMonitor() const
 		{ return m_pAudioOutputMonitor; }
 
+	// Plugin chain process call timing statistics.
+	qtractorDspLoad *dspLoad()
+		{ return &m_dspLoad; }
+
 	// Current bank selection accessors.
 	void setCurrentBank(int iBank)
 		{ m_iCurrentBank = iBank; }
@@ -430,6 +435,8 @@ private:
 
 	qtractorAudioOutputMonitor *m_pAudioOutputMonitor;
 
+	qtractorDspLoad m_dspLoad;
+
 	int m_iCurrentBank;
 	int m_iCurrentProg;
 
@@ -1,7 +1,7 @@
 // qtractorMidiSequence.cpp
 //
 /****************************************************************************
-   Copyright (C) 2005-2024, rncbc aka Rui Nuno Capela. All rights reserved.
+   Copyright (C) 2005-2025, rncbc aka Rui Nuno Capela. All rights reserved.
 
    This program is free software; you can redistribute it and/or
    modify it under the terms of the GNU General Public License
@@ -22,6 +22,10 @@
 #include "qtractorMidiSequence.h"
 
 
+// Sparse time index granularity (events per checkpoint).
+static const unsigned int c_iIndexStep = 32;
+
+
 //----------------------------------------------------------------------
 // class qtractorMidiSequence -- The generic MIDI event sequence buffer.
 //
@@ -42,6 +46,11 @@ qtractorMidiSequence::qtractorMidiSequence ( const QString& sName,
 	m_noteMax = 0;
 	m_noteMin = 0;
 
+	m_pIndex = nullptr;
+	m_iIndexReaders = 0;
+	m_bIndexDirty = true;
+	m_iSerial = 0;
+
 	clear();
 }
 
@@ -50,6 +59,12 @@ qtractorMidiSequence::qtractorMidiSequence ( const QString& sName,
 qtractorMidiSequence::~qtractorMidiSequence (void)
 {
 	clear();
+
+	freeIndexes(true);
+
+	Index *pIndex = m_pIndex.exchange(nullptr);
+	if (pIndex)
+		delete pIndex;
 }
 
 
@@ -66,33 +81,47 @@ void qtractorMidiSequence::clear (void)
 
 	m_duration = 0;
 
+	m_bIndexDirty = true;
+
 	m_events.clear();
-	m_notes.clear();
+
+	::memset(m_notes, 0, sizeof(m_notes));
+
+	// Start over contiguous storage...
+	m_arena.reset();
 }
 
 
 // NOTEON/OFF: Find previous note event and compute duration...
 void qtractorMidiSequence::addNoteEvent ( qtractorMidiEvent *pEvent )
 {
-	NoteOns::Iterator iter = m_notes.find(pEvent->note());
-	if (iter == m_notes.end())
-		return;
-
-	qtractorMidiEvent *pNoteEvent = iter.value();
-	if (pNoteEvent == nullptr) // Double-check, not really necessary...
+	const unsigned char note = (pEvent->note() & 0x7f);
+	qtractorMidiEvent *pNoteEvent = m_notes[note];
+	if (pNoteEvent == nullptr)
 		return;
 
 	const unsigned long t1 = pNoteEvent->time(); // Last NOTEON...
 	const unsigned long t2 = pEvent->time();     // This NOTEON/OFF.
 	if (t2 > t1) {
-		pNoteEvent->setDuration(t2 - t1);
+		setEventDuration(pNoteEvent, t2 - t1);
 		if (m_duration < t2)
 			m_duration = t2;
 	} else {
-		pNoteEvent->setDuration(m_duration - t1);
+		setEventDuration(pNoteEvent, m_duration - t1);
 	}
 
-	m_notes.erase(iter);
+	m_notes[note] = nullptr;
+}
+
+
+// Add a note-off to a channel sequence: just folds into the
+// lingering note-on duration (transient, no event storage).
+void qtractorMidiSequence::addNoteOff ( unsigned long iTime, unsigned char note )
+{
+	qtractorMidiEvent event(iTime, qtractorMidiEvent::NOTEOFF, note);
+	event.adjustTime(m_iTimeOffset);
+
+	addNoteEvent(&event);
 }
 
 
@@ -113,7 +142,7 @@ void qtractorMidiSequence::addEvent ( qtractorMidiEvent *pEvent )
 	if (pEvent->type() == qtractorMidiEvent::NOTEON) {
 		// NOTEON: Just add to lingering notes...
 		addNoteEvent(pEvent);
-		m_notes.insert(pEvent->note(), pEvent);
+		m_notes[pEvent->note() & 0x7f] = pEvent;
 	}
 	else
 	if (pEvent->type() == qtractorMidiEvent::SYSEX) {
@@ -137,6 +166,8 @@ void qtractorMidiSequence::insertEvent ( qtractorMidiEvent *pEvent )
 	while (pEventAfter && pEventAfter->time() > pEvent->time())
 		pEventAfter = pEventAfter->prev();
 
+	m_bIndexDirty = true;
+
 	// Insert it...
 	if (pEventAfter)
 		m_events.insertAfter(pEvent, pEventAfter);
@@ -161,13 +192,30 @@ void qtractorMidiSequence::insertEvent ( qtractorMidiEvent *pEvent )
 // Unlink event from a channel sequence.
 void qtractorMidiSequence::unlinkEvent ( qtractorMidiEvent *pEvent )
 {
+	m_bIndexDirty = true;
+
 	m_events.unlink(pEvent);
 }
 
 
+// Event duration change (sparse time index reach gets dirty).
+void qtractorMidiSequence::setEventDuration (
+	qtractorMidiEvent *pEvent, unsigned long iDuration )
+{
+	if (pEvent->duration() == iDuration)
+		return;
+
+	m_bIndexDirty = true;
+
+	pEvent->setDuration(iDuration);
+}
+
+
 // Remove event from a channel sequence.
 void qtractorMidiSequence::removeEvent ( qtractorMidiEvent *pEvent )
 {
+	m_bIndexDirty = true;
+
 	m_events.remove(pEvent);
 }
 
@@ -182,15 +230,132 @@ void qtractorMidiSequence::close (void)
 		m_iTimeLength = m_duration;
 
 	// Finish all pending notes...
-	NoteOns::ConstIterator iter = m_notes.constBegin();
-	const NoteOns::ConstIterator& iter_end = m_notes.constEnd();
-	for ( ; iter != iter_end; ++iter) {
-		qtractorMidiEvent *pEvent = iter.value();
-		pEvent->setDuration(m_duration - pEvent->time());
+	for (int note = 0; note < 128; ++note) {
+		qtractorMidiEvent *pEvent = m_notes[note];
+		if (pEvent)
+			setEventDuration(pEvent, m_duration - pEvent->time());
 	}
 
 	// Reset all pending notes.
-	m_notes.clear();
+	::memset(m_notes, 0, sizeof(m_notes));
+
+	// Ready for fast seeking...
+	updateIndex();
+}
+
+
+// Sparse time index (re)build, if dirty.
+void qtractorMidiSequence::updateIndex (void)
+{
+	if (!m_bIndexDirty)
+		return;
+
+	Index *pIndex = new Index(1 + m_events.count() / c_iIndexStep);
+
+	unsigned long iReach = 0;
+	unsigned int i = 0;
+	qtractorMidiEvent *pEvent = m_events.first();
+	for ( ; pEvent; pEvent = pEvent->next(), ++i) {
+		if ((i % c_iIndexStep) == 0) {
+			IndexItem& item = pIndex->items[pIndex->count++];
+			item.time  = pEvent->time();
+			item.reach = iReach;
+			item.event = pEvent;
+		}
+		const unsigned long iEndTime = pEvent->time() + pEvent->duration();
+		if (iReach < iEndTime)
+			iReach = iEndTime;
+	}
+
+	// Swap in the new index; the retired one is kept
+	// around till no look-ups are in progress, as the
+	// playback cursors might be still looking at it...
+	Index *pIndexOld = m_pIndex.exchange(pIndex);
+	if (pIndexOld)
+		m_indexesOld.append(pIndexOld);
+
+	m_bIndexDirty = false;
+
+	++m_iSerial;
+
+	freeIndexes(false);
+}
+
+
+// Retired sparse time indexes reclaim: only safe when no
+// look-ups are in progress, as any later one would be on
+// the current index already.
+void qtractorMidiSequence::freeIndexes ( bool bForce )
+{
+	if (m_indexesOld.isEmpty())
+		return;
+
+	if (!bForce && m_iIndexReaders.load() > 0)
+		return;
+
+	qDeleteAll(m_indexesOld);
+	m_indexesOld.clear();
+}
+
+
+// Indexed look-up: nearest checkpoint event before the
+// last one that starts earlier than the given time.
+qtractorMidiEvent *qtractorMidiSequence::seekIndex ( unsigned long iTime ) const
+{
+	qtractorMidiEvent *pEvent = nullptr;
+
+	++m_iIndexReaders;
+
+	const Index *pIndex = m_pIndex.load();
+	if (pIndex) {
+		// Binary search for the last checkpoint before time...
+		unsigned int lo = 0;
+		unsigned int hi = pIndex->count;
+		while (lo < hi) {
+			const unsigned int mid = (lo + hi) >> 1;
+			if (pIndex->items[mid].time < iTime)
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+		if (lo > 0)
+			pEvent = pIndex->items[lo - 1].event;
+	}
+
+	--m_iIndexReaders;
+
+	return pEvent;
+}
+
+
+// Indexed look-up: nearest checkpoint event before the
+// first one that is still sounding at the given time.
+qtractorMidiEvent *qtractorMidiSequence::resetIndex ( unsigned long iTime ) const
+{
+	qtractorMidiEvent *pEvent = nullptr;
+
+	++m_iIndexReaders;
+
+	const Index *pIndex = m_pIndex.load();
+	if (pIndex) {
+		// Binary search for the last checkpoint whose
+		// preceding events have all ended before time...
+		unsigned int lo = 0;
+		unsigned int hi = pIndex->count;
+		while (lo < hi) {
+			const unsigned int mid = (lo + hi) >> 1;
+			if (pIndex->items[mid].reach < iTime)
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+		if (lo > 0)
+			pEvent = pIndex->items[lo - 1].event;
+	}
+
+	--m_iIndexReaders;
+
+	return pEvent;
 }
 
 
@@ -228,7 +393,8 @@ void qtractorMidiSequence::replaceEvents ( qtractorMidiSequence *pSeq,
 
 	// Insert new (cloned and adjusted) ones...
 	for (pEvent = pSeq->events().first(); pEvent; pEvent = pEvent->next()) {
-		qtractorMidiEvent *pNewEvent = new qtractorMidiEvent(*pEvent);
+		qtractorMidiEvent *pNewEvent
+			= new (&m_arena) qtractorMidiEvent(*pEvent, &m_arena);
 		pNewEvent->setTime(timeq(iTimeOffset + pEvent->time(), iTicksPerBeat));
 		if (pEvent->type() == qtractorMidiEvent::NOTEON)
 			pNewEvent->setDuration(timeq(pEvent->duration(), iTicksPerBeat));
@@ -236,6 +402,7 @@ void qtractorMidiSequence::replaceEvents ( qtractorMidiSequence *pSeq,
 	}
 
 	// Done.
+	updateIndex();
 }
 
 
@@ -243,20 +410,28 @@ void qtractorMidiSequence::replaceEvents ( qtractorMidiSequence *pSeq,
 void qtractorMidiSequence::copyEvents ( qtractorMidiSequence *pSeq )
 {
 	// Remove existing events.
+	m_bIndexDirty = true;
+
 	m_events.clear();
 
+	// Start over contiguous storage...
+	m_arena.reset();
+
 	const unsigned short iTicksPerBeat = pSeq->ticksPerBeat();
 
 	// Clone new ones...
 	qtractorMidiEvent *pEvent = pSeq->events().first();
 	for (; pEvent; pEvent = pEvent->next()) {
-		qtractorMidiEvent *pNewEvent = new qtractorMidiEvent(*pEvent);
+		qtractorMidiEvent *pNewEvent
+			= new (&m_arena) qtractorMidiEvent(*pEvent, &m_arena);
 		pNewEvent->setTime(timeq(pEvent->time(), iTicksPerBeat));
 		if (pEvent->type() == qtractorMidiEvent::NOTEON)
 			pNewEvent->setDuration(timeq(pEvent->duration(), iTicksPerBeat));
 		m_events.append(pNewEvent);
 	}
+
 	// Done.
+	updateIndex();
 }
 
 
@@ -1,7 +1,7 @@
 // qtractorMidiSequence.h
 //
 /****************************************************************************
-   Copyright (C) 2005-2024, rncbc aka Rui Nuno Capela. All rights reserved.
+   Copyright (C) 2005-2025, rncbc aka Rui Nuno Capela. All rights reserved.
 
    This program is free software; you can redistribute it and/or
    modify it under the terms of the GNU General Public License
@@ -26,6 +26,9 @@
 
 #include <QString>
 #include <QMultiHash>
+#include <QList>
+
+#include <atomic>
 
 // typedef unsigned long long uint64_t;
 #include <stdint.h>
@@ -101,12 +104,19 @@ public:
 	// Event list accessor.
 	const qtractorList<qtractorMidiEvent>& events() const { return m_events; }
 
+	// Contiguous event storage accessor (for bulk allocation).
+	qtractorMidiEventArena *arena() { return &m_arena; }
+
 	// Event list management methods.
 	void addEvent    (qtractorMidiEvent *pEvent);
+	void addNoteOff  (unsigned long iTime, unsigned char note);
 	void insertEvent (qtractorMidiEvent *pEvent);
 	void unlinkEvent (qtractorMidiEvent *pEvent);
 	void removeEvent (qtractorMidiEvent *pEvent);
 
+	// Event duration change (sparse time index reach gets dirty).
+	void setEventDuration(qtractorMidiEvent *pEvent, unsigned long iDuration);
+
 	// Adjust time resolutions (64bit).
 	unsigned long timep(unsigned long iTime, unsigned short p) const
 		{ return uint64_t(iTime) * p / m_iTicksPerBeat; }
@@ -123,14 +133,32 @@ public:
 	// Sequence closure method.
 	void close();
 
-	// Typed hash table to track note-ons.
-	typedef QHash<unsigned char, qtractorMidiEvent *> NoteOns;
+	// Sparse time index (re)build, if dirty.
+	void updateIndex();
+
+	// Whether the sparse time index is currently valid.
+	bool isIndexed() const
+		{ return (m_pIndex.load() && !m_bIndexDirty.load()); }
+
+	// Time index serial number (bumped on every rebuild).
+	unsigned int serial() const { return m_iSerial.load(); }
+
+	// Indexed look-up: nearest checkpoint event before the
+	// last one that starts earlier than the given time.
+	qtractorMidiEvent *seekIndex(unsigned long iTime) const;
+
+	// Indexed look-up: nearest checkpoint event before the
+	// first one that is still sounding at the given time.
+	qtractorMidiEvent *resetIndex(unsigned long iTime) const;
 
 protected:
 
 	// NOTEON/OFF: Find previous note event and compute duration...
 	void addNoteEvent(qtractorMidiEvent *pEvent);
 
+	// Retired sparse time indexes reclaim.
+	void freeIndexes(bool bForce);
+
 private:
 
 	// Sequence/track properties.
@@ -155,8 +183,44 @@ private:
 	// Sequence instance event list (all same MIDI channel).
 	qtractorList<qtractorMidiEvent> m_events;
 
-	// Local hash table to track note-ons.
-	NoteOns m_notes;
+	// Sequence instance event storage (contiguous chunks).
+	qtractorMidiEventArena m_arena;
+
+	// Local table to track note-ons, per key
+	// (fixed, so that capture won't hit the heap).
+	qtractorMidiEvent *m_notes[128];
+
+	// Sparse time index checkpoint item.
+	struct IndexItem
+	{
+		unsigned long time;     // Checkpoint event time.
+		unsigned long reach;    // Latest event end-time before.
+		qtractorMidiEvent *event;
+	};
+
+	// Sparse time index table.
+	struct Index
+	{
+		Index(unsigned int iSize)
+			: count(0), items(new IndexItem [iSize]) {}
+		~Index() { delete [] items; }
+
+		unsigned int count;
+		IndexItem   *items;
+	};
+
+	// Sparse time index (current, published lock-free) and
+	// the look-ups in progress; retired ones are only reclaimed
+	// when there are none, as they might still be looking.
+	std::atomic<Index *> m_pIndex;
+	mutable std::atomic<unsigned int> m_iIndexReaders;
+
+	QList<Index *> m_indexesOld;
+
+	std::atomic<bool> m_bIndexDirty;
+
+	// Time index serial number.
+	std::atomic<unsigned int> m_iSerial;
 };
 
 
@@ -355,6 +355,12 @@ void qtractorMixerStrip::initMixerStrip (void)
 	m_pPluginListView->setTinyScrollBar(true);
 	m_pLayout->addWidget(m_pPluginListView, 1);
 
+	m_pDspLoadLabel = new QLabel(/*this*/);
+	m_pDspLoadLabel->setFont(font3);
+	m_pDspLoadLabel->setAlignment(Qt::AlignHCenter | Qt::AlignVCenter);
+	m_pDspLoadLabel->hide();
+	m_pLayout->addWidget(m_pDspLoadLabel);
+
 	const QSizePolicy buttonPolicy(QSizePolicy::Minimum, QSizePolicy::Fixed);
 
 	m_pButtonLayout = new QHBoxLayout(/*this*/);
@@ -710,6 +716,30 @@ void qtractorMixerStrip::updateMidiLabel (void)
 }
 
 
+// DSP load (process call timing) display updater.
+void qtractorMixerStrip::updateDspLoad (void)
+{
+	qtractorDspLoad *pDspLoad = nullptr;
+	if (m_pPluginListView->pluginList()) {
+		if (m_pTrack)
+			pDspLoad = m_pTrack->dspLoad();
+		else
+		if (m_pBus && (m_busMode & qtractorBus::Output))
+			pDspLoad = m_pBus->dspLoad();
+	}
+
+	const bool bDspLoad = (pDspLoad && qtractorDspLoad::isEnabled());
+	if (bDspLoad) {
+		m_pDspLoadLabel->setText(pDspLoad->text());
+		m_pDspLoadLabel->setToolTip(pDspLoad->toolTip());
+	}
+	m_pDspLoadLabel->setVisible(bDspLoad);
+
+	// Plugin items show their own...
+	m_pPluginListView->viewport()->update();
+}
+
+
 // Mixer strip clear/suspend delegates
 void qtractorMixerStrip::clear (void)
 {
@@ -1431,6 +1461,16 @@ void qtractorMixerRack::cleanStrips ( int iMark )
 }
 
 
+// DSP load (process call timing) display updater.
+void qtractorMixerRack::updateDspLoads (void)
+{
+	Strips::ConstIterator strip = m_strips.constBegin();
+	const Strips::ConstIterator& strip_end = m_strips.constEnd();
+	for ( ; strip != strip_end; ++strip)
+		strip.value()->updateDspLoad();
+}
+
+
 // Find a mixer strip, given its MIDI-manager handle.
 qtractorMixerStrip *qtractorMixerRack::findMidiManagerStrip (
 	qtractorMidiManager *pMidiManager ) const
@@ -1780,6 +1820,15 @@ void qtractorMixer::updateWorkspaces (void)
 }
 
 
+// DSP load (process call timing) display updater.
+void qtractorMixer::updateDspLoads (void)
+{
+	m_pInputRack->updateDspLoads();
+	m_pTrackRack->updateDspLoads();
+	m_pOutputRack->updateDspLoads();
+}
+
+
 // Keyboard event handler.
 void qtractorMixer::keyPressEvent ( QKeyEvent *pKeyEvent )
 {
@@ -171,6 +171,9 @@ public:
 	// Retrieve the MIDI manager from a mixer strip, if any....
 	qtractorMidiManager *midiManager() const;
 
+	// DSP load (process call timing) display updater.
+	void updateDspLoad();
+
 public slots:
 
 	// Bus context menu slots.
@@ -227,6 +230,7 @@ private:
 	qtractorMixerMeter     *m_pMixerMeter;
 	QPushButton            *m_pBusButton;
 	QLabel                 *m_pMidiLabel;
+	QLabel                 *m_pDspLoadLabel;
 
 	// Selection stuff.
 	bool m_bSelected;
@@ -337,6 +341,9 @@ public:
 	void markStrips(int iMark);
 	void cleanStrips(int iMark);
 
+	// DSP load (process call timing) display updater.
+	void updateDspLoads();
+
 	// Multi-row workspace layout method.
 	void updateWorkspace()
 		{ m_pRackWidget->updateWorkspace(); }
@@ -421,6 +428,9 @@ public:
 	// Multi-row workspace layout method.
 	void updateWorkspaces();
 
+	// DSP load (process call timing) display updater.
+	void updateDspLoads();
+
 protected:
 
 	// Just about to notify main-window that we're closing.
@@ -105,6 +105,7 @@ void qtractorOptions::loadOptions (void)
 	bStdoutCapture  = m_settings.value("/StdoutCapture", true).toBool();
 	bCompletePath   = m_settings.value("/CompletePath", true).toBool();
 	bPeakAutoRemove = m_settings.value("/PeakAutoRemove", true).toBool();
+	iPeakThreads    = m_settings.value("/PeakThreads", -1).toInt();
 	bKeepToolsOnTop = m_settings.value("/KeepToolsOnTop", true).toBool();
 	bKeepEditorsOnTop = m_settings.value("/KeepEditorsOnTop", false).toBool();
 	iDisplayFormat  = m_settings.value("/DisplayFormat", 1).toInt();
@@ -158,6 +159,10 @@ void qtractorOptions::loadOptions (void)
 	bAudioAutoTimeStretch = m_settings.value("/AutoTimeStretch", false).toBool();
 	bAudioWsolaTimeStretch = m_settings.value("/WsolaTimeStretch", true).toBool();
 	bAudioWsolaQuickSeek = m_settings.value("/WsolaQuickSeek", false).toBool();
+	bAudioWsolaCoarseSeek = m_settings.value("/WsolaCoarseSeek", false).toBool();
+	bAudioRenderCache = m_settings.value("/RenderCache", false).toBool();
+	iAudioPageCacheSize = m_settings.value("/PageCacheSize", 0).toInt();
+	iAudioPreloadSize = m_settings.value("/PreloadSize", 0).toInt();
 	bAudioRubberBandFormant = m_settings.value("/RubberBandFormant", false).toBool();
 	bAudioRubberBandFinerR3 = m_settings.value("/RubberBandFinerR3", false).toBool();
 	bAudioPlayerBus      = m_settings.value("/PlayerBus", false).toBool();
@@ -170,6 +175,13 @@ void qtractorOptions::loadOptions (void)
 	bAudioMetroAutoConnect = m_settings.value("/MetroAutoConnect", true).toBool();
 	bAudioSelfConnected = m_settings.value("/SelfConnected", true).toBool();
 	iAudioMetroOffset  = (unsigned long) m_settings.value("/MetroOffset", 0).toUInt();
+	iAudioGraphThreads = m_settings.value("/GraphThreads", 0).toInt();
+	bAudioGraphDeterministic = m_settings.value("/GraphDeterministic", true).toBool();
+	audioGraphSerialPlugins = m_settings.value("/GraphSerialPlugins").toStringList();
+	bAudioExportOffline = m_settings.value("/ExportOffline", false).toBool();
+	iAudioExportThreads = m_settings.value("/ExportThreads", -1).toInt();
+	iAudioTaskThreads = m_settings.value("/TaskThreads", -1).toInt();
+	bAudioDspLoad = m_settings.value("/DspLoad", false).toBool();
 	m_settings.endGroup();
 
 	// MIDI rendering options group.
@@ -179,6 +191,8 @@ void qtractorOptions::loadOptions (void)
 	iMidiCaptureQuantize = m_settings.value("/CaptureQuantize", 0).toInt();
 	iMidiQueueTimer    = m_settings.value("/QueueTimer", 0).toInt();
 	bMidiDriftCorrect  = m_settings.value("/DriftCorrect", true).toBool();
+	bMidiJackOutput    = m_settings.value("/JackOutput", false).toBool();
+	bMidiJackInput     = m_settings.value("/JackInput", false).toBool();
 	bMidiPlayerBus     = m_settings.value("/PlayerBus", false).toBool();
 	bMidiControlBus    = m_settings.value("/ControlBus", false).toBool();
 	bMidiMetroBus      = m_settings.value("/MetroBus", false).toBool();
@@ -285,6 +299,7 @@ void qtractorOptions::loadOptions (void)
 	iDummyVst3Hash = m_settings.value("/DummyVst3Hash", 0).toInt();
 	iDummyClapHash = m_settings.value("/DummyClapHash", 0).toInt();
 	iDummyLv2Hash = m_settings.value("/DummyLv2Hash", 0).toInt();
+	iPluginScanThreads = m_settings.value("/ScanThreads", -1).toInt();
 	m_settings.endGroup();
 
 	// Instrument file list.
@@ -444,6 +459,7 @@ void qtractorOptions::saveOptions (void)
 	m_settings.setValue("/StdoutCapture", bStdoutCapture);
 	m_settings.setValue("/CompletePath", bCompletePath);
 	m_settings.setValue("/PeakAutoRemove", bPeakAutoRemove);
+	m_settings.setValue("/PeakThreads", iPeakThreads);
 	m_settings.setValue("/KeepToolsOnTop", bKeepToolsOnTop);
 	m_settings.setValue("/KeepEditorsOnTop", bKeepEditorsOnTop);
 	m_settings.setValue("/DisplayFormat", iDisplayFormat);
@@ -497,6 +513,10 @@ void qtractorOptions::saveOptions (void)
 	m_settings.setValue("/AutoTimeStretch", bAudioAutoTimeStretch);
 	m_settings.setValue("/WsolaTimeStretch", bAudioWsolaTimeStretch);
 	m_settings.setValue("/WsolaQuickSeek", bAudioWsolaQuickSeek);
+	m_settings.setValue("/WsolaCoarseSeek", bAudioWsolaCoarseSeek);
+	m_settings.setValue("/RenderCache", bAudioRenderCache);
+	m_settings.setValue("/PageCacheSize", iAudioPageCacheSize);
+	m_settings.setValue("/PreloadSize", iAudioPreloadSize);
 	m_settings.setValue("/RubberBandFormant", bAudioRubberBandFormant);
 	m_settings.setValue("/RubberBandFinerR3", bAudioRubberBandFinerR3);
 	m_settings.setValue("/PlayerBus", bAudioPlayerBus);
@@ -509,6 +529,13 @@ void qtractorOptions::saveOptions (void)
 	m_settings.setValue("/MetroAutoConnect", bAudioMetroAutoConnect);
 	m_settings.setValue("/SelfConnected", bAudioSelfConnected);
 	m_settings.setValue("/MetroOffset", uint(iAudioMetroOffset));
+	m_settings.setValue("/GraphThreads", iAudioGraphThreads);
+	m_settings.setValue("/GraphDeterministic", bAudioGraphDeterministic);
+	m_settings.setValue("/GraphSerialPlugins", audioGraphSerialPlugins);
+	m_settings.setValue("/ExportOffline", bAudioExportOffline);
+	m_settings.setValue("/ExportThreads", iAudioExportThreads);
+	m_settings.setValue("/TaskThreads", iAudioTaskThreads);
+	m_settings.setValue("/DspLoad", bAudioDspLoad);
 	m_settings.endGroup();
 
 	// MIDI rendering options group.
@@ -518,6 +545,8 @@ void qtractorOptions::saveOptions (void)
 	m_settings.setValue("/CaptureQuantize", iMidiCaptureQuantize);
 	m_settings.setValue("/QueueTimer", iMidiQueueTimer);
 	m_settings.setValue("/DriftCorrect", bMidiDriftCorrect);
+	m_settings.setValue("/JackOutput", bMidiJackOutput);
+	m_settings.setValue("/JackInput", bMidiJackInput);
 	m_settings.setValue("/PlayerBus", bMidiPlayerBus);
 	m_settings.setValue("/ControlBus", bMidiControlBus);
 	m_settings.setValue("/MetroBus", bMidiMetroBus);
@@ -620,6 +649,7 @@ void qtractorOptions::saveOptions (void)
 	m_settings.setValue("/DummyVst3Hash", iDummyVst3Hash);
 	m_settings.setValue("/DummyClapHash", iDummyClapHash);
 	m_settings.setValue("/DummyLv2Hash", iDummyLv2Hash);
+	m_settings.setValue("/ScanThreads", iPluginScanThreads);
 	m_settings.endGroup();
 
 	// Instrument file list.
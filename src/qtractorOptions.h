@@ -75,6 +75,7 @@ public:
 	bool    bStdoutCapture;
 	bool    bCompletePath;
 	bool    bPeakAutoRemove;
+	int     iPeakThreads;
 	bool    bKeepToolsOnTop;
 	bool    bKeepEditorsOnTop;
 	int     iDisplayFormat;
@@ -119,6 +120,10 @@ public:
 	bool    bAudioAutoTimeStretch;
 	bool    bAudioWsolaTimeStretch;
 	bool    bAudioWsolaQuickSeek;
+	bool    bAudioWsolaCoarseSeek;
+	bool    bAudioRenderCache;
+	int     iAudioPageCacheSize;
+	int     iAudioPreloadSize;
 	bool    bAudioRubberBandFormant;
 	bool    bAudioRubberBandFinerR3;
 	bool    bAudioPlayerBus;
@@ -134,6 +139,21 @@ public:
 	// Audio metronome latency offset compensation.
 	unsigned long iAudioMetroOffset;
 
+	// Audio parallel track process graph (worker threads).
+	int     iAudioGraphThreads;
+	bool    bAudioGraphDeterministic;
+	QStringList audioGraphSerialPlugins;
+
+	// Audio export offline mode and parallel process (worker threads).
+	bool    bAudioExportOffline;
+	int     iAudioExportThreads;
+
+	// Audio real-time parallel task pool (worker threads).
+	int     iAudioTaskThreads;
+
+	// Audio DSP load (process call timing) profiling.
+	bool    bAudioDspLoad;
+
 	// Audio metronome parameters.
 	QString sMetroBarFilename;
 	float   fMetroBarGain;
@@ -150,6 +170,8 @@ public:
 	int  iMidiCaptureQuantize;
 	int  iMidiQueueTimer;
 	bool bMidiDriftCorrect;
+	bool bMidiJackOutput;
+	bool bMidiJackInput;
 	bool bMidiPlayerBus;
 	bool bMidiControlBus;
 	bool bMidiMetroBus;
@@ -277,6 +299,9 @@ public:
 	int  iDummyClapHash;
 	int  iDummyLv2Hash;
 
+	// Out-of-process plugin scanning (parallel processes per type).
+	int  iPluginScanThreads;
+
 	// The instrument file list.
 	QStringList instrumentFiles;
 
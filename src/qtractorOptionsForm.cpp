@@ -266,6 +266,9 @@ qtractorOptionsForm::qtractorOptionsForm ( QWidget *pParent )
 	QObject::connect(m_ui.AudioWsolaQuickSeekCheckBox,
 		SIGNAL(stateChanged(int)),
 		SLOT(changed()));
+	QObject::connect(m_ui.AudioWsolaCoarseSeekCheckBox,
+		SIGNAL(stateChanged(int)),
+		SLOT(changed()));
 #ifdef CONFIG_LIBRUBBERBAND
 	QObject::connect(m_ui.AudioRubberBandFormantCheckBox,
 		SIGNAL(stateChanged(int)),
@@ -339,6 +342,12 @@ qtractorOptionsForm::qtractorOptionsForm ( QWidget *pParent )
 	QObject::connect(m_ui.MidiResetAllControllersCheckBox,
 		SIGNAL(stateChanged(int)),
 		SLOT(changed()));
+	QObject::connect(m_ui.MidiJackOutputCheckBox,
+		SIGNAL(stateChanged(int)),
+		SLOT(changed()));
+	QObject::connect(m_ui.MidiJackInputCheckBox,
+		SIGNAL(stateChanged(int)),
+		SLOT(changed()));
 	QObject::connect(m_ui.MidiMmcModeComboBox,
 		SIGNAL(activated(int)),
 		SLOT(changed()));
@@ -536,6 +545,9 @@ qtractorOptionsForm::qtractorOptionsForm ( QWidget *pParent )
 	QObject::connect(m_ui.AudioOutputAutoConnectCheckBox,
 		SIGNAL(stateChanged(int)),
 		SLOT(changed()));
+	QObject::connect(m_ui.PluginsTaskThreadsSpinBox,
+		SIGNAL(valueChanged(int)),
+		SLOT(changed()));
 	QObject::connect(m_ui.OpenEditorCheckBox,
 		SIGNAL(stateChanged(int)),
 		SLOT(changed()));
@@ -653,6 +665,7 @@ void qtractorOptionsForm::setOptions ( qtractorOptions *pOptions )
 	m_ui.AudioRubberBandFinerR3CheckBox->hide();
 #endif
 	m_ui.AudioWsolaQuickSeekCheckBox->setChecked(m_pOptions->bAudioWsolaQuickSeek);
+	m_ui.AudioWsolaCoarseSeekCheckBox->setChecked(m_pOptions->bAudioWsolaCoarseSeek);
 	m_ui.AudioPlayerBusCheckBox->setChecked(m_pOptions->bAudioPlayerBus);
 	m_ui.AudioPlayerAutoConnectCheckBox->setChecked(m_pOptions->bAudioPlayerAutoConnect);
 	m_ui.AudioSelfConnectedCheckBox->setChecked(m_pOptions->bAudioSelfConnected);
@@ -720,6 +733,8 @@ void qtractorOptionsForm::setOptions ( qtractorOptions *pOptions )
 	m_ui.MidiDriftCorrectCheckBox->setChecked(m_pOptions->bMidiDriftCorrect);
 	m_ui.MidiPlayerBusCheckBox->setChecked(m_pOptions->bMidiPlayerBus);
 	m_ui.MidiResetAllControllersCheckBox->setChecked(m_pOptions->bMidiResetAllControllers);
+	m_ui.MidiJackOutputCheckBox->setChecked(m_pOptions->bMidiJackOutput);
+	m_ui.MidiJackInputCheckBox->setChecked(m_pOptions->bMidiJackInput);
 
 	// MIDI control options.
 	m_ui.MidiMmcModeComboBox->setCurrentIndex(m_pOptions->iMidiMmcMode);
@@ -868,6 +883,7 @@ void qtractorOptionsForm::setOptions ( qtractorOptions *pOptions )
 	// Plugin instruments options.
 	m_ui.AudioOutputBusCheckBox->setChecked(m_pOptions->bAudioOutputBus);
 	m_ui.AudioOutputAutoConnectCheckBox->setChecked(m_pOptions->bAudioOutputAutoConnect);
+	m_ui.PluginsTaskThreadsSpinBox->setValue(m_pOptions->iAudioTaskThreads);
 	m_ui.OpenEditorCheckBox->setChecked(m_pOptions->bOpenEditor);
 	m_ui.QueryEditorTypeCheckBox->setChecked(m_pOptions->bQueryEditorType);
 
@@ -941,6 +957,7 @@ void qtractorOptionsForm::accept (void)
 		m_pOptions->bAudioAutoTimeStretch = m_ui.AudioAutoTimeStretchCheckBox->isChecked();
 		m_pOptions->bAudioWsolaTimeStretch = m_ui.AudioWsolaTimeStretchCheckBox->isChecked();
 		m_pOptions->bAudioWsolaQuickSeek = m_ui.AudioWsolaQuickSeekCheckBox->isChecked();
+		m_pOptions->bAudioWsolaCoarseSeek = m_ui.AudioWsolaCoarseSeekCheckBox->isChecked();
 		m_pOptions->bAudioRubberBandFormant = m_ui.AudioRubberBandFormantCheckBox->isChecked();
 		m_pOptions->bAudioRubberBandFinerR3 = m_ui.AudioRubberBandFinerR3CheckBox->isChecked();
 		m_pOptions->bAudioPlayerBus      = m_ui.AudioPlayerBusCheckBox->isChecked();
@@ -965,6 +982,8 @@ void qtractorOptionsForm::accept (void)
 		m_pOptions->bMidiDriftCorrect    = m_ui.MidiDriftCorrectCheckBox->isChecked();
 		m_pOptions->bMidiPlayerBus       = m_ui.MidiPlayerBusCheckBox->isChecked();
 		m_pOptions->bMidiResetAllControllers = m_ui.MidiResetAllControllersCheckBox->isChecked();
+		m_pOptions->bMidiJackOutput      = m_ui.MidiJackOutputCheckBox->isChecked();
+		m_pOptions->bMidiJackInput       = m_ui.MidiJackInputCheckBox->isChecked();
 		m_pOptions->iMidiMmcMode         = m_ui.MidiMmcModeComboBox->currentIndex();
 		m_pOptions->iMidiMmcDevice       = m_ui.MidiMmcDeviceComboBox->currentIndex();
 		m_pOptions->iMidiSppMode         = m_ui.MidiSppModeComboBox->currentIndex();
@@ -1017,6 +1036,7 @@ void qtractorOptionsForm::accept (void)
 		// Plugin instruments options.
 		m_pOptions->bAudioOutputBus      = m_ui.AudioOutputBusCheckBox->isChecked();
 		m_pOptions->bAudioOutputAutoConnect = m_ui.AudioOutputAutoConnectCheckBox->isChecked();
+		m_pOptions->iAudioTaskThreads    = m_ui.PluginsTaskThreadsSpinBox->value();
 		m_pOptions->bOpenEditor          = m_ui.OpenEditorCheckBox->isChecked();
 		m_pOptions->bQueryEditorType     = m_ui.QueryEditorTypeCheckBox->isChecked();
 		// Messages options...
@@ -2200,8 +2220,10 @@ void qtractorOptionsForm::stabilizeForm (void)
 		bValid  = qtractorAudioFileFactory::isValidFormat(pFormat, iFormat);
 	}
 
-	m_ui.AudioWsolaQuickSeekCheckBox->setEnabled(
-		m_ui.AudioWsolaTimeStretchCheckBox->isChecked());
+	const bool bAudioWsolaTimeStretch
+		= m_ui.AudioWsolaTimeStretchCheckBox->isChecked();
+	m_ui.AudioWsolaQuickSeekCheckBox->setEnabled(bAudioWsolaTimeStretch);
+	m_ui.AudioWsolaCoarseSeekCheckBox->setEnabled(bAudioWsolaTimeStretch);
 
 	m_ui.AudioPlayerAutoConnectCheckBox->setEnabled(
 		m_ui.AudioPlayerBusCheckBox->isChecked());
@@ -41,6 +41,8 @@
 
 #include "qtractorMessageList.h"
 
+#include "qtractorAtomic.h"
+
 #include <QDomDocument>
 #include <QDomElement>
 #include <QTextStream>
@@ -262,9 +264,11 @@ qtractorPlugin::qtractorPlugin (
 	: m_pList(pList), m_pType(pType), m_iUniqueID(0), m_iInstances(0),
 		m_iActivated(0), m_bActivated(false), m_bAutoDeactivated(false),
 		m_activateObserver(this), m_iActivateSubjectIndex(0),
-		m_pLastUpdatedParam(nullptr), m_pLastUpdatedProperty(nullptr),
-		m_pForm(nullptr), m_iEditorType(-1),
-		m_iDirectAccessParamIndex(-1)
+		m_pLastUpdatedParam(nullptr), m_iSplitChannels(0),
+		m_ppIBufferSplit(nullptr), m_ppOBufferSplit(nullptr),
+		m_pLastUpdatedProperty(nullptr), m_pForm(nullptr), m_iEditorType(-1),
+		m_iDirectAccessParamIndex(-1), m_iSilentFrames(0),
+		m_bSilentIn(false), m_bIdle(false), m_bGraphSerial(false)
 {
 	// Acquire a local unique id in chain...
 	if (m_pList && m_pType)
@@ -274,6 +278,16 @@ qtractorPlugin::qtractorPlugin (
 	if (m_pType)
 		m_sLabel = m_pType->label();
 
+	// Parallel graph audit: DSSI (run_multiple_synths) and VST2
+	// make no promise about instances running concurrently...
+	if (m_pType) {
+		const qtractorPluginType::Hint typeHint = m_pType->typeHint();
+		m_bGraphSerial = (typeHint == qtractorPluginType::Dssi
+			|| typeHint == qtractorPluginType::Vst2
+			|| g_graphSerialPlugins.contains(m_pType->name())
+			|| g_graphSerialPlugins.contains(m_pType->filename()));
+	}
+
 	// Activate subject properties.
 	m_activateSubject.setName(QObject::tr("Activate"));
 	m_activateSubject.setToggled(true);
@@ -288,6 +302,12 @@ qtractorPlugin::~qtractorPlugin (void)
 	clearParams();
 	clearProperties();
 
+	// Sub-block split processing scratch...
+	if (m_ppOBufferSplit)
+		delete [] m_ppOBufferSplit;
+	if (m_ppIBufferSplit)
+		delete [] m_ppIBufferSplit;
+
 	// Rest of stuff goes cleaned too...
 	if (m_pType) delete m_pType;
 }
@@ -400,6 +420,7 @@ void qtractorPlugin::updateActivated ( bool bActivated )
 			++m_iActivated;
 		}
 		// Let the change be...
+		resetIdle();
 		m_bActivated = bActivated;
 		// Last time deactivate?
 		if (!bActivated && m_iActivated == 0)
@@ -453,6 +474,17 @@ void qtractorPlugin::updateActivatedEx ( bool bActivated )
 void qtractorPlugin::setChannelsActivated (
 	unsigned short iChannels, bool bActivated )
 {
+	// Sub-block split processing scratch (grow only)...
+	if (m_iSplitChannels < iChannels) {
+		if (m_ppOBufferSplit)
+			delete [] m_ppOBufferSplit;
+		if (m_ppIBufferSplit)
+			delete [] m_ppIBufferSplit;
+		m_iSplitChannels = iChannels;
+		m_ppIBufferSplit = new float * [m_iSplitChannels];
+		m_ppOBufferSplit = new float * [m_iSplitChannels];
+	}
+
 	if (iChannels > 0) {
 		// First time activation?...
 		if (!bActivated) ++m_iActivated;
@@ -615,11 +647,13 @@ void qtractorPlugin::addParam ( qtractorPlugin::Param *pParam )
 		pParam->observer()->setLogarithmic(true);
 	m_params.insert(pParam->index(), pParam);
 	m_paramNames.insert(pParam->name(), pParam);
+	m_paramSubjects.insert(pParam->subject(), pParam);
 }
 
 
 void qtractorPlugin::removeParam ( qtractorPlugin::Param *pParam )
 {
+	m_paramSubjects.remove(pParam->subject());
 	m_paramNames.remove(pParam->name());
 	m_params.remove(pParam->index());
 }
@@ -630,6 +664,220 @@ void qtractorPlugin::clearParams (void)
 	qDeleteAll(m_params);
 	m_params.clear();
 	m_paramNames.clear();
+	m_paramSubjects.clear();
+}
+
+
+// Sample-accurate automation curve list,
+// only while playing back (RT-safe).
+qtractorCurveList *qtractorPlugin::processCurveList (void) const
+{
+	qtractorCurveList *pCurveList = (m_pList ? m_pList->curveList() : nullptr);
+	if (pCurveList == nullptr || !pCurveList->isProcess())
+		return nullptr;
+
+	qtractorSession *pSession = qtractorSession::getInstance();
+	if (pSession == nullptr || !pSession->isPlaying())
+		return nullptr;
+
+	return pCurveList;
+}
+
+
+// Whether a parameter is being automated
+// from within the process cycle (sample-accurate).
+bool qtractorPlugin::isProcessCurve ( Param *pParam ) const
+{
+	qtractorCurve *pCurve = pParam->subject()->curve();
+	if (pCurve == nullptr || !pCurve->isProcess())
+		return false;
+
+	qtractorCurveList *pCurveList = processCurveList();
+	return (pCurveList && pCurve->list() == pCurveList);
+}
+
+
+// Sample-accurate automation, sub-block split processing (RT-safe):
+// plain control ports are only read once per run call, so the cycle
+// is split wherever an automated parameter value actually changes.
+void qtractorPlugin::process_split (
+	float **ppIBuffer, float **ppOBuffer, unsigned int nframes )
+{
+	const unsigned short iChannels = channels();
+
+	qtractorCurveList *pCurveList = processCurveList();
+	if (pCurveList == nullptr || iChannels > m_iSplitChannels) {
+		process_block(ppIBuffer, ppOBuffer, nframes);
+		return;
+	}
+
+	// Plain control ports get coarser steps...
+	const unsigned int iStep = (qtractorCurve::c_iProcessStep << 1);
+
+	float **ppIBuffer2 = m_ppIBufferSplit;
+	float **ppOBuffer2 = m_ppOBufferSplit;
+	unsigned short i;
+
+	const unsigned long iFrameStart = pCurveList->frame();
+	const unsigned long iFrameEnd = iFrameStart + nframes;
+
+	unsigned long iFrame = iFrameStart;
+	while (iFrame < iFrameEnd) {
+		// Find the nearest automated parameter change...
+		unsigned long iNextFrame = iFrameEnd;
+		qtractorCurve *pCurve = pCurveList->first();
+		for ( ; pCurve; pCurve = pCurve->next()) {
+			if (!pCurve->isProcess())
+				continue;
+			Param *pParam = findParamSubject(pCurve->subject());
+			if (pParam == nullptr)
+				continue;
+			unsigned long iNextFrame2 = iFrame;
+			float fValue = pParam->subject()->value();
+			if (pCurve->processNext(iNextFrame2, iNextFrame, fValue, iStep))
+				iNextFrame = iNextFrame2;
+		}
+		// Run the sub-block...
+		const unsigned int iOffset = (iFrame - iFrameStart);
+		const unsigned int nframes2 = (iNextFrame - iFrame);
+		if (iOffset > 0) {
+			for (i = 0; i < iChannels; ++i) {
+				ppIBuffer2[i] = ppIBuffer[i] + iOffset;
+				ppOBuffer2[i] = ppOBuffer[i] + iOffset;
+			}
+			process_block(ppIBuffer2, ppOBuffer2, nframes2);
+		}
+		else process_block(ppIBuffer, ppOBuffer, nframes2);
+		// Set control ports for the next sub-block...
+		if (iNextFrame < iFrameEnd) {
+			pCurve = pCurveList->first();
+			for ( ; pCurve; pCurve = pCurve->next()) {
+				if (!pCurve->isProcess())
+					continue;
+				Param *pParam = findParamSubject(pCurve->subject());
+				if (pParam == nullptr)
+					continue;
+				qtractorSubject *pSubject = pParam->subject();
+				*pSubject->data() = pSubject->safeValue(pCurve->value(iNextFrame));
+			}
+		}
+		iFrame = iNextFrame;
+	}
+}
+
+
+// Sample-accurate automation, intra-cycle parameter point walk (RT-safe):
+// each automated parameter gets its current value at offset zero, then
+// every actual value change within the cycle, in time order.
+bool qtractorPlugin::process_curves ( unsigned int nframes )
+{
+	qtractorCurveList *pCurveList = processCurveList();
+	if (pCurveList == nullptr)
+		return false;
+
+	const unsigned long iFrameStart = pCurveList->frame();
+	const unsigned long iFrameEnd = iFrameStart + nframes;
+
+	qtractorCurve *pCurve = pCurveList->first();
+	for ( ; pCurve; pCurve = pCurve->next()) {
+		if (!pCurve->isProcess())
+			continue;
+		Param *pParam = findParamSubject(pCurve->subject());
+		if (pParam == nullptr)
+			continue;
+		unsigned long iFrame = iFrameStart;
+		float fValue = pParam->subject()->value();
+		process_curve(pParam, fValue, 0);
+		while (pCurve->processNext(iFrame, iFrameEnd, fValue))
+			process_curve(pParam, fValue, iFrame - iFrameStart);
+	}
+
+	return true;
+}
+
+
+// Parallel graph opt-out list (plugin names or file names).
+QStringList qtractorPlugin::g_graphSerialPlugins;
+
+void qtractorPlugin::setGraphSerialPlugins ( const QStringList& plugins )
+{
+	g_graphSerialPlugins = plugins;
+}
+
+const QStringList& qtractorPlugin::graphSerialPlugins (void)
+{
+	return g_graphSerialPlugins;
+}
+
+
+// Whether this plugin may go idle at all: only actual plugins,
+// not the internal ones (inserts, aux-sends and controllers),
+// nor the ones that may output MIDI on their own, nor the ones
+// without any input, audio or MIDI (generators).
+bool qtractorPlugin::canBeIdle (void) const
+{
+	if (m_pType == nullptr)
+		return false;
+
+	if (m_pType->audioIns() < 1 && m_pType->midiIns() < 1)
+		return false;
+
+	switch (m_pType->typeHint()) {
+	case qtractorPluginType::Ladspa:
+	case qtractorPluginType::Dssi:
+	case qtractorPluginType::Vst2:
+	case qtractorPluginType::Vst3:
+	case qtractorPluginType::Clap:
+	case qtractorPluginType::Lv2:
+		return (m_pType->midiOuts() < 1);
+	default:
+		return false;
+	}
+}
+
+
+// Update idle state, after processing a silent (or not) input;
+// returns whether the output is digital silence too (RT-safe).
+bool qtractorPlugin::updateIdle (
+	float **ppOBuffer, unsigned int nframes, unsigned long iIdleFrames )
+{
+	const bool bSilentOut = isSilentBuffer(ppOBuffer, channels(), nframes);
+
+	if (m_bSilentIn) {
+		// Known tails are counted from input silence,
+		// unknown ones from output silence instead...
+		const long iTail = tail();
+		if (iTail < 0 && !bSilentOut)
+			m_iSilentFrames = 0;
+		else
+			m_iSilentFrames += nframes;
+		if (iTail >= 0)
+			iIdleFrames = iTail;
+		m_bIdle = (bSilentOut && m_iSilentFrames >= iIdleFrames
+			&& canBeIdle());
+	}
+	else resetIdle();
+
+	return bSilentOut;
+}
+
+
+// Digital silence predicate (RT-safe).
+bool qtractorPlugin::isSilentBuffer (
+	float **ppBuffer, unsigned short iChannels, unsigned int nframes )
+{
+	// About -140dB...
+	const float fThreshold = 1E-7f;
+
+	for (unsigned short i = 0; i < iChannels; ++i) {
+		const float *pBuffer = ppBuffer[i];
+		for (unsigned int n = 0; n < nframes; ++n) {
+			if (pBuffer[n] > fThreshold || pBuffer[n] < -fThreshold)
+				return false;
+		}
+	}
+
+	return true;
 }
 
 
@@ -1753,6 +2001,9 @@ void qtractorPlugin::Param::setValue ( float fValue, bool bUpdate )
 
 	m_observer.setValue(fValue);
 
+	// Wake up, if idle...
+	m_pPlugin->resetIdle();
+
 	// Update specifics.
 	if (bUpdate) m_pPlugin->updateParam(this, fValue, true);
 
@@ -1789,6 +2040,7 @@ void qtractorPlugin::Param::updateValue ( float fValue, bool bUpdate )
 void qtractorPlugin::Param::update ( float fValue, bool bUpdate )
 {
 	qtractorPlugin *pPlugin = plugin();
+	pPlugin->resetIdle();
 	if (bUpdate && pPlugin->directAccessParamIndex() == long(index()))
 		pPlugin->updateListViews();
 	pPlugin->updateParam(this, fValue, bUpdate);
@@ -1848,6 +2100,13 @@ void qtractorPlugin::Property::update ( float fValue, bool bUpdate )
 // qtractorPluginList -- Plugin chain list instance.
 //
 
+// Idle plugin calls skipped since last asked (all chains).
+static qtractorAtomic g_iIdleSkipCount;
+
+// Idle wake-up serial, bumped on transport changes (all chains).
+static qtractorAtomic g_iIdleSerial;
+
+
 // Constructor.
 qtractorPluginList::qtractorPluginList (
 	unsigned short iChannels, unsigned int iFlags )
@@ -1857,7 +2116,8 @@ qtractorPluginList::qtractorPluginList (
 		m_pMidiProgramSubject(nullptr),
 		m_bAutoDeactivated(false),
 		m_bAudioOutputMonitor(false),
-		m_bLatency(false), m_iLatency(0)
+		m_bLatency(false), m_iLatency(0),
+		m_iIdleSerial(ATOMIC_GET(&g_iIdleSerial))
 {
 	setAutoDelete(true);
 
@@ -1872,6 +2132,7 @@ qtractorPluginList::qtractorPluginList (
 		= qtractorMidiManager::isDefaultAudioOutputAutoConnect();
 
 	m_iAudioInsertActivated = 0;
+	m_iAudioAuxSendActivated = 0;
 
 	setChannels(iChannels, iFlags);
 }
@@ -2267,6 +2528,24 @@ void qtractorPluginList::process ( float **ppBuffer, unsigned int nframes )
 	// Buffer binary iterator...
 	unsigned short iBuffer = 0;
 
+	// Digital silence tracking, through the chain...
+	bool bSilent = qtractorPlugin::isSilentBuffer(ppBuffer, m_iChannels, nframes);
+
+	// Any MIDI input breaks silence, for MIDI plugins...
+	const bool bMidiIn
+		= (m_pMidiManager && m_pMidiManager->buffer_in()->count() > 0);
+
+	// Wake up all idle plugins, on transport changes...
+	const int iIdleSerial = ATOMIC_GET(&g_iIdleSerial);
+	const bool bIdleReset = (m_iIdleSerial != iIdleSerial);
+	m_iIdleSerial = iIdleSerial;
+
+	// Unknown tails go idle after a couple seconds of output silence...
+	unsigned long iIdleFrames = 0;
+	qtractorSession *pSession = qtractorSession::getInstance();
+	if (pSession)
+		iIdleFrames = (pSession->sampleRate() << 1);
+
 	// For each plugin in chain (in order, of course...)
 	for (qtractorPlugin *pPlugin = first();
 			pPlugin; pPlugin = pPlugin->next()) {
@@ -2275,11 +2554,29 @@ void qtractorPluginList::process ( float **ppBuffer, unsigned int nframes )
 		if (!pPlugin->isActivated())
 			continue;
 
+		const bool bSilentIn = bSilent && !(bMidiIn && pPlugin->midiIns() > 0);
+
+		if (bIdleReset)
+			pPlugin->resetIdle();
+
+		// Idle on silence: skip it altogether (silent pass-thru)...
+		if (bSilentIn && pPlugin->isIdle()) {
+			pPlugin->process_idle(nframes);
+			ATOMIC_INC(&g_iIdleSkipCount);
+			continue;
+		}
+
 		// Set proper buffers for this plugin...
 		float **ppIBuffer = m_pppBuffers[  iBuffer & 1];
 		float **ppOBuffer = m_pppBuffers[++iBuffer & 1];
 		// Time for the real thing...
-		pPlugin->process(ppIBuffer, ppOBuffer, nframes);
+		pPlugin->setSilentIn(bSilentIn);
+		{
+			qtractorDspLoad::Scope timing(pPlugin->dspLoad());
+			pPlugin->process(ppIBuffer, ppOBuffer, nframes);
+		}
+		// Whether it may go idle, next time...
+		bSilent = pPlugin->updateIdle(ppOBuffer, nframes, iIdleFrames);
 	}
 
 	// Now for the output buffer commitment...
@@ -2292,6 +2589,20 @@ void qtractorPluginList::process ( float **ppBuffer, unsigned int nframes )
 }
 
 
+// Idle plugin calls skipped since last asked (all chains).
+unsigned int qtractorPluginList::takeIdleSkipCount (void)
+{
+	return ATOMIC_TAZ(&g_iIdleSkipCount);
+}
+
+
+// Wake up all idle plugins, on transport changes (all chains).
+void qtractorPluginList::resetIdleAll (void)
+{
+	ATOMIC_INC(&g_iIdleSerial);
+}
+
+
 // Create/load plugin state.
 qtractorPlugin *qtractorPluginList::loadPlugin ( QDomElement *pElement )
 {
@@ -2636,6 +2947,19 @@ bool qtractorPluginList::isAutoDeactivated (void) const
 }
 
 
+// Whether any plugin must not run concurrently (parallel graph).
+bool qtractorPluginList::isGraphSerial (void) const
+{
+	for (qtractorPlugin *pPlugin = first();
+			pPlugin; pPlugin = pPlugin->next()) {
+		if (pPlugin->isGraphSerial())
+			return true;
+	}
+
+	return false;
+}
+
+
 // Check/sanitize plugin file-path;
 bool qtractorPluginList::checkPluginFile (
 	QString& sFilename, qtractorPluginType::Hint typeHint ) const
@@ -27,6 +27,7 @@
 #include "qtractorMidiControlObserver.h"
 
 #include "qtractorDocument.h"
+#include "qtractorDspLoad.h"
 
 #include <QStringList>
 #include <QPoint>
@@ -303,6 +304,19 @@ public:
 	Param *findParam(unsigned long iIndex) const
 		{ return m_params.value(iIndex, nullptr); }
 
+	typedef QHash<qtractorSubject *, Param *> ParamSubjects;
+
+	Param *findParamSubject(qtractorSubject *pSubject) const
+		{ return m_paramSubjects.value(pSubject, nullptr); }
+
+	// Sample-accurate automation curve list,
+	// only while playing back (RT-safe).
+	qtractorCurveList *processCurveList() const;
+
+	// Whether a parameter is being automated
+	// from within the process cycle (sample-accurate).
+	bool isProcessCurve(Param *pParam) const;
+
 	// Last updated parameter accessors.
 	void setLastUpdatedParam(Param *pLastUpdatedParam)
 		{ m_pLastUpdatedParam = pLastUpdatedParam; }
@@ -370,6 +384,9 @@ public:
 	virtual void process(
 		float **ppIBuffer, float **ppOBuffer, unsigned int nframes);
 
+	// Idle sleep, instead of processing (RT-safe).
+	virtual void process_idle(unsigned int /*nframes*/) {}
+
 	// Parameter update method.
 	virtual void updateParam(
 		Param */*pParam*/, float /*fValue*/, bool /*bUpdate*/) {}
@@ -420,6 +437,48 @@ public:
 	virtual unsigned long latency() const
 		{ return 0; }
 
+	// Plugin current tail (in frames), for how long output
+	// may still be non-silent after input silence begins;
+	// negative when unknown (RT-safe).
+	virtual long tail() const
+		{ return -1; }
+
+	// Silence detection and idle sleep (RT-safe).
+	void setSilentIn(bool bSilentIn)
+		{ m_bSilentIn = bSilentIn; }
+	bool isSilentIn() const
+		{ return m_bSilentIn; }
+
+	bool isIdle() const
+		{ return m_bIdle; }
+	void resetIdle()
+		{ m_iSilentFrames = 0; m_bIdle = false; }
+
+	// Whether this plugin may go idle at all.
+	bool canBeIdle() const;
+
+	// Whether this plugin must not run concurrently with any other
+	// (parallel graph opt-out, either by format or user listed).
+	bool isGraphSerial() const
+		{ return m_bGraphSerial; }
+
+	// Parallel graph opt-out list (plugin names or file names).
+	static void setGraphSerialPlugins(const QStringList& plugins);
+	static const QStringList& graphSerialPlugins();
+
+	// Update idle state, after processing a silent (or not) input;
+	// returns whether the output is digital silence too (RT-safe).
+	bool updateIdle(float **ppOBuffer, unsigned int nframes,
+		unsigned long iIdleFrames);
+
+	// Digital silence predicate (RT-safe).
+	static bool isSilentBuffer(float **ppBuffer,
+		unsigned short iChannels, unsigned int nframes);
+
+	// Process call timing statistics.
+	qtractorDspLoad *dspLoad()
+		{ return &m_dspLoad; }
+
 	// GUI Editor stuff.
 	virtual void openEditor(QWidget */*pParent*/= nullptr) {}
 	virtual void closeEditor() {};
@@ -628,6 +687,22 @@ protected:
 	// Internal deactivation cleanup.
 	void cleanup();
 
+	// Sample-accurate automation, sub-block split processing.
+	void process_split(
+		float **ppIBuffer, float **ppOBuffer, unsigned int nframes);
+
+	// Sub-block processing procedure (plain control ports).
+	virtual void process_block(
+		float **/*ppIBuffer*/, float **/*ppOBuffer*/, unsigned int /*nframes*/) {}
+
+	// Sample-accurate automation, intra-cycle parameter point walk;
+	// returns whether there's any automation curve being processed.
+	bool process_curves(unsigned int nframes);
+
+	// Intra-cycle parameter point procedure (offset in frames).
+	virtual void process_curve(
+		Param */*pParam*/, float /*fValue*/, unsigned int /*iOffset*/) {}
+
 	// Plugin configure and parameter/state clearance.
 	void clearConfigs() { m_configs.clear(); m_ctypes.clear(); }
 	void clearValues()  { m_values.names.clear(); m_values.index.clear(); }
@@ -691,9 +766,17 @@ private:
 	// List of parameters (by name).
 	ParamNames m_paramNames;
 
+	// List of parameters (by subject).
+	ParamSubjects m_paramSubjects;
+
 	// Last updated parameter.
 	Param *m_pLastUpdatedParam;
 
+	// Sub-block split processing buffer pointers (scratch).
+	unsigned short m_iSplitChannels;
+	float **m_ppIBufferSplit;
+	float **m_ppOBufferSplit;
+
 	// List of  properties (also parameters).
 	Properties m_properties;
 
@@ -731,6 +814,19 @@ private:
 	// Direct access parameter, if any.
 	long m_iDirectAccessParamIndex;
 
+	// Silence detection and idle sleep state.
+	unsigned long m_iSilentFrames;
+	volatile bool m_bSilentIn;
+	volatile bool m_bIdle;
+
+	// Parallel graph opt-out state.
+	bool m_bGraphSerial;
+
+	static QStringList g_graphSerialPlugins;
+
+	// Process call timing statistics.
+	qtractorDspLoad m_dspLoad;
+
 	// Default preset name.
 	static QString g_sDefPreset;
 };
@@ -1004,6 +1100,12 @@ public:
 	// The meta-main audio-processing plugin-chain procedure.
 	void process(float **ppBuffer, unsigned int nframes);
 
+	// Idle plugin calls skipped since last asked (all chains).
+	static unsigned int takeIdleSkipCount();
+
+	// Wake up all idle plugins, on transport changes (all chains).
+	static void resetIdleAll();
+
 	// Forward declarations.
 	class Document;
 	class WaitCursor;
@@ -1102,6 +1204,22 @@ public:
 	bool isAudioInsertActivated() const
 		{ return (m_iAudioInsertActivated > 0); }
 
+	// Special audio aux-sends activation state methods.
+	void setAudioAuxSendActivated(bool bAudioAuxSendActivated)
+	{
+		if (bAudioAuxSendActivated)
+			++m_iAudioAuxSendActivated;
+		else
+		if (m_iAudioAuxSendActivated > 0)
+			--m_iAudioAuxSendActivated;
+	}
+
+	bool isAudioAuxSendActivated() const
+		{ return (m_iAudioAuxSendActivated > 0); }
+
+	// Whether any plugin must not run concurrently (parallel graph).
+	bool isGraphSerial() const;
+
 	// Special auto-deactivate methods
 	void autoDeactivatePlugins(bool bDeactivated, bool bForce = false);
 	bool isAutoDeactivated() const;
@@ -1162,6 +1280,9 @@ private:
 	// Audio inserts activation state.
 	unsigned int m_iAudioInsertActivated;
 
+	// Audio aux-sends activation state.
+	unsigned int m_iAudioAuxSendActivated;
+
 	// Internal running buffer chain references.
 	float **m_pppBuffers[2];
 
@@ -1180,6 +1301,9 @@ private:
 	// Plugin chain total latency (in frames);
 	bool          m_bLatency;
 	unsigned long m_iLatency;
+
+	// Idle wake-up serial (last seen).
+	int m_iIdleSerial;
 };
 
 
@@ -46,7 +46,11 @@
 
 #include "qtractorOptions.h"
 
+#include "qtractorMainForm.h"
+
 #include <QApplication>
+#include <QThread>
+#include <QTimer>
 
 #include <QLibrary>
 #include <QTextStream>
@@ -68,6 +72,16 @@
 #endif
 
 
+// Out-of-process scan progress poll period (msecs).
+static const int c_iScanPollMsecs = 200;
+
+// Out-of-process scan time limit, per plugin file (msecs).
+static const int c_iScanTimeout = 30000;
+
+// Slow plugin file scan time report threshold (msecs).
+static const int c_iSlowScanTime = 1000;
+
+
 //----------------------------------------------------------------------------
 // qtractorPluginFactory -- Plugin path helper.
 //
@@ -111,10 +125,14 @@ qtractorPluginFactory::qtractorPluginFactory ( QObject *pParent )
 	//m_blacklist.clear();
 	QFile data_file(blacklistDataFilePath());
 	if (data_file.exists())
-		readBlacklist(data_file);
+		readBlacklist(data_file, m_blacklist);
+
+	// In-flight scans on a previous crash were all out-of-process,
+	// several at once, thus not necessarily the culprits: these
+	// are not blacklisted but just reported on next scan...
 	QFile temp_file(blacklistTempFilePath());
 	if (temp_file.exists()) {
-		readBlacklist(temp_file);
+		readBlacklist(temp_file, m_crashFiles);
 		temp_file.remove();
 	}
 
@@ -447,7 +465,8 @@ QString qtractorPluginFactory::blacklistDataFilePath (void) const
 
 
 // Read from file and append to blacklist.
-bool qtractorPluginFactory::readBlacklist (	QFile& file )
+bool qtractorPluginFactory::readBlacklist (
+	QFile& file, QStringList& blacklist ) const
 {
 	if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
 		return false;
@@ -457,7 +476,7 @@ bool qtractorPluginFactory::readBlacklist (	QFile& file )
 		const QString& line = sin.readLine();
 		if (line.isEmpty())
 			continue;
-		m_blacklist.append(line);
+		blacklist.append(line);
 	}
 	file.close();
 
@@ -485,58 +504,35 @@ bool qtractorPluginFactory::writeBlacklist (
 // Generic plugin-scan factory method.
 int qtractorPluginFactory::startScan ( qtractorPluginType::Hint typeHint )
 {
-	qtractorOptions *pOptions = qtractorOptions::getInstance();
-	if (pOptions == nullptr)
-		return 0;
-
-	int iDummyPluginHash = 0;
-
-	switch (typeHint) {
-	case qtractorPluginType::Ladspa:
-		iDummyPluginHash = pOptions->iDummyLadspaHash;
-		break;
-	case qtractorPluginType::Dssi:
-		iDummyPluginHash = pOptions->iDummyDssiHash;
-		break;
-	case qtractorPluginType::Vst2:
-		iDummyPluginHash = pOptions->iDummyVst2Hash;
-		break;
-	case qtractorPluginType::Vst3:
-		iDummyPluginHash = pOptions->iDummyVst3Hash;
-		break;
-	case qtractorPluginType::Clap:
-		iDummyPluginHash = pOptions->iDummyClapHash;
-		break;
-	case qtractorPluginType::Lv2:
-		iDummyPluginHash = pOptions->iDummyLv2Hash;
-		break;
-	default:
-		break;
-	}
-
 	const QString& sCacheFilePath = m_cacheFilePaths.value(typeHint);
 	if (sCacheFilePath.isEmpty())
 		return 0;
 
 	Scanner *pScanner = new Scanner(typeHint, this);
-	if (!pScanner->open(sCacheFilePath, iDummyPluginHash))
+	if (!pScanner->open(sCacheFilePath, m_bRescan)) {
+		delete pScanner;
 		return 0;
+	}
 
 	m_scanners.insert(typeHint, pScanner);
 
-	QStringList& files = m_files[typeHint];
-	files.append(pScanner->files());
-#ifdef CONFIG_LV2
-	if (typeHint == qtractorPluginType::Lv2)
-		files.clear();
-#endif
-	int iFileCount = files.count();
-	if (m_bRescan || iFileCount == 0) {
-		m_bRescan = false;
-		iFileCount += addFiles(typeHint, pluginPaths(typeHint));
-	}
+	// Always look after all plugin files, as
+	// only new or changed ones get actually scanned...
+	return addFiles(typeHint, pluginPaths(typeHint));
+}
 
-	return iFileCount;
+
+// Number of plugin files still being scanned (out-of-process).
+int qtractorPluginFactory::pendingScan (void) const
+{
+	int iPending = 0;
+
+	Scanners::ConstIterator iter = m_scanners.constBegin();
+	const Scanners::ConstIterator& iter_end = m_scanners.constEnd();
+	for ( ; iter != iter_end; ++iter)
+		iPending += iter.value()->pending();
+
+	return iPending;
 }
 
 
@@ -592,7 +588,10 @@ void qtractorPluginFactory::scan (void)
 	}
 #endif
 
-	// Do the real scan...
+	m_bRescan = false;
+
+	// Do the real scan: cached files get listed right away,
+	// new or changed ones are queued for parallel scanning...
 	int iFile = 0;
 	Paths::ConstIterator files_iter = m_files.constBegin();
 	const Paths::ConstIterator& files_end = m_files.constEnd();
@@ -601,12 +600,62 @@ void qtractorPluginFactory::scan (void)
 		QStringListIterator file_iter(files_iter.value());
 		while (file_iter.hasNext()) {
 			addTypes(typeHint, file_iter.next());
-			emit scanned((++iFile * 100) / iFileCount);
+			emit scanned((++iFile - pendingScan()) * 100 / iFileCount);
 			QApplication::processEvents(
 				QEventLoop::ExcludeUserInputEvents);
 		}
 	}
 
+	// Wait for the parallel (out-of-process) scans to finish...
+	QTimer timer;
+	timer.start(c_iScanPollMsecs);
+	int iPending = pendingScan();
+	while (iPending > 0) {
+		QApplication::processEvents(
+			QEventLoop::ExcludeUserInputEvents |
+			QEventLoop::WaitForMoreEvents);
+		Scanners::ConstIterator iter = m_scanners.constBegin();
+		const Scanners::ConstIterator& iter_end = m_scanners.constEnd();
+		for ( ; iter != iter_end; ++iter)
+			iter.value()->timeout(c_iScanTimeout);
+		iPending = pendingScan();
+		emit scanned((iFile - iPending) * 100 / iFileCount);
+	}
+	timer.stop();
+
+	// Report the slowest plugin files, if any...
+	if (!m_slowFiles.isEmpty()) {
+		qtractorMainForm *pMainForm = qtractorMainForm::getInstance();
+		QStringListIterator iter(m_slowFiles);
+		while (iter.hasNext()) {
+			const QString& sFilename = iter.next();
+			const QString& sText
+				= tr("Plugin scan: \"%1\" took %2 msecs.")
+				.arg(sFilename).arg(m_scanTimes.value(sFilename));
+			if (pMainForm)
+				pMainForm->appendMessages(sText);
+			else
+				QTextStream(stderr) << sText << endl;
+		}
+		m_slowFiles.clear();
+	}
+
+	// Report in-flight plugin files on a previous crash, if any...
+	if (!m_crashFiles.isEmpty()) {
+		qtractorMainForm *pMainForm = qtractorMainForm::getInstance();
+		QStringListIterator iter(m_crashFiles);
+		while (iter.hasNext()) {
+			const QString& sText
+				= tr("Plugin scan: \"%1\" was being scanned on a previous crash"
+				" (not blacklisted).").arg(iter.next());
+			if (pMainForm)
+				pMainForm->appendMessagesColor(sText, Qt::darkYellow);
+			else
+				QTextStream(stderr) << sText << endl;
+		}
+		m_crashFiles.clear();
+	}
+
 	// Done.
 	reset();
 }
@@ -677,6 +726,7 @@ void qtractorPluginFactory::clearAll ( qtractorPluginType::Hint typeHint )
 			if (!sCacheFilePath.isEmpty())
 				QFile::remove(sCacheFilePath);
 		}
+		m_scanTimes.clear();
 	} else {
 		const QString& sCacheFilePath = m_cacheFilePaths.value(typeHint);
 		if (!sCacheFilePath.isEmpty())
@@ -876,12 +926,67 @@ bool qtractorPluginFactory::addTypes (
 	// Try first out-of-process scans, if any...
 	Scanner *pScanner = m_scanners.value(typeHint, nullptr);
 	if (pScanner)
-		return pScanner->addTypes(typeHint, sFilename);
+		return pScanner->addTypes(sFilename);
 	else
 		return false;
 }
 
 
+// In-flight scan files: should we crash while scanning,
+// these will get reported on next run...
+void qtractorPluginFactory::beginProbe ( const QString& sFilename )
+{
+	m_probes.append(sFilename);
+
+	QFile temp_file(blacklistTempFilePath());
+	writeBlacklist(temp_file, m_probes);
+}
+
+
+void qtractorPluginFactory::endProbe (
+	const QString& sFilename, bool bBlacklist )
+{
+	m_probes.removeAll(sFilename);
+
+	QFile temp_file(blacklistTempFilePath());
+	if (m_probes.isEmpty())
+		temp_file.remove();
+	else
+		writeBlacklist(temp_file, m_probes);
+
+	// Crashed or hung scans get blacklisted right away...
+	if (bBlacklist && !m_blacklist.contains(sFilename)) {
+		m_blacklist.append(sFilename);
+		const QString& sText
+			= tr("Plugin scan: \"%1\" crashed or timed out (blacklisted).")
+			.arg(sFilename);
+		qtractorMainForm *pMainForm = qtractorMainForm::getInstance();
+		if (pMainForm)
+			pMainForm->appendMessagesColor(sText, Qt::red);
+		else
+			QTextStream(stderr) << sText << endl;
+	}
+}
+
+
+// Plugin file scan time registry.
+void qtractorPluginFactory::setScanTime (
+	const QString& sFilename, int iScanTime, bool bProbed )
+{
+	m_scanTimes.insert(sFilename, iScanTime);
+
+	if (bProbed && iScanTime >= c_iSlowScanTime)
+		m_slowFiles.append(sFilename);
+}
+
+
+// Last known plugin file scan time (msecs; -1 if unknown).
+int qtractorPluginFactory::scanTime ( const QString& sFilename ) const
+{
+	return m_scanTimes.value(sFilename, -1);
+}
+
+
 // Plugin type listing method.
 bool qtractorPluginFactory::addTypes (
 	qtractorPluginType::Hint typeHint,
@@ -940,218 +1045,201 @@ bool qtractorPluginFactory::addTypes (
 
 
 //----------------------------------------------------------------------------
-// qtractorPluginFactory::Scanner -- Plugin path proxy (out-of-process client).
+// qtractorPluginFactory::Scanner -- Plugin scan cache and worker pool.
 //
 
 // Constructor.
 qtractorPluginFactory::Scanner::Scanner (
-	qtractorPluginType::Hint typeHint, QObject *pParent )
-		: QProcess(pParent), m_typeHint(typeHint),
-			m_iExitStatus(-1), m_iDummyPluginHash(0)
+	qtractorPluginType::Hint typeHint, qtractorPluginFactory *pPluginFactory )
+		: QObject(pPluginFactory), m_typeHint(typeHint),
+			m_pPluginFactory(pPluginFactory), m_bRescan(false),
+			m_iMaxWorkers(1), m_iDummyPluginHash(0)
 {
-	QObject::connect(this,
-		SIGNAL(readyReadStandardOutput()),
-		SLOT(stdout_slot()));
-	QObject::connect(this,
-		SIGNAL(readyReadStandardError()),
-		SLOT(stderr_slot()));
-	QObject::connect(this,
-		SIGNAL(finished(int, QProcess::ExitStatus)),
-		SLOT(exit_slot(int, QProcess::ExitStatus)));
+	qtractorOptions *pOptions = qtractorOptions::getInstance();
+	if (pOptions)
+		m_iMaxWorkers = pOptions->iPluginScanThreads;
+	if (m_iMaxWorkers < 0)
+		m_iMaxWorkers = QThread::idealThreadCount();
+	if (m_iMaxWorkers < 1)
+		m_iMaxWorkers = 1;
 }
 
 
 // Open/start method.
 bool qtractorPluginFactory::Scanner::open (
-	const QString& sCacheFilePath, int iDummyPluginHash )
+	const QString& sCacheFilePath, bool bRescan )
 {
 	// Cache file setup...
-	m_file.setFileName(sCacheFilePath);
-	m_list.clear();
+	m_sCacheFilePath = sCacheFilePath;
+	m_bRescan = bRescan;
+
+	m_items.clear();
+	m_queue.clear();
 
-	// Open and read cache file, whether applicable...
 	m_iDummyPluginHash = 0;
 
-	if (m_file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+	// Open and read cache file, whether applicable...
+	QFile file(m_sCacheFilePath);
+	if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
 		// Read from cache...
-		QTextStream sin(&m_file);
+		QTextStream sin(&file);
 		while (!sin.atEnd()) {
 			const QString& sText = sin.readLine();
 			if (sText.isEmpty())
 				continue;
 			const QStringList& props = sText.split('|');
-			if (props.count() >= 6) { // get filename...
-				m_list[props.at(6)].append(sText);
-				++m_iDummyPluginHash;
+			if (props.at(0) == "FILE") { // get file stamp...
+				if (props.count() > 4) {
+					Item& item = m_items[props.at(1)];
+					item.mtime = props.at(2).toLongLong();
+					item.size  = props.at(3).toLongLong();
+					item.msecs = props.at(4).toInt();
+				}
 			}
+			else
+			if (props.count() > 6) // get filename...
+				m_items[props.at(6)].list.append(sText);
 		}
 		// May close the file.
-		m_file.close();
-	}
-
-	if (iDummyPluginHash > 0 && iDummyPluginHash == m_iDummyPluginHash)
-		return true;
-
-	// Re-open cache file for update...
-	if (!m_file.open(QIODevice::Append | QIODevice::Text)) {
-		// Make sure cache file location do exists...
-		const QFileInfo fi(m_file);
-		if (!fi.dir().mkpath(fi.absolutePath()))
-			return false;
-		// Open cache file for writing...
-		if (!m_file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate))
-			return false;
+		file.close();
 	}
 
-	// LV2 plugins are dang special,
-	// need no out-of-process scanning whatsoever...
-	if (m_typeHint == qtractorPluginType::Lv2) {
-		m_iExitStatus = 0;
-		return true;
-	}
-
-	// Go go go...
-	return start();
+	// Make sure cache file location do exists...
+	const QFileInfo fi(file);
+	return fi.dir().mkpath(fi.absolutePath());
 }
 
 
 // Close/stop method.
 void qtractorPluginFactory::Scanner::close (void)
 {
-	// We're we scanning hard?...
-	if (QProcess::state() != QProcess::NotRunning || m_iExitStatus < 0) {
-		QProcess::closeWriteChannel();
-		while (QProcess::state() != QProcess::NotRunning)
-			QProcess::waitForFinished(200);
+	// Stop all workers, hard...
+	QListIterator<Worker *> iter(m_workers);
+	while (iter.hasNext()) {
+		Worker *pWorker = iter.next();
+		if (!pWorker->isIdle()) {
+			m_pPluginFactory->endProbe(pWorker->abort());
+		}
+		else
+		if (pWorker->state() != QProcess::NotRunning) {
+			pWorker->closeWriteChannel();
+			if (!pWorker->waitForFinished(200))
+				pWorker->kill();
+		}
 	}
 
-	// Done anyway.
-	QProcess::terminate();
+	qDeleteAll(m_workers);
+	m_workers.clear();
 
-	// Close cache file...
-	if (m_file.isOpen())
-		m_file.close();
-
-	// Cleanup cache...
-	m_list.clear();
-}
-
-
-// Scan start method.
-bool qtractorPluginFactory::Scanner::start (void)
-{
-	// Maybe we're still running, doh!
-	if (QProcess::state() != QProcess::NotRunning)
-		return false;
+	m_queue.clear();
 
-	// Start from scratch...
-	m_iExitStatus = -1;
+	// Rewrite the cache file, only with what's still there...
+	m_iDummyPluginHash = 0;
 
-	// Get the main scanner executable...
-	const QString sName("qtractor_plugin_scan");
-	QString sLibPath = QApplication::applicationDirPath();
-	QFileInfo fi(sLibPath, sName);
-	if (!fi.isExecutable()) {
-		sLibPath.remove(CONFIG_BINDIR);
-		sLibPath.append(CONFIG_LIBDIR);
-		sLibPath.append(QDir::separator());
-		sLibPath.append(PROJECT_NAME);
-		fi = QFileInfo(sLibPath, sName);
+	QFile file(m_sCacheFilePath);
+	if (file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
+		QTextStream sout(&file);
+		QHash<QString, Item>::ConstIterator item_iter = m_items.constBegin();
+		const QHash<QString, Item>::ConstIterator& item_end = m_items.constEnd();
+		for ( ; item_iter != item_end; ++item_iter) {
+			const Item& item = item_iter.value();
+			if (!item.seen)
+				continue;
+			if (m_typeHint != qtractorPluginType::Lv2) {
+				sout << "FILE|" << item_iter.key() << '|';
+				sout << item.mtime << '|' << item.size << '|';
+				sout << item.msecs << endl;
+			}
+			QStringListIterator list_iter(item.list);
+			while (list_iter.hasNext()) {
+				sout << list_iter.next() << endl;
+				++m_iDummyPluginHash;
+			}
+		}
+		file.close();
 	}
 
-	if (!fi.isExecutable())
-		return false;
-
-	// Go go go!
-	QProcess::start(fi.filePath(), QStringList());
-	return true;
+	// Cleanup cache...
+	m_items.clear();
 }
 
 
-// Service slots.
-void qtractorPluginFactory::Scanner::stdout_slot (void)
+// Cache file stamp predicate.
+bool qtractorPluginFactory::Scanner::isCached ( const QString& sFilename ) const
 {
-	qtractorPluginFactory *pPluginFactory
-		= static_cast<qtractorPluginFactory *> (QObject::parent());
-	if (pPluginFactory == nullptr)
-		return;
-
-	const QString sData(QProcess::readAllStandardOutput());
-	addTypes(sData.split('\n'), true);
-}
-
+	if (!m_items.contains(sFilename))
+		return false;
 
-void qtractorPluginFactory::Scanner::stderr_slot (void)
-{
-	QTextStream(stderr) << QProcess::readAllStandardError();
-}
+	const Item& item = m_items[sFilename];
 
+	// Files with no plugins are scanned again on rescan...
+	if (item.list.isEmpty() && m_bRescan)
+		return false;
 
-void qtractorPluginFactory::Scanner::exit_slot (
-	int exitCode, QProcess::ExitStatus exitStatus )
-{
-	if (m_iExitStatus < 0)
-		m_iExitStatus = 0;
+#ifdef CONFIG_LV2
+	// LV2 plugins are dang special...
+	if (m_typeHint == qtractorPluginType::Lv2)
+		return !item.list.isEmpty();
+#endif
 
-	if (exitCode || exitStatus != QProcess::NormalExit)
-		++m_iExitStatus;
+	// Same modification time and size, same plugins...
+	const QFileInfo fi(sFilename);
+	return fi.exists()
+		&& fi.size() == item.size
+		&& fi.lastModified().toMSecsSinceEpoch() == item.mtime;
 }
 
 
 // Service methods.
-bool qtractorPluginFactory::Scanner::addTypes (
-	qtractorPluginType::Hint typeHint, const QString& sFilename )
+bool qtractorPluginFactory::Scanner::addTypes ( const QString& sFilename )
 {
 	// See if it's already cached in...
-	const QStringList& list = m_list.value(sFilename);
-	if (!list.isEmpty() && (
-	#ifdef CONFIG_LV2
-		m_typeHint == qtractorPluginType::Lv2 ||
-	#endif
-		QFileInfo(sFilename).exists())) {
-		return addTypes(list, false);
+	if (isCached(sFilename)) {
+		Item& item = m_items[sFilename];
+		item.seen = true;
+		m_pPluginFactory->setScanTime(sFilename, item.msecs);
+		return addTypes(item.list);
 	}
 
-	// If cache file isn't open for update
-	// there's no use to run any further...
-	if (!m_file.isOpen())
-		return false;
-
-	qtractorPluginFactory *pPluginFactory
-		= static_cast<qtractorPluginFactory *> (QObject::parent());
-	if (pPluginFactory == nullptr)
-		return false;
-
 #ifdef CONFIG_LV2
-	// LV2 plugins are dang special...
-	if (typeHint == qtractorPluginType::Lv2) {
+	// LV2 plugins are dang special,
+	// need no out-of-process scanning whatsoever...
+	if (m_typeHint == qtractorPluginType::Lv2) {
+		m_items.remove(sFilename);
+		QElapsedTimer timer;
+		timer.start();
 		qtractorPluginType *pType
 			= qtractorLv2PluginType::createType(sFilename);
 		if (pType == nullptr)
 			return false;
 		if (pType->open()) {
-			pPluginFactory->addType(pType);
+			m_pPluginFactory->addType(pType);
 			pType->close();
 			// Cache out...
-			if (m_file.isOpen()) {
-				QTextStream sout(&m_file);
-				sout << "LV2|";
-				sout << pType->name() << '|';
-				sout << pType->audioIns()   << ':' << pType->audioOuts()   << '|';
-				sout << pType->midiIns()    << ':' << pType->midiOuts()    << '|';
-				sout << pType->controlIns() << ':' << pType->controlOuts() << '|';
-				QStringList flags;
-				if (pType->isEditor())
-					flags.append("GUI");
-				if (pType->isConfigure())
-					flags.append("EXT");
-				if (pType->isRealtime())
-					flags.append("RT");
-				sout << flags.join(",") << '|';
-				sout << sFilename << '|' << 0 << '|';
-				sout << "0x" << QString::number(pType->uniqueID(), 16) << endl;
-				++m_iDummyPluginHash;
-			}
+			QStringList flags;
+			if (pType->isEditor())
+				flags.append("GUI");
+			if (pType->isConfigure())
+				flags.append("EXT");
+			if (pType->isRealtime())
+				flags.append("RT");
+			QString sText = "LV2|";
+			sText += pType->name() + '|';
+			sText += QString::number(pType->audioIns()) + ':'
+				+ QString::number(pType->audioOuts()) + '|';
+			sText += QString::number(pType->midiIns()) + ':'
+				+ QString::number(pType->midiOuts()) + '|';
+			sText += QString::number(pType->controlIns()) + ':'
+				+ QString::number(pType->controlOuts()) + '|';
+			sText += flags.join(",") + '|';
+			sText += sFilename + '|' + QString::number(0) + '|';
+			sText += "0x" + QString::number(pType->uniqueID(), 16);
+			const int iScanTime = int(timer.elapsed());
+			Item& item = m_items[sFilename];
+			item.msecs = iScanTime;
+			item.seen  = true;
+			item.list.append(sText);
+			m_pPluginFactory->setScanTime(sFilename, iScanTime, true);
 			// Success.
 			return true;
 		} else {
@@ -1162,45 +1250,20 @@ bool qtractorPluginFactory::Scanner::addTypes (
 	}
 #endif
 
-	// Add to temporary blacklist...
-	QFile temp_file(pPluginFactory->blacklistTempFilePath());
-	if (temp_file.exists())
-		pPluginFactory->readBlacklist(temp_file);
-	pPluginFactory->writeBlacklist(temp_file, QStringList() << sFilename);
+	// Not cached, yet: queue for out-of-process scan...
+	m_items.remove(sFilename);
+	m_queue.append(sFilename);
 
-	// Not cached, yet...
-	const QString& sHint = qtractorPluginType::textFromHint(typeHint);
-	const QString& sLine = sHint + ':' + sFilename + '\n';
-	const QByteArray& data = sLine.toUtf8();
-
-	bool bResult = (QProcess::write(data) == data.size());
+	dispatch();
 
-	// Check for hideous scan crashes...
-	if (!QProcess::waitForReadyRead(3000)) {
-		if (m_iExitStatus > 0) {
-			QProcess::waitForFinished(200);
-			start(); // Restart the crashed scan...
-			QProcess::waitForStarted(200);
-			bResult = false;
-		}
-	}
-
-	// If it reaches here safely, then there's
-	// no use to temporary blacklist anymore...
-	if (bResult)
-		temp_file.remove();
-
-	return bResult;
+	return true;
 }
 
 
 bool qtractorPluginFactory::Scanner::addTypes (
-	const QStringList& list, bool bDummyPluginType )
+	const QStringList& list, QStringList *pList )
 {
-	qtractorPluginFactory *pPluginFactory
-		= static_cast<qtractorPluginFactory *> (QObject::parent());
-	if (pPluginFactory == nullptr)
-		return false;
+	bool bResult = false;
 
 	QStringListIterator iter(list);
 	while (iter.hasNext()) {
@@ -1210,27 +1273,124 @@ bool qtractorPluginFactory::Scanner::addTypes (
 		qtractorPluginType *pType = qtractorDummyPluginType::createType(sText);
 		if (pType) {
 			// Brand new type, add to inventory...
-			pPluginFactory->addType(pType);
+			m_pPluginFactory->addType(pType);
 			// Cache in...
-			if (bDummyPluginType && m_file.isOpen()) {
-				QTextStream(&m_file) << sText << endl;
-				++m_iDummyPluginHash;
-			}
+			if (pList)
+				pList->append(sText);
 			// Done.
+			bResult = true;
 		} else {
 			// Possibly some mistake occurred...
 			QTextStream(stderr) << sText << endl;
 		}
 	}
 
-	return true;
+	return bResult;
+}
+
+
+// Feed idle workers with queued files.
+void qtractorPluginFactory::Scanner::dispatch (void)
+{
+	// Idle workers first...
+	QListIterator<Worker *> iter(m_workers);
+	while (iter.hasNext() && !m_queue.isEmpty()) {
+		Worker *pWorker = iter.next();
+		if (!pWorker->isIdle())
+			continue;
+		// Restart any crashed one...
+		if (pWorker->state() == QProcess::NotRunning && !pWorker->start())
+			continue;
+		const QString sFilename = m_queue.takeFirst();
+		m_pPluginFactory->beginProbe(sFilename);
+		if (!pWorker->probe(sFilename))
+			m_pPluginFactory->endProbe(sFilename);
+	}
+
+	// Spawn new workers, if still needed and allowed...
+	while (!m_queue.isEmpty() && m_workers.count() < m_iMaxWorkers) {
+		Worker *pWorker = new Worker(this);
+		if (!pWorker->start()) {
+			delete pWorker;
+			break;
+		}
+		m_workers.append(pWorker);
+		const QString sFilename = m_queue.takeFirst();
+		m_pPluginFactory->beginProbe(sFilename);
+		if (!pWorker->probe(sFilename))
+			m_pPluginFactory->endProbe(sFilename);
+	}
+
+	// No worker can be started whatsoever?
+	bool bAlive = false;
+	QListIterator<Worker *> iter2(m_workers);
+	while (iter2.hasNext() && !bAlive)
+		bAlive = (iter2.next()->state() != QProcess::NotRunning);
+	if (!bAlive)
+		m_queue.clear();
+}
+
+
+// Number of files still queued or being scanned.
+int qtractorPluginFactory::Scanner::pending (void) const
+{
+	int iPending = m_queue.count();
+
+	QListIterator<Worker *> iter(m_workers);
+	while (iter.hasNext()) {
+		if (!iter.next()->isIdle())
+			++iPending;
+	}
+
+	return iPending;
 }
 
 
-// Cached files accessor.
-QStringList qtractorPluginFactory::Scanner::files (void) const
+// Kill any scan taking way too long (msecs).
+void qtractorPluginFactory::Scanner::timeout ( int iTimeout )
 {
-	return m_list.keys();
+	QListIterator<Worker *> iter(m_workers);
+	while (iter.hasNext()) {
+		Worker *pWorker = iter.next();
+		const int iScanTime = pWorker->elapsed();
+		if (!pWorker->isIdle() && iScanTime > iTimeout)
+			probeFailed(pWorker->abort(), iScanTime);
+	}
+}
+
+
+// Worker scan results.
+void qtractorPluginFactory::Scanner::probeDone (
+	const QString& sFilename, int iScanTime, const QStringList& list )
+{
+	m_pPluginFactory->endProbe(sFilename);
+
+	QStringList valid;
+	addTypes(list, &valid);
+
+	const QFileInfo fi(sFilename);
+	Item& item = m_items[sFilename];
+	item.mtime = fi.lastModified().toMSecsSinceEpoch();
+	item.size  = fi.size();
+	item.msecs = iScanTime;
+	item.seen  = true;
+	item.list  = valid;
+
+	m_pPluginFactory->setScanTime(sFilename, iScanTime, true);
+
+	dispatch();
+}
+
+
+void qtractorPluginFactory::Scanner::probeFailed (
+	const QString& sFilename, int iScanTime )
+{
+	m_pPluginFactory->endProbe(sFilename, true);
+	m_items.remove(sFilename);
+
+	m_pPluginFactory->setScanTime(sFilename, iScanTime, true);
+
+	dispatch();
 }
 
 
@@ -1241,6 +1401,145 @@ int qtractorPluginFactory::Scanner::dummyPluginHash (void) const
 }
 
 
+//----------------------------------------------------------------------------
+// qtractorPluginFactory::Worker -- Plugin scan proxy (out-of-process client).
+//
+
+// Constructor.
+qtractorPluginFactory::Worker::Worker ( Scanner *pScanner )
+	: QProcess(pScanner), m_pScanner(pScanner)
+{
+	QObject::connect(this,
+		SIGNAL(readyReadStandardOutput()),
+		SLOT(stdout_slot()));
+	QObject::connect(this,
+		SIGNAL(readyReadStandardError()),
+		SLOT(stderr_slot()));
+	QObject::connect(this,
+		SIGNAL(finished(int, QProcess::ExitStatus)),
+		SLOT(exit_slot(int, QProcess::ExitStatus)));
+}
+
+
+// Scan start method.
+bool qtractorPluginFactory::Worker::start (void)
+{
+	// Maybe we're still running, doh!
+	if (QProcess::state() != QProcess::NotRunning)
+		return false;
+
+	// Start from scratch...
+	m_data.clear();
+
+	// Get the main scanner executable...
+	const QString sName("qtractor_plugin_scan");
+	QString sLibPath = QApplication::applicationDirPath();
+	QFileInfo fi(sLibPath, sName);
+	if (!fi.isExecutable()) {
+		sLibPath.remove(CONFIG_BINDIR);
+		sLibPath.append(CONFIG_LIBDIR);
+		sLibPath.append(QDir::separator());
+		sLibPath.append(PROJECT_NAME);
+		fi = QFileInfo(sLibPath, sName);
+	}
+
+	if (!fi.isExecutable())
+		return false;
+
+	// Go go go!
+	QProcess::start(fi.filePath(), QStringList());
+	return true;
+}
+
+
+// Service methods.
+bool qtractorPluginFactory::Worker::probe ( const QString& sFilename )
+{
+	m_sFilename = sFilename;
+	m_list.clear();
+	m_timer.start();
+
+	const QString& sHint
+		= qtractorPluginType::textFromHint(m_pScanner->typeHint());
+	const QString& sLine = sHint + ':' + sFilename + '\n';
+	const QByteArray& data = sLine.toUtf8();
+
+	if (QProcess::write(data) != data.size()) {
+		m_sFilename.clear();
+		return false;
+	}
+
+	return true;
+}
+
+
+// Abort the current scan, whatever.
+QString qtractorPluginFactory::Worker::abort (void)
+{
+	const QString sFilename = m_sFilename;
+
+	m_sFilename.clear();
+	m_list.clear();
+
+	QProcess::kill();
+	QProcess::waitForFinished(200);
+
+	return sFilename;
+}
+
+
+// Service slots.
+void qtractorPluginFactory::Worker::stdout_slot (void)
+{
+	m_data.append(QProcess::readAllStandardOutput());
+
+	int iEol = m_data.indexOf('\n');
+	while (iEol >= 0) {
+		const QString sText
+			= QString::fromUtf8(m_data.left(iEol)).simplified();
+		const bool bDone = m_data.startsWith("DONE|");
+		m_data.remove(0, iEol + 1);
+		if (bDone) {
+			// Done with this one, for sure...
+			if (!isIdle()) {
+				const QString sFilename = m_sFilename;
+				const QStringList list = m_list;
+				const int iScanTime = elapsed();
+				m_sFilename.clear();
+				m_list.clear();
+				m_pScanner->probeDone(sFilename, iScanTime, list);
+			}
+		}
+		else
+		if (!sText.isEmpty())
+			m_list.append(sText);
+		iEol = m_data.indexOf('\n');
+	}
+}
+
+
+void qtractorPluginFactory::Worker::stderr_slot (void)
+{
+	QTextStream(stderr) << QProcess::readAllStandardError();
+}
+
+
+void qtractorPluginFactory::Worker::exit_slot (
+	int /*exitCode*/, QProcess::ExitStatus /*exitStatus*/ )
+{
+	// Crashed while scanning?...
+	if (isIdle())
+		return;
+
+	const QString sFilename = m_sFilename;
+	const int iScanTime = elapsed();
+	m_sFilename.clear();
+	m_list.clear();
+
+	m_pScanner->probeFailed(sFilename, iScanTime);
+}
+
+
 //----------------------------------------------------------------------------
 // qtractorDummyPluginType -- Dummy plugin type instance.
 //
@@ -26,6 +26,7 @@
 
 #include <QProcess>
 #include <QFile>
+#include <QElapsedTimer>
 
 
 //----------------------------------------------------------------------------
@@ -87,6 +88,9 @@ public:
 	void setBlacklist(const QStringList&  blacklist);
 	const QStringList& blacklist() const;
 
+	// Last known plugin file scan time (msecs; -1 if unknown).
+	int scanTime(const QString& sFilename) const;
+
 	// Singleton instance accessor.
 	static qtractorPluginFactory *getInstance();
 
@@ -115,12 +119,23 @@ protected:
 	QString blacklistDataFilePath() const;
 
 	// Simple blacklist file I/O methods.
-	bool readBlacklist(QFile& file);
+	bool readBlacklist(QFile& file, QStringList& blacklist) const;
 	bool writeBlacklist(QFile& file, const QStringList& blacklist) const;
 
 	// Generic plugin-scan factory method.
 	int startScan(qtractorPluginType::Hint typeHint);
 
+	// Number of plugin files still being scanned (out-of-process).
+	int pendingScan() const;
+
+	// In-flight scan files (temporary list).
+	void beginProbe(const QString& sFilename);
+	void endProbe(const QString& sFilename, bool bBlacklist = false);
+
+	// Plugin file scan time registry.
+	void setScanTime(const QString& sFilename, int iScanTime,
+		bool bProbed = false);
+
 	// Plugin scan reset method.
 	void reset();
 
@@ -146,11 +161,24 @@ private:
 
 	// Scan (out-of-process) clients.
 	class Scanner;
+	class Worker;
 
 	typedef QHash<qtractorPluginType::Hint, Scanner *> Scanners;
 
 	Scanners m_scanners;
 
+	// In-flight scan files.
+	QStringList m_probes;
+
+	// Plugin file scan times (msecs).
+	QHash<QString, int> m_scanTimes;
+
+	// Slowest plugin files scanned on last scan.
+	QStringList m_slowFiles;
+
+	// In-flight scan files left over from a previous crash.
+	QStringList m_crashFiles;
+
 	typedef QHash<qtractorPluginType::Hint, QString> CacheFilePaths;
 
 	// List of active cache scan results.
@@ -162,66 +190,157 @@ private:
 
 
 //----------------------------------------------------------------------------
-// qtractorPluginFactory::Scanner -- Plugin scan proxy (out-of-process client).
+// qtractorPluginFactory::Scanner -- Plugin scan cache and worker pool.
 //
 
-class qtractorPluginFactory::Scanner : public QProcess
+class qtractorPluginFactory::Scanner : public QObject
 {
 	Q_OBJECT
 
 public:
 
 	// ctor.
-	Scanner(qtractorPluginType::Hint typeHint, QObject *pParent = nullptr);
+	Scanner(qtractorPluginType::Hint typeHint,
+		qtractorPluginFactory *pPluginFactory);
 
 	// Open/close method.
-	bool open(const QString& sCacheFilePath, int iDummyPluginHash = 0);
+	bool open(const QString& sCacheFilePath, bool bRescan = false);
 	void close();
 
 	// Service methods.
-	bool addTypes(qtractorPluginType::Hint typeHint, const QString& sFilename);
+	bool addTypes(const QString& sFilename);
+
+	// Number of files still queued or being scanned.
+	int pending() const;
 
-	// Cached files list accessor.
-	QStringList files() const;
+	// Kill any scan taking way too long (msecs).
+	void timeout(int iTimeout);
 
 	// Cache hash result.
 	int dummyPluginHash() const;
 
-protected slots:
-
-	// Service slots.
-	void stdout_slot();
-	void stderr_slot();
+	// Worker scan results.
+	void probeDone(const QString& sFilename,
+		int iScanTime, const QStringList& list);
+	void probeFailed(const QString& sFilename, int iScanTime);
 
-	void exit_slot(int exitCode, QProcess::ExitStatus exitStatus);
+	// Plugin type hint accessor.
+	qtractorPluginType::Hint typeHint() const
+		{ return m_typeHint; }
 
 protected:
 
-	// Scan start method.
-	bool start();
+	// Feed idle workers with queued files.
+	void dispatch();
 
 	// Service methods (internal)
-	bool addTypes(const QStringList& list, bool bDummyPluginType = false);
+	bool addTypes(const QStringList& list, QStringList *pList = nullptr);
+
+	// Cache file stamp predicate.
+	bool isCached(const QString& sFilename) const;
 
 private:
 
 	// Instance scanner name.
 	qtractorPluginType::Hint m_typeHint;
 
-	// Instance state.
-	volatile int m_iExitStatus;
+	// Instance factory.
+	qtractorPluginFactory *m_pPluginFactory;
+
+	// Cache file name.
+	QString m_sCacheFilePath;
+
+	// Whether files known to have no plugins are to be scanned again.
+	bool m_bRescan;
+
+	// Cache entry, per plugin file.
+	struct Item
+	{
+		Item() : mtime(-1), size(-1), msecs(-1), seen(false) {}
+
+		qint64 mtime;
+		qint64 size;
+		int    msecs;
+		bool   seen;
 
-	// Cache file object.
-	QFile m_file;
+		QStringList list;
+	};
 
 	// Cache hash list.
-	QHash<QString, QStringList> m_list;
+	QHash<QString, Item> m_items;
+
+	// Files queued for out-of-process scan.
+	QStringList m_queue;
+
+	// Out-of-process scan worker pool.
+	QList<Worker *> m_workers;
+
+	int m_iMaxWorkers;
 
 	// Cache hash result.
 	int m_iDummyPluginHash;
 };
 
 
+//----------------------------------------------------------------------------
+// qtractorPluginFactory::Worker -- Plugin scan proxy (out-of-process client).
+//
+
+class qtractorPluginFactory::Worker : public QProcess
+{
+	Q_OBJECT
+
+public:
+
+	// ctor.
+	Worker(Scanner *pScanner);
+
+	// Scan start method.
+	bool start();
+
+	// Service methods.
+	bool probe(const QString& sFilename);
+
+	// Whether not scanning anything.
+	bool isIdle() const
+		{ return m_sFilename.isEmpty(); }
+
+	// Current scan file and time elapsed (msecs).
+	const QString& filename() const
+		{ return m_sFilename; }
+	int elapsed() const
+		{ return (isIdle() ? 0 : int(m_timer.elapsed())); }
+
+	// Abort the current scan, whatever.
+	QString abort();
+
+protected slots:
+
+	// Service slots.
+	void stdout_slot();
+	void stderr_slot();
+
+	void exit_slot(int exitCode, QProcess::ExitStatus exitStatus);
+
+private:
+
+	// Instance scanner.
+	Scanner *m_pScanner;
+
+	// Current scan file.
+	QString m_sFilename;
+
+	// Current scan time.
+	QElapsedTimer m_timer;
+
+	// Partial output line buffer.
+	QByteArray m_data;
+
+	// Current scan output.
+	QStringList m_list;
+};
+
+
 //----------------------------------------------------------------------------
 // qtractorDummyPluginType -- Dummy plugin type instance.
 //
@@ -41,6 +41,10 @@
 #include "qtractorInsertPlugin.h"
 #include "qtractorMidiControlPlugin.h"
 
+#ifdef CONFIG_CLAP
+#include "qtractorClapPlugin.h"
+#endif
+
 #include <QItemDelegate>
 #include <QPainter>
 #include <QMenu>
@@ -63,6 +67,10 @@
 #include <QDrag>
 #endif
 
+#if QT_VERSION < QT_VERSION_CHECK(5, 11, 0)
+#define horizontalAdvance  width
+#endif
+
 
 //----------------------------------------------------------------------------
 // qtractorPluginListView::TinyScrollBarStyle -- Custom tiny scrollbar style.
@@ -154,9 +162,23 @@ protected:
 			pPainter->drawPixmap(rect.left() + 2,
 				rect.top() + ((rect.height() - iconSize.height()) >> 1),
 				pItem->icon().pixmap(iconSize));
-			// Draw the text...
+			// Draw the DSP load, if any...
 			rect.setLeft(iconSize.width() + 4);
 			pPainter->setPen(rgbFore);
+			if (pPlugin && qtractorDspLoad::isEnabled()) {
+				qtractorDspLoad *pDspLoad = pPlugin->dspLoad();
+				if (pDspLoad->isValid()) {
+					const QString& sDspLoad = pDspLoad->text();
+					const int iDspLoadWidth
+						= pPainter->fontMetrics().horizontalAdvance(sDspLoad) + 4;
+					if (rect.width() > (iDspLoadWidth << 1)) {
+						pPainter->drawText(rect.adjusted(0, 0, -2, 0),
+							Qt::AlignRight | Qt::AlignVCenter, sDspLoad);
+						rect.setRight(rect.right() - iDspLoadWidth);
+					}
+				}
+			}
+			// Draw the text...
 			pPainter->drawText(rect,
 				Qt::AlignLeft | Qt::AlignVCenter, pItem->text());
 			// Draw frame lines...
@@ -1446,6 +1468,26 @@ bool qtractorPluginListView::eventFilter ( QObject *pObject, QEvent *pEvent )
 								.arg(pDirectAccessParam->display()));
 						}
 					}
+				#ifdef CONFIG_CLAP
+					if (pType && pType->typeHint() == qtractorPluginType::Clap) {
+						qtractorClapPlugin *pClapPlugin
+							= static_cast<qtractorClapPlugin *> (pPlugin);
+						const unsigned long iTasks
+							= pClapPlugin->threadPoolTasks();
+						if (iTasks > 0) {
+							sToolTip.append(
+								tr("\nThread-pool: %1 tasks, %2 ms saved")
+								.arg(iTasks)
+								.arg(0.001 * pClapPlugin->threadPoolSaved(), 0, 'f', 1));
+						}
+					}
+				#endif
+					if (qtractorDspLoad::isEnabled()) {
+						const QString& sDspLoad
+							= pPlugin->dspLoad()->toolTip();
+						if (!sDspLoad.isEmpty())
+							sToolTip.append('\n' + sDspLoad);
+					}
 					QToolTip::showText(pHelpEvent->globalPos(),
 						sToolTip, pViewport);
 					return true;
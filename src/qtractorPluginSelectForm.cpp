@@ -373,6 +373,11 @@ void qtractorPluginSelectForm::refresh (void)
 			pItem->setTextAlignment(2, Qt::AlignHCenter);	// MIDI
 			pItem->setTextAlignment(3, Qt::AlignHCenter);	// Controls
 			pItem->setTextAlignment(4, Qt::AlignHCenter);	// Modes
+			const int iScanTime = pPluginFactory->scanTime(sFilename);
+			if (iScanTime >= 0) {
+				pItem->setToolTip(5,	// Path
+					tr("Scan time: %1 msecs").arg(iScanTime));
+			}
 			items.append(pItem);
 		}
 	}
@@ -24,7 +24,10 @@
 #include "qtractorSessionCursor.h"
 
 #include "qtractorAudioEngine.h"
+#include "qtractorAudioGraph.h"
 #include "qtractorAudioPeak.h"
+#include "qtractorAudioRender.h"
+#include "qtractorAudioPageCache.h"
 #include "qtractorAudioClip.h"
 
 #include "qtractorMidiEngine.h"
@@ -118,6 +121,8 @@ qtractorSession::qtractorSession (void)
 	m_pMidiEngine       = new qtractorMidiEngine(this);
 	m_pAudioEngine      = new qtractorAudioEngine(this);
 	m_pAudioPeakFactory = new qtractorAudioPeakFactory();
+	m_pAudioRenderFactory = new qtractorAudioRenderFactory();
+	m_pAudioPageCache = new qtractorAudioPageCache();
 
 	m_bAutoTimeStretch  = false;
 
@@ -135,6 +140,8 @@ qtractorSession::~qtractorSession (void)
 	close();
 	clear();
 
+	delete m_pAudioPageCache;
+	delete m_pAudioRenderFactory;
 	delete m_pAudioPeakFactory;
 	delete m_pAudioEngine;
 	delete m_pMidiEngine;
@@ -322,6 +329,8 @@ void qtractorSession::clear (void)
 	}
 
 	m_pAudioPeakFactory->cleanup();
+	m_pAudioRenderFactory->cleanup();
+	m_pAudioPageCache->clear();
 
 	qtractorMidiControl *pMidiControl = qtractorMidiControl::getInstance();
 	if (pMidiControl)
@@ -420,6 +429,12 @@ void qtractorSession::updateSession (
 				m_iSessionStart = iClipStart;
 			if (m_iSessionEnd < iClipEnd)
 				m_iSessionEnd = iClipEnd;
+			// Rebuild MIDI clip playback schedule, if stale...
+			if (pTrack->trackType() == qtractorTrack::Midi) {
+				qtractorMidiClip *pMidiClip
+					= static_cast<qtractorMidiClip *> (pClip);
+				pMidiClip->updateSchedule();
+			}
 			++i;
 		}
 		// Find the first and last automation curve frame position...
@@ -1261,6 +1276,9 @@ void qtractorSession::setPlaying ( bool bPlaying )
 	m_pAudioEngine->setPlaying(bPlaying);
 	m_pMidiEngine->setPlaying(bPlaying);
 
+	// Wake up all idle plugins...
+	qtractorPluginList::resetIdleAll();
+
 	// notify auto-plugin-deactivate
 	autoDeactivatePlugins();
 }
@@ -1289,6 +1307,9 @@ void qtractorSession::seek ( unsigned long iFrame, bool bSync )
 
 	m_pAudioEngine->sessionCursor()->seek(iFrame, bSync);
 	m_pMidiEngine->sessionCursor()->seek(iFrame, bSync);
+
+	// Wake up all idle plugins...
+	qtractorPluginList::resetIdleAll();
 }
 
 
@@ -1972,6 +1993,20 @@ qtractorAudioPeakFactory *qtractorSession::audioPeakFactory (void) const
 }
 
 
+// Audio render (time-stretch/pitch-shift) cache factory accessor.
+qtractorAudioRenderFactory *qtractorSession::audioRenderFactory (void) const
+{
+	return m_pAudioRenderFactory;
+}
+
+
+// Shared decoded audio page cache accessor.
+qtractorAudioPageCache *qtractorSession::audioPageCache (void) const
+{
+	return m_pAudioPageCache;
+}
+
+
 // MIDI track tagging specifics.
 unsigned short qtractorSession::midiTag (void) const
 {
@@ -2047,6 +2082,15 @@ void qtractorSession::process (
 {
 	const qtractorTrack::TrackType syncType = pSessionCursor->syncType();
 
+	// Parallel audio track processing, if any...
+	if (syncType == qtractorTrack::Audio) {
+		qtractorAudioGraph *pAudioGraph = m_pAudioEngine->graph();
+		if (pAudioGraph) {
+			pAudioGraph->process(pSessionCursor, iFrameStart, iFrameEnd);
+			return;
+		}
+	}
+
 	// Now, for every track...
 	int iTrack = 0;
 	qtractorTrack *pTrack = m_tracks.first();
@@ -38,6 +38,8 @@ class qtractorClip;
 class qtractorMidiEngine;
 class qtractorAudioEngine;
 class qtractorAudioPeakFactory;
+class qtractorAudioPageCache;
+class qtractorAudioRenderFactory;
 class qtractorSessionCursor;
 class qtractorMidiManager;
 class qtractorInstrumentList;
@@ -335,6 +337,12 @@ public:
 	// Audio peak factory accessor.
 	qtractorAudioPeakFactory *audioPeakFactory() const;
 
+	// Audio render (time-stretch/pitch-shift) cache factory accessor.
+	qtractorAudioRenderFactory *audioRenderFactory() const;
+
+	// Shared decoded audio page cache accessor.
+	qtractorAudioPageCache *audioPageCache() const;
+
 	// MIDI track tagging specifics.
 	unsigned short midiTag() const;
 	void acquireMidiTag(qtractorTrack *pTrack);
@@ -467,6 +475,12 @@ private:
 	// Audio peak factory (singleton) instance.
 	qtractorAudioPeakFactory *m_pAudioPeakFactory;
 
+	// Audio render cache factory (singleton) instance.
+	qtractorAudioRenderFactory *m_pAudioRenderFactory;
+
+	// Shared decoded audio page cache (singleton) instance.
+	qtractorAudioPageCache *m_pAudioPageCache;
+
 	// Track recording counts.
 	unsigned short m_iAudioRecord;
 	unsigned short m_iMidiRecord;
@@ -465,6 +465,8 @@ void qtractorTimeScale::updateNode ( qtractorTimeScale::Node *pNode )
 
 	// And update marker/bar positions too...
 	updateMarkers(pNode->prev());
+
+	++m_iSerial;
 }
 
 
@@ -492,6 +494,8 @@ void qtractorTimeScale::removeNode ( qtractorTimeScale::Node *pNode )
 
 	// Then update marker/bar positions too...
 	updateMarkers(pNodePrev);
+
+	++m_iSerial;
 }
 
 
@@ -514,6 +518,8 @@ void qtractorTimeScale::updateScale (void)
 
 	// Also update all marker/bar positions too...
 	updateMarkers(m_nodes.first());
+
+	++m_iSerial;
 }
 
 
@@ -50,11 +50,11 @@ public:
 
 	// Default constructor.
 	qtractorTimeScale() : m_displayFormat(Frames), m_iSampleRate(44100),
-		m_cursor(this), m_markerCursor(this) { clear(); }
+		m_cursor(this), m_iSerial(0), m_markerCursor(this) { clear(); }
 
 	// Copy constructor.
 	qtractorTimeScale(const qtractorTimeScale& ts)
-		: m_cursor(this), m_markerCursor(this) { copy(ts); }
+		: m_cursor(this), m_iSerial(0), m_markerCursor(this) { copy(ts); }
 
 	// Assignment operator,
 	qtractorTimeScale& operator=(const qtractorTimeScale& ts)
@@ -305,6 +305,10 @@ public:
 	// Complete time-scale update method.
 	void updateScale();
 
+	// Tempo-map change serial number
+	// (bumped on every node/scale update).
+	unsigned int serial() const { return m_iSerial; }
+
 	// Frame/pixel convertors.
 	int pixelFromFrame(unsigned long iFrame) const
 		{ return uroundf((m_fPixelRate * iFrame) / m_fFrameRate); }
@@ -666,6 +670,9 @@ private:
 	// Internal node cursor.
 	Cursor m_cursor;
 
+	// Tempo-map change serial number.
+	volatile unsigned int m_iSerial;
+
 	// Tempo-map independent coefficients.
 	float m_fPixelRate;
 	float m_fFrameRate;
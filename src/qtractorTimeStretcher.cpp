@@ -68,6 +68,7 @@ qtractorTimeStretcher::qtractorTimeStretcher (
 		m_pWsolaTimeStretcher = new qtractorWsolaTimeStretcher(iChannels, iSampleRate);
 		m_pWsolaTimeStretcher->setTempo(1.0f / fTimeStretch);
 		m_pWsolaTimeStretcher->setQuickSeek(iFlags & WsolaQuickSeek);
+		m_pWsolaTimeStretcher->setCoarseSeek(iFlags & WsolaCoarseSeek);
 		fTimeStretch = 0.0f; // Avoid RubberBandStretcher...
 	}
 
@@ -45,9 +45,10 @@ public:
 	#ifdef CONFIG_LIBRUBBERBAND
 		RubberBandFormant = 4,
 	#ifdef CONFIG_LIBRUBBERBAND_R3
-		RubberBandFinerR3 = 8
+		RubberBandFinerR3 = 8,
 	#endif
 	#endif
+		WsolaCoarseSeek   = 16
 	};
 
 	// Constructor.
@@ -31,6 +31,7 @@
 #include "qtractorAudioEngine.h"
 #include "qtractorAudioMonitor.h"
 #include "qtractorAudioBuffer.h"
+#include "qtractorAudioGraph.h"
 #include "qtractorMidiEngine.h"
 #include "qtractorMidiMonitor.h"
 #include "qtractorMidiManager.h"
@@ -315,6 +316,12 @@ qtractorTrack::qtractorTrack ( qtractorSession *pSession, TrackType trackType )
 
 	m_pSyncThread = nullptr;
 
+	m_iGraphChannels = 0;
+	m_iGraphBufferSize = 0;
+	m_ppGraphXBuffer = nullptr;
+	m_ppGraphYBuffer = nullptr;
+	m_ppGraphBuffer  = nullptr;
+
 	m_pMidiVolumeObserver  = nullptr;
 	m_pMidiPanningObserver = nullptr;
 
@@ -509,6 +516,10 @@ bool qtractorTrack::open (void)
 				pAudioBus->channels(), m_props.gain, m_props.panning);
 			m_pPluginList->setChannels(pAudioBus->channels(),
 				qtractorPluginList::AudioTrack);
+			// Parallel graph node work buffers...
+			if (pAudioEngine->graphThreads() > 0
+				|| pAudioEngine->exportThreads() > 0)
+				openGraphBuffers(pAudioBus->channels());
 		}
 		break;
 	}
@@ -667,6 +678,8 @@ void qtractorTrack::close (void)
 	m_pInputBus  = nullptr;
 	m_pOutputBus = nullptr;
 
+	closeGraphBuffers();
+
 	setClipRecord(nullptr);
 }
 
@@ -1518,6 +1531,10 @@ void qtractorTrack::resetProperties (void)
 void qtractorTrack::process ( qtractorClip *pClip,
 	unsigned long iFrameStart, unsigned long iFrameEnd )
 {
+	// MIDI tracks only schedule output here (see dspLoad)...
+	qtractorDspLoad::Scope timing(
+		m_props.trackType == qtractorTrack::Audio ? &m_dspLoad : nullptr);
+
 	// Audio-buffers needs some preparation...
 	const unsigned int nframes = iFrameEnd - iFrameStart;
 	qtractorAudioMonitor *pAudioMonitor = nullptr;
@@ -1534,28 +1551,192 @@ void qtractorTrack::process ( qtractorClip *pClip,
 	}
 
 	// Playback...
+	process_clips(pClip, iFrameStart, iFrameEnd);
+
+	// Audio buffers needs monitoring and commitment...
+	if (pAudioMonitor && pOutputBus) {
+		// Plugin chain post-processing...
+		m_pPluginList->process(pOutputBus->buffer(), nframes);
+		// Monitor passthru...
+		pAudioMonitor->process(pOutputBus->buffer(), nframes);
+		// Actually render it...
+		pOutputBus->buffer_commit(nframes);
+	}
+}
+
+
+// Process call timing statistics: MIDI tracks get their
+// plugin chain timed by the MIDI manager, if any, instead.
+qtractorDspLoad *qtractorTrack::dspLoad (void)
+{
+	if (m_props.trackType == qtractorTrack::Midi) {
+		qtractorMidiManager *pMidiManager = m_pPluginList->midiManager();
+		if (pMidiManager)
+			return pMidiManager->dspLoad();
+	}
+
+	return &m_dspLoad;
+}
+
+
+// Track clip playback processing.
+void qtractorTrack::process_clips ( qtractorClip *pClip,
+	unsigned long iFrameStart, unsigned long iFrameEnd, bool bExport )
+{
 	if (!isMute() && (!m_pSession->soloTracks() || isSolo())) {
 		const unsigned long iLatency = m_pPluginList->latency();
 		const unsigned long iFrameStart2 = iFrameStart + iLatency;
 		const unsigned long iFrameEnd2 = iFrameEnd + iLatency;
 		// Now, for every clip...
 		while (pClip && pClip->clipStart() < iFrameEnd2) {
-			if (!pClip->isClipMute() &&
-				iFrameStart2 < pClip->clipStart() + pClip->clipLength())
-				pClip->process(iFrameStart2, iFrameEnd2);
+			if (iFrameStart2 < pClip->clipStart() + pClip->clipLength()) {
+				if (bExport)
+					pClip->process_export(iFrameStart2, iFrameEnd2);
+				else
+				if (!pClip->isClipMute())
+					pClip->process(iFrameStart2, iFrameEnd2);
+			}
 			pClip = pClip->next();
 		}
 	}
+}
 
-	// Audio buffers needs monitoring and commitment...
-	if (pAudioMonitor && pOutputBus) {
-		// Plugin chain post-processing...
-		m_pPluginList->process(pOutputBus->buffer(), nframes);
-		// Monitor passthru...
-		pAudioMonitor->process(pOutputBus->buffer(), nframes);
-		// Actually render it...
-		pOutputBus->buffer_commit(nframes);
+
+// Whether this track may be processed as a parallel graph node;
+// audio inserts and aux-sends write onto other buses directly,
+// so those are left to the serial process path, as are tracks
+// with plugins not known to be safe to run concurrently.
+bool qtractorTrack::isGraphNode ( unsigned int iBufferSize ) const
+{
+	if (m_ppGraphXBuffer == nullptr || m_pMonitor == nullptr)
+		return false;
+	if (m_iGraphBufferSize < iBufferSize)
+		return false;
+
+	qtractorAudioBus *pOutputBus
+		= static_cast<qtractorAudioBus *> (m_pOutputBus);
+	if (pOutputBus == nullptr || !pOutputBus->isEnabled())
+		return false;
+	if (pOutputBus->channels() != m_iGraphChannels)
+		return false;
+
+	return !m_pPluginList->isAudioInsertActivated()
+		&& !m_pPluginList->isAudioAuxSendActivated()
+		&& !m_pPluginList->isGraphSerial();
+}
+
+
+// Parallel graph node process executive (worker thread).
+void qtractorTrack::process_graph ( qtractorClip *pClip,
+	unsigned long iFrameStart, unsigned long iFrameEnd, bool bExport )
+{
+	qtractorDspLoad::Scope timing(&m_dspLoad);
+
+	const unsigned int nframes = iFrameEnd - iFrameStart;
+
+	qtractorAudioMonitor *pAudioMonitor
+		= static_cast<qtractorAudioMonitor *> (m_pMonitor);
+	qtractorAudioBus *pOutputBus
+		= static_cast<qtractorAudioBus *> (m_pOutputBus);
+
+	// Prepare this track node buffer (no monitoring on export)...
+	qtractorAudioBus *pInputBus = (!bExport && m_pSession->isTrackMonitor(this)
+		? static_cast<qtractorAudioBus *> (m_pInputBus) : nullptr);
+	pOutputBus->buffer_prepare(nframes, pInputBus,
+		m_ppGraphXBuffer, m_ppGraphYBuffer);
+
+	m_ppGraphBuffer = m_ppGraphYBuffer;
+
+	// Playback...
+	process_clips(pClip, iFrameStart, iFrameEnd, bExport);
+
+	// Plugin chain post-processing...
+	m_pPluginList->process(m_ppGraphYBuffer, nframes);
+	// Monitor passthru...
+	pAudioMonitor->process(m_ppGraphYBuffer, nframes);
+
+	m_ppGraphBuffer = nullptr;
+}
+
+
+// Parallel graph node commit executive;
+// concurrent (worker) commits just try and fail when busy.
+bool qtractorTrack::process_graph_commit (
+	unsigned int nframes, bool bTryLock )
+{
+	qtractorAudioBus *pOutputBus
+		= static_cast<qtractorAudioBus *> (m_pOutputBus);
+	if (pOutputBus == nullptr)
+		return true;
+
+	if (bTryLock)
+		return pOutputBus->buffer_commit_try(nframes, m_ppGraphXBuffer);
+
+	pOutputBus->buffer_commit(nframes, m_ppGraphXBuffer);
+	return true;
+}
+
+
+// Parallel graph node work buffers (audio tracks only).
+void qtractorTrack::openGraphBuffers ( unsigned short iChannels )
+{
+	closeGraphBuffers();
+
+	qtractorAudioEngine *pAudioEngine = m_pSession->audioEngine();
+	if (pAudioEngine == nullptr || iChannels < 1)
+		return;
+
+	const unsigned int iBufferSizeEx = pAudioEngine->bufferSizeEx();
+
+	m_ppGraphXBuffer = new float * [iChannels];
+	m_ppGraphYBuffer = new float * [iChannels];
+	for (unsigned short i = 0; i < iChannels; ++i) {
+		m_ppGraphXBuffer[i] = new float [iBufferSizeEx];
+		m_ppGraphYBuffer[i] = nullptr;
+	}
+
+	m_iGraphChannels = iChannels;
+	m_iGraphBufferSize = iBufferSizeEx;
+
+	qtractorAudioGraph *pAudioGraph = pAudioEngine->graph();
+	if (pAudioGraph)
+		pAudioGraph->reserve(m_pSession->tracks().count());
+}
+
+
+void qtractorTrack::closeGraphBuffers (void)
+{
+	if (m_ppGraphXBuffer) {
+		for (unsigned short i = 0; i < m_iGraphChannels; ++i)
+			delete [] m_ppGraphXBuffer[i];
+		delete [] m_ppGraphXBuffer;
+		m_ppGraphXBuffer = nullptr;
+	}
+
+	if (m_ppGraphYBuffer) {
+		delete [] m_ppGraphYBuffer;
+		m_ppGraphYBuffer = nullptr;
 	}
+
+	m_ppGraphBuffer  = nullptr;
+	m_iGraphChannels = 0;
+	m_iGraphBufferSize = 0;
+}
+
+
+// Parallel graph node work buffers resize (buffer-size change,
+// while the JACK process cycle is not running).
+void qtractorTrack::resizeGraphBuffers ( unsigned int iBufferSize )
+{
+	if (m_ppGraphXBuffer == nullptr || m_iGraphBufferSize >= iBufferSize)
+		return;
+
+	for (unsigned short i = 0; i < m_iGraphChannels; ++i) {
+		delete [] m_ppGraphXBuffer[i];
+		m_ppGraphXBuffer[i] = new float [iBufferSize];
+	}
+
+	m_iGraphBufferSize = iBufferSize;
 }
 
 
@@ -1578,17 +1759,7 @@ void qtractorTrack::process_export ( qtractorClip *pClip,
 	}
 
 	// Playback...
-	if (!isMute() && (!m_pSession->soloTracks() || isSolo())) {
-		const unsigned long iLatency = m_pPluginList->latency();
-		const unsigned long iFrameStart2 = iFrameStart + iLatency;
-		const unsigned long iFrameEnd2 = iFrameEnd + iLatency;
-		// Now, for every clip...
-		while (pClip && pClip->clipStart() < iFrameEnd2) {
-			if (iFrameStart2 < pClip->clipStart() + pClip->clipLength())
-				pClip->process_export(iFrameStart2, iFrameEnd2);
-			pClip = pClip->next();
-		}
-	}
+	process_clips(pClip, iFrameStart, iFrameEnd, true);
 
 	// Audio buffers needs monitoring and commitment...
 	if (pAudioMonitor && pOutputBus) {
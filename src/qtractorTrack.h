@@ -25,6 +25,7 @@
 #include "qtractorList.h"
 
 #include "qtractorMidiControl.h"
+#include "qtractorDspLoad.h"
 
 #include <QColor>
 
@@ -245,6 +246,23 @@ public:
 	// Track special process automation executive.
 	void process_curve(unsigned long iFrame);
 
+	// Parallel graph node process executives (audio tracks only).
+	bool isGraphNode(unsigned int iBufferSize) const;
+	void process_graph(qtractorClip *pClip,
+		unsigned long iFrameStart, unsigned long iFrameEnd,
+		bool bExport = false);
+	bool process_graph_commit(unsigned int nframes, bool bTryLock = false);
+
+	// Parallel graph node work buffers resize (non RT-safe).
+	void resizeGraphBuffers(unsigned int iBufferSize);
+
+	// Parallel graph node work buffer (while processing only).
+	float **graphBuffer() const
+		{ return m_ppGraphBuffer; }
+
+	// Process call timing statistics.
+	qtractorDspLoad *dspLoad();
+
 	// Track paint method.
 	void drawTrack(QPainter *pPainter, const QRect& trackRect,
 		unsigned long iTrackStart, unsigned long iTrackEnd,
@@ -451,6 +469,24 @@ private:
 
 	// Default track color saturation factor [0..500].
 	static int g_iTrackColorSaturation;
+
+	// Track clip playback processing.
+	void process_clips(qtractorClip *pClip,
+		unsigned long iFrameStart, unsigned long iFrameEnd,
+		bool bExport = false);
+
+	// Parallel graph node work buffers (audio tracks only).
+	void openGraphBuffers(unsigned short iChannels);
+	void closeGraphBuffers();
+
+	unsigned short m_iGraphChannels;
+	unsigned int   m_iGraphBufferSize;
+	float **m_ppGraphXBuffer;
+	float **m_ppGraphYBuffer;
+	float **m_ppGraphBuffer;
+
+	// Process call timing statistics.
+	qtractorDspLoad m_dspLoad;
 };
 
 
@@ -78,10 +78,18 @@
 
 #include <cmath>
 
+#ifdef CONFIG_DEBUG
+#include <QElapsedTimer>
+#endif
+
 
 // Follow-playhead: maximum iterations on hold.
 #define QTRACTOR_SYNC_VIEW_HOLD 46
 
+// Pixmap tile width and rendering slack (pixels).
+static const int c_iTileWidth  = 256;
+static const int c_iTileMargin = 16;
+
 
 //----------------------------------------------------------------------------
 // qtractorTrackView::ClipBoard - Local clipaboard singleton.
@@ -105,6 +113,10 @@ qtractorTrackView::qtractorTrackView ( qtractorTracks *pTracks,
 	m_pSessionCursor = nullptr;
 	m_pRubberBand    = nullptr;
 
+	m_iTilesY = 0;
+	m_iTilesHeight = 0;
+	m_bTilesScroll = false;
+
 	m_selectMode = SelectClip;
 
 	m_bDropSpan  = true;
@@ -301,39 +313,6 @@ void qtractorTrackView::updateContentsWidth ( int iContentsWidth )
 			pNode->beat + (pNode->beatsPerBar << 1)) - pNode->pixel;
 		if (iContentsWidth  < qtractorScrollView::width())
 			iContentsWidth += qtractorScrollView::width();
-		// HACK: Try and check whether we need to change
-		// current (global) audio-peak period resolution...
-		qtractorAudioPeakFactory *pPeakFactory = pSession->audioPeakFactory();
-		if (pPeakFactory) {
-			const unsigned short iPeakPeriod = pPeakFactory->peakPeriod();
-			// Should we change resolution?
-			const int p2 = ((iSessionLength / iPeakPeriod) >> 1) + 1;
-			int q2 = (iSessionWidth / p2);
-			if (q2 > 4) {
-				pPeakFactory->setPeakPeriod(iPeakPeriod >> 3);
-			#ifdef CONFIG_DEBUG
-				qDebug("qtractorTrackView::updateContentsWidth() "
-					"iSessionLength=%lu iSessionWidth=%d "
-					"++ peakPeriod=%u (%u) p2=%d q2=%d.",
-					iSessionLength, iSessionWidth,
-					pPeakFactory->peakPeriod(), iPeakPeriod, p2, q2);
-			#endif
-			}
-			else
-			if (q2 < 2 && iSessionWidth > 1) {
-				q2 = (p2 / iSessionWidth);
-				if (q2 > 4) {
-					pPeakFactory->setPeakPeriod(iPeakPeriod << 3);
-				#ifdef CONFIG_DEBUG
-					qDebug("qtractorTrackView::updateContentsWidth() "
-						"iSessionLength=%lu iSessionWidth=%d "
-						"-- peakPeriod=%u (%u) p2=%d q2=%d.",
-						iSessionLength, iSessionWidth,
-						pPeakFactory->peakPeriod(), iPeakPeriod, p2, q2);
-				#endif
-				}
-			}
-		}
 	#if 0
 		m_iPlayHeadX = pSession->pixelFromFrame(pSession->playHead());
 		m_iEditHeadX = pSession->pixelFromFrame(pSession->editHead());
@@ -359,6 +338,14 @@ void qtractorTrackView::updateContentsWidth ( int iContentsWidth )
 // Local rectangular contents update.
 void qtractorTrackView::updateContents ( const QRect& rect )
 {
+	// Only the tiles under the damaged area need a redraw...
+	if (!m_bTilesScroll) {
+		const int k1 = (rect.left() - c_iTileMargin) / c_iTileWidth;
+		const int k2 = (rect.right() + c_iTileMargin) / c_iTileWidth;
+		for (int k = k1; k <= k2; ++k)
+			m_tiles.remove(k);
+	}
+
 	updatePixmap(
 		qtractorScrollView::contentsX(), qtractorScrollView::contentsY());
 
@@ -369,6 +356,9 @@ void qtractorTrackView::updateContents ( const QRect& rect )
 // Overall contents update.
 void qtractorTrackView::updateContents (void)
 {
+	if (!m_bTilesScroll)
+		m_tiles.clear();
+
 	updatePixmap(
 		qtractorScrollView::contentsX(), qtractorScrollView::contentsY());
 
@@ -376,6 +366,24 @@ void qtractorTrackView::updateContents (void)
 }
 
 
+// Damage-rect update for a single clip
+// (and all past its start, if its length may have changed).
+void qtractorTrackView::updateClip ( qtractorClip *pClip, bool bTail )
+{
+	qtractorTrack *pTrack = (pClip ? pClip->track() : nullptr);
+	if (pTrack == nullptr)
+		return;
+
+	TrackViewInfo tvi;
+	QRect rectClip;
+	if (trackInfo(pTrack, &tvi) && clipInfo(pClip, &rectClip, &tvi)) {
+		if (bTail)
+			rectClip.setRight(qtractorScrollView::contentsWidth());
+		updateContents(rectClip);
+	}
+}
+
+
 // Special recording visual feedback.
 void qtractorTrackView::updateContentsRecord (void)
 {
@@ -886,6 +894,15 @@ void qtractorTrackView::resizeEvent ( QResizeEvent *pResizeEvent )
 }
 
 
+// Horizontal scrolling keeps the tile cache.
+void qtractorTrackView::scrollContentsBy ( int dx, int dy )
+{
+	m_bTilesScroll = (dy == 0);
+	qtractorScrollView::scrollContentsBy(dx, dy);
+	m_bTilesScroll = false;
+}
+
+
 // (Re)create the complete track view pixmap.
 void qtractorTrackView::updatePixmap ( int cx, int cy )
 {
@@ -893,15 +910,93 @@ void qtractorTrackView::updatePixmap ( int cx, int cy )
 	const int w = pViewport->width();
 	const int h = pViewport->height();
 
-	const QPalette& pal = qtractorScrollView::palette();
-
 	if (w < 1 || h < 1)
 		return;
 
+#ifdef CONFIG_DEBUG
+	QElapsedTimer timer;
+	timer.start();
+	int iTiles = 0;
+#endif
+
+	// Reset peak file read statistics...
+	qtractorAudioPeakFile::resetReadBytes();
+
+	// Cached tiles are only good for the same vertical extent...
+	if (m_iTilesY != cy || m_iTilesHeight != h) {
+		m_tiles.clear();
+		m_iTilesY = cy;
+		m_iTilesHeight = h;
+	}
+
+	if (m_pixmap.width() != w || m_pixmap.height() != h)
+		m_pixmap = QPixmap(w, h);
+
+	// Compose from column tiles, rendering just the missing ones;
+	// each tile gets rendered with some slack on either side, so
+	// that clip frame edges don't show up on the tile boundaries...
+	const int k1 = cx / c_iTileWidth;
+	const int k2 = (cx + w - 1) / c_iTileWidth;
+
+	QPixmap pixmap;
+	QPainter painter(&m_pixmap);
+	for (int k = k1; k <= k2; ++k) {
+		const int x = k * c_iTileWidth;
+		QHash<int, QPixmap>::ConstIterator iter = m_tiles.constFind(k);
+		if (iter == m_tiles.constEnd()) {
+			const int dx = (x < c_iTileMargin ? x : c_iTileMargin);
+			if (pixmap.isNull())
+				pixmap = QPixmap(c_iTileWidth + (c_iTileMargin << 1), h);
+			renderPixmap(pixmap, x - dx, cy);
+			iter = m_tiles.insert(k, pixmap.copy(dx, 0, c_iTileWidth, h));
+		#ifdef CONFIG_DEBUG
+			++iTiles;
+		#endif
+		}
+		painter.drawPixmap(x - cx, 0, iter.value());
+	}
+
+	// Drop tiles farther than a viewport width away...
+	const int kd = k2 - k1 + 1;
+	QHash<int, QPixmap>::Iterator iter = m_tiles.begin();
+	while (iter != m_tiles.end()) {
+		const int k = iter.key();
+		if (k < k1 - kd || k > k2 + kd)
+			iter = m_tiles.erase(iter);
+		else
+			++iter;
+	}
+
+	// Keep view session cursor on the current location...
+	qtractorSession *pSession = qtractorSession::getInstance();
+	if (pSession && m_pSessionCursor)
+		m_pSessionCursor->seek(pSession->frameFromPixel(cx));
+
+#ifdef CONFIG_DEBUG
+	// Peak file read statistics and paint time, per redraw...
+	const unsigned long iReadBytes = qtractorAudioPeakFile::readBytes();
+	const unsigned long iMapBytes  = qtractorAudioPeakFile::mapBytes();
+	if (iTiles > 0 || iReadBytes > 0 || iMapBytes > 0) {
+		qDebug("qtractorTrackView::updatePixmap(%d, %d) "
+			"tiles=%d/%d (%lld us) peak bytes read=%lu mapped=%lu.",
+			cx, cy, iTiles, k2 - k1 + 1, timer.nsecsElapsed() / 1000,
+			iReadBytes, iMapBytes);
+	}
+#endif
+}
+
+
+// Render a track view pixmap at some contents position.
+void qtractorTrackView::renderPixmap ( QPixmap& pixmap, int cx, int cy )
+{
+	const int w = pixmap.width();
+	const int h = pixmap.height();
+
+	const QPalette& pal = qtractorScrollView::palette();
+
 	const QColor& rgbMid = pal.mid().color();
-	
-	m_pixmap = QPixmap(w, h);
-	m_pixmap.fill(rgbMid);
+
+	pixmap.fill(rgbMid);
 
 	qtractorSession *pSession = qtractorSession::getInstance();
 	if (pSession == nullptr)
@@ -911,7 +1006,7 @@ void qtractorTrackView::updatePixmap ( int cx, int cy )
 	if (pTimeScale == nullptr)
 		return;
 
-	QPainter painter(&m_pixmap);
+	QPainter painter(&pixmap);
 //	painter.initFrom(this);
 	painter.setFont(qtractorScrollView::font());
 
@@ -30,6 +30,7 @@
 
 #include <QPixmap>
 #include <QBrush>
+#include <QHash>
 
 
 // Forward declarations.
@@ -83,6 +84,10 @@ public:
 	void updateContents(const QRect& rect);
 	void updateContents();
 
+	// Damage-rect update for a single clip
+	// (and all past its start, if its length may have changed).
+	void updateClip(qtractorClip *pClip, bool bTail = false);
+
 	// Special recording visual feedback.
 	void updateContentsRecord();
 
@@ -264,6 +269,12 @@ protected:
 	// Resize event handler.
 	void resizeEvent(QResizeEvent *pResizeEvent);
 
+	// Horizontal scrolling keeps the tile cache.
+	void scrollContentsBy(int dx, int dy);
+
+	// Render a track view pixmap at some contents position.
+	void renderPixmap(QPixmap& pixmap, int cx, int cy);
+
 	// Draw the track view
 	void drawContents(QPainter *pPainter, const QRect& rect);
 
@@ -439,6 +450,12 @@ private:
 	// Local double-buffering pixmap.
 	QPixmap m_pixmap;
 
+	// Column tile cache, keyed by contents-x / tile width.
+	QHash<int, QPixmap> m_tiles;
+	int  m_iTilesY;
+	int  m_iTilesHeight;
+	bool m_bTilesScroll;
+
 	// To maintain the current track/clip positioning.
 	qtractorSessionCursor *m_pSessionCursor;
 
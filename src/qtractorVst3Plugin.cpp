@@ -28,6 +28,7 @@
 #include "qtractorSession.h"
 #include "qtractorAudioEngine.h"
 #include "qtractorMidiManager.h"
+#include "qtractorCurve.h"
 
 #include "pluginterfaces/vst/ivsthostapplication.h"
 #include "pluginterfaces/vst/ivstpluginterfacesupport.h"
@@ -63,6 +64,8 @@
 
 #include <QRegularExpression>
 
+#include <climits>
+
 #if QT_VERSION >= QT_VERSION_CHECK(5, 0, 0)
 #define CONFIG_VST3_XCB
 #endif
@@ -1448,6 +1451,10 @@ public:
 
 	void clear () { m_ncount = 0; }
 
+	// Pre-allocate points, so that addPoint won't resize in RT.
+	void reserve (int32 nsize)
+		{ if (m_nsize < nsize) resize((nsize + 1) >> 1); }
+
 protected:
 
 	void resize (int32 nsize)
@@ -1557,6 +1564,16 @@ public:
 		m_ncount = 0;
 	}
 
+	// Pre-allocate queues and their points, so that
+	// addParameterData and addPoint won't resize in RT.
+	void reserve (int32 nqueues, int32 npoints)
+	{
+		if (m_nsize < nqueues)
+			resize((nqueues + 1) >> 1);
+		for (int32 i = 0; i < m_nsize; ++i)
+			m_queues[i].reserve(npoints);
+	}
+
 protected:
 
 	void resize (int32 nsize)
@@ -1712,6 +1729,9 @@ public:
 	// Plugin current latency (in frames);
 	unsigned long latency () const;
 
+	// Plugin current tail (in frames).
+	long tail () const;
+
 	// Set/add a parameter value/point.
 	void setParameter (
 		Vst::ParamID id, Vst::ParamValue value, uint32 offset);
@@ -2460,6 +2480,13 @@ bool qtractorVst3Plugin::Impl::process_reset (
 	m_params_in.clear();
 //	m_params_out.clear();
 
+	// Pre-size parameter changes for automation: one point per
+	// curve process step on the largest block, plus the first...
+	const int32 nqueues = qBound(8, int(m_pPlugin->params().count()), 64);
+	const int32 npoints = qMax(16, int(pAudioEngine->bufferSizeEx()
+		/ qtractorCurve::c_iProcessStep) + 2);
+	m_params_in.reserve(nqueues, npoints);
+
 	m_events_in.clear();
 	m_events_out.clear();
 
@@ -2635,6 +2662,15 @@ void qtractorVst3Plugin::Impl::process (
 	m_buffers_out.channelBuffers32 = outs;
 	m_process_data.numSamples = nframes;
 
+	// Flag silent input channels, all or none...
+	m_buffers_in.silenceFlags = 0;
+	if (m_pPlugin->isSilentIn() && m_buffers_in.numChannels > 0) {
+		const int32 nchannels = m_buffers_in.numChannels;
+		m_buffers_in.silenceFlags = (nchannels < 64
+			? (uint64(1) << nchannels) - 1 : ~uint64(0));
+	}
+	m_buffers_out.silenceFlags = 0;
+
 	if (m_processor->process(m_process_data) != kResultOk) {
 		qWarning("qtractorVst3Plugin::Impl[%p]::process() FAILED!", this);
 	}
@@ -2654,6 +2690,17 @@ unsigned long qtractorVst3Plugin::Impl::latency (void) const
 }
 
 
+// Plugin current tail (in frames).
+long qtractorVst3Plugin::Impl::tail (void) const
+{
+	if (!m_processor)
+		return -1;
+
+	const uint32 tail = m_processor->getTailSamples();
+	return (tail < uint32(INT32_MAX) ? long(tail) : LONG_MAX);
+}
+
+
 // Set/add a parameter value/point.
 void qtractorVst3Plugin::Impl::setParameter (
 	Vst::ParamID id, Vst::ParamValue value, uint32 offset )
@@ -3194,7 +3241,9 @@ void qtractorVst3Plugin::updateParam (
 
 	const Vst::ParamID id = pVst3Param->impl()->paramInfo().id;
 	const Vst::ParamValue value = Vst::ParamValue(fValue);
-	m_pImpl->setParameter(id, value, 0);
+	// Already delivered from within the process cycle?
+	if (!isProcessCurve(pParam))
+		m_pImpl->setParameter(id, value, 0);
 	controller->setParamNormalized(id, value);
 
 	pVst3Param->setValueEnabled(true);
@@ -3490,6 +3539,19 @@ void qtractorVst3Plugin::process_midi_in (
 }
 
 
+// Intra-cycle parameter point procedure (offset in frames).
+void qtractorVst3Plugin::process_curve (
+	qtractorPlugin::Param *pParam, float fValue, unsigned int iOffset )
+{
+	Param *pVst3Param = static_cast<Param *> (pParam);
+	if (pVst3Param->impl() == nullptr)
+		return;
+
+	const Vst::ParamID id = pVst3Param->impl()->paramInfo().id;
+	m_pImpl->setParameter(id, Vst::ParamValue(fValue), iOffset);
+}
+
+
 void qtractorVst3Plugin::process (
 	float **ppIBuffer, float **ppOBuffer, unsigned int nframes )
 {
@@ -3541,6 +3603,9 @@ void qtractorVst3Plugin::process (
 			m_ppOBuffer[i] = m_pfODummy; // dummy output!
 	}
 
+	// Sample-accurate automation, if any...
+	process_curves(nframes);
+
 	// Run the main processor routine...
 	//
 	m_pImpl->process(m_ppIBuffer, m_ppOBuffer, nframes);
@@ -3599,6 +3664,13 @@ unsigned long qtractorVst3Plugin::latency (void) const
 }
 
 
+// Plugin current tail (in frames).
+long qtractorVst3Plugin::tail (void) const
+{
+	return m_pImpl->tail();
+}
+
+
 // Provisional program/patch accessor.
 bool qtractorVst3Plugin::getProgram ( int iIndex, Program& program ) const
 {
@@ -144,6 +144,9 @@ public:
 	// Plugin current latency (in frames);
 	unsigned long latency() const;
 
+	// Plugin current tail (in frames).
+	long tail() const;
+
 	// Provisional program/patch accessor.
 	bool getProgram(int iIndex, Program& program) const;
 
@@ -182,6 +185,10 @@ protected:
 	void initialize();
 	void deinitialize();
 
+	// Intra-cycle parameter point procedure (offset in frames).
+	void process_curve(
+		qtractorPlugin::Param *pParam, float fValue, unsigned int iOffset);
+
 	// Internal accessors.
 	EditorFrame *editorFrame() const;
 
@@ -119,6 +119,116 @@ static inline float sse_cross_corr (
 	return (pvCorr[0] + pvCorr[1] + pvCorr[2] + pvCorr[3]) / ::sqrtf(fNorm);
 }
 
+
+// SSE enabled overlap-add version.
+static inline void sse_overlap (
+	float *pOutput, const float *pInput, const float *pMid,
+	unsigned int iOverlapLength )
+{
+	const float fLength = float(iOverlapLength);
+	const __m128 vLength = _mm_load_ps1(&fLength);
+	const __m128 vStep = _mm_set1_ps(4.0f);
+	__m128 vJ = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+
+	// Overlap length is divisible by 8 anyway...
+	for (unsigned int j = 0; j < iOverlapLength; j += 4) {
+		_mm_storeu_ps(pOutput + j,
+			_mm_div_ps(
+				_mm_add_ps(
+					_mm_mul_ps(_mm_loadu_ps(pInput + j), vJ),
+					_mm_mul_ps(_mm_loadu_ps(pMid + j), _mm_sub_ps(vLength, vJ))),
+				vLength));
+		vJ = _mm_add_ps(vJ, vStep);
+	}
+}
+
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+
+#include <immintrin.h>
+
+// AVX2/FMA detection (runtime, also checks for OS support).
+static inline bool avx2_enabled (void)
+{
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+}
+
+
+// AVX2/FMA enabled version.
+__attribute__((target("avx2,fma")))
+static float avx2_cross_corr (
+	const float *pV1, const float *pV2, unsigned int iOverlapLength )
+{
+	__m256 vCorr0, vCorr1, vNorm0, vNorm1, vTemp0, vTemp1;
+
+	// Note: pV2 _must_ be aligned to 32-byte boundary, pV1 need not.
+	vCorr0 = vCorr1 = _mm256_setzero_ps();
+	vNorm0 = vNorm1 = _mm256_setzero_ps();
+
+	// Unroll the loop by factor of 2 * 8 operations,
+	// with independent accumulators...
+	unsigned int i = 0;
+	for (; i + 16 <= iOverlapLength; i += 16) {
+		vTemp0 = _mm256_loadu_ps(pV1 + i);
+		vTemp1 = _mm256_loadu_ps(pV1 + i + 8);
+		vCorr0 = _mm256_fmadd_ps(vTemp0, _mm256_load_ps(pV2 + i), vCorr0);
+		vCorr1 = _mm256_fmadd_ps(vTemp1, _mm256_load_ps(pV2 + i + 8), vCorr1);
+		vNorm0 = _mm256_fmadd_ps(vTemp0, vTemp0, vNorm0);
+		vNorm1 = _mm256_fmadd_ps(vTemp1, vTemp1, vNorm1);
+	}
+
+	// Overlap length is divisible by 8 anyway...
+	for (; i + 8 <= iOverlapLength; i += 8) {
+		vTemp0 = _mm256_loadu_ps(pV1 + i);
+		vCorr0 = _mm256_fmadd_ps(vTemp0, _mm256_load_ps(pV2 + i), vCorr0);
+		vNorm0 = _mm256_fmadd_ps(vTemp0, vTemp0, vNorm0);
+	}
+
+	// Horizontal sums...
+	__m256 vSum = _mm256_hadd_ps(
+		_mm256_add_ps(vCorr0, vCorr1),
+		_mm256_add_ps(vNorm0, vNorm1));
+	vSum = _mm256_hadd_ps(vSum, vSum);
+	const __m128 vLow = _mm256_castps256_ps128(vSum);
+	const __m128 vHigh = _mm256_extractf128_ps(vSum, 1);
+	const __m128 vTotal = _mm_add_ps(vLow, vHigh);
+
+	const float fCorr = _mm_cvtss_f32(vTotal);
+	float fNorm = _mm_cvtss_f32(_mm_shuffle_ps(vTotal, vTotal, 1));
+
+	if (fNorm < 1e-9f) fNorm = 1.0f; // avoid div by zero
+
+	return fCorr / ::sqrtf(fNorm);
+}
+
+
+// AVX2/FMA enabled overlap-add version.
+__attribute__((target("avx2,fma")))
+static void avx2_overlap (
+	float *pOutput, const float *pInput, const float *pMid,
+	unsigned int iOverlapLength )
+{
+	const __m256 vLength = _mm256_set1_ps(float(iOverlapLength));
+	const __m256 vStep = _mm256_set1_ps(8.0f);
+	__m256 vJ = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+
+	// Overlap length is divisible by 8 anyway...
+	for (unsigned int j = 0; j < iOverlapLength; j += 8) {
+		_mm256_storeu_ps(pOutput + j,
+			_mm256_div_ps(
+				_mm256_fmadd_ps(_mm256_loadu_ps(pInput + j), vJ,
+					_mm256_mul_ps(_mm256_loadu_ps(pMid + j),
+						_mm256_sub_ps(vLength, vJ))),
+				vLength));
+		vJ = _mm256_add_ps(vJ, vStep);
+	}
+}
+
+#define QTRACTOR_AVX2_WSOLA
+
+#endif // __GNUC__ && (__x86_64__ || __i386__)
+
 #endif
 
 
@@ -140,6 +250,18 @@ static inline float std_cross_corr (
 }
 
 
+// Standard (slow) overlap-add version.
+static inline void std_overlap (
+	float *pOutput, const float *pInput, const float *pMid,
+	unsigned int iOverlapLength )
+{
+	for (unsigned int j = 0; j < iOverlapLength; ++j) {
+		const unsigned int k = iOverlapLength - j;
+		pOutput[j] = (pInput[j] * j + pMid[j] * k) / iOverlapLength;
+	}
+}
+
+
 //---------------------------------------------------------------------------
 // qtractorWsolaTimeStretcher - Time-stretch (tempo change) effect for processed sound.
 //
@@ -153,6 +275,7 @@ qtractorWsolaTimeStretcher::qtractorWsolaTimeStretcher (
 
 	m_fTempo = 1.0f;
 	m_bQuickSeek = false;
+	m_bCoarseSeek = false;
 
 	m_bMidBufferDirty = false;
 	m_ppMidBuffer = nullptr;
@@ -162,12 +285,7 @@ qtractorWsolaTimeStretcher::qtractorWsolaTimeStretcher (
 
 	m_iOverlapLength = 0;
 
-#if defined(__SSE__)
-	if (sse_enabled())
-		m_pfnCrossCorr = sse_cross_corr;
-	else
-#endif
-	m_pfnCrossCorr = std_cross_corr;
+	setKernel(KernelAuto);
 
 	setParameters(iSampleRate);
 }
@@ -258,6 +376,72 @@ bool qtractorWsolaTimeStretcher::isQuickSeek (void) const
 }
 
 
+// Set coarse-seek mode (coarse-then-fine search).
+void qtractorWsolaTimeStretcher::setCoarseSeek ( bool bCoarseSeek )
+{
+	m_bCoarseSeek = bCoarseSeek;
+}
+
+// Get coarse-seek mode.
+bool qtractorWsolaTimeStretcher::isCoarseSeek (void) const
+{
+	return m_bCoarseSeek;
+}
+
+
+// Set processor kernel type (eg. benchmarking).
+bool qtractorWsolaTimeStretcher::setKernel ( Kernel kernel )
+{
+	if (kernel == KernelAuto) {
+	#if defined(QTRACTOR_AVX2_WSOLA)
+		if (avx2_enabled())
+			kernel = KernelAvx2;
+		else
+	#endif
+	#if defined(__SSE__)
+		if (sse_enabled())
+			kernel = KernelSse;
+		else
+	#endif
+		kernel = KernelStd;
+	}
+
+	switch (kernel) {
+#if defined(QTRACTOR_AVX2_WSOLA)
+	case KernelAvx2:
+		if (!avx2_enabled())
+			return false;
+		m_pfnCrossCorr = avx2_cross_corr;
+		m_pfnOverlap = avx2_overlap;
+		break;
+#endif
+#if defined(__SSE__)
+	case KernelSse:
+		if (!sse_enabled())
+			return false;
+		m_pfnCrossCorr = sse_cross_corr;
+		m_pfnOverlap = sse_overlap;
+		break;
+#endif
+	case KernelStd:
+		m_pfnCrossCorr = std_cross_corr;
+		m_pfnOverlap = std_overlap;
+		break;
+	default:
+		return false;
+	}
+
+	m_kernel = kernel;
+	return true;
+}
+
+// Get current processor kernel type.
+qtractorWsolaTimeStretcher::Kernel qtractorWsolaTimeStretcher::kernel (void) const
+{
+	return m_kernel;
+}
+
+
 // Sets routine control parameters.
 // These control are certain time constants defining
 // how the sound is stretched to the desired duration.
@@ -387,6 +571,46 @@ unsigned int qtractorWsolaTimeStretcher::seekBestOverlapPosition (void)
 			}
 			iPrevBestOffs = iBestOffs;
 		}
+	}
+	else
+	if (m_bCoarseSeek) {
+		// Coarse-then-fine search: first scan every other
+		// few positions, keeping the two best candidates...
+		const int iSeekLength = int(m_iSeekLength);
+		const int iCoarseStep = 8;
+		int iCoarseOffs[2] = { 0, 0 };
+		float fCoarseCorr[2] = { -1e38f, -1e38f };
+		for (iOffs = 0; iOffs < iSeekLength; iOffs += iCoarseStep) {
+			fCorr = calcCrossCorr(iOffs);
+			if (fCorr > fCoarseCorr[0]) {
+				fCoarseCorr[1] = fCoarseCorr[0];
+				iCoarseOffs[1] = iCoarseOffs[0];
+				fCoarseCorr[0] = fCorr;
+				iCoarseOffs[0] = iOffs;
+			}
+			else
+			if (fCorr > fCoarseCorr[1]) {
+				fCoarseCorr[1] = fCorr;
+				iCoarseOffs[1] = iOffs;
+			}
+		}
+		// Then refine linearly around each candidate...
+		iBestOffs = iCoarseOffs[0];
+		fBestCorr = fCoarseCorr[0];
+		for (k = 0; k < 2; ++k) {
+			if (fCoarseCorr[k] < -1e37f)
+				break;
+			for (j = 1 - iCoarseStep; j < iCoarseStep; ++j) {
+				iOffs = iCoarseOffs[k] + j;
+				if (j == 0 || iOffs < 0 || iOffs >= iSeekLength)
+					continue;
+				fCorr = calcCrossCorr(iOffs);
+				if (fCorr > fBestCorr) {
+					fBestCorr = fCorr;
+					iBestOffs = iOffs;
+				}
+			}
+		}
 	} else {
 		// Linear search...
 		iBestOffs = 0;
@@ -410,12 +634,29 @@ unsigned int qtractorWsolaTimeStretcher::seekBestOverlapPosition (void)
 }
 
 
+// Calculates the cross-correlation value for the mixing position
+// corresponding to iOffs (the highest one of all channels).
+float qtractorWsolaTimeStretcher::calcCrossCorr ( int iOffs ) const
+{
+	float fBestCorr = -1e38f;
+
+	for (unsigned short i = 0; i < m_iChannels; ++i) {
+		const float fCorr = (*m_pfnCrossCorr)(
+			m_inputBuffer.ptrBegin(i) + iOffs,
+			m_ppRefMidBuffer[i], m_iOverlapLength);
+		if (fCorr > fBestCorr)
+			fBestCorr = fCorr;
+	}
+
+	return fBestCorr;
+}
+
+
 // Processes as many processing frames of the samples
 // from input-buffer, store the result into output-buffer.
 void qtractorWsolaTimeStretcher::processFrames (void)
 {
 	unsigned short i;
-	unsigned int j, k;
 	float *pInput, *pOutput;
 	unsigned int iSkip, iOffset;
 	int iTemp;
@@ -445,13 +686,10 @@ void qtractorWsolaTimeStretcher::processFrames (void)
 		m_outputBuffer.ensureCapacity(m_iOverlapLength);
 		// Overlap...
 		for (i = 0; i < m_iChannels; ++i) {
-			pInput = m_inputBuffer.ptrBegin(i);
+			pInput = m_inputBuffer.ptrBegin(i) + iOffset;
 			pOutput = m_outputBuffer.ptrEnd(i);
-			for (j = 0; j < m_iOverlapLength ; ++j) {
-				k = m_iOverlapLength - j;
-				pOutput[j] = (pInput[j + iOffset] * j
-					+ m_ppMidBuffer[i][j] * k) / m_iOverlapLength;
-			}
+			(*m_pfnOverlap)(pOutput, pInput,
+				m_ppMidBuffer[i], m_iOverlapLength);
 		}
 		// Commit...
 		m_outputBuffer.putFrames(m_iOverlapLength);
@@ -586,11 +824,11 @@ void qtractorWsolaTimeStretcher::calcOverlapLength (void)
 		for (i = 0; i < m_iChannels; ++i) {
 			m_ppMidBuffer[i] = new float [2 * m_iOverlapLength];
 			m_ppRefMidBufferUnaligned[i]
-				= new float[2 * m_iOverlapLength + 16 / sizeof(float)];
+				= new float[2 * m_iOverlapLength + 32 / sizeof(float)];
 			// Ensure that ref-mid-buffer is aligned
-			// to 16 byte boundary for efficiency
+			// to 32 byte boundary for efficiency (AVX)
 			m_ppRefMidBuffer[i] = (float *)
-				((((unsigned long) m_ppRefMidBufferUnaligned[i]) + 15) & -16);
+				((((unsigned long) m_ppRefMidBufferUnaligned[i]) + 31) & -32);
 		}
 		m_bMidBufferDirty = true;
 		clearMidBuffer();
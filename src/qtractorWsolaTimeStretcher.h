@@ -65,6 +65,22 @@ public:
 	// Get quick-seek mode.
 	bool isQuickSeek() const;
 
+	// Set coarse-seek mode (coarse-then-fine search).
+	void setCoarseSeek(bool bCoarseSeek);
+
+	// Get coarse-seek mode.
+	bool isCoarseSeek() const;
+
+	// Processor kernel types.
+	enum Kernel { KernelAuto = 0, KernelStd, KernelSse, KernelAvx2 };
+
+	// Set processor kernel type (eg. benchmarking);
+	// returns false if not supported by this host.
+	bool setKernel(Kernel kernel);
+
+	// Get current processor kernel type.
+	Kernel kernel() const;
+
 	// Default values for sound processing parameters.
 	enum {
 
@@ -239,6 +255,9 @@ protected:
 	// Seeks for the optimal overlap-mixing position.
 	unsigned int seekBestOverlapPosition();
 
+	// Calculates the cross-correlation value for a mixing position.
+	float calcCrossCorr(int iOffs) const;
+
 	// Slopes the amplitude of the mid-buffer samples.
 	void calcCrossCorrReference();
 
@@ -255,6 +274,7 @@ private:
 
 	float m_fTempo;
 	bool  m_bQuickSeek;
+	bool  m_bCoarseSeek;
 
 	unsigned int m_iSampleRate;
 	unsigned int m_iSequenceMs;
@@ -278,8 +298,14 @@ private:
 	FifoBuffer m_inputBuffer;
 	bool m_bMidBufferDirty;
 
+	// Current processor kernel type.
+	Kernel m_kernel;
+
 	// Calculates the cross-correlation value over the overlap period.
 	float (*m_pfnCrossCorr)(const float *, const float *, unsigned int);
+
+	// Overlap-adds the input with the mid-buffer over the overlap period.
+	void (*m_pfnOverlap)(float *, const float *, const float *, unsigned int);
 };
 
 
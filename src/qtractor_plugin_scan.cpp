@@ -1842,31 +1842,40 @@ int main ( int argc, char **argv )
 			const QString& sHint = req.at(0).toUpper();
 			const QString& sFilename = req.at(1);
 		#ifdef CONFIG_LADSPA
-			if (sHint == "LADSPA")
+			if (sHint == "LADSPA") {
 				qtractor_ladspa_scan_file(sFilename);
+			}
 			else
 		#endif
 		#ifdef CONFIG_DSSI
-			if (sHint == "DSSI")
+			if (sHint == "DSSI") {
 				qtractor_dssi_scan_file(sFilename);
+			}
 			else
 		#endif
 		#ifdef CONFIG_VST2
-			if (sHint == "VST2" || sHint == "VST")
+			if (sHint == "VST2" || sHint == "VST") {
 				qtractor_vst2_scan_file(sFilename);
+			}
 			else
 		#endif
 		#ifdef CONFIG_VST3
-			if (sHint == "VST3")
+			if (sHint == "VST3") {
 				qtractor_vst3_scan_file(sFilename);
+			}
 			else
 		#endif
 		#ifdef CONFIG_CLAP
-			if (sHint == "CLAP")
+			if (sHint == "CLAP") {
 				qtractor_clap_scan_file(sFilename);
+			}
 			else
 		#endif
-			break;
+			{
+				break;
+			}
+			// Done with this one, anyway (always on a line of its own)...
+			QTextStream(stdout) << "\nDONE|" << sFilename << '\n';
 		}
 	}
 #ifdef CONFIG_DEBUG